@@ -8,6 +8,6 @@ public class CityGIS : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "WebBrowser", "WebBrowserWidget", "UMG", "Json", "JsonUtilities"  });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "WebBrowser", "WebBrowserWidget", "UMG", "Json", "JsonUtilities", "ProceduralMeshComponent" });
 	}
 }
@@ -0,0 +1,982 @@
+#include "GISBinarySave.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISBinarySave, Log, All);
+
+const TCHAR* FGISBinarySave::Extension = TEXT(".gisb");
+
+namespace
+{
+	constexpr uint32 SaveMagic = 0x42534947; // "GISB"
+	constexpr uint32 SaveVersion = 1;
+	constexpr double CoordScale = 1e7;
+	constexpr double MaxCoord = MAX_int32 / CoordScale;
+
+	// 每处理这么多要素汇报一次进度
+	constexpr int32 ProgressInterval = 256;
+
+	bool ReportProgress(const FGISSaveProgress& Progress, float Value)
+	{
+		return !Progress || Progress(Value);
+	}
+
+	// 属性表中按下标保存的字符串属性 (顺序即写出顺序)
+	const TCHAR* const StringKeys[] = {
+		TEXT("id"), TEXT("name"), TEXT("svCol"), TEXT("customType"), TEXT("pid"), TEXT("svTxtCol"), TEXT("customTag")
+	};
+	constexpr int32 NumStringKeys = UE_ARRAY_COUNT(StringKeys);
+
+	// PresentMask：低位为字符串属性，其后为数值/布尔/中心点
+	constexpr uint16 Mask_Opacity = 1 << (NumStringKeys + 0);
+	constexpr uint16 Mask_Height = 1 << (NumStringKeys + 1);
+	constexpr uint16 Mask_Line = 1 << (NumStringKeys + 2);
+	constexpr uint16 Mask_LineValue = 1 << (NumStringKeys + 3);
+	constexpr uint16 Mask_Center = 1 << (NumStringKeys + 4);
+
+	enum class EGeomType : uint8
+	{
+		None,
+		Point,
+		LineString,
+		MultiLineString,
+		Polygon,
+		MultiPolygon,
+		// 其他几何 (GeometryCollection 等) 原样存为 JSON 文本
+		Raw
+	};
+
+	struct FFeatureRow
+	{
+		uint16 PresentMask = 0;
+		int32 Strings[NumStringKeys];
+		int32 ExtraProperties = INDEX_NONE;
+		int32 RawGeometry = INDEX_NONE;
+		double Opacity = 0.0;
+		double Height = 0.0;
+		FVector2D Center = FVector2D::ZeroVector;
+		EGeomType GeomType = EGeomType::None;
+		int32 PartCount = 0;
+
+		FFeatureRow()
+		{
+			for (int32& Index : Strings)
+			{
+				Index = INDEX_NONE;
+			}
+		}
+
+		// 定长行，用于读取前校验行数
+		static constexpr int64 SerializedSize = 2 + 4 * (NumStringKeys + 2) + 8 * 4 + 1 + 4;
+
+		friend FArchive& operator<<(FArchive& Ar, FFeatureRow& Row)
+		{
+			Ar << Row.PresentMask;
+			for (int32& Index : Row.Strings)
+			{
+				Ar << Index;
+			}
+			Ar << Row.ExtraProperties << Row.RawGeometry;
+			Ar << Row.Opacity << Row.Height << Row.Center.X << Row.Center.Y;
+			uint8 GeomType = static_cast<uint8>(Row.GeomType);
+			Ar << GeomType;
+			Row.GeomType = static_cast<EGeomType>(GeomType);
+			Ar << Row.PartCount;
+			return Ar;
+		}
+	};
+
+	// 平铺数组：长度 + 原始字节，读取时先校验剩余长度
+	template <typename T>
+	void SerializeFlat(FArchive& Ar, TArray<T>& Array)
+	{
+		int32 Num = Array.Num();
+		Ar << Num;
+		if (Ar.IsLoading())
+		{
+			if (Num < 0 || static_cast<int64>(Num) * sizeof(T) > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+			Array.SetNumUninitialized(Num);
+		}
+		Ar.Serialize(Array.GetData(), static_cast<int64>(Num) * sizeof(T));
+	}
+
+	struct FPayload
+	{
+		TArray<FString> Strings;
+		TArray<FFeatureRow> Rows;
+		// 每个部件的环数 / 每个环的点数 / 差分编码的量化坐标 (x, y 交错)
+		TArray<int32> PartRings;
+		TArray<int32> RingPoints;
+		TArray<int32> Coords;
+
+		bool Serialize(FArchive& Ar)
+		{
+			int32 NumStrings = Strings.Num();
+			Ar << NumStrings;
+			if (Ar.IsLoading())
+			{
+				// 每个 FString 至少占 4 字节长度前缀
+				if (NumStrings < 0 || NumStrings * 4ll > Ar.TotalSize() - Ar.Tell())
+				{
+					return false;
+				}
+				Strings.SetNum(NumStrings);
+			}
+			for (FString& String : Strings)
+			{
+				Ar << String;
+			}
+
+			int32 NumRows = Rows.Num();
+			Ar << NumRows;
+			if (Ar.IsLoading())
+			{
+				if (NumRows < 0 || NumRows * FFeatureRow::SerializedSize > Ar.TotalSize() - Ar.Tell())
+				{
+					return false;
+				}
+				Rows.SetNum(NumRows);
+			}
+			for (FFeatureRow& Row : Rows)
+			{
+				Ar << Row;
+			}
+
+			SerializeFlat(Ar, PartRings);
+			SerializeFlat(Ar, RingPoints);
+			SerializeFlat(Ar, Coords);
+			return !Ar.IsError();
+		}
+	};
+
+	FName GetCompressionName(EGISSaveCompression Compression)
+	{
+		switch (Compression)
+		{
+		case EGISSaveCompression::Zlib:
+			return NAME_Zlib;
+		case EGISSaveCompression::Oodle:
+			return NAME_Oodle;
+		default:
+			return NAME_None;
+		}
+	}
+
+	// GeoJSON Feature -> 属性表行 + 平铺几何
+	class FPayloadBuilder
+	{
+	public:
+		FPayload Payload;
+		FBox2D Bounds = FBox2D(ForceInit);
+
+		void AddFeature(const FJsonObject& Feature)
+		{
+			FFeatureRow& Row = Payload.Rows.AddDefaulted_GetRef();
+
+			const TSharedPtr<FJsonObject>* Properties = nullptr;
+			if (Feature.TryGetObjectField(TEXT("properties"), Properties))
+			{
+				AddProperties(**Properties, Row);
+			}
+
+			const TSharedPtr<FJsonObject>* Geometry = nullptr;
+			if (Feature.TryGetObjectField(TEXT("geometry"), Geometry))
+			{
+				AddGeometry(Geometry->ToSharedRef(), Row);
+			}
+		}
+
+	private:
+		TMap<FString, int32> StringLookup;
+
+		int32 AddString(const FString& String)
+		{
+			if (const int32* Found = StringLookup.Find(String))
+			{
+				return *Found;
+			}
+			const int32 Index = Payload.Strings.Add(String);
+			StringLookup.Add(String, Index);
+			return Index;
+		}
+
+		static FString WriteCondensed(const TSharedRef<FJsonObject>& Object)
+		{
+			FString Text;
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+			FJsonSerializer::Serialize(Object, Writer);
+			return Text;
+		}
+
+		void AddProperties(const FJsonObject& Properties, FFeatureRow& Row)
+		{
+			TSharedRef<FJsonObject> Extra = MakeShared<FJsonObject>();
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Properties.Values)
+			{
+				const FString& Key = Pair.Key;
+				const TSharedPtr<FJsonValue>& Value = Pair.Value;
+				if (!Value.IsValid())
+				{
+					continue;
+				}
+
+				bool bKnown = false;
+				if (Value->Type == EJson::String)
+				{
+					for (int32 Slot = 0; Slot < NumStringKeys; ++Slot)
+					{
+						if (Key == StringKeys[Slot])
+						{
+							Row.Strings[Slot] = AddString(Value->AsString());
+							Row.PresentMask |= 1 << Slot;
+							bKnown = true;
+							break;
+						}
+					}
+				}
+				else if (Value->Type == EJson::Number && Key == TEXT("svOp"))
+				{
+					Row.Opacity = Value->AsNumber();
+					Row.PresentMask |= Mask_Opacity;
+					bKnown = true;
+				}
+				else if (Value->Type == EJson::Number && Key == TEXT("customHeight"))
+				{
+					Row.Height = Value->AsNumber();
+					Row.PresentMask |= Mask_Height;
+					bKnown = true;
+				}
+				else if (Value->Type == EJson::Boolean && Key == TEXT("svLine"))
+				{
+					Row.PresentMask |= Mask_Line | (Value->AsBool() ? Mask_LineValue : 0);
+					bKnown = true;
+				}
+				else if (Value->Type == EJson::Array && Key == TEXT("center"))
+				{
+					const TArray<TSharedPtr<FJsonValue>>& Center = Value->AsArray();
+					if (Center.Num() == 2 && Center[0]->Type == EJson::Number && Center[1]->Type == EJson::Number)
+					{
+						Row.Center = FVector2D(Center[0]->AsNumber(), Center[1]->AsNumber());
+						Row.PresentMask |= Mask_Center;
+						bKnown = true;
+					}
+				}
+
+				if (!bKnown)
+				{
+					Extra->SetField(Key, Value);
+				}
+			}
+
+			if (Extra->Values.Num() > 0)
+			{
+				// 只保留花括号内部，读取时直接拼接到已知属性之后
+				const FString Text = WriteCondensed(Extra);
+				Row.ExtraProperties = AddString(Text.Mid(1, Text.Len() - 2));
+			}
+		}
+
+		bool AddRing(const TArray<TSharedPtr<FJsonValue>>& Points)
+		{
+			const int32 First = Payload.Coords.Num();
+			uint32 PrevX = 0;
+			uint32 PrevY = 0;
+			for (const TSharedPtr<FJsonValue>& PointValue : Points)
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Point = nullptr;
+				if (!PointValue.IsValid() || !PointValue->TryGetArray(Point) || Point->Num() < 2
+					|| (*Point)[0]->Type != EJson::Number || (*Point)[1]->Type != EJson::Number)
+				{
+					Payload.Coords.SetNum(First);
+					return false;
+				}
+
+				const double X = (*Point)[0]->AsNumber();
+				const double Y = (*Point)[1]->AsNumber();
+				if (FMath::Abs(X) > MaxCoord || FMath::Abs(Y) > MaxCoord)
+				{
+					Payload.Coords.SetNum(First);
+					return false;
+				}
+				Bounds += FVector2D(X, Y);
+
+				// 无符号回绕做差分，跨度再大也能精确还原
+				const uint32 QX = static_cast<uint32>(static_cast<int32>(FMath::RoundToDouble(X * CoordScale)));
+				const uint32 QY = static_cast<uint32>(static_cast<int32>(FMath::RoundToDouble(Y * CoordScale)));
+				Payload.Coords.Add(static_cast<int32>(QX - PrevX));
+				Payload.Coords.Add(static_cast<int32>(QY - PrevY));
+				PrevX = QX;
+				PrevY = QY;
+			}
+			Payload.RingPoints.Add(Points.Num());
+			return true;
+		}
+
+		bool AddPart(const TArray<TSharedPtr<FJsonValue>>& Rings)
+		{
+			for (const TSharedPtr<FJsonValue>& RingValue : Rings)
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Ring = nullptr;
+				if (!RingValue.IsValid() || !RingValue->TryGetArray(Ring) || !AddRing(*Ring))
+				{
+					return false;
+				}
+			}
+			Payload.PartRings.Add(Rings.Num());
+			return true;
+		}
+
+		bool AddCoordinates(EGeomType Type, const TArray<TSharedPtr<FJsonValue>>& Coordinates, int32& OutParts)
+		{
+			switch (Type)
+			{
+			case EGeomType::Point:
+			{
+				// 单点按 "一个部件、一个环、一个点" 存储
+				TArray<TSharedPtr<FJsonValue>> Ring;
+				Ring.Add(MakeShared<FJsonValueArray>(Coordinates));
+				TArray<TSharedPtr<FJsonValue>> Part;
+				Part.Add(MakeShared<FJsonValueArray>(Ring));
+				OutParts = 1;
+				return AddPart(Part);
+			}
+			case EGeomType::LineString:
+			{
+				TArray<TSharedPtr<FJsonValue>> Part;
+				Part.Add(MakeShared<FJsonValueArray>(Coordinates));
+				OutParts = 1;
+				return AddPart(Part);
+			}
+			case EGeomType::MultiLineString:
+			case EGeomType::Polygon:
+				OutParts = 1;
+				return AddPart(Coordinates);
+			case EGeomType::MultiPolygon:
+				for (const TSharedPtr<FJsonValue>& PartValue : Coordinates)
+				{
+					const TArray<TSharedPtr<FJsonValue>>* Part = nullptr;
+					if (!PartValue.IsValid() || !PartValue->TryGetArray(Part) || !AddPart(*Part))
+					{
+						return false;
+					}
+					++OutParts;
+				}
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		void AddGeometry(const TSharedRef<FJsonObject>& Geometry, FFeatureRow& Row)
+		{
+			static const TPair<const TCHAR*, EGeomType> TypeNames[] = {
+				{ TEXT("Point"), EGeomType::Point },
+				{ TEXT("LineString"), EGeomType::LineString },
+				{ TEXT("MultiLineString"), EGeomType::MultiLineString },
+				{ TEXT("Polygon"), EGeomType::Polygon },
+				{ TEXT("MultiPolygon"), EGeomType::MultiPolygon },
+			};
+
+			FString TypeName;
+			Geometry->TryGetStringField(TEXT("type"), TypeName);
+			EGeomType Type = EGeomType::Raw;
+			for (const TPair<const TCHAR*, EGeomType>& Entry : TypeNames)
+			{
+				if (TypeName == Entry.Key)
+				{
+					Type = Entry.Value;
+					break;
+				}
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* Coordinates = nullptr;
+			if (Type != EGeomType::Raw && Geometry->TryGetArrayField(TEXT("coordinates"), Coordinates))
+			{
+				const FBox2D BoundsMark = Bounds;
+				const int32 PartMark = Payload.PartRings.Num();
+				const int32 RingMark = Payload.RingPoints.Num();
+				const int32 CoordMark = Payload.Coords.Num();
+				int32 Parts = 0;
+				if (AddCoordinates(Type, *Coordinates, Parts))
+				{
+					Row.GeomType = Type;
+					Row.PartCount = Parts;
+					return;
+				}
+				// 坐标结构不合规时回滚，整体按原文保存
+				Payload.PartRings.SetNum(PartMark);
+				Payload.RingPoints.SetNum(RingMark);
+				Payload.Coords.SetNum(CoordMark);
+				Bounds = BoundsMark;
+			}
+
+			Row.GeomType = EGeomType::Raw;
+			Row.RawGeometry = AddString(WriteCondensed(Geometry));
+		}
+	};
+
+	// 属性表 + 平铺几何 -> Feature 数组文本，游标越界视为文件损坏
+	class FFeatureWriter
+	{
+	public:
+		FFeatureWriter(const FPayload& InPayload, FString& InOut, const FGISSaveProgress& InProgress)
+			: Payload(InPayload), Out(InOut), Progress(InProgress)
+		{
+		}
+
+		bool WasCancelled() const
+		{
+			return bCancelled;
+		}
+
+		// 进度从 ProgressStart 线性增长到 1
+		bool Write(float ProgressStart)
+		{
+			Out.Reset();
+			Out.Reserve(Payload.Coords.Num() * 12 + Payload.Rows.Num() * 256);
+			Out.AppendChar(TEXT('['));
+			for (int32 RowIdx = 0; RowIdx < Payload.Rows.Num(); ++RowIdx)
+			{
+				if (RowIdx > 0)
+				{
+					Out.AppendChar(TEXT(','));
+				}
+				if (RowIdx % ProgressInterval == 0
+					&& !ReportProgress(Progress, ProgressStart + (1.0f - ProgressStart) * RowIdx / Payload.Rows.Num()))
+				{
+					bCancelled = true;
+					return false;
+				}
+				const FFeatureRow& Row = Payload.Rows[RowIdx];
+				Out += TEXT("{\"type\":\"Feature\",\"properties\":{");
+				if (!WriteProperties(Row))
+				{
+					return false;
+				}
+				Out += TEXT("},\"geometry\":");
+				if (!WriteGeometry(Row))
+				{
+					return false;
+				}
+				Out.AppendChar(TEXT('}'));
+			}
+			Out.AppendChar(TEXT(']'));
+			return PartCursor == Payload.PartRings.Num() && RingCursor == Payload.RingPoints.Num() && CoordCursor == Payload.Coords.Num();
+		}
+
+	private:
+		const FPayload& Payload;
+		FString& Out;
+		const FGISSaveProgress& Progress;
+		bool bCancelled = false;
+		int32 PartCursor = 0;
+		int32 RingCursor = 0;
+		int32 CoordCursor = 0;
+		bool bFirstProperty = true;
+
+		const FString* GetString(int32 Index) const
+		{
+			return Payload.Strings.IsValidIndex(Index) ? &Payload.Strings[Index] : nullptr;
+		}
+
+		void WriteKey(const TCHAR* Key)
+		{
+			if (!bFirstProperty)
+			{
+				Out.AppendChar(TEXT(','));
+			}
+			bFirstProperty = false;
+			Out.AppendChar(TEXT('"'));
+			Out += Key;
+			Out += TEXT("\":");
+		}
+
+		// 结果会作为 JS 字面量执行，U+2028/2029 在字符串里也必须转义
+		void WriteFragment(const FString& Fragment)
+		{
+			for (const TCHAR Char : Fragment)
+			{
+				if (Char == 0x2028 || Char == 0x2029)
+				{
+					Out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Out.AppendChar(Char);
+				}
+			}
+		}
+
+		void WriteString(const FString& String)
+		{
+			Out.AppendChar(TEXT('"'));
+			for (const TCHAR Char : String)
+			{
+				if (Char == TEXT('"') || Char == TEXT('\\'))
+				{
+					Out.AppendChar(TEXT('\\'));
+					Out.AppendChar(Char);
+				}
+				else if (static_cast<uint32>(Char) < 0x20 || Char == 0x2028 || Char == 0x2029)
+				{
+					Out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Out.AppendChar(Char);
+				}
+			}
+			Out.AppendChar(TEXT('"'));
+		}
+
+		// 最短可往返的十进制表示
+		void WriteNumber(double Value)
+		{
+			FString Text = FString::Printf(TEXT("%.15g"), Value);
+			if (FCString::Atod(*Text) != Value)
+			{
+				Text = FString::Printf(TEXT("%.17g"), Value);
+			}
+			Out += Text;
+		}
+
+		// 量化值按定点数直接输出，不经过浮点格式化
+		void WriteCoord(int32 Quantized)
+		{
+			TCHAR Buffer[24];
+			int32 Len = 0;
+			int64 Value = Quantized;
+			if (Value < 0)
+			{
+				Buffer[Len++] = TEXT('-');
+				Value = -Value;
+			}
+
+			const int64 Scale = static_cast<int64>(CoordScale);
+			int64 Whole = Value / Scale;
+			int64 Frac = Value % Scale;
+
+			TCHAR Digits[12];
+			int32 NumDigits = 0;
+			do
+			{
+				Digits[NumDigits++] = TEXT('0') + static_cast<TCHAR>(Whole % 10);
+				Whole /= 10;
+			}
+			while (Whole > 0);
+			while (NumDigits > 0)
+			{
+				Buffer[Len++] = Digits[--NumDigits];
+			}
+
+			if (Frac > 0)
+			{
+				Buffer[Len++] = TEXT('.');
+				int32 FracDigits = 7;
+				while (Frac % 10 == 0)
+				{
+					Frac /= 10;
+					--FracDigits;
+				}
+				for (int32 Pos = Len + FracDigits - 1; Pos >= Len; --Pos)
+				{
+					Buffer[Pos] = TEXT('0') + static_cast<TCHAR>(Frac % 10);
+					Frac /= 10;
+				}
+				Len += FracDigits;
+			}
+			Out.AppendChars(Buffer, Len);
+		}
+
+		bool WriteProperties(const FFeatureRow& Row)
+		{
+			bFirstProperty = true;
+			for (int32 Slot = 0; Slot < NumStringKeys; ++Slot)
+			{
+				if (Row.PresentMask & (1 << Slot))
+				{
+					const FString* String = GetString(Row.Strings[Slot]);
+					if (!String)
+					{
+						return false;
+					}
+					WriteKey(StringKeys[Slot]);
+					WriteString(*String);
+				}
+			}
+			if (Row.PresentMask & Mask_Opacity)
+			{
+				WriteKey(TEXT("svOp"));
+				WriteNumber(Row.Opacity);
+			}
+			if (Row.PresentMask & Mask_Line)
+			{
+				WriteKey(TEXT("svLine"));
+				Out += (Row.PresentMask & Mask_LineValue) ? TEXT("true") : TEXT("false");
+			}
+			if (Row.PresentMask & Mask_Height)
+			{
+				WriteKey(TEXT("customHeight"));
+				WriteNumber(Row.Height);
+			}
+			if (Row.PresentMask & Mask_Center)
+			{
+				WriteKey(TEXT("center"));
+				Out.AppendChar(TEXT('['));
+				WriteNumber(Row.Center.X);
+				Out.AppendChar(TEXT(','));
+				WriteNumber(Row.Center.Y);
+				Out.AppendChar(TEXT(']'));
+			}
+			if (Row.ExtraProperties != INDEX_NONE)
+			{
+				const FString* Extra = GetString(Row.ExtraProperties);
+				if (!Extra)
+				{
+					return false;
+				}
+				if (!bFirstProperty)
+				{
+					Out.AppendChar(TEXT(','));
+				}
+				WriteFragment(*Extra);
+			}
+			return true;
+		}
+
+		bool WriteRing(int32 MaxPoints)
+		{
+			if (!Payload.RingPoints.IsValidIndex(RingCursor))
+			{
+				return false;
+			}
+			const int32 NumPoints = Payload.RingPoints[RingCursor++];
+			if (NumPoints < 0 || NumPoints > (Payload.Coords.Num() - CoordCursor) / 2)
+			{
+				return false;
+			}
+
+			uint32 X = 0;
+			uint32 Y = 0;
+			const int32 NumWritten = FMath::Min(NumPoints, MaxPoints);
+			if (MaxPoints > 1)
+			{
+				Out.AppendChar(TEXT('['));
+			}
+			for (int32 PointIdx = 0; PointIdx < NumPoints; ++PointIdx)
+			{
+				X += static_cast<uint32>(Payload.Coords[CoordCursor++]);
+				Y += static_cast<uint32>(Payload.Coords[CoordCursor++]);
+				if (PointIdx >= NumWritten)
+				{
+					continue;
+				}
+				if (PointIdx > 0)
+				{
+					Out.AppendChar(TEXT(','));
+				}
+				Out.AppendChar(TEXT('['));
+				WriteCoord(static_cast<int32>(X));
+				Out.AppendChar(TEXT(','));
+				WriteCoord(static_cast<int32>(Y));
+				Out.AppendChar(TEXT(']'));
+			}
+			if (MaxPoints > 1)
+			{
+				Out.AppendChar(TEXT(']'));
+			}
+			return true;
+		}
+
+		// bWrapRings 为 false 时部件只应有一个环 (Point / LineString)
+		bool WritePart(bool bWrapRings, int32 MaxPoints = MAX_int32)
+		{
+			if (!Payload.PartRings.IsValidIndex(PartCursor))
+			{
+				return false;
+			}
+			const int32 NumRings = Payload.PartRings[PartCursor++];
+			if (NumRings < 0 || (!bWrapRings && NumRings != 1))
+			{
+				return false;
+			}
+
+			if (bWrapRings)
+			{
+				Out.AppendChar(TEXT('['));
+			}
+			for (int32 RingIdx = 0; RingIdx < NumRings; ++RingIdx)
+			{
+				if (RingIdx > 0)
+				{
+					Out.AppendChar(TEXT(','));
+				}
+				if (!WriteRing(MaxPoints))
+				{
+					return false;
+				}
+			}
+			if (bWrapRings)
+			{
+				Out.AppendChar(TEXT(']'));
+			}
+			return true;
+		}
+
+		bool WriteGeometry(const FFeatureRow& Row)
+		{
+			switch (Row.GeomType)
+			{
+			case EGeomType::None:
+				Out += TEXT("null");
+				return Row.PartCount == 0;
+			case EGeomType::Raw:
+				if (const FString* Raw = GetString(Row.RawGeometry))
+				{
+					WriteFragment(*Raw);
+					return Row.PartCount == 0;
+				}
+				return false;
+			case EGeomType::Point:
+				Out += TEXT("{\"type\":\"Point\",\"coordinates\":");
+				if (Row.PartCount != 1 || !WritePart(false, 1))
+				{
+					return false;
+				}
+				break;
+			case EGeomType::LineString:
+				Out += TEXT("{\"type\":\"LineString\",\"coordinates\":");
+				if (Row.PartCount != 1 || !WritePart(false))
+				{
+					return false;
+				}
+				break;
+			case EGeomType::MultiLineString:
+			case EGeomType::Polygon:
+				Out += Row.GeomType == EGeomType::Polygon ? TEXT("{\"type\":\"Polygon\",\"coordinates\":") : TEXT("{\"type\":\"MultiLineString\",\"coordinates\":");
+				if (Row.PartCount != 1 || !WritePart(true))
+				{
+					return false;
+				}
+				break;
+			case EGeomType::MultiPolygon:
+				Out += TEXT("{\"type\":\"MultiPolygon\",\"coordinates\":[");
+				for (int32 PartIdx = 0; PartIdx < Row.PartCount; ++PartIdx)
+				{
+					if (PartIdx > 0)
+					{
+						Out.AppendChar(TEXT(','));
+					}
+					if (!WritePart(true))
+					{
+						return false;
+					}
+				}
+				Out.AppendChar(TEXT(']'));
+				break;
+			default:
+				return false;
+			}
+			Out.AppendChar(TEXT('}'));
+			return true;
+		}
+	};
+}
+
+FArchive& operator<<(FArchive& Ar, FGISSaveHeader& Header)
+{
+	uint32 Magic = SaveMagic;
+	Ar << Magic;
+	if (Magic != SaveMagic)
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Header.Version;
+	if (Header.Version == 0 || Header.Version > SaveVersion)
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Header.ID << Header.Name << Header.Description << Header.Date;
+	Ar << Header.FeatureCount << Header.VertexCount;
+	Ar << Header.Bounds.Min.X << Header.Bounds.Min.Y << Header.Bounds.Max.X << Header.Bounds.Max.Y;
+
+	uint8 Compression = static_cast<uint8>(Header.Compression);
+	Ar << Compression;
+	Header.Compression = static_cast<EGISSaveCompression>(Compression);
+
+	Ar << Header.RawSize << Header.StoredSize;
+
+	if (Ar.IsLoading())
+	{
+		Header.Bounds.bIsValid = Header.VertexCount > 0;
+	}
+	return Ar;
+}
+
+bool FGISBinarySave::IsBinarySave(const FString& FilePath)
+{
+	return FilePath.EndsWith(Extension, ESearchCase::IgnoreCase);
+}
+
+bool FGISBinarySave::Save(const FString& FilePath, const FString& FeaturesJson, FGISSaveHeader& InOutHeader, bool bCompress, const FGISSaveProgress& Progress)
+{
+	TArray<TSharedPtr<FJsonValue>> Features;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FeaturesJson);
+	if (!FJsonSerializer::Deserialize(Reader, Features))
+	{
+		UE_LOG(LogGISBinarySave, Warning, TEXT("存档数据不是要素数组，未写入 %s"), *FilePath);
+		return false;
+	}
+
+	// 进度分段：解析 0.3 / 编码 0.3~0.8 / 压缩写盘 0.8~1
+	if (!ReportProgress(Progress, 0.3f))
+	{
+		return false;
+	}
+
+	FPayloadBuilder Builder;
+	for (int32 FeatureIdx = 0; FeatureIdx < Features.Num(); ++FeatureIdx)
+	{
+		if (FeatureIdx % ProgressInterval == 0 && !ReportProgress(Progress, 0.3f + 0.5f * FeatureIdx / Features.Num()))
+		{
+			return false;
+		}
+
+		const TSharedPtr<FJsonValue>& Value = Features[FeatureIdx];
+		const TSharedPtr<FJsonObject>* Feature = nullptr;
+		if (Value.IsValid() && Value->TryGetObject(Feature))
+		{
+			Builder.AddFeature(**Feature);
+		}
+	}
+
+	TArray<uint8> Raw;
+	FMemoryWriter RawWriter(Raw);
+	Builder.Payload.Serialize(RawWriter);
+	if (!ReportProgress(Progress, 0.8f))
+	{
+		return false;
+	}
+
+	// 先试 Oodle，不可用时退回 Zlib；压缩无收益则存原文
+	TArray<uint8> Compressed;
+	EGISSaveCompression Compression = EGISSaveCompression::None;
+	if (bCompress && Raw.Num() > 0)
+	{
+		for (const EGISSaveCompression Candidate : { EGISSaveCompression::Oodle, EGISSaveCompression::Zlib })
+		{
+			const FName Format = GetCompressionName(Candidate);
+			int32 CompressedSize = FCompression::CompressMemoryBound(Format, Raw.Num());
+			Compressed.SetNumUninitialized(CompressedSize);
+			if (FCompression::CompressMemory(Format, Compressed.GetData(), CompressedSize, Raw.GetData(), Raw.Num()) && CompressedSize < Raw.Num())
+			{
+				Compressed.SetNum(CompressedSize);
+				Compression = Candidate;
+				break;
+			}
+		}
+	}
+	const TArray<uint8>& Stored = Compression != EGISSaveCompression::None ? Compressed : Raw;
+
+	InOutHeader.Version = SaveVersion;
+	InOutHeader.FeatureCount = Builder.Payload.Rows.Num();
+	InOutHeader.VertexCount = Builder.Payload.Coords.Num() / 2;
+	InOutHeader.Bounds = Builder.Bounds;
+	InOutHeader.Compression = Compression;
+	InOutHeader.RawSize = Raw.Num();
+	InOutHeader.StoredSize = Stored.Num();
+
+	TArray<uint8> FileBytes;
+	FileBytes.Reserve(Stored.Num() + 1024);
+	FMemoryWriter FileWriter(FileBytes);
+	FileWriter << InOutHeader;
+	FileWriter.Serialize(const_cast<uint8*>(Stored.GetData()), Stored.Num());
+
+	// 写盘前最后一次检查取消，之后文件必然完整落盘
+	if (!ReportProgress(Progress, 0.9f))
+	{
+		return false;
+	}
+	if (!FFileHelper::SaveArrayToFile(FileBytes, *FilePath))
+	{
+		UE_LOG(LogGISBinarySave, Warning, TEXT("写入存档失败: %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool FGISBinarySave::ReadHeader(const FString& FilePath, FGISSaveHeader& OutHeader)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader)
+	{
+		return false;
+	}
+	*Reader << OutHeader;
+	return !Reader->IsError();
+}
+
+bool FGISBinarySave::Load(const FString& FilePath, FGISSaveHeader& OutHeader, FString& OutFeaturesJson, const FGISSaveProgress& Progress)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath) || !ReportProgress(Progress, 0.1f))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Reader << OutHeader;
+	const int64 PayloadOffset = Reader.Tell();
+	if (Reader.IsError() || OutHeader.RawSize < 0 || OutHeader.StoredSize < 0 || PayloadOffset + OutHeader.StoredSize > Bytes.Num())
+	{
+		UE_LOG(LogGISBinarySave, Warning, TEXT("存档头无效: %s"), *FilePath);
+		return false;
+	}
+
+	TArrayView<const uint8> PayloadBytes(Bytes.GetData() + PayloadOffset, OutHeader.StoredSize);
+	TArray<uint8> Raw;
+	if (OutHeader.Compression != EGISSaveCompression::None)
+	{
+		Raw.SetNumUninitialized(OutHeader.RawSize);
+		if (!FCompression::UncompressMemory(GetCompressionName(OutHeader.Compression), Raw.GetData(), Raw.Num(), PayloadBytes.GetData(), PayloadBytes.Num()))
+		{
+			UE_LOG(LogGISBinarySave, Warning, TEXT("存档解压失败: %s"), *FilePath);
+			return false;
+		}
+		PayloadBytes = Raw;
+	}
+
+	FPayload Payload;
+	FMemoryReaderView PayloadReader(PayloadBytes);
+	if (!Payload.Serialize(PayloadReader))
+	{
+		UE_LOG(LogGISBinarySave, Warning, TEXT("存档内容损坏: %s"), *FilePath);
+		return false;
+	}
+
+	FFeatureWriter Writer(Payload, OutFeaturesJson, Progress);
+	if (!Writer.Write(0.3f))
+	{
+		if (!Writer.WasCancelled())
+		{
+			UE_LOG(LogGISBinarySave, Warning, TEXT("存档内容损坏: %s"), *FilePath);
+		}
+		OutFeaturesJson.Reset();
+		return false;
+	}
+	return true;
+}
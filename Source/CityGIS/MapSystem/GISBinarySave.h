@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 进度回调：参数为 0~1，返回 false 表示取消
+using FGISSaveProgress = TFunction<bool(float)>;
+
+// .gisb 负载的压缩方式 (写入文件头，读取时据此解压)
+enum class EGISSaveCompression : uint8
+{
+	None,
+	Zlib,
+	Oodle
+};
+
+/**
+ * .gisb 文件头：定长字段 + 元数据字符串
+ * 列表界面只需读取这一段，不必读入整个存档
+ */
+struct FGISSaveHeader
+{
+	uint32 Version = 0;
+	FString ID;
+	FString Name;
+	FString Description;
+	FString Date;
+	int32 FeatureCount = 0;
+	int32 VertexCount = 0;
+	FBox2D Bounds = FBox2D(ForceInit);
+	EGISSaveCompression Compression = EGISSaveCompression::None;
+	int32 RawSize = 0;
+	int32 StoredSize = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FGISSaveHeader& Header);
+};
+
+/**
+ * 二进制存档 (.gisb)，与 JSON 存档并存
+ *
+ * 布局：文件头 | 负载 (可选 Oodle/Zlib 压缩)
+ * 负载：字符串表 | 要素属性表 | 部件/环/点数 | 量化坐标
+ *   - 属性表只存字符串表下标和数值，已知字段之外的属性原样保留为 JSON 片段
+ *   - 坐标按 1e-7 度量化为 int32 (约 1cm)，环内差分编码以便压缩
+ * 读取时一次读盘，直接拼出网页 importMap 所需的要素数组文本，不构建 JSON DOM
+ * 纯计算、无共享状态，可在工作线程中调用
+ */
+class CITYGIS_API FGISBinarySave
+{
+public:
+	static const TCHAR* Extension;
+
+	static bool IsBinarySave(const FString& FilePath);
+
+	// FeaturesJson 为网页导出的 Feature 数组；Header 的元数据由调用方填写，统计字段由这里写回
+	static bool Save(const FString& FilePath, const FString& FeaturesJson, FGISSaveHeader& InOutHeader, bool bCompress, const FGISSaveProgress& Progress = nullptr);
+
+	static bool ReadHeader(const FString& FilePath, FGISSaveHeader& OutHeader);
+
+	// 解码为 Feature 数组的 JSON 文本 (可直接作为 JS 字面量)
+	static bool Load(const FString& FilePath, FGISSaveHeader& OutHeader, FString& OutFeaturesJson, const FGISSaveProgress& Progress = nullptr);
+};
@@ -0,0 +1,103 @@
+#include "GISBridge.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISBridge, Log, All);
+
+const FString UGISBridge::BindingName = TEXT("gisbridge");
+
+void UGISBridge::RegisterHandler(FName MessageType, FGISBridgeHandler Handler)
+{
+	Handlers.Add(MessageType, MoveTemp(Handler));
+}
+
+bool UGISBridge::Dispatch(FName MessageType, const FString& Payload) const
+{
+	if (const FGISBridgeHandler* Handler = Handlers.Find(MessageType))
+	{
+		return Handler->ExecuteIfBound(Payload);
+	}
+
+	if (MessageType == TEXT("ERROR"))
+	{
+		UE_LOG(LogGISBridge, Warning, TEXT("%s"), *Payload);
+	}
+	else
+	{
+		UE_LOG(LogGISBridge, Verbose, TEXT("[%s] %s"), *MessageType.ToString(), *Payload);
+	}
+	return false;
+}
+
+void UGISBridge::Post(const FString& Type, const FString& Payload)
+{
+	Dispatch(FName(*Type), Payload);
+}
+
+void UGISBridge::AddFeatures(const TArray<FGISFeatureRecord>& Records)
+{
+	FeatureHandler.ExecuteIfBound(Records);
+}
+
+bool UGISBridge::DispatchConsoleMessage(const FString& Message) const
+{
+	if (!Message.StartsWith(TEXT("UE_"), ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	int32 ColonIdx = INDEX_NONE;
+	if (!Message.FindChar(TEXT(':'), ColonIdx))
+	{
+		return false;
+	}
+
+	const FString Type = Message.Mid(3, ColonIdx - 3);
+	const FString Payload = Message.Mid(ColonIdx + 1);
+
+	if (Type != TEXT("ADD"))
+	{
+		return Dispatch(FName(*Type), Payload);
+	}
+
+	// 与 addfeatures 相同的记录数组 (JSON)，含 geometry/road，保证空间索引在兜底通道下也能建立
+	TArray<TSharedPtr<FJsonValue>> Values;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload);
+	if (!FJsonSerializer::Deserialize(Reader, Values))
+	{
+		UE_LOG(LogGISBridge, Warning, TEXT("无法解析要素记录"));
+		return false;
+	}
+
+	TArray<FGISFeatureRecord> Records;
+	Records.Reserve(Values.Num());
+	for (const TSharedPtr<FJsonValue>& Value : Values)
+	{
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		FGISFeatureRecord Record;
+		if (!Value.IsValid() || !Value->TryGetObject(Object) || !(*Object)->TryGetStringField(TEXT("id"), Record.ID))
+		{
+			continue;
+		}
+
+		double Number = 0.0;
+		(*Object)->TryGetStringField(TEXT("name"), Record.Name);
+		(*Object)->TryGetStringField(TEXT("type"), Record.Type);
+		(*Object)->TryGetStringField(TEXT("parentId"), Record.ParentID);
+		(*Object)->TryGetStringField(TEXT("color"), Record.Color);
+		if ((*Object)->TryGetNumberField(TEXT("opacity"), Number))
+		{
+			Record.Opacity = static_cast<float>(Number);
+		}
+		(*Object)->TryGetStringField(TEXT("textColor"), Record.TextColor);
+		(*Object)->TryGetStringField(TEXT("tag"), Record.Tag);
+		if ((*Object)->TryGetNumberField(TEXT("height"), Number))
+		{
+			Record.Height = static_cast<float>(Number);
+		}
+		(*Object)->TryGetStringField(TEXT("geometry"), Record.Geometry);
+		(*Object)->TryGetStringField(TEXT("road"), Record.Road);
+		Records.Add(MoveTemp(Record));
+	}
+	return FeatureHandler.ExecuteIfBound(Records);
+}
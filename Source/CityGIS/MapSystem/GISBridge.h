@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GISBridge.generated.h"
+
+// JS -> C++ 的要素记录，替代原先 "UE_ADD:id|name|..." 的竖线拼接字符串
+// JS 端字段名大小写不敏感 (FName 匹配)，例如 { id, name, type, parentId, ... }
+USTRUCT(BlueprintType)
+struct FGISFeatureRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY() FString ID;
+	UPROPERTY() FString Name;
+	UPROPERTY() FString Type;
+	UPROPERTY() FString ParentID;
+	UPROPERTY() FString Color;
+	UPROPERTY() float Opacity = 1.0f;
+	UPROPERTY() FString TextColor;
+	UPROPERTY() FString Tag;
+	UPROPERTY() float Height = 0.0f;
+	// 要素几何的 GeoJSON 文本 (geometry 对象)，供 C++ 侧空间分析使用
+	UPROPERTY() FString Geometry;
+	// 【新增】道路的中心线与宽度 (properties.road 的 JSON 文本)，其它要素为空
+	UPROPERTY() FString Road;
+};
+
+DECLARE_DELEGATE_OneParam(FGISBridgeHandler, const FString& /*Payload*/);
+DECLARE_DELEGATE_OneParam(FGISFeatureBatchHandler, const TArray<FGISFeatureRecord>& /*Records*/);
+
+/**
+ * 网页 <-> C++ 的结构化消息通道
+ * 绑定到 WebBrowser 后，JS 通过 window.ue.gisbridge.post(type, payload) / addfeatures([...]) 调用
+ * C++ 侧按消息类型查表分发，大数据 (导出 GeoJSON) 只以引用传递，不再做前缀扫描和 RightChop 拷贝
+ */
+UCLASS()
+class CITYGIS_API UGISBridge : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// JS 端对象名 (UE 绑定时会转为小写)
+	static const FString BindingName;
+
+	void RegisterHandler(FName MessageType, FGISBridgeHandler Handler);
+	FGISFeatureBatchHandler& OnFeatures() { return FeatureHandler; }
+
+	bool Dispatch(FName MessageType, const FString& Payload) const;
+
+	// 兼容旧的 console.log("UE_xxx:...") 通道，浏览器未注入绑定对象时使用
+	// UE_ADD 的载荷是与 addfeatures 相同的记录数组 (JSON)
+	bool DispatchConsoleMessage(const FString& Message) const;
+
+	UFUNCTION()
+	void Post(const FString& Type, const FString& Payload);
+
+	UFUNCTION()
+	void AddFeatures(const TArray<FGISFeatureRecord>& Records);
+
+private:
+	TMap<FName, FGISBridgeHandler> Handlers;
+	FGISFeatureBatchHandler FeatureHandler;
+};
@@ -0,0 +1,82 @@
+#include "GISCityMeshActor.h"
+#include "ProceduralMeshComponent.h"
+#include "Materials/MaterialInterface.h"
+
+AGISCityMeshActor::AGISCityMeshActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Mesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Mesh"));
+	Mesh->bUseAsyncCooking = true;
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RootComponent = Mesh;
+}
+
+void AGISCityMeshActor::ApplySections(const TArray<FGISMeshSection>& Sections)
+{
+	TSet<FString> Present;
+	Present.Reserve(Sections.Num());
+
+	for (const FGISMeshSection& Section : Sections)
+	{
+		Present.Add(Section.Group);
+		if (FSectionSlot* Slot = SectionByGroup.Find(Section.Group))
+		{
+			if (Slot->Hash != Section.Hash)
+			{
+				Slot->Hash = Section.Hash;
+				CreateSection(Slot->Index, Section);
+			}
+			continue;
+		}
+
+		// 没有空闲段号时已用段号恰为 [0, Num)
+		FSectionSlot NewSlot;
+		NewSlot.Index = FreeSections.Num() > 0 ? FreeSections.Pop(EAllowShrinking::No) : SectionByGroup.Num();
+		NewSlot.Hash = Section.Hash;
+		SectionByGroup.Add(Section.Group, NewSlot);
+		CreateSection(NewSlot.Index, Section);
+	}
+
+	for (auto It = SectionByGroup.CreateIterator(); It; ++It)
+	{
+		if (!Present.Contains(It.Key()))
+		{
+			Mesh->ClearMeshSection(It.Value().Index);
+			FreeSections.Add(It.Value().Index);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void AGISCityMeshActor::ClearSections()
+{
+	Mesh->ClearAllMeshSections();
+	SectionByGroup.Reset();
+	FreeSections.Reset();
+}
+
+void AGISCityMeshActor::CreateSection(int32 Index, const FGISMeshSection& Section)
+{
+	Mesh->CreateMeshSection(Index, Section.Vertices, Section.Triangles, Section.Normals, TArray<FVector2D>(), Section.Colors, TArray<FProcMeshTangent>(), bCollision);
+	if (Material)
+	{
+		Mesh->SetMaterial(Index, Material);
+	}
+}
+
+void AGISCityMeshActor::SetMeshMaterial(UMaterialInterface* InMaterial)
+{
+	Material = InMaterial;
+	for (const TPair<FString, FSectionSlot>& Pair : SectionByGroup)
+	{
+		Mesh->SetMaterial(Pair.Value.Index, Material);
+	}
+}
+
+void AGISCityMeshActor::SetCollisionEnabled(bool bEnabled)
+{
+	// 已有网格段的碰撞在下次重建该分组时生效
+	bCollision = bEnabled;
+	Mesh->SetCollisionEnabled(bEnabled ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GISExtrusion.h"
+#include "GISCityMeshActor.generated.h"
+
+class UProceduralMeshComponent;
+class UMaterialInterface;
+
+/**
+ * 要素拉伸出的城市体块：每个分组 (区镇) 一个程序化网格段
+ * 重建结果按分组提交，内容哈希未变的网格段保留不动，只重新上传变化的分组
+ */
+UCLASS()
+class CITYGIS_API AGISCityMeshActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGISCityMeshActor();
+
+	// 用一次完整构建的结果替换当前网格：新增/变化的分组重建，消失的分组清除
+	void ApplySections(const TArray<FGISMeshSection>& Sections);
+	void ClearSections();
+
+	void SetMeshMaterial(UMaterialInterface* InMaterial);
+	void SetCollisionEnabled(bool bEnabled);
+
+	int32 NumSections() const { return SectionByGroup.Num(); }
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GIS")
+	UProceduralMeshComponent* Mesh = nullptr;
+
+private:
+	struct FSectionSlot
+	{
+		int32 Index = 0;
+		uint32 Hash = 0;
+	};
+
+	void CreateSection(int32 Index, const FGISMeshSection& Section);
+
+	UPROPERTY()
+	UMaterialInterface* Material = nullptr;
+
+	bool bCollision = false;
+
+	// 分组 -> 网格段；清除后空出的段号优先复用
+	TMap<FString, FSectionSlot> SectionByGroup;
+	TArray<int32> FreeSections;
+};
@@ -0,0 +1,380 @@
+#include "GISCoordinates.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	constexpr double XPi = UE_DOUBLE_PI * 3000.0 / 180.0;
+	constexpr double DegToRad = UE_DOUBLE_PI / 180.0;
+
+	// 克拉索夫斯基椭球
+	constexpr double KrasovskyA = 6378245.0;
+	constexpr double KrasovskyEE = 0.00669342162296594323;
+
+	// WGS84 椭球
+	constexpr double Wgs84A = 6378137.0;
+	constexpr double Wgs84EE = 0.00669437999014;
+
+	// 反算的不动点迭代次数：偏移量对位置的导数在 1e-3 量级，3 次后误差远小于 1e-9 度
+	constexpr int32 InverseIterations = 3;
+
+	// 批量转换每个任务处理的点数，小于此数不分任务
+	constexpr int32 BatchChunkSize = 4096;
+
+	/**
+	 * 4 个 double 一组的 SIMD 寄存器 (VectorRegister4Double，Windows 上 sin/cos/atan2 走 SVML)
+	 * 重载运算符后下面的转换公式只写一份；标量接口也用它计算 (只取第 0 路)，
+	 * 因为 VectorSin 等与 FMath::Sin 是不同的实现，分开计算时两条路径的结果并不逐位相同
+	 */
+	struct FDouble4
+	{
+		VectorRegister4Double V;
+
+		FDouble4() = default;
+		FDouble4(const VectorRegister4Double& InV) : V(InV) {}
+		FDouble4(double Value) : V(VectorSetFloat1(Value)) {}
+	};
+
+	FORCEINLINE FDouble4 operator+(const FDouble4& A, const FDouble4& B) { return VectorAdd(A.V, B.V); }
+	FORCEINLINE FDouble4 operator-(const FDouble4& A, const FDouble4& B) { return VectorSubtract(A.V, B.V); }
+	FORCEINLINE FDouble4 operator*(const FDouble4& A, const FDouble4& B) { return VectorMultiply(A.V, B.V); }
+	FORCEINLINE FDouble4 operator/(const FDouble4& A, const FDouble4& B) { return VectorDivide(A.V, B.V); }
+	FORCEINLINE FDouble4 operator-(const FDouble4& A) { return VectorNegate(A.V); }
+
+	FORCEINLINE FDouble4 Sqrt(const FDouble4& X) { return VectorSqrt(X.V); }
+	FORCEINLINE FDouble4 Abs(const FDouble4& X) { return VectorAbs(X.V); }
+	FORCEINLINE FDouble4 Sin(const FDouble4& X) { return VectorSin(X.V); }
+	FORCEINLINE FDouble4 Cos(const FDouble4& X) { return VectorCos(X.V); }
+	FORCEINLINE FDouble4 Atan2(const FDouble4& Y, const FDouble4& X) { return VectorATan2(Y.V, X.V); }
+	FORCEINLINE FDouble4 Greater(const FDouble4& A, const FDouble4& B) { return VectorCompareGT(A.V, B.V); }
+	FORCEINLINE FDouble4 Or(const FDouble4& A, const FDouble4& B) { return VectorBitwiseOr(A.V, B.V); }
+	FORCEINLINE FDouble4 Select(const FDouble4& Mask, const FDouble4& A, const FDouble4& B) { return VectorSelect(Mask.V, A.V, B.V); }
+
+	template <typename T>
+	auto IsOutOfChina(const T& Lng, const T& Lat)
+	{
+		return Or(Or(Greater(T(72.004), Lng), Greater(Lng, T(137.8347))), Or(Greater(T(0.8293), Lat), Greater(Lat, T(55.8271))));
+	}
+
+	template <typename T>
+	T TransformLat(const T& X, const T& Y)
+	{
+		T Ret = -100.0 + 2.0 * X + 3.0 * Y + 0.2 * Y * Y + 0.1 * X * Y + 0.2 * Sqrt(Abs(X));
+		Ret = Ret + (20.0 * Sin(6.0 * UE_DOUBLE_PI * X) + 20.0 * Sin(2.0 * UE_DOUBLE_PI * X)) * (2.0 / 3.0);
+		Ret = Ret + (20.0 * Sin(UE_DOUBLE_PI * Y) + 40.0 * Sin(UE_DOUBLE_PI / 3.0 * Y)) * (2.0 / 3.0);
+		Ret = Ret + (160.0 * Sin(UE_DOUBLE_PI / 12.0 * Y) + 320.0 * Sin(UE_DOUBLE_PI / 30.0 * Y)) * (2.0 / 3.0);
+		return Ret;
+	}
+
+	template <typename T>
+	T TransformLng(const T& X, const T& Y)
+	{
+		T Ret = 300.0 + X + 2.0 * Y + 0.1 * X * X + 0.1 * X * Y + 0.1 * Sqrt(Abs(X));
+		Ret = Ret + (20.0 * Sin(6.0 * UE_DOUBLE_PI * X) + 20.0 * Sin(2.0 * UE_DOUBLE_PI * X)) * (2.0 / 3.0);
+		Ret = Ret + (20.0 * Sin(UE_DOUBLE_PI * X) + 40.0 * Sin(UE_DOUBLE_PI / 3.0 * X)) * (2.0 / 3.0);
+		Ret = Ret + (150.0 * Sin(UE_DOUBLE_PI / 12.0 * X) + 300.0 * Sin(UE_DOUBLE_PI / 30.0 * X)) * (2.0 / 3.0);
+		return Ret;
+	}
+
+	// 百度公开算法 (x_pi = π·3000/180)
+	template <typename T>
+	void Gcj02ToBd09(T& Lng, T& Lat)
+	{
+		const T Z = Sqrt(Lng * Lng + Lat * Lat) + 0.00002 * Sin(XPi * Lat);
+		const T Theta = Atan2(Lat, Lng) + 0.000003 * Cos(XPi * Lng);
+		Lng = Z * Cos(Theta) + 0.0065;
+		Lat = Z * Sin(Theta) + 0.006;
+	}
+
+	// 百度公开的近似反算 (误差约 1e-6 度)，再用正算做不动点迭代修正
+	template <typename T>
+	void Bd09ToGcj02(T& Lng, T& Lat)
+	{
+		const T TargetLng = Lng;
+		const T TargetLat = Lat;
+
+		const T X = Lng - 0.0065;
+		const T Y = Lat - 0.006;
+		const T Z = Sqrt(X * X + Y * Y) - 0.00002 * Sin(XPi * Y);
+		const T Theta = Atan2(Y, X) - 0.000003 * Cos(XPi * X);
+		Lng = Z * Cos(Theta);
+		Lat = Z * Sin(Theta);
+
+		for (int32 Iteration = 0; Iteration < InverseIterations; ++Iteration)
+		{
+			T ForwardLng = Lng;
+			T ForwardLat = Lat;
+			Gcj02ToBd09(ForwardLng, ForwardLat);
+			Lng = Lng - (ForwardLng - TargetLng);
+			Lat = Lat - (ForwardLat - TargetLat);
+		}
+	}
+
+	// 国测局算法，国外坐标不偏移
+	template <typename T>
+	void Wgs84ToGcj02(T& Lng, T& Lat)
+	{
+		T DLat = TransformLat(Lng - 105.0, Lat - 35.0);
+		T DLng = TransformLng(Lng - 105.0, Lat - 35.0);
+
+		const T RadLat = DegToRad * Lat;
+		const T SinLat = Sin(RadLat);
+		const T Magic = 1.0 - KrasovskyEE * SinLat * SinLat;
+		const T SqrtMagic = Sqrt(Magic);
+
+		DLat = (DLat * 180.0) / ((KrasovskyA * (1.0 - KrasovskyEE)) / (Magic * SqrtMagic) * UE_DOUBLE_PI);
+		DLng = (DLng * 180.0) / (KrasovskyA / SqrtMagic * Cos(RadLat) * UE_DOUBLE_PI);
+
+		const auto OutOfChina = IsOutOfChina(Lng, Lat);
+		Lng = Select(OutOfChina, Lng, Lng + DLng);
+		Lat = Select(OutOfChina, Lat, Lat + DLat);
+	}
+
+	// 正算没有解析逆，用 W = W - (F(W) - G) 迭代 (国外坐标 F(W) = W，结果不变)
+	template <typename T>
+	void Gcj02ToWgs84(T& Lng, T& Lat)
+	{
+		const T TargetLng = Lng;
+		const T TargetLat = Lat;
+		for (int32 Iteration = 0; Iteration < InverseIterations; ++Iteration)
+		{
+			T ForwardLng = Lng;
+			T ForwardLat = Lat;
+			Wgs84ToGcj02(ForwardLng, ForwardLat);
+			Lng = Lng - (ForwardLng - TargetLng);
+			Lat = Lat - (ForwardLat - TargetLat);
+		}
+	}
+
+	// 统一经 GCJ02 中转，每种组合最多一次正算一次反算
+	template <typename T>
+	void Convert(T& Lng, T& Lat, EGISCoordSystem From, EGISCoordSystem To)
+	{
+		if (From == To)
+		{
+			return;
+		}
+
+		if (From == EGISCoordSystem::BD09)
+		{
+			Bd09ToGcj02(Lng, Lat);
+		}
+		else if (From == EGISCoordSystem::WGS84)
+		{
+			Wgs84ToGcj02(Lng, Lat);
+		}
+
+		if (To == EGISCoordSystem::BD09)
+		{
+			Gcj02ToBd09(Lng, Lat);
+		}
+		else if (To == EGISCoordSystem::WGS84)
+		{
+			Gcj02ToWgs84(Lng, Lat);
+		}
+	}
+
+	// WGS84 大地坐标 (度、米) -> 地心地固坐标 (米)
+	template <typename T>
+	void GeodeticToEcef(const T& Lng, const T& Lat, const T& Height, T& OutX, T& OutY, T& OutZ)
+	{
+		const T RadLng = DegToRad * Lng;
+		const T RadLat = DegToRad * Lat;
+		const T SinLat = Sin(RadLat);
+		const T CosLat = Cos(RadLat);
+		const T N = Wgs84A / Sqrt(1.0 - Wgs84EE * SinLat * SinLat);
+		OutX = (N + Height) * CosLat * Cos(RadLng);
+		OutY = (N + Height) * CosLat * Sin(RadLng);
+		OutZ = (N * (1.0 - Wgs84EE) + Height) * SinLat;
+	}
+
+	// 单点：写入寄存器的 4 路，计算后取第 0 路
+	void ConvertPoint(double& Lng, double& Lat, EGISCoordSystem From, EGISCoordSystem To)
+	{
+		FDouble4 LngLanes(Lng);
+		FDouble4 LatLanes(Lat);
+		Convert(LngLanes, LatLanes, From, To);
+
+		double OutLng[4];
+		double OutLat[4];
+		VectorStore(LngLanes.V, OutLng);
+		VectorStore(LatLanes.V, OutLat);
+		Lng = OutLng[0];
+		Lat = OutLat[0];
+	}
+
+	/**
+	 * 以 4 个点为一组拆成经度、纬度两个寄存器交给 Kernel，结果写回 (末组不足 4 个时用最后一个点补齐，只写回有效的)
+	 * Kernel(FDouble4& Lng, FDouble4& Lat, int32 Start, int32 Count)
+	 */
+	template <typename KernelFunc>
+	void ForEachLanes(TArrayView<const FVector2D> Points, KernelFunc&& Kernel)
+	{
+		double Lng[4];
+		double Lat[4];
+		for (int32 Start = 0; Start < Points.Num(); Start += 4)
+		{
+			const int32 Count = FMath::Min(4, Points.Num() - Start);
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				const FVector2D& Point = Points[Start + FMath::Min(Lane, Count - 1)];
+				Lng[Lane] = Point.X;
+				Lat[Lane] = Point.Y;
+			}
+			FDouble4 LngLanes(VectorLoad(Lng));
+			FDouble4 LatLanes(VectorLoad(Lat));
+			Kernel(LngLanes, LatLanes, Start, Count);
+		}
+	}
+
+	// 大批量按块分给线程池
+	template <typename ChunkFunc>
+	void ForEachChunk(int32 Num, ChunkFunc&& Chunk)
+	{
+		if (Num <= BatchChunkSize)
+		{
+			Chunk(0, Num);
+			return;
+		}
+		const int32 NumChunks = FMath::DivideAndRoundUp(Num, BatchChunkSize);
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			const int32 Start = ChunkIndex * BatchChunkSize;
+			Chunk(Start, FMath::Min(BatchChunkSize, Num - Start));
+		});
+	}
+}
+
+FVector2D GISCoordinates::Gcj02ToBd09(const FVector2D& LngLat)
+{
+	return Convert(LngLat, EGISCoordSystem::GCJ02, EGISCoordSystem::BD09);
+}
+
+FVector2D GISCoordinates::Bd09ToGcj02(const FVector2D& LngLat)
+{
+	return Convert(LngLat, EGISCoordSystem::BD09, EGISCoordSystem::GCJ02);
+}
+
+FVector2D GISCoordinates::Wgs84ToGcj02(const FVector2D& LngLat)
+{
+	return Convert(LngLat, EGISCoordSystem::WGS84, EGISCoordSystem::GCJ02);
+}
+
+FVector2D GISCoordinates::Gcj02ToWgs84(const FVector2D& LngLat)
+{
+	return Convert(LngLat, EGISCoordSystem::GCJ02, EGISCoordSystem::WGS84);
+}
+
+FVector2D GISCoordinates::Wgs84ToBd09(const FVector2D& LngLat)
+{
+	return Convert(LngLat, EGISCoordSystem::WGS84, EGISCoordSystem::BD09);
+}
+
+FVector2D GISCoordinates::Bd09ToWgs84(const FVector2D& LngLat)
+{
+	return Convert(LngLat, EGISCoordSystem::BD09, EGISCoordSystem::WGS84);
+}
+
+FVector2D GISCoordinates::ToBd09(const FVector2D& LngLat, EGISCoordSystem From)
+{
+	return Convert(LngLat, From, EGISCoordSystem::BD09);
+}
+
+FVector2D GISCoordinates::Convert(const FVector2D& LngLat, EGISCoordSystem From, EGISCoordSystem To)
+{
+	double Lng = LngLat.X;
+	double Lat = LngLat.Y;
+	ConvertPoint(Lng, Lat, From, To);
+	return FVector2D(Lng, Lat);
+}
+
+void GISCoordinates::ConvertBatch(TArrayView<FVector2D> InOutLngLat, EGISCoordSystem From, EGISCoordSystem To)
+{
+	if (From == To)
+	{
+		return;
+	}
+
+	ForEachChunk(InOutLngLat.Num(), [&](int32 ChunkStart, int32 ChunkNum)
+	{
+		TArrayView<FVector2D> Chunk = InOutLngLat.Slice(ChunkStart, ChunkNum);
+		ForEachLanes(Chunk, [&](FDouble4& Lng, FDouble4& Lat, int32 Start, int32 Count)
+		{
+			::Convert(Lng, Lat, From, To);
+
+			double OutLng[4];
+			double OutLat[4];
+			VectorStore(Lng.V, OutLng);
+			VectorStore(Lat.V, OutLat);
+			for (int32 Lane = 0; Lane < Count; ++Lane)
+			{
+				Chunk[Start + Lane] = FVector2D(OutLng[Lane], OutLat[Lane]);
+			}
+		});
+	});
+}
+
+FGISEnuFrame::FGISEnuFrame(const FVector2D& InOriginLngLat, EGISCoordSystem InSource)
+	: OriginLngLat(InOriginLngLat)
+	, Source(InSource)
+	, bValid(true)
+{
+	double Lng = InOriginLngLat.X;
+	double Lat = InOriginLngLat.Y;
+	ConvertPoint(Lng, Lat, Source, EGISCoordSystem::WGS84);
+
+	FDouble4 X, Y, Z;
+	GeodeticToEcef(FDouble4(Lng), FDouble4(Lat), FDouble4(0.0), X, Y, Z);
+	double OutX[4];
+	double OutY[4];
+	double OutZ[4];
+	VectorStore(X.V, OutX);
+	VectorStore(Y.V, OutY);
+	VectorStore(Z.V, OutZ);
+	OriginEcef = FVector(OutX[0], OutY[0], OutZ[0]);
+
+	FMath::SinCos(&SinLat, &CosLat, FMath::DegreesToRadians(Lat));
+	FMath::SinCos(&SinLng, &CosLng, FMath::DegreesToRadians(Lng));
+}
+
+FVector FGISEnuFrame::ToLocal(const FVector2D& LngLat, double HeightMeters) const
+{
+	// 与批量接口走同一段代码，保证同一点两种调用得到相同结果
+	FVector Local;
+	ToLocalBatch(MakeArrayView(&LngLat, 1), MakeArrayView(&Local, 1), HeightMeters);
+	return Local;
+}
+
+void FGISEnuFrame::ToLocalBatch(TArrayView<const FVector2D> LngLat, TArrayView<FVector> OutLocal, double HeightMeters) const
+{
+	check(OutLocal.Num() >= LngLat.Num());
+
+	ForEachChunk(LngLat.Num(), [&](int32 ChunkStart, int32 ChunkNum)
+	{
+		ForEachLanes(LngLat.Slice(ChunkStart, ChunkNum), [&](FDouble4& Lng, FDouble4& Lat, int32 Start, int32 Count)
+		{
+			::Convert(Lng, Lat, Source, EGISCoordSystem::WGS84);
+
+			FDouble4 X, Y, Z;
+			GeodeticToEcef(Lng, Lat, FDouble4(HeightMeters), X, Y, Z);
+			X = X - OriginEcef.X;
+			Y = Y - OriginEcef.Y;
+			Z = Z - OriginEcef.Z;
+
+			// 直接得到 UE 坐标：东、南 (-北)、天，单位厘米
+			const FDouble4 East = 100.0 * (-SinLng * X + CosLng * Y);
+			const FDouble4 South = 100.0 * (SinLat * CosLng * X + SinLat * SinLng * Y - CosLat * Z);
+			const FDouble4 Up = 100.0 * (CosLat * CosLng * X + CosLat * SinLng * Y + SinLat * Z);
+
+			double OutX[4];
+			double OutY[4];
+			double OutZ[4];
+			VectorStore(East.V, OutX);
+			VectorStore(South.V, OutY);
+			VectorStore(Up.V, OutZ);
+			for (int32 Lane = 0; Lane < Count; ++Lane)
+			{
+				OutLocal[ChunkStart + Start + Lane] = FVector(OutX[Lane], OutY[Lane], OutZ[Lane]);
+			}
+		});
+	});
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISCoordinates.generated.h"
+
+// 数据源坐标系；地图 (百度) 使用 BD09
+UENUM(BlueprintType)
+enum class EGISCoordSystem : uint8
+{
+	BD09,
+	GCJ02,
+	WGS84
+};
+
+/**
+ * 国内常用坐标系转换 (X = lng, Y = lat)
+ * GCJ02 -> BD09 使用百度公开算法 (x_pi = π·3000/180；ConvertCSV.py 漏了 /180，会有约 10 米偏差)
+ * WGS84 -> GCJ02 为国测局算法；两个反算都没有解析式，以正算做不动点迭代，往返误差小于 1e-9 度
+ * 任意两种坐标系之间都经 GCJ02 中转
+ *
+ * 标量与批量接口共用同一套 VectorRegister4Double 计算 (标量只用第 0 路)，同一点两种调用结果逐位相同；
+ * 批量接口每 4 个点一组计算，大批量再分块并行
+ */
+namespace GISCoordinates
+{
+	CITYGIS_API FVector2D Gcj02ToBd09(const FVector2D& LngLat);
+	CITYGIS_API FVector2D Bd09ToGcj02(const FVector2D& LngLat);
+	CITYGIS_API FVector2D Wgs84ToGcj02(const FVector2D& LngLat);
+	CITYGIS_API FVector2D Gcj02ToWgs84(const FVector2D& LngLat);
+	CITYGIS_API FVector2D Wgs84ToBd09(const FVector2D& LngLat);
+	CITYGIS_API FVector2D Bd09ToWgs84(const FVector2D& LngLat);
+
+	// 任意源坐标系转到地图使用的 BD09
+	CITYGIS_API FVector2D ToBd09(const FVector2D& LngLat, EGISCoordSystem From);
+
+	CITYGIS_API FVector2D Convert(const FVector2D& LngLat, EGISCoordSystem From, EGISCoordSystem To);
+
+	// 原地批量转换连续的坐标数组
+	CITYGIS_API void ConvertBatch(TArrayView<FVector2D> InOutLngLat, EGISCoordSystem From, EGISCoordSystem To);
+}
+
+/**
+ * 以某经纬度为原点的局部东北天 (ENU) 坐标系，输入先转为 WGS84 再经椭球的地心坐标换算
+ * 输出为 UE 世界坐标 (厘米)：X = 东，Y = 南 (UE 为左手系)，Z = 天
+ * 城市范围内 (几十公里) 误差远小于 1 厘米
+ */
+struct CITYGIS_API FGISEnuFrame
+{
+	FGISEnuFrame() = default;
+
+	// 原点与之后输入的坐标都使用 InSource 坐标系 (默认与地图一致)
+	explicit FGISEnuFrame(const FVector2D& InOriginLngLat, EGISCoordSystem InSource = EGISCoordSystem::BD09);
+
+	bool IsValid() const { return bValid; }
+	const FVector2D& GetOrigin() const { return OriginLngLat; }
+	EGISCoordSystem GetSource() const { return Source; }
+
+	FVector ToLocal(const FVector2D& LngLat, double HeightMeters = 0.0) const;
+
+	// 批量版本，OutLocal 至少与 LngLat 等长
+	void ToLocalBatch(TArrayView<const FVector2D> LngLat, TArrayView<FVector> OutLocal, double HeightMeters = 0.0) const;
+
+private:
+	FVector2D OriginLngLat = FVector2D::ZeroVector;
+	EGISCoordSystem Source = EGISCoordSystem::BD09;
+	FVector OriginEcef = FVector::ZeroVector;
+	double SinLat = 0.0;
+	double CosLat = 1.0;
+	double SinLng = 0.0;
+	double CosLng = 1.0;
+	bool bValid = false;
+};
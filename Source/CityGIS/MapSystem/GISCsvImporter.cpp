@@ -0,0 +1,750 @@
+#include "GISCsvImporter.h"
+#include "GISPointLayer.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/SecureHash.h"
+#include "Misc/Guid.h"
+#include "Misc/DateTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISCsvImporter, Log, All);
+
+namespace
+{
+	constexpr int64 ReadChunkSize = 64 * 1024;
+
+	// RFC 4180 流式读取：字段保存为以 0 结尾的 UTF-8 字节串，缓冲区逐行复用
+	class FCsvStreamReader
+	{
+	public:
+		explicit FCsvStreamReader(IFileHandle* InHandle)
+			: Handle(InHandle)
+		{
+			Buffer.SetNumUninitialized(ReadChunkSize);
+		}
+
+		bool ReadRecord(TArray<TArray<ANSICHAR>>& OutFields, int32& OutNumFields)
+		{
+			OutNumFields = 0;
+			bool bInQuotes = false;
+			bool bAnyChar = false;
+			TArray<ANSICHAR>* Field = BeginField(OutFields, OutNumFields);
+
+			ANSICHAR Char;
+			while (NextChar(Char))
+			{
+				bAnyChar = true;
+				if (bInQuotes)
+				{
+					if (Char == '"')
+					{
+						ANSICHAR Peek;
+						if (PeekChar(Peek) && Peek == '"')
+						{
+							NextChar(Peek);
+							Field->Add('"');
+						}
+						else
+						{
+							bInQuotes = false;
+						}
+					}
+					else
+					{
+						Field->Add(Char);
+					}
+					continue;
+				}
+
+				if (Char == '"')
+				{
+					bInQuotes = true;
+				}
+				else if (Char == ',')
+				{
+					Field->Add('\0');
+					Field = BeginField(OutFields, OutNumFields);
+				}
+				else if (Char == '\n')
+				{
+					break;
+				}
+				else if (Char != '\r')
+				{
+					Field->Add(Char);
+				}
+			}
+
+			Field->Add('\0');
+			return bAnyChar;
+		}
+
+	private:
+		static TArray<ANSICHAR>* BeginField(TArray<TArray<ANSICHAR>>& Fields, int32& NumFields)
+		{
+			if (NumFields == Fields.Num())
+			{
+				Fields.AddDefaulted();
+			}
+			TArray<ANSICHAR>& Field = Fields[NumFields++];
+			Field.Reset();
+			return &Field;
+		}
+
+		bool Fill()
+		{
+			const int64 Remaining = Handle->Size() - Handle->Tell();
+			const int64 ToRead = FMath::Min(Remaining, ReadChunkSize);
+			if (ToRead <= 0 || !Handle->Read(reinterpret_cast<uint8*>(Buffer.GetData()), ToRead))
+			{
+				return false;
+			}
+			Cursor = 0;
+			Length = static_cast<int32>(ToRead);
+			return true;
+		}
+
+		bool NextChar(ANSICHAR& OutChar)
+		{
+			if (Cursor >= Length && !Fill())
+			{
+				return false;
+			}
+			OutChar = Buffer[Cursor++];
+			return true;
+		}
+
+		bool PeekChar(ANSICHAR& OutChar)
+		{
+			if (Cursor >= Length && !Fill())
+			{
+				return false;
+			}
+			OutChar = Buffer[Cursor];
+			return true;
+		}
+
+		IFileHandle* Handle;
+		TArray<ANSICHAR> Buffer;
+		int32 Cursor = 0;
+		int32 Length = 0;
+	};
+
+	// 坐标数组改写时先写占位符，整个几何的点收集齐后批量转换再填回
+	constexpr ANSICHAR PointPlaceholder = '#';
+
+	// GeoJSON 几何的字符级扫描：只识别 type / coordinates，坐标批量转换后写入 Out
+	class FGeometryRewriter
+	{
+	public:
+		FGeometryRewriter(const ANSICHAR* InText, EGISCoordSystem InFrom, TArray<ANSICHAR>& InOut)
+			: Cur(InText), From(InFrom), Out(InOut)
+		{
+		}
+
+		bool RewriteGeometry()
+		{
+			SkipWhitespace();
+			if (*Cur != '{')
+			{
+				return false;
+			}
+			++Cur;
+
+			const ANSICHAR* TypeBegin = nullptr;
+			int32 TypeLen = 0;
+			TArray<ANSICHAR> Coordinates;
+			TArray<FVector2D> Points;
+
+			while (true)
+			{
+				SkipWhitespace();
+				if (*Cur == '}')
+				{
+					++Cur;
+					break;
+				}
+				if (*Cur == ',')
+				{
+					++Cur;
+					continue;
+				}
+
+				const ANSICHAR* Key = nullptr;
+				int32 KeyLen = 0;
+				if (!ReadString(Key, KeyLen))
+				{
+					return false;
+				}
+				SkipWhitespace();
+				if (*Cur++ != ':')
+				{
+					return false;
+				}
+				SkipWhitespace();
+
+				if (KeyLen == 4 && FCStringAnsi::Strncmp(Key, "type", 4) == 0)
+				{
+					if (!ReadString(TypeBegin, TypeLen))
+					{
+						return false;
+					}
+				}
+				else if (KeyLen == 11 && FCStringAnsi::Strncmp(Key, "coordinates", 11) == 0)
+				{
+					FGeometryRewriter Nested(Cur, From, Coordinates);
+					if (!Nested.RewriteArray())
+					{
+						return false;
+					}
+					Cur = Nested.Cur;
+					Points = MoveTemp(Nested.Points);
+				}
+				else if (!SkipValue())
+				{
+					return false;
+				}
+			}
+
+			if (!TypeBegin || Coordinates.Num() == 0)
+			{
+				return false;
+			}
+
+			Append("{\"type\":\"");
+			Out.Append(TypeBegin, TypeLen);
+			Append("\",\"coordinates\":");
+			GISCoordinates::ConvertBatch(Points, From, EGISCoordSystem::BD09);
+			int32 PointIndex = 0;
+			for (const ANSICHAR Char : Coordinates)
+			{
+				if (Char != PointPlaceholder)
+				{
+					Out.Add(Char);
+					continue;
+				}
+				const FVector2D& Point = Points[PointIndex++];
+				ANSICHAR Number[64];
+				FCStringAnsi::Snprintf(Number, UE_ARRAY_COUNT(Number), "[%.9f,%.9f]", Point.X, Point.Y);
+				Append(Number);
+			}
+			Append("}");
+			return true;
+		}
+
+		// 只取 Point 的坐标 (center_point 列)
+		bool ReadPoint(FVector2D& OutPoint)
+		{
+			const ANSICHAR* Found = FCStringAnsi::Strstr(Cur, "\"coordinates\"");
+			if (!Found)
+			{
+				return false;
+			}
+			Cur = Found + 13;
+			SkipWhitespace();
+			if (*Cur++ != ':')
+			{
+				return false;
+			}
+			SkipWhitespace();
+			if (*Cur++ != '[')
+			{
+				return false;
+			}
+			if (!ReadPosition(OutPoint))
+			{
+				return false;
+			}
+			OutPoint = GISCoordinates::ToBd09(OutPoint, From);
+			return true;
+		}
+
+	private:
+		void SkipWhitespace()
+		{
+			while (*Cur == ' ' || *Cur == '\t' || *Cur == '\r' || *Cur == '\n')
+			{
+				++Cur;
+			}
+		}
+
+		void Append(const ANSICHAR* Text)
+		{
+			Out.Append(Text, FCStringAnsi::Strlen(Text));
+		}
+
+		bool ReadString(const ANSICHAR*& OutBegin, int32& OutLen)
+		{
+			if (*Cur != '"')
+			{
+				return false;
+			}
+			OutBegin = ++Cur;
+			while (*Cur && *Cur != '"')
+			{
+				Cur += (*Cur == '\\' && Cur[1]) ? 2 : 1;
+			}
+			if (*Cur != '"')
+			{
+				return false;
+			}
+			OutLen = static_cast<int32>(Cur - OutBegin);
+			++Cur;
+			return true;
+		}
+
+		bool SkipValue()
+		{
+			int32 Depth = 0;
+			while (*Cur)
+			{
+				const ANSICHAR Char = *Cur;
+				if (Char == '"')
+				{
+					const ANSICHAR* Ignored;
+					int32 IgnoredLen;
+					if (!ReadString(Ignored, IgnoredLen))
+					{
+						return false;
+					}
+					if (Depth == 0)
+					{
+						return true;
+					}
+					continue;
+				}
+				if (Char == '{' || Char == '[')
+				{
+					++Depth;
+				}
+				else if (Char == '}' || Char == ']')
+				{
+					if (Depth == 0)
+					{
+						return true;
+					}
+					if (--Depth == 0)
+					{
+						++Cur;
+						return true;
+					}
+				}
+				else if (Char == ',' && Depth == 0)
+				{
+					return true;
+				}
+				++Cur;
+			}
+			return false;
+		}
+
+		// 读取 "x, y(, z)]" (源坐标系)，Cur 指向 '[' 之后
+		bool ReadPosition(FVector2D& OutPoint)
+		{
+			double Values[2] = { 0.0, 0.0 };
+			int32 Count = 0;
+			while (true)
+			{
+				SkipWhitespace();
+				ANSICHAR* NumberEnd = nullptr;
+				const double Value = FCStringAnsi::Strtod(Cur, &NumberEnd);
+				if (NumberEnd == Cur)
+				{
+					return false;
+				}
+				if (Count < 2)
+				{
+					Values[Count] = Value;
+				}
+				++Count;
+				Cur = NumberEnd;
+				SkipWhitespace();
+				if (*Cur == ',')
+				{
+					++Cur;
+				}
+				else if (*Cur == ']')
+				{
+					++Cur;
+					break;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			if (Count < 2)
+			{
+				return false;
+			}
+			OutPoint = FVector2D(Values[0], Values[1]);
+			return true;
+		}
+
+		bool RewriteArray()
+		{
+			SkipWhitespace();
+			if (*Cur != '[')
+			{
+				return false;
+			}
+			++Cur;
+			SkipWhitespace();
+
+			// 最内层：数字开头即为一个坐标点
+			if ((*Cur >= '0' && *Cur <= '9') || *Cur == '-')
+			{
+				FVector2D Point;
+				if (!ReadPosition(Point))
+				{
+					return false;
+				}
+				Points.Add(Point);
+				Out.Add(PointPlaceholder);
+				return true;
+			}
+
+			Out.Add('[');
+			bool bFirst = true;
+			while (true)
+			{
+				SkipWhitespace();
+				if (*Cur == ']')
+				{
+					++Cur;
+					break;
+				}
+				if (*Cur == ',')
+				{
+					++Cur;
+					continue;
+				}
+				if (!bFirst)
+				{
+					Out.Add(',');
+				}
+				bFirst = false;
+				if (!RewriteArray())
+				{
+					return false;
+				}
+			}
+			Out.Add(']');
+			return true;
+		}
+
+		const ANSICHAR* Cur;
+		EGISCoordSystem From;
+		TArray<ANSICHAR>& Out;
+
+		// 坐标数组中按出现顺序收集的点
+		TArray<FVector2D> Points;
+	};
+
+	void WriteRaw(FArchive& Ar, const ANSICHAR* Data, int32 Len)
+	{
+		Ar.Serialize(const_cast<ANSICHAR*>(Data), Len);
+	}
+
+	template <int32 N>
+	void WriteLiteral(FArchive& Ar, const ANSICHAR (&Literal)[N])
+	{
+		WriteRaw(Ar, Literal, N - 1);
+	}
+
+	void WriteText(FArchive& Ar, const FString& Text)
+	{
+		FTCHARToUTF8 Utf8(*Text);
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+	}
+
+	// 写出 JSON 字符串字面量 (输入为 UTF-8 原文)
+	void WriteJsonString(FArchive& Ar, const ANSICHAR* Utf8)
+	{
+		TArray<ANSICHAR, TInlineAllocator<256>> Escaped;
+		Escaped.Add('"');
+		for (const ANSICHAR* Ptr = Utf8; *Ptr; ++Ptr)
+		{
+			const ANSICHAR Char = *Ptr;
+			if (Char == '"' || Char == '\\')
+			{
+				Escaped.Add('\\');
+				Escaped.Add(Char);
+			}
+			else if (static_cast<uint8>(Char) < 0x20)
+			{
+				ANSICHAR Code[8];
+				FCStringAnsi::Snprintf(Code, UE_ARRAY_COUNT(Code), "\\u%04x", static_cast<uint8>(Char));
+				Escaped.Append(Code, 6);
+			}
+			else
+			{
+				Escaped.Add(Char);
+			}
+		}
+		Escaped.Add('"');
+		WriteRaw(Ar, Escaped.GetData(), Escaped.Num());
+	}
+
+	// 按表头定位列 (首列去掉 UTF-8 BOM)
+	int32 FindColumn(const TArray<TArray<ANSICHAR>>& Fields, int32 NumFields, const ANSICHAR* Name)
+	{
+		for (int32 Idx = 0; Idx < NumFields; ++Idx)
+		{
+			const ANSICHAR* Header = Fields[Idx].GetData();
+			if (Idx == 0 && (uint8)Header[0] == 0xEF && (uint8)Header[1] == 0xBB && (uint8)Header[2] == 0xBF)
+			{
+				Header += 3;
+			}
+			if (FCStringAnsi::Stricmp(Header, Name) == 0)
+			{
+				return Idx;
+			}
+		}
+		return (int32)INDEX_NONE;
+	}
+
+	// 依次尝试几个常见列名
+	int32 FindAnyColumn(const TArray<TArray<ANSICHAR>>& Fields, int32 NumFields, std::initializer_list<const ANSICHAR*> Names)
+	{
+		for (const ANSICHAR* Name : Names)
+		{
+			const int32 Idx = FindColumn(Fields, NumFields, Name);
+			if (Idx != INDEX_NONE)
+			{
+				return Idx;
+			}
+		}
+		return (int32)INDEX_NONE;
+	}
+
+	// 整个字段是否为一个十进制数
+	bool ParseNumber(const ANSICHAR* Text, double& OutValue)
+	{
+		if (*Text == '\0' || !FCStringAnsi::IsNumeric(Text))
+		{
+			return false;
+		}
+		OutValue = FCStringAnsi::Atod(Text);
+		return true;
+	}
+
+	FString ColorFromKey(const ANSICHAR* Utf8)
+	{
+		FMD5 Md5;
+		Md5.Update(reinterpret_cast<const uint8*>(Utf8), FCStringAnsi::Strlen(Utf8));
+		uint8 Digest[16];
+		Md5.Final(Digest);
+
+		// 与 Python 的 int(hexdigest, 16) & 0xFFFFFF 相同：取摘要最后 3 个字节
+		return FString::Printf(TEXT("#%02x%02x%02x"), Digest[13], Digest[14], Digest[15]);
+	}
+}
+
+FGISCsvImportResult FGISCsvImporter::Import(const FString& CsvPath, const FString& OutputPath, const FGISCsvImportOptions& Options)
+{
+	FGISCsvImportResult Result;
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*CsvPath));
+	if (!Handle)
+	{
+		Result.Error = FString::Printf(TEXT("无法打开 %s"), *CsvPath);
+		return Result;
+	}
+
+	FCsvStreamReader Reader(Handle.Get());
+	TArray<TArray<ANSICHAR>> Fields;
+	int32 NumFields = 0;
+
+	if (!Reader.ReadRecord(Fields, NumFields))
+	{
+		Result.Error = TEXT("CSV 为空");
+		return Result;
+	}
+
+	// 按表头定位列
+	const int32 ColID = FindColumn(Fields, NumFields, "id");
+	const int32 ColName = FindColumn(Fields, NumFields, "name");
+	const int32 ColDistrict = FindColumn(Fields, NumFields, "district_code");
+	const int32 ColCenter = FindColumn(Fields, NumFields, "center_point");
+	const int32 ColGeometry = FindColumn(Fields, NumFields, "geometry");
+	if (ColID == INDEX_NONE || ColName == INDEX_NONE || ColDistrict == INDEX_NONE || ColGeometry == INDEX_NONE)
+	{
+		Result.Error = TEXT("CSV 缺少 id / name / district_code / geometry 列");
+		return Result;
+	}
+	const int32 RequiredFields = FMath::Max(FMath::Max(ColID, ColName), FMath::Max(ColDistrict, ColGeometry)) + 1;
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*OutputPath));
+	if (!Writer)
+	{
+		Result.Error = FString::Printf(TEXT("无法写入 %s"), *OutputPath);
+		return Result;
+	}
+
+	// 要素数在读完之前未知，先写 data，元数据放在末尾 (读取端按字段名访问，与顺序无关)
+	WriteLiteral(*Writer, "{\"data\":[");
+
+	TMap<FString, FString> DistrictColors;
+	TArray<ANSICHAR> Geometry;
+	const FString OpacityText = FString::SanitizeFloat(Options.Opacity);
+	int32 Row = 0;
+
+	while (Reader.ReadRecord(Fields, NumFields))
+	{
+		++Row;
+		if (NumFields < RequiredFields)
+		{
+			// 空行 (如文件末尾换行) 不计入跳过数
+			if (NumFields > 1 || Fields[0].Num() > 1)
+			{
+				++Result.Skipped;
+				UE_LOG(LogGISCsvImporter, Warning, TEXT("跳过错误行 %d: 字段数 %d"), Row, NumFields);
+			}
+			continue;
+		}
+
+		Geometry.Reset();
+		FGeometryRewriter Rewriter(Fields[ColGeometry].GetData(), Options.SourceCoords, Geometry);
+		if (!Rewriter.RewriteGeometry())
+		{
+			++Result.Skipped;
+			UE_LOG(LogGISCsvImporter, Warning, TEXT("跳过错误行 %d: geometry 无法解析"), Row);
+			continue;
+		}
+
+		const ANSICHAR* DistrictCode = Fields[ColDistrict].GetData();
+		const FString DistrictKey = UTF8_TO_TCHAR(DistrictCode);
+		FString* Color = DistrictColors.Find(DistrictKey);
+		if (!Color)
+		{
+			Color = &DistrictColors.Add(DistrictKey, ColorFromKey(DistrictCode));
+		}
+
+		if (Result.Imported > 0)
+		{
+			WriteLiteral(*Writer, ",");
+		}
+		WriteLiteral(*Writer, "\n{\"type\":\"Feature\",\"geometry\":");
+		WriteRaw(*Writer, Geometry.GetData(), Geometry.Num());
+
+		WriteLiteral(*Writer, ",\"properties\":{\"id\":");
+		TArray<ANSICHAR, TInlineAllocator<64>> StreetID;
+		StreetID.Append("street_", 7);
+		StreetID.Append(Fields[ColID].GetData(), Fields[ColID].Num());
+		WriteJsonString(*Writer, StreetID.GetData());
+
+		WriteLiteral(*Writer, ",\"name\":");
+		WriteJsonString(*Writer, Fields[ColName].GetData());
+
+		WriteText(*Writer, FString::Printf(TEXT(",\"customType\":\"Street\",\"svCol\":\"%s\",\"svOp\":%s,\"svLine\":false,\"pid\":\"None\",\"svTxtCol\":\"#FFFFFF\",\"customTag\":"),
+		                                   **Color, *OpacityText));
+		WriteJsonString(*Writer, DistrictCode);
+		WriteLiteral(*Writer, ",\"customHeight\":0");
+
+		// 中心点用于标注位置，省去页面端的质心计算
+		FVector2D Center;
+		if (ColCenter != INDEX_NONE && ColCenter < NumFields)
+		{
+			FGeometryRewriter CenterReader(Fields[ColCenter].GetData(), Options.SourceCoords, Geometry);
+			if (CenterReader.ReadPoint(Center))
+			{
+				WriteText(*Writer, FString::Printf(TEXT(",\"center\":[%.9f,%.9f]"), Center.X, Center.Y));
+			}
+		}
+		WriteLiteral(*Writer, "}}");
+
+		++Result.Imported;
+	}
+
+	// 存档名由用户输入，按 JSON 字符串转义后写出
+	WriteText(*Writer, FString::Printf(TEXT("\n],\"id\":\"%s\",\"name\":"), *FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower)));
+	WriteJsonString(*Writer, FTCHARToUTF8(*Options.SaveName).Get());
+	WriteText(*Writer, FString::Printf(TEXT(",\"desc\":\"从 CSV 导入的 %d 条街道数据\",\"date\":\"%s\"}"),
+	                                   Result.Imported, *FDateTime::Now().ToString(TEXT("%Y-%m-%d %H:%M:%S"))));
+
+	Result.bSuccess = Writer->Close() && !Writer->IsError();
+	if (!Result.bSuccess)
+	{
+		Result.Error = FString::Printf(TEXT("写入 %s 失败"), *OutputPath);
+	}
+
+	UE_LOG(LogGISCsvImporter, Log, TEXT("CSV 导入完成: %d 条, 跳过 %d 行 -> %s"), Result.Imported, Result.Skipped, *OutputPath);
+	return Result;
+}
+
+FGISCsvImportResult FGISCsvImporter::ImportPoints(const FString& CsvPath, EGISCoordSystem SourceCoords, FGISPointLayer& OutLayer)
+{
+	FGISCsvImportResult Result;
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*CsvPath));
+	if (!Handle)
+	{
+		Result.Error = FString::Printf(TEXT("无法打开 %s"), *CsvPath);
+		return Result;
+	}
+
+	FCsvStreamReader Reader(Handle.Get());
+	TArray<TArray<ANSICHAR>> Fields;
+	int32 NumFields = 0;
+	if (!Reader.ReadRecord(Fields, NumFields))
+	{
+		Result.Error = TEXT("CSV 为空");
+		return Result;
+	}
+
+	const int32 ColLng = FindAnyColumn(Fields, NumFields, { "lng", "lon", "longitude", "x" });
+	const int32 ColLat = FindAnyColumn(Fields, NumFields, { "lat", "latitude", "y" });
+	const int32 ColName = FindColumn(Fields, NumFields, "name");
+	const int32 ColCategory = FindAnyColumn(Fields, NumFields, { "category", "type" });
+	if (ColLng == INDEX_NONE || ColLat == INDEX_NONE)
+	{
+		Result.Error = TEXT("CSV 缺少经纬度列 (lng / lat)");
+		return Result;
+	}
+	const int32 RequiredFields = FMath::Max(ColLng, ColLat) + 1;
+
+	// 类别文本逐行重复，按原始字节缓存最近一次的查找结果
+	TArray<ANSICHAR> LastCategory;
+	int32 LastCategoryIndex = OutLayer.FindOrAddCategory(FString());
+	int32 Row = 0;
+
+	while (Reader.ReadRecord(Fields, NumFields))
+	{
+		++Row;
+		double Lng = 0.0;
+		double Lat = 0.0;
+		if (NumFields < RequiredFields || !ParseNumber(Fields[ColLng].GetData(), Lng) || !ParseNumber(Fields[ColLat].GetData(), Lat)
+			|| FMath::Abs(Lng) > 180.0 || FMath::Abs(Lat) > 90.0)
+		{
+			// 空行 (如文件末尾换行) 不计入跳过数
+			if (NumFields > 1 || Fields[0].Num() > 1)
+			{
+				++Result.Skipped;
+				UE_LOG(LogGISCsvImporter, Verbose, TEXT("跳过错误行 %d"), Row);
+			}
+			continue;
+		}
+
+		if (ColCategory != INDEX_NONE && ColCategory < NumFields && Fields[ColCategory] != LastCategory)
+		{
+			LastCategory = Fields[ColCategory];
+			LastCategoryIndex = OutLayer.FindOrAddCategory(UTF8_TO_TCHAR(LastCategory.GetData()));
+		}
+
+		// 字段以 0 结尾，长度不含结尾
+		const bool bHasName = ColName != INDEX_NONE && ColName < NumFields;
+		OutLayer.Add(FVector2D(Lng, Lat), LastCategoryIndex, bHasName ? Fields[ColName].GetData() : "", bHasName ? Fields[ColName].Num() - 1 : 0);
+		++Result.Imported;
+	}
+
+	OutLayer.Finalize(SourceCoords);
+	Result.bSuccess = Result.Imported > 0;
+	if (!Result.bSuccess)
+	{
+		Result.Error = TEXT("CSV 中没有有效的点");
+	}
+
+	UE_LOG(LogGISCsvImporter, Log, TEXT("点 CSV 导入完成: %d 个, %d 类, 跳过 %d 行"), Result.Imported, OutLayer.GetCategoryNames().Num(), Result.Skipped);
+	return Result;
+}
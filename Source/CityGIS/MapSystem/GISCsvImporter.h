@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISCoordinates.h"
+
+class FGISPointLayer;
+
+struct FGISCsvImportOptions
+{
+	EGISCoordSystem SourceCoords = EGISCoordSystem::BD09;
+	FString SaveName = TEXT("Imported_Streets");
+	float Opacity = 0.4f;
+};
+
+struct FGISCsvImportResult
+{
+	bool bSuccess = false;
+	int32 Imported = 0;
+	int32 Skipped = 0;
+	FString Error;
+};
+
+/**
+ * 街道 CSV (exported_subdistrict_db.csv) -> 存档 JSON，替代 ConvertCSV.py
+ * 按 RFC 4180 逐块读取、逐行处理；geometry / center_point 列中的 GeoJSON 只做字符级扫描，
+ * 坐标边读边转换边写出，不构建 JSON DOM，内存占用与单行大小相关而与文件大小无关
+ * 颜色规则与脚本一致：district_code 的 MD5 取最低 3 字节
+ */
+class CITYGIS_API FGISCsvImporter
+{
+public:
+	static FGISCsvImportResult Import(const FString& CsvPath, const FString& OutputPath, const FGISCsvImportOptions& Options);
+
+	// 点资源 CSV -> 点图层：经度列 lng/lon/longitude/x，纬度列 lat/latitude/y，可选 name 与 category/type 列
+	// 坐标读完后批量转为 BD09；不访问全局状态，可在工作线程调用
+	static FGISCsvImportResult ImportPoints(const FString& CsvPath, EGISCoordSystem SourceCoords, FGISPointLayer& OutLayer);
+};
@@ -0,0 +1,189 @@
+#include "GISEditHistory.h"
+
+namespace
+{
+	int64 StringBytes(const FString& Value)
+	{
+		return Value.Len() * sizeof(TCHAR);
+	}
+
+	int64 EditBytes(const FGISFeatureEdit& Edit)
+	{
+		return StringBytes(Edit.Name) + StringBytes(Edit.Color) + StringBytes(Edit.TextColor) + StringBytes(Edit.ParentID);
+	}
+}
+
+void FGISEditHistory::SetMemoryLimit(int64 InLimitBytes)
+{
+	LimitBytes = FMath::Max<int64>(InLimitBytes, 0);
+	Trim();
+}
+
+int64 FGISEditHistory::ComputeBytes(const FGISHistoryCommand& Command)
+{
+	int64 Bytes = sizeof(FGISHistoryCommand);
+	for (const FGISHistoryChange& Change : Command.Changes)
+	{
+		Bytes += sizeof(FGISHistoryChange) + StringBytes(Change.ID) + EditBytes(Change.Before) + EditBytes(Change.After);
+		if (Change.Feature.IsValid())
+		{
+			Bytes += StringBytes(*Change.Feature);
+		}
+		for (const FString& Child : Change.Children)
+		{
+			Bytes += StringBytes(Child);
+		}
+	}
+	return Bytes;
+}
+
+bool FGISEditHistory::IsReady(const FGISHistoryCommand& Command, bool bUndo)
+{
+	// 撤销删除、重做新增时需要要素文本
+	const EGISHistoryOp NeedsFeature = bUndo ? EGISHistoryOp::Delete : EGISHistoryOp::Create;
+	for (const FGISHistoryChange& Change : Command.Changes)
+	{
+		if (Change.Op == NeedsFeature && !Change.Feature.IsValid())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FGISEditHistory::Record(TArray<FGISHistoryChange>&& Changes)
+{
+	if (Changes.Num() == 0)
+	{
+		return;
+	}
+
+	for (const FGISHistoryCommand& Command : RedoStack)
+	{
+		UsedBytes -= Command.Bytes;
+	}
+	RedoStack.Reset();
+
+	FGISHistoryCommand& Command = UndoStack.AddDefaulted_GetRef();
+	Command.Changes = MoveTemp(Changes);
+	Command.Bytes = ComputeBytes(Command);
+	UsedBytes += Command.Bytes;
+	Trim();
+}
+
+bool FGISEditHistory::FillFeature(FGISHistoryCommand& Command, const FString& ID, const TSharedPtr<const FString>& Feature)
+{
+	for (FGISHistoryChange& Change : Command.Changes)
+	{
+		if (Change.Op != EGISHistoryOp::Attributes && !Change.Feature.IsValid() && Change.ID == ID)
+		{
+			Change.Feature = Feature;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FGISEditHistory::SetDeletedFeature(const FString& ID, FString FeatureJson)
+{
+	if (FeatureJson.IsEmpty())
+	{
+		return;
+	}
+
+	// 同一要素删除 -> 恢复 -> 再删除时文本通常不变，沿用已有的一份
+	TSharedPtr<const FString> Feature;
+	if (const TWeakPtr<const FString>* Latest = LatestFeature.Find(ID))
+	{
+		Feature = Latest->Pin();
+		if (Feature.IsValid() && !Feature->Equals(FeatureJson, ESearchCase::CaseSensitive))
+		{
+			Feature.Reset();
+		}
+	}
+	if (!Feature.IsValid())
+	{
+		Feature = MakeShared<const FString>(MoveTemp(FeatureJson));
+	}
+
+	for (TArray<FGISHistoryCommand>* Stack : { &RedoStack, &UndoStack })
+	{
+		for (int32 Index = Stack->Num() - 1; Index >= 0; --Index)
+		{
+			FGISHistoryCommand& Command = (*Stack)[Index];
+			if (FillFeature(Command, ID, Feature))
+			{
+				UsedBytes -= Command.Bytes;
+				Command.Bytes = ComputeBytes(Command);
+				UsedBytes += Command.Bytes;
+				LatestFeature.Add(ID, Feature);
+				Trim();
+				return;
+			}
+		}
+	}
+}
+
+const FGISHistoryCommand* FGISEditHistory::Undo()
+{
+	if (!CanUndo())
+	{
+		return nullptr;
+	}
+	RedoStack.Add(UndoStack.Pop(EAllowShrinking::No));
+	return &RedoStack.Last();
+}
+
+const FGISHistoryCommand* FGISEditHistory::Redo()
+{
+	if (!CanRedo())
+	{
+		return nullptr;
+	}
+	UndoStack.Add(RedoStack.Pop(EAllowShrinking::No));
+	return &UndoStack.Last();
+}
+
+void FGISEditHistory::Reset()
+{
+	UndoStack.Reset();
+	RedoStack.Reset();
+	LatestFeature.Reset();
+	UsedBytes = 0;
+}
+
+void FGISEditHistory::Trim()
+{
+	// 先丢最旧的撤销记录，仍超出时丢最远的重做记录
+	int32 DropUndo = 0;
+	while (UsedBytes > LimitBytes && DropUndo < UndoStack.Num())
+	{
+		UsedBytes -= UndoStack[DropUndo++].Bytes;
+	}
+	if (DropUndo > 0)
+	{
+		UndoStack.RemoveAt(0, DropUndo, EAllowShrinking::No);
+	}
+
+	int32 DropRedo = 0;
+	while (UsedBytes > LimitBytes && DropRedo < RedoStack.Num())
+	{
+		UsedBytes -= RedoStack[DropRedo++].Bytes;
+	}
+	if (DropRedo > 0)
+	{
+		RedoStack.RemoveAt(0, DropRedo, EAllowShrinking::No);
+	}
+
+	// 文本已随命令释放的条目
+	if (DropUndo > 0 || DropRedo > 0)
+	{
+		for (auto It = LatestFeature.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
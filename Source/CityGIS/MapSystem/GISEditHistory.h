@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 编辑框可修改的属性 (与页面 updatePolyAttributes 的参数一致)
+struct FGISFeatureEdit
+{
+	FString Name;
+	FString Color;
+	float Opacity = 1.0f;
+	FString TextColor;
+	FString ParentID;
+};
+
+enum class EGISHistoryOp : uint8
+{
+	Attributes,
+	Create,
+	Delete
+};
+
+struct FGISHistoryChange
+{
+	EGISHistoryOp Op = EGISHistoryOp::Attributes;
+	FString ID;
+
+	// Attributes：修改前后的属性
+	FGISFeatureEdit Before;
+	FGISFeatureEdit After;
+
+	// Create/Delete：要素的完整 GeoJSON 文本，只读共享；页面删除该要素时才上报，在此之前为空
+	TSharedPtr<const FString> Feature;
+
+	// Delete：删除时变为根的子要素，恢复后重新挂回
+	TArray<FString> Children;
+};
+
+struct FGISHistoryCommand
+{
+	TArray<FGISHistoryChange> Changes;
+	int64 Bytes = 0;
+};
+
+/**
+ * 撤销/重做历史
+ *
+ * 每条命令记录一次操作涉及的要素变化：属性只记前后差异，增删记要素文本。
+ * 要素文本以只读共享指针保存，在撤销/重做栈之间移动不复制；同一要素反复删除/恢复共用一份文本。
+ * 内存按各命令引用的文本与属性估算 (共享的文本重复计入，偏保守)，超过上限时从最旧的命令淘汰。
+ * 仅在游戏线程使用。
+ */
+class CITYGIS_API FGISEditHistory
+{
+public:
+	void SetMemoryLimit(int64 InLimitBytes);
+
+	// 新命令入栈并清空重做栈
+	void Record(TArray<FGISHistoryChange>&& Changes);
+
+	// 页面删除要素时上报的文本，补给等待该要素文本的最近一条 Create/Delete；没有等待者时丢弃
+	void SetDeletedFeature(const FString& ID, FString FeatureJson);
+
+	// 栈顶命令的要素文本尚未到达时暂不可撤销/重做 (下一帧即可)
+	bool CanUndo() const { return UndoStack.Num() > 0 && IsReady(UndoStack.Last(), true); }
+	bool CanRedo() const { return RedoStack.Num() > 0 && IsReady(RedoStack.Last(), false); }
+
+	// 把栈顶命令移到另一个栈并返回，由调用方逆序 (撤销) 或顺序 (重做) 应用；指针在下次修改历史前有效
+	const FGISHistoryCommand* Undo();
+	const FGISHistoryCommand* Redo();
+
+	void Reset();
+
+	int32 NumUndo() const { return UndoStack.Num(); }
+	int32 NumRedo() const { return RedoStack.Num(); }
+	int64 GetMemoryUsage() const { return UsedBytes; }
+
+private:
+	static int64 ComputeBytes(const FGISHistoryCommand& Command);
+	static bool IsReady(const FGISHistoryCommand& Command, bool bUndo);
+	static bool FillFeature(FGISHistoryCommand& Command, const FString& ID, const TSharedPtr<const FString>& Feature);
+
+	void Trim();
+
+	TArray<FGISHistoryCommand> UndoStack;
+	TArray<FGISHistoryCommand> RedoStack;
+
+	int64 UsedBytes = 0;
+	int64 LimitBytes = 32ll * 1024 * 1024;
+
+	// 每个要素最近一次的文本，内容相同时复用；弱引用，不延长文本寿命
+	TMap<FString, TWeakPtr<const FString>> LatestFeature;
+};
@@ -0,0 +1,600 @@
+#include "GISEditJournal.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISEditJournal, Log, All);
+
+const TCHAR* FGISEditJournal::Extension = TEXT(".gisj");
+
+namespace
+{
+	constexpr uint32 JournalMagic = 0x4A534947; // "GISJ"
+	constexpr uint32 JournalVersion = 1;
+	constexpr int64 FileHeaderSize = sizeof(uint32) * 2;
+	// 每条记录前：长度 + CRC32
+	constexpr int64 FrameHeaderSize = sizeof(int32) + sizeof(uint32);
+
+	void WriteRecord(FArchive& Ar, const FGISEditRecord& Record)
+	{
+		uint8 Op = static_cast<uint8>(Record.Op);
+		Ar << Op;
+		Ar << const_cast<FString&>(Record.ID);
+		Ar << const_cast<FString&>(Record.FeatureJson);
+	}
+
+	bool ReadRecord(FArchive& Ar, FGISEditRecord& OutRecord)
+	{
+		uint8 Op = 0;
+		Ar << Op;
+		Ar << OutRecord.ID;
+		Ar << OutRecord.FeatureJson;
+		if (Ar.IsError() || Op > static_cast<uint8>(EGISEditOp::Delete) || OutRecord.ID.IsEmpty())
+		{
+			return false;
+		}
+		OutRecord.Op = static_cast<EGISEditOp>(Op);
+		return true;
+	}
+
+	struct FFeatureSpan
+	{
+		int32 Start = 0;
+		int32 End = 0;
+		FString ID;
+	};
+
+	/**
+	 * 要素数组的轻量扫描：只跟踪括号深度与字符串边界，
+	 * 取出每个顶层元素的文本范围和 properties.id，其余内容原样跳过
+	 */
+	class FFeatureScanner
+	{
+	public:
+		explicit FFeatureScanner(const FString& InJson)
+			: Json(*InJson)
+			, Len(InJson.Len())
+		{
+		}
+
+		bool Scan(TArray<FFeatureSpan>& OutSpans)
+		{
+			SkipWhitespace();
+			if (!Consume(TEXT('[')))
+			{
+				return false;
+			}
+			SkipWhitespace();
+			if (Consume(TEXT(']')))
+			{
+				return true;
+			}
+
+			while (true)
+			{
+				SkipWhitespace();
+				FFeatureSpan& Span = OutSpans.AddDefaulted_GetRef();
+				Span.Start = Pos;
+				if (!ScanElement(Span.ID))
+				{
+					return false;
+				}
+				Span.End = Pos;
+
+				SkipWhitespace();
+				if (Consume(TEXT(']')))
+				{
+					return true;
+				}
+				if (!Consume(TEXT(',')))
+				{
+					return false;
+				}
+			}
+		}
+
+	private:
+		bool ScanElement(FString& OutID)
+		{
+			if (Pos >= Len || Json[Pos] != TEXT('{'))
+			{
+				return false;
+			}
+
+			int32 Depth = 0;
+			int32 PropsDepth = INDEX_NONE;
+			do
+			{
+				if (Pos >= Len)
+				{
+					return false;
+				}
+
+				const TCHAR C = Json[Pos];
+				if (C == TEXT('"'))
+				{
+					int32 KeyStart = 0;
+					int32 KeyEnd = 0;
+					if (!ScanString(KeyStart, KeyEnd))
+					{
+						return false;
+					}
+					SkipWhitespace();
+					if (!Consume(TEXT(':')))
+					{
+						continue;
+					}
+					SkipWhitespace();
+					if (Pos >= Len)
+					{
+						return false;
+					}
+
+					if (Depth == 1 && Json[Pos] == TEXT('{') && Matches(KeyStart, KeyEnd, TEXT("properties")))
+					{
+						PropsDepth = 2;
+					}
+					else if (Depth == PropsDepth && Json[Pos] == TEXT('"') && Matches(KeyStart, KeyEnd, TEXT("id")))
+					{
+						int32 IdStart = 0;
+						int32 IdEnd = 0;
+						if (!ScanString(IdStart, IdEnd))
+						{
+							return false;
+						}
+						OutID = Unescape(IdStart, IdEnd);
+					}
+				}
+				else if (C == TEXT('{') || C == TEXT('['))
+				{
+					++Depth;
+					++Pos;
+				}
+				else if (C == TEXT('}') || C == TEXT(']'))
+				{
+					if (Depth == PropsDepth)
+					{
+						PropsDepth = INDEX_NONE;
+					}
+					--Depth;
+					++Pos;
+				}
+				else
+				{
+					++Pos;
+				}
+			}
+			while (Depth > 0);
+			return true;
+		}
+
+		// Pos 指向起始引号；返回不含引号的内容范围，Pos 移到结束引号之后
+		bool ScanString(int32& OutStart, int32& OutEnd)
+		{
+			OutStart = ++Pos;
+			while (Pos < Len)
+			{
+				const TCHAR C = Json[Pos];
+				if (C == TEXT('\\'))
+				{
+					Pos += 2;
+				}
+				else if (C == TEXT('"'))
+				{
+					OutEnd = Pos++;
+					return true;
+				}
+				else
+				{
+					++Pos;
+				}
+			}
+			return false;
+		}
+
+		bool Matches(int32 Start, int32 End, const TCHAR* Literal) const
+		{
+			const int32 LiteralLen = FCString::Strlen(Literal);
+			return End - Start == LiteralLen && FCString::Strncmp(Json + Start, Literal, LiteralLen) == 0;
+		}
+
+		FString Unescape(int32 Start, int32 End) const
+		{
+			FString Result;
+			Result.Reserve(End - Start);
+			for (int32 Index = Start; Index < End; ++Index)
+			{
+				TCHAR C = Json[Index];
+				if (C == TEXT('\\') && Index + 1 < End)
+				{
+					C = Json[++Index];
+					switch (C)
+					{
+					case TEXT('b'): C = TEXT('\b'); break;
+					case TEXT('f'): C = TEXT('\f'); break;
+					case TEXT('n'): C = TEXT('\n'); break;
+					case TEXT('r'): C = TEXT('\r'); break;
+					case TEXT('t'): C = TEXT('\t'); break;
+					case TEXT('u'):
+						if (Index + 4 < End)
+						{
+							C = static_cast<TCHAR>(FParse::HexNumber(*FString(4, Json + Index + 1)));
+							Index += 4;
+						}
+						break;
+					default: break;
+					}
+				}
+				Result.AppendChar(C);
+			}
+			return Result;
+		}
+
+		void SkipWhitespace()
+		{
+			while (Pos < Len && FChar::IsWhitespace(Json[Pos]))
+			{
+				++Pos;
+			}
+		}
+
+		bool Consume(TCHAR Expected)
+		{
+			if (Pos < Len && Json[Pos] == Expected)
+			{
+				++Pos;
+				return true;
+			}
+			return false;
+		}
+
+		const TCHAR* Json;
+		int32 Len;
+		int32 Pos = 0;
+	};
+}
+
+FString FGISEditJournal::GetJournalPath(const FString& SnapshotPath)
+{
+	return SnapshotPath + Extension;
+}
+
+bool FGISEditJournal::Append(const FString& JournalPath, const TArray<FGISEditRecord>& Records)
+{
+	if (Records.Num() == 0)
+	{
+		return true;
+	}
+
+	// 文件头不完整时当作新文件覆盖，否则追加在其后的记录永远读不到
+	const bool bNewFile = IFileManager::Get().FileSize(*JournalPath) < FileHeaderSize;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	if (bNewFile)
+	{
+		uint32 Magic = JournalMagic;
+		uint32 Version = JournalVersion;
+		Writer << Magic << Version;
+	}
+
+	TArray<uint8> RecordBytes;
+	for (const FGISEditRecord& Record : Records)
+	{
+		RecordBytes.Reset();
+		FMemoryWriter RecordWriter(RecordBytes);
+		WriteRecord(RecordWriter, Record);
+
+		int32 Size = RecordBytes.Num();
+		uint32 Crc = FCrc::MemCrc32(RecordBytes.GetData(), Size);
+		Writer << Size << Crc;
+		Writer.Serialize(RecordBytes.GetData(), Size);
+	}
+
+	// 整批一次写出
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*JournalPath, bNewFile ? 0 : FILEWRITE_Append));
+	if (!File)
+	{
+		UE_LOG(LogGISEditJournal, Warning, TEXT("无法打开编辑日志: %s"), *JournalPath);
+		return false;
+	}
+	File->Serialize(Bytes.GetData(), Bytes.Num());
+	const bool bClosed = File->Close();
+	if (!bClosed || File->IsError())
+	{
+		UE_LOG(LogGISEditJournal, Warning, TEXT("写入编辑日志失败: %s"), *JournalPath);
+		return false;
+	}
+	return true;
+}
+
+bool FGISEditJournal::Read(const FString& JournalPath, TArray<FGISEditRecord>& OutRecords, FGISJournalState& OutState)
+{
+	OutRecords.Reset();
+	OutState = FGISJournalState();
+
+	if (!IFileManager::Get().FileExists(*JournalPath))
+	{
+		return true;
+	}
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *JournalPath))
+	{
+		return false;
+	}
+
+	const int64 TotalSize = Bytes.Num();
+	if (TotalSize < FileHeaderSize)
+	{
+		OutState.bTornTail = TotalSize > 0;
+		return true;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != JournalMagic)
+	{
+		UE_LOG(LogGISEditJournal, Warning, TEXT("编辑日志文件头损坏，已忽略: %s"), *JournalPath);
+		OutState.bTornTail = true;
+		return true;
+	}
+	if (Version != JournalVersion)
+	{
+		UE_LOG(LogGISEditJournal, Warning, TEXT("不支持的编辑日志版本 %u: %s"), Version, *JournalPath);
+		return false;
+	}
+
+	int64 Offset = FileHeaderSize;
+	while (Offset < TotalSize)
+	{
+		if (TotalSize - Offset < FrameHeaderSize)
+		{
+			OutState.bTornTail = true;
+			break;
+		}
+
+		Reader.Seek(Offset);
+		int32 Size = 0;
+		uint32 Crc = 0;
+		Reader << Size << Crc;
+
+		const int64 DataOffset = Offset + FrameHeaderSize;
+		if (Size < 0 || Size > TotalSize - DataOffset || FCrc::MemCrc32(Bytes.GetData() + DataOffset, Size) != Crc)
+		{
+			OutState.bTornTail = true;
+			break;
+		}
+
+		FMemoryReaderView RecordReader(MakeArrayView(Bytes.GetData() + DataOffset, Size));
+		FGISEditRecord Record;
+		if (!ReadRecord(RecordReader, Record))
+		{
+			OutState.bTornTail = true;
+			break;
+		}
+		OutRecords.Add(MoveTemp(Record));
+		Offset = DataOffset + Size;
+	}
+
+	if (OutState.bTornTail)
+	{
+		UE_LOG(LogGISEditJournal, Warning, TEXT("编辑日志尾部不完整，保留前 %d 条记录: %s"), OutRecords.Num(), *JournalPath);
+	}
+	OutState.RecordCount = OutRecords.Num();
+	return true;
+}
+
+bool FGISEditJournal::Apply(const FString& FeaturesJson, const TArray<FGISEditRecord>& Records, FString& OutFeaturesJson)
+{
+	if (Records.Num() == 0)
+	{
+		OutFeaturesJson = FeaturesJson.IsEmpty() ? FString(TEXT("[]")) : FeaturesJson;
+		return true;
+	}
+
+	// 同一 id 以最后一条记录为准；快照中没有的要素按首次出现的顺序追加到末尾
+	TMap<FString, int32> Latest;
+	TArray<FString> NewOrder;
+	for (int32 Index = 0; Index < Records.Num(); ++Index)
+	{
+		if (int32* Found = Latest.Find(Records[Index].ID))
+		{
+			*Found = Index;
+		}
+		else
+		{
+			Latest.Add(Records[Index].ID, Index);
+			NewOrder.Add(Records[Index].ID);
+		}
+	}
+
+	TArray<FFeatureSpan> Spans;
+	if (!FeaturesJson.IsEmpty() && !FFeatureScanner(FeaturesJson).Scan(Spans))
+	{
+		UE_LOG(LogGISEditJournal, Warning, TEXT("快照要素数组无法解析，编辑日志未应用"));
+		return false;
+	}
+
+	FString Result;
+	Result.Reserve(FeaturesJson.Len() + 1024);
+	Result.AppendChar(TEXT('['));
+	bool bFirst = true;
+	auto Emit = [&Result, &bFirst](const TCHAR* Text, int32 Count)
+	{
+		if (!bFirst)
+		{
+			Result.AppendChar(TEXT(','));
+		}
+		bFirst = false;
+		Result.AppendChars(Text, Count);
+	};
+
+	TSet<FString> Emitted;
+	auto EmitRecord = [&Emit, &Emitted](const FGISEditRecord& Record)
+	{
+		bool bAlreadyEmitted = false;
+		Emitted.Add(Record.ID, &bAlreadyEmitted);
+		if (!bAlreadyEmitted && Record.Op == EGISEditOp::Put && !Record.FeatureJson.IsEmpty())
+		{
+			Emit(*Record.FeatureJson, Record.FeatureJson.Len());
+		}
+	};
+
+	for (const FFeatureSpan& Span : Spans)
+	{
+		const int32* RecordIndex = Span.ID.IsEmpty() ? nullptr : Latest.Find(Span.ID);
+		if (RecordIndex)
+		{
+			EmitRecord(Records[*RecordIndex]);
+		}
+		else
+		{
+			Emit(*FeaturesJson + Span.Start, Span.End - Span.Start);
+		}
+	}
+
+	for (const FString& ID : NewOrder)
+	{
+		EmitRecord(Records[Latest[ID]]);
+	}
+
+	Result.AppendChar(TEXT(']'));
+	OutFeaturesJson = MoveTemp(Result);
+	return true;
+}
+
+void FGISEditJournal::Open(const FString& InSnapshotPath, const FGISJournalState& State)
+{
+	if (HasDocument() && Pending.Num() > 0)
+	{
+		FGISEditBatch& Batch = Detached.AddDefaulted_GetRef();
+		Batch.SnapshotPath = SnapshotPath;
+		Batch.Records = MoveTemp(Pending);
+	}
+	Pending.Reset();
+	PendingIndex.Reset();
+
+	SnapshotPath = InSnapshotPath;
+	JournalRecords = State.RecordCount;
+	bCompactRequested = State.bTornTail;
+}
+
+void FGISEditJournal::Rebase(const FString& InSnapshotPath)
+{
+	SnapshotPath = InSnapshotPath;
+	JournalRecords = 0;
+	bCompactRequested = false;
+}
+
+void FGISEditJournal::Put(const FString& ID, FString FeatureJson)
+{
+	FGISEditRecord Record;
+	Record.Op = EGISEditOp::Put;
+	Record.ID = ID;
+	Record.FeatureJson = MoveTemp(FeatureJson);
+	AddRecord(MoveTemp(Record));
+}
+
+void FGISEditJournal::Delete(const FString& ID)
+{
+	FGISEditRecord Record;
+	Record.Op = EGISEditOp::Delete;
+	Record.ID = ID;
+	AddRecord(MoveTemp(Record));
+}
+
+void FGISEditJournal::AddRecord(FGISEditRecord&& Record)
+{
+	if (const int32* Found = PendingIndex.Find(Record.ID))
+	{
+		Pending[*Found] = MoveTemp(Record);
+		return;
+	}
+	PendingIndex.Add(Record.ID, Pending.Num());
+	Pending.Add(MoveTemp(Record));
+}
+
+TArray<FGISEditBatch> FGISEditJournal::TakeBatches(int32 CompactRecords)
+{
+	TArray<FGISEditBatch> Batches = MoveTemp(Detached);
+	Detached.Reset();
+
+	// 尚未存过的新地图没有快照可追加，记录留在队列中等待另存为
+	if (HasDocument() && (Pending.Num() > 0 || bCompactRequested))
+	{
+		FGISEditBatch& Batch = Batches.AddDefaulted_GetRef();
+		Batch.SnapshotPath = SnapshotPath;
+		Batch.Records = MoveTemp(Pending);
+		Batch.bCompact = bCompactRequested || (CompactRecords > 0 && JournalRecords + Batch.Records.Num() >= CompactRecords);
+
+		Pending.Reset();
+		PendingIndex.Reset();
+		bCompactRequested = false;
+	}
+	return Batches;
+}
+
+void FGISEditJournal::OnBatchWritten(const FGISEditBatch& Batch, bool bSuccess, const FString& NewSnapshotPath)
+{
+	const bool bCurrent = Batch.SnapshotPath == SnapshotPath;
+	if (!bSuccess)
+	{
+		RestoreRecords(Batch.SnapshotPath, Batch.Records);
+		if (bCurrent && Batch.bCompact)
+		{
+			bCompactRequested = true;
+		}
+		return;
+	}
+
+	if (!bCurrent)
+	{
+		return;
+	}
+
+	// 压实后快照可能从旧版 .json 换成了 .gisb
+	if (!NewSnapshotPath.IsEmpty())
+	{
+		SnapshotPath = NewSnapshotPath;
+		JournalRecords = 0;
+	}
+	else
+	{
+		JournalRecords += Batch.Records.Num();
+	}
+}
+
+void FGISEditJournal::RestoreRecords(const FString& Path, const TArray<FGISEditRecord>& Records)
+{
+	if (Path != SnapshotPath)
+	{
+		FGISEditBatch& Batch = Detached.AddDefaulted_GetRef();
+		Batch.SnapshotPath = Path;
+		Batch.Records = Records;
+		return;
+	}
+
+	// 失败的记录比队列中的旧，已有更新记录的 id 不再放回
+	TArray<FGISEditRecord> Merged;
+	Merged.Reserve(Records.Num() + Pending.Num());
+	for (const FGISEditRecord& Record : Records)
+	{
+		if (!PendingIndex.Contains(Record.ID))
+		{
+			Merged.Add(Record);
+		}
+	}
+	Merged.Append(MoveTemp(Pending));
+
+	Pending = MoveTemp(Merged);
+	PendingIndex.Reset();
+	for (int32 Index = 0; Index < Pending.Num(); ++Index)
+	{
+		PendingIndex.Add(Pending[Index].ID, Index);
+	}
+}
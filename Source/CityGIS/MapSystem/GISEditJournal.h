@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EGISEditOp : uint8
+{
+	// 新增或修改：记录完整的要素 JSON，重放时整体替换
+	Put,
+	Delete
+};
+
+struct FGISEditRecord
+{
+	EGISEditOp Op = EGISEditOp::Put;
+	FString ID;
+	FString FeatureJson;
+};
+
+// 一批待写入某个日志文件的记录
+struct FGISEditBatch
+{
+	FString SnapshotPath;
+	TArray<FGISEditRecord> Records;
+	// 写入后做压实：日志合并进快照，日志文件删除
+	bool bCompact = false;
+};
+
+// 读取日志的结果，供调用方决定是否需要压实
+struct FGISJournalState
+{
+	int32 RecordCount = 0;
+	// 文件尾部不完整 (写盘中途崩溃)，之后追加的记录会读不到，应尽快压实
+	bool bTornTail = false;
+};
+
+/**
+ * 存档的编辑日志 (<存档>.gisj)
+ *
+ * 存档文件作为快照，之后的增/改/删按要素 id 追加到日志中，保存只写新增的记录；
+ * 日志过长时压实：快照 + 日志合并写成新的 .gisb 快照，再删除日志。
+ * 记录幂等 (Put 整体替换、Delete 重复无害)，压实中途崩溃后重放旧日志结果不变。
+ *
+ * 静态函数为纯文件操作，可在工作线程调用；同一日志的写入由调用方保证串行。
+ * 成员部分是游戏线程上的待写队列，同一 id 的多次修改只保留最后一次。
+ */
+class CITYGIS_API FGISEditJournal
+{
+public:
+	static const TCHAR* Extension;
+
+	static FString GetJournalPath(const FString& SnapshotPath);
+
+	// 追加记录，文件不存在时创建；每条记录带长度与校验，尾部损坏只影响最后一条
+	static bool Append(const FString& JournalPath, const TArray<FGISEditRecord>& Records);
+
+	// 读取全部完整记录；文件不存在视为空日志
+	static bool Read(const FString& JournalPath, TArray<FGISEditRecord>& OutRecords, FGISJournalState& OutState);
+
+	// 把记录应用到要素数组文本上：只定位每个要素的 properties.id，不构建 JSON DOM
+	static bool Apply(const FString& FeaturesJson, const TArray<FGISEditRecord>& Records, FString& OutFeaturesJson);
+
+	// ---- 游戏线程：待写队列 ----
+
+	// 切换到另一个存档；旧存档尚未写出的记录保留，下次写盘时写回旧日志
+	void Open(const FString& SnapshotPath, const FGISJournalState& State);
+
+	// 另存为：记录继续归属新存档 (新快照已包含其中的大部分，重放幂等)
+	void Rebase(const FString& SnapshotPath);
+
+	bool HasDocument() const { return !SnapshotPath.IsEmpty(); }
+	const FString& GetSnapshotPath() const { return SnapshotPath; }
+	bool HasPending() const { return Pending.Num() > 0 || Detached.Num() > 0 || bCompactRequested; }
+
+	void Put(const FString& ID, FString FeatureJson);
+	void Delete(const FString& ID);
+
+	// 取出所有待写批次；当前存档的日志达到 CompactRecords 条时要求压实
+	TArray<FGISEditBatch> TakeBatches(int32 CompactRecords);
+
+	// 写盘完成后回报：成功则计数，失败则把记录放回队列 (不覆盖期间产生的新记录)
+	void OnBatchWritten(const FGISEditBatch& Batch, bool bSuccess, const FString& NewSnapshotPath);
+
+private:
+	void AddRecord(FGISEditRecord&& Record);
+	void RestoreRecords(const FString& Path, const TArray<FGISEditRecord>& Records);
+
+	FString SnapshotPath;
+	TArray<FGISEditRecord> Pending;
+	TMap<FString, int32> PendingIndex;
+
+	// 切换存档前未写出的旧批次
+	TArray<FGISEditBatch> Detached;
+
+	// 当前日志文件中已有的记录数
+	int32 JournalRecords = 0;
+	bool bCompactRequested = false;
+};
@@ -0,0 +1,198 @@
+#include "GISExtrusion.h"
+#include "GISTriangulator.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+	// 单个要素的网格
+	struct FPiece
+	{
+		TArray<FVector> Vertices;
+		TArray<int32> Triangles;
+		TArray<FVector> Normals;
+	};
+
+	double SignedAreaXY(const TArray<FVector>& Ring)
+	{
+		double Sum = 0.0;
+		for (int32 Index = 0, Prev = Ring.Num() - 1; Index < Ring.Num(); Prev = Index++)
+		{
+			Sum += Ring[Prev].X * Ring[Index].Y - Ring[Index].X * Ring[Prev].Y;
+		}
+		return Sum * 0.5;
+	}
+
+	// 一个环的侧面：每条边独立 4 个顶点，法线水平朝外
+	void AddWalls(const TArray<FVector>& Bottom, const TArray<FVector>& Top, bool bOuter, FPiece& Out)
+	{
+		// 让实体始终在前进方向左侧 (局部 XY 平面内外环逆时针、洞顺时针)，右侧即朝外
+		const double Area = SignedAreaXY(Bottom);
+		const bool bReverse = bOuter ? Area < 0.0 : Area > 0.0;
+		const int32 Count = Bottom.Num();
+
+		for (int32 Edge = 0; Edge < Count; ++Edge)
+		{
+			int32 IndexA = Edge;
+			int32 IndexB = (Edge + 1) % Count;
+			if (bReverse)
+			{
+				Swap(IndexA, IndexB);
+			}
+
+			const FVector Dir = Bottom[IndexB] - Bottom[IndexA];
+			const FVector Normal = FVector(Dir.Y, -Dir.X, 0.0).GetSafeNormal();
+			if (Normal.IsZero())
+			{
+				continue;
+			}
+
+			// (A0, B0, B1) 与 (A0, B1, A1)：cross(B - A, C - A) 与朝外法线同向
+			const int32 Base = Out.Vertices.Num();
+			Out.Vertices.Add(Bottom[IndexA]);
+			Out.Vertices.Add(Bottom[IndexB]);
+			Out.Vertices.Add(Top[IndexB]);
+			Out.Vertices.Add(Top[IndexA]);
+			for (int32 Corner = 0; Corner < 4; ++Corner)
+			{
+				Out.Normals.Add(Normal);
+			}
+			Out.Triangles.Append({ Base, Base + 1, Base + 2, Base, Base + 2, Base + 3 });
+		}
+	}
+
+	void BuildPiece(const FGISExtrusionInput& Input, const FGISEnuFrame& Frame, FPiece& Out)
+	{
+		TArray<FVector2D> LngLats;
+		TArray<int32> HoleStarts;
+		TArray<FVector> Bottom;
+		TArray<FVector> Top;
+		TArray<FVector2D> Plane;
+		TArray<int32> CapTriangles;
+
+		for (const FGISPolygon& Polygon : *Input.Geometry)
+		{
+			GISTriangulator::Flatten(Polygon, [](const FVector2D& LngLat) { return LngLat; }, LngLats, HoleStarts);
+			if (LngLats.Num() < 3)
+			{
+				continue;
+			}
+
+			Bottom.SetNumUninitialized(LngLats.Num(), EAllowShrinking::No);
+			Top.SetNumUninitialized(LngLats.Num(), EAllowShrinking::No);
+			Frame.ToLocalBatch(LngLats, Bottom);
+			Frame.ToLocalBatch(LngLats, Top, Input.Height);
+
+			Plane.Reset(LngLats.Num());
+			for (const FVector& Low : Bottom)
+			{
+				Plane.Add(FVector2D(Low.X, Low.Y));
+			}
+
+			// 顶面：局部 XY 平面内逆时针的三角形，cross 朝 +Z
+			GISTriangulator::Triangulate(Plane, HoleStarts, CapTriangles);
+			const int32 CapBase = Out.Vertices.Num();
+			Out.Vertices.Append(Top);
+			for (int32 Index = 0; Index < Top.Num(); ++Index)
+			{
+				Out.Normals.Add(FVector::UpVector);
+			}
+			for (const int32 Index : CapTriangles)
+			{
+				Out.Triangles.Add(CapBase + Index);
+			}
+
+			// 侧面：逐环取出顶点段
+			TArray<FVector> RingBottom;
+			TArray<FVector> RingTop;
+			for (int32 Ring = 0; Ring <= HoleStarts.Num(); ++Ring)
+			{
+				const int32 Start = Ring == 0 ? 0 : HoleStarts[Ring - 1];
+				const int32 End = Ring < HoleStarts.Num() ? HoleStarts[Ring] : LngLats.Num();
+				RingBottom.Reset();
+				RingTop.Reset();
+				RingBottom.Append(Bottom.GetData() + Start, End - Start);
+				RingTop.Append(Top.GetData() + Start, End - Start);
+				AddWalls(RingBottom, RingTop, Ring == 0, Out);
+			}
+		}
+	}
+}
+
+void FGISExtrusion::Build(const TArray<FGISExtrusionInput>& Inputs, const FGISEnuFrame& Frame, TArray<FGISMeshSection>& OutSections)
+{
+	OutSections.Reset();
+	if (!Frame.IsValid())
+	{
+		return;
+	}
+
+	// 各要素独立生成
+	TArray<FPiece> Pieces;
+	Pieces.SetNum(Inputs.Num());
+	ParallelFor(Inputs.Num(), [&](int32 Index)
+	{
+		const FGISExtrusionInput& Input = Inputs[Index];
+		if (Input.Geometry.IsValid() && Input.Height > 0.0f)
+		{
+			BuildPiece(Input, Frame, Pieces[Index]);
+		}
+	});
+
+	// 按分组归并，分组内保持输入顺序，结果与线程调度无关
+	TMap<FString, int32> GroupIndex;
+	TArray<TArray<int32>> Members;
+	for (int32 Index = 0; Index < Inputs.Num(); ++Index)
+	{
+		if (Pieces[Index].Triangles.Num() == 0)
+		{
+			continue;
+		}
+		int32* Found = GroupIndex.Find(Inputs[Index].Group);
+		if (!Found)
+		{
+			Found = &GroupIndex.Add(Inputs[Index].Group, Members.Num());
+			Members.AddDefaulted();
+			OutSections.AddDefaulted_GetRef().Group = Inputs[Index].Group;
+		}
+		Members[*Found].Add(Index);
+	}
+
+	ParallelFor(OutSections.Num(), [&](int32 SectionIndex)
+	{
+		FGISMeshSection& Section = OutSections[SectionIndex];
+		int32 NumVertices = 0;
+		int32 NumIndices = 0;
+		for (const int32 Member : Members[SectionIndex])
+		{
+			NumVertices += Pieces[Member].Vertices.Num();
+			NumIndices += Pieces[Member].Triangles.Num();
+		}
+		Section.Vertices.Reserve(NumVertices);
+		Section.Normals.Reserve(NumVertices);
+		Section.Colors.Reserve(NumVertices);
+		Section.Triangles.Reserve(NumIndices);
+
+		for (const int32 Member : Members[SectionIndex])
+		{
+			const FPiece& Piece = Pieces[Member];
+			const int32 Base = Section.Vertices.Num();
+			Section.Vertices.Append(Piece.Vertices);
+			Section.Normals.Append(Piece.Normals);
+			for (int32 Vertex = 0; Vertex < Piece.Vertices.Num(); ++Vertex)
+			{
+				Section.Colors.Add(Inputs[Member].Color);
+			}
+			for (const int32 Index : Piece.Triangles)
+			{
+				Section.Triangles.Add(Base + Index);
+			}
+		}
+
+		uint32 Hash = FCrc::MemCrc32(Section.Vertices.GetData(), Section.Vertices.Num() * sizeof(FVector));
+		Hash = FCrc::MemCrc32(Section.Triangles.GetData(), Section.Triangles.Num() * sizeof(int32), Hash);
+		Section.Hash = FCrc::MemCrc32(Section.Colors.GetData(), Section.Colors.Num() * sizeof(FColor), Hash);
+	});
+
+	OutSections.Sort([](const FGISMeshSection& A, const FGISMeshSection& B) { return A.Group < B.Group; });
+}
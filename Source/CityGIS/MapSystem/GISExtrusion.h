@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+#include "GISCoordinates.h"
+
+// 一个待拉伸的要素
+struct FGISExtrusionInput
+{
+	// 所属网格分组 (一个分组对应一个网格段)
+	FString Group;
+	TSharedPtr<const FGISMultiPolygon> Geometry;
+	// 拉伸高度 (米)，不大于 0 的要素跳过
+	float Height = 0.0f;
+	FColor Color = FColor::White;
+};
+
+// 一个分组合并后的网格段，数组可直接交给 UProceduralMeshComponent::CreateMeshSection
+struct FGISMeshSection
+{
+	FString Group;
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<FColor> Colors;
+
+	// 网格内容的哈希，未变化的分组不必重新提交
+	uint32 Hash = 0;
+};
+
+/**
+ * 按高度把面要素拉伸为棱柱网格 (顶面 earcut 剖分 + 侧面，不生成底面)
+ * 坐标先经 ENU 局部坐标系换到厘米，再在局部平面内剖分，避免经纬度的纵横比失真
+ * 各要素并行生成，再按分组并行合并；输入为只读快照，可在工作线程中执行
+ */
+class CITYGIS_API FGISExtrusion
+{
+public:
+	// 输出按分组名排序，不含空分组
+	static void Build(const TArray<FGISExtrusionInput>& Inputs, const FGISEnuFrame& Frame, TArray<FGISMeshSection>& OutSections);
+};
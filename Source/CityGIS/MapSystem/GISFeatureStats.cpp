@@ -0,0 +1,192 @@
+#include "GISFeatureStats.h"
+
+namespace
+{
+	// 祖先链长度上限 (正常只有 3 层)，防止异常数据死循环
+	constexpr int32 MaxAncestorDepth = 64;
+}
+
+FGISStatsTotals& FGISStatsTotals::operator+=(const FGISStatsTotals& Other)
+{
+	NumFeatures += Other.NumFeatures;
+	NumStreets += Other.NumStreets;
+	NumCommunities += Other.NumCommunities;
+	AreaM2 += Other.AreaM2;
+	PerimeterM += Other.PerimeterM;
+	return *this;
+}
+
+FGISStatsTotals& FGISStatsTotals::operator-=(const FGISStatsTotals& Other)
+{
+	NumFeatures -= Other.NumFeatures;
+	NumStreets -= Other.NumStreets;
+	NumCommunities -= Other.NumCommunities;
+	AreaM2 -= Other.AreaM2;
+	PerimeterM -= Other.PerimeterM;
+	return *this;
+}
+
+FGISFeatureStats::FSlot* FGISFeatureStats::FindSlot(FGISFeatureHandle Handle)
+{
+	return Handle.IsSet() && Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].Handle == Handle ? &Slots[Handle.Index] : nullptr;
+}
+
+const FGISFeatureStats::FSlot* FGISFeatureStats::FindSlot(FGISFeatureHandle Handle) const
+{
+	return const_cast<FGISFeatureStats*>(this)->FindSlot(Handle);
+}
+
+FGISFeatureStats::FSlot& FGISFeatureStats::FindOrAddSlot(FGISFeatureHandle Handle)
+{
+	if (FSlot* Slot = FindSlot(Handle))
+	{
+		return *Slot;
+	}
+	if (Handle.Index >= Slots.Num())
+	{
+		Slots.SetNum(Handle.Index + 1);
+	}
+
+	// 槽位被新要素复用：旧记录的贡献已在 Remove 时移除
+	FSlot& Slot = Slots[Handle.Index];
+	Slot = FSlot();
+	Slot.Handle = Handle;
+	return Slot;
+}
+
+FGISStatsTotals FGISFeatureStats::OwnTotals(const FSlot& Slot)
+{
+	FGISStatsTotals Totals;
+	Totals.NumFeatures = 1;
+	Totals.NumStreets = Slot.Type == EGISFeatureType::Street ? 1 : 0;
+	Totals.NumCommunities = Slot.Type == EGISFeatureType::Community ? 1 : 0;
+	Totals.AreaM2 = Slot.Measure.AreaM2;
+	Totals.PerimeterM = Slot.Measure.PerimeterM;
+	return Totals;
+}
+
+void FGISFeatureStats::AddToAncestors(const FSlot& Slot, const FGISStatsTotals& Delta, bool bSubtract)
+{
+	FGISFeatureHandle Parent = Slot.RolledParent;
+	for (int32 Depth = 0; Depth < MaxAncestorDepth; ++Depth)
+	{
+		FSlot* Ancestor = FindSlot(Parent);
+		if (!Ancestor)
+		{
+			return;
+		}
+		if (bSubtract)
+		{
+			Ancestor->Descendants -= Delta;
+		}
+		else
+		{
+			Ancestor->Descendants += Delta;
+		}
+		Parent = Ancestor->RolledParent;
+	}
+}
+
+bool FGISFeatureStats::NeedsMeasure(FGISFeatureHandle Handle, const TSharedPtr<const FGISMultiPolygon>& Geometry) const
+{
+	// 弱引用失效 (旧几何已释放) 时 Pin 为空，不会误判为同一份
+	const FSlot* Slot = FindSlot(Handle);
+	return !Slot || !Slot->bMeasured || Slot->Geometry.Pin() != Geometry;
+}
+
+void FGISFeatureStats::SetMeasure(FGISFeatureHandle Handle, const TSharedPtr<const FGISMultiPolygon>& Geometry, const FGISFeatureMeasure& Measure)
+{
+	FSlot& Slot = FindOrAddSlot(Handle);
+	const FGISStatsTotals Before = OwnTotals(Slot);
+	Slot.Geometry = Geometry;
+	Slot.Measure = Measure;
+	Slot.bMeasured = true;
+
+	FGISStatsTotals Delta = OwnTotals(Slot);
+	Delta -= Before;
+	AddToAncestors(Slot, Delta, false);
+}
+
+void FGISFeatureStats::SyncParent(const FGISFeatureStore& Store, FGISFeatureHandle Handle)
+{
+	if (!Store.IsValid(Handle))
+	{
+		return;
+	}
+
+	FSlot& Slot = FindOrAddSlot(Handle);
+	FGISStatsTotals Contribution = OwnTotals(Slot);
+	Contribution += Slot.Descendants;
+	AddToAncestors(Slot, Contribution, true);
+
+	Slot.Type = Store.GetType(Handle);
+	Slot.RolledParent = Store.GetParent(Handle);
+
+	Contribution = OwnTotals(Slot);
+	Contribution += Slot.Descendants;
+	AddToAncestors(Slot, Contribution, false);
+}
+
+void FGISFeatureStats::Remove(FGISFeatureHandle Handle)
+{
+	FSlot* Slot = FindSlot(Handle);
+	if (!Slot)
+	{
+		return;
+	}
+
+	FGISStatsTotals Contribution = OwnTotals(*Slot);
+	Contribution += Slot->Descendants;
+	AddToAncestors(*Slot, Contribution, true);
+	*Slot = FSlot();
+}
+
+void FGISFeatureStats::Reset()
+{
+	Slots.Reset();
+}
+
+const FGISFeatureMeasure* FGISFeatureStats::GetMeasure(FGISFeatureHandle Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot && Slot->bMeasured ? &Slot->Measure : nullptr;
+}
+
+FGISStatsTotals FGISFeatureStats::GetDescendantTotals(FGISFeatureHandle Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot ? Slot->Descendants : FGISStatsTotals();
+}
+
+bool FGISFeatureStats::GetSummary(FGISFeatureHandle Handle, FGISFeatureSummary& OutSummary) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	OutSummary = FGISFeatureSummary();
+	if (Slot->bMeasured)
+	{
+		const FGISFeatureMeasure& Measure = Slot->Measure;
+		OutSummary.AreaM2 = Measure.AreaM2;
+		OutSummary.PerimeterM = Measure.PerimeterM;
+		OutSummary.Centroid = Measure.Centroid;
+		OutSummary.LabelPoint = Measure.LabelPoint;
+		if (Measure.Bounds.bIsValid)
+		{
+			OutSummary.BoundsMin = Measure.Bounds.Min;
+			OutSummary.BoundsMax = Measure.Bounds.Max;
+		}
+	}
+
+	// 加减累积的浮点误差可能让空汇总略小于 0
+	const FGISStatsTotals& Descendants = Slot->Descendants;
+	OutSummary.NumDescendants = Descendants.NumFeatures;
+	OutSummary.NumStreets = Descendants.NumStreets;
+	OutSummary.NumCommunities = Descendants.NumCommunities;
+	OutSummary.DescendantAreaM2 = FMath::Max(Descendants.AreaM2, 0.0);
+	OutSummary.DescendantPerimeterM = FMath::Max(Descendants.PerimeterM, 0.0);
+	return true;
+}
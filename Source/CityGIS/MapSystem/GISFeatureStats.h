@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISFeatureStore.h"
+#include "GISMeasure.h"
+#include "GISFeatureStats.generated.h"
+
+// 一个要素自身的量测与其全部下级的汇总，供蓝图/面板读取
+USTRUCT(BlueprintType)
+struct FGISFeatureSummary
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly) double AreaM2 = 0.0;
+	UPROPERTY(BlueprintReadOnly) double PerimeterM = 0.0;
+	UPROPERTY(BlueprintReadOnly) FVector2D Centroid = FVector2D::ZeroVector;
+	UPROPERTY(BlueprintReadOnly) FVector2D LabelPoint = FVector2D::ZeroVector;
+	UPROPERTY(BlueprintReadOnly) FVector2D BoundsMin = FVector2D::ZeroVector;
+	UPROPERTY(BlueprintReadOnly) FVector2D BoundsMax = FVector2D::ZeroVector;
+
+	// 全部下级 (不含自身)：要素数、其中街道与小区数、面积与周长之和
+	UPROPERTY(BlueprintReadOnly) int32 NumDescendants = 0;
+	UPROPERTY(BlueprintReadOnly) int32 NumStreets = 0;
+	UPROPERTY(BlueprintReadOnly) int32 NumCommunities = 0;
+	UPROPERTY(BlueprintReadOnly) double DescendantAreaM2 = 0.0;
+	UPROPERTY(BlueprintReadOnly) double DescendantPerimeterM = 0.0;
+};
+
+// 可加减的汇总量 (下级的增减直接按差量沿祖先链累加)
+struct FGISStatsTotals
+{
+	int32 NumFeatures = 0;
+	int32 NumStreets = 0;
+	int32 NumCommunities = 0;
+	double AreaM2 = 0.0;
+	double PerimeterM = 0.0;
+
+	FGISStatsTotals& operator+=(const FGISStatsTotals& Other);
+	FGISStatsTotals& operator-=(const FGISStatsTotals& Other);
+};
+
+/**
+ * 要素量测缓存与层级汇总 (区镇 -> 街道 -> 小区)
+ *
+ * 量测按几何版本缓存：几何以只读共享指针保存，换了新几何指针即视为新版本，未变的要素不重算。
+ * 每个要素记着自身量测已计入哪个父级 (RolledParent)，自身或父级变化时只把差量沿祖先链增减，
+ * 单个要素变动的代价是 O(层级深度)，不必重算全城。
+ * 以要素存储的句柄槽位为下标；层级变化须在同一帧内调用 SyncParent，仅在游戏线程使用。
+ */
+class CITYGIS_API FGISFeatureStats
+{
+public:
+	// 该要素缓存的量测是否不是这份几何算出的
+	bool NeedsMeasure(FGISFeatureHandle Handle, const TSharedPtr<const FGISMultiPolygon>& Geometry) const;
+
+	// 写入量测并把面积/周长的差量计入祖先
+	void SetMeasure(FGISFeatureHandle Handle, const TSharedPtr<const FGISMultiPolygon>& Geometry, const FGISFeatureMeasure& Measure);
+
+	// 要素新建或父级变化后调用：从原父级链移除自身及下级的贡献，再计入当前父级链
+	void SyncParent(const FGISFeatureStore& Store, FGISFeatureHandle Handle);
+
+	// 要素删除前调用 (子要素随之变为根，其贡献已包含在被删要素中一并移除)
+	void Remove(FGISFeatureHandle Handle);
+
+	void Reset();
+
+	const FGISFeatureMeasure* GetMeasure(FGISFeatureHandle Handle) const;
+
+	// 全部下级的汇总
+	FGISStatsTotals GetDescendantTotals(FGISFeatureHandle Handle) const;
+
+	bool GetSummary(FGISFeatureHandle Handle, FGISFeatureSummary& OutSummary) const;
+
+private:
+	struct FSlot
+	{
+		FGISFeatureHandle Handle;
+		EGISFeatureType Type = EGISFeatureType::Custom;
+
+		TWeakPtr<const FGISMultiPolygon> Geometry;
+		FGISFeatureMeasure Measure;
+		bool bMeasured = false;
+
+		FGISStatsTotals Descendants;
+		FGISFeatureHandle RolledParent;
+	};
+
+	FSlot* FindSlot(FGISFeatureHandle Handle);
+	const FSlot* FindSlot(FGISFeatureHandle Handle) const;
+	FSlot& FindOrAddSlot(FGISFeatureHandle Handle);
+
+	// 自身一项 (不含下级)
+	static FGISStatsTotals OwnTotals(const FSlot& Slot);
+
+	// 沿 RolledParent 链给每个祖先加上/减去 Delta
+	void AddToAncestors(const FSlot& Slot, const FGISStatsTotals& Delta, bool bSubtract);
+
+	TArray<FSlot> Slots;
+};
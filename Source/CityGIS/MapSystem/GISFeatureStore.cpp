@@ -0,0 +1,533 @@
+#include "GISFeatureStore.h"
+
+namespace GISFeatureType
+{
+	EGISFeatureType FromString(const FString& Name)
+	{
+		if (Name == TEXT("District")) return EGISFeatureType::District;
+		if (Name == TEXT("Street")) return EGISFeatureType::Street;
+		if (Name == TEXT("Community")) return EGISFeatureType::Community;
+		if (Name == TEXT("Road")) return EGISFeatureType::Road;
+		if (Name == TEXT("Reconstruct")) return EGISFeatureType::Reconstruct;
+		return EGISFeatureType::Custom;
+	}
+
+	const TCHAR* ToString(EGISFeatureType Type)
+	{
+		switch (Type)
+		{
+		case EGISFeatureType::District: return TEXT("District");
+		case EGISFeatureType::Street: return TEXT("Street");
+		case EGISFeatureType::Community: return TEXT("Community");
+		case EGISFeatureType::Road: return TEXT("Road");
+		case EGISFeatureType::Reconstruct: return TEXT("Reconstruct");
+		default: return TEXT("Custom");
+		}
+	}
+
+	const TCHAR* GetDisplayName(EGISFeatureType Type)
+	{
+		switch (Type)
+		{
+		case EGISFeatureType::District: return TEXT("区镇");
+		case EGISFeatureType::Street: return TEXT("街道");
+		case EGISFeatureType::Community: return TEXT("小区");
+		case EGISFeatureType::Road: return TEXT("道路");
+		case EGISFeatureType::Reconstruct: return TEXT("重构");
+		default: return TEXT("自定义");
+		}
+	}
+
+	bool GetParentType(EGISFeatureType Type, EGISFeatureType& OutParentType)
+	{
+		switch (Type)
+		{
+		case EGISFeatureType::Street:
+			OutParentType = EGISFeatureType::District;
+			return true;
+		case EGISFeatureType::Community:
+		case EGISFeatureType::Custom:
+		case EGISFeatureType::Road:
+			OutParentType = EGISFeatureType::Street;
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+
+FGISFeatureHandle FGISFeatureStore::Add(const FString& IDText, const FAttributes& Attributes)
+{
+	const FName ID(*IDText);
+	if (const int32* Existing = HandleByID.Find(ID))
+	{
+		return MakeHandle(*Existing);
+	}
+
+	int32 Index;
+	if (FreeSlots.Num() > 0)
+	{
+		Index = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Index = IDs.AddDefaulted();
+		Names.AddDefaulted();
+		Types.AddDefaulted();
+		ParentIDs.AddDefaulted();
+		FillColorIndices.AddDefaulted();
+		TextColorIndices.AddDefaulted();
+		Opacities.AddDefaulted();
+		Heights.AddDefaulted();
+		TagIndices.AddDefaulted();
+		Bounds.AddDefaulted();
+		Serials.Add(0);
+		Alive.Add(false);
+		Parents.AddDefaulted();
+		Children.AddDefaulted();
+		IndexInParent.AddDefaulted();
+		IndexInType.AddDefaulted();
+	}
+
+	IDs[Index] = ID;
+	Names[Index] = Attributes.Name;
+	Types[Index] = Attributes.Type;
+	ParentIDs[Index] = FName(*Attributes.ParentID);
+	FillColorIndices[Index] = InternColor(Attributes.FillColor);
+	TextColorIndices[Index] = InternColor(Attributes.TextColor);
+	Opacities[Index] = Attributes.Opacity;
+	Heights[Index] = Attributes.Height;
+	TagIndices[Index] = InternTag(Attributes.Tag);
+	Bounds[Index] = FBox2D(ForceInit);
+	Alive[Index] = true;
+
+	Parents[Index] = INDEX_NONE;
+	Children[Index].Reset();
+	IndexInParent[Index] = INDEX_NONE;
+	IndexInType[Index] = MembersByType[static_cast<int32>(Attributes.Type)].Add(Index);
+
+	HandleByID.Add(ID, Index);
+	return MakeHandle(Index);
+}
+
+void FGISFeatureStore::Remove(FGISFeatureHandle Handle, TArray<FGISFeatureHandle>* OutOrphans)
+{
+	if (!IsValid(Handle))
+	{
+		return;
+	}
+
+	const int32 Index = Handle.Index;
+	Unlink(Index);
+
+	for (const int32 ChildIndex : Children[Index])
+	{
+		Parents[ChildIndex] = INDEX_NONE;
+		IndexInParent[ChildIndex] = INDEX_NONE;
+		if (OutOrphans)
+		{
+			OutOrphans->Add(MakeHandle(ChildIndex));
+		}
+	}
+	Children[Index].Reset();
+
+	TArray<int32>& Members = MembersByType[static_cast<int32>(Types[Index])];
+	const int32 Last = Members.Last();
+	Members.RemoveAtSwap(IndexInType[Index], 1, EAllowShrinking::No);
+	if (Last != Index)
+	{
+		IndexInType[Last] = IndexInType[Index];
+	}
+	IndexInType[Index] = INDEX_NONE;
+
+	HandleByID.Remove(IDs[Index]);
+	IDs[Index] = NAME_None;
+	Names[Index].Reset();
+	ParentIDs[Index] = NAME_None;
+	Alive[Index] = false;
+	++Serials[Index];
+	FreeSlots.Add(Index);
+}
+
+void FGISFeatureStore::Reset()
+{
+	// 序号保留，旧句柄在重置后仍然失效
+	for (TConstSetBitIterator<> It(Alive); It; ++It)
+	{
+		const int32 Index = It.GetIndex();
+		IDs[Index] = NAME_None;
+		Names[Index].Reset();
+		ParentIDs[Index] = NAME_None;
+		Parents[Index] = INDEX_NONE;
+		Children[Index].Reset();
+		IndexInParent[Index] = INDEX_NONE;
+		IndexInType[Index] = INDEX_NONE;
+		++Serials[Index];
+		FreeSlots.Add(Index);
+	}
+	Alive.Init(false, Alive.Num());
+	HandleByID.Reset();
+	for (TArray<int32>& Members : MembersByType)
+	{
+		Members.Reset();
+	}
+
+	// 标签表随要素一起清空
+	Tags.Reset();
+	Tags.AddDefaulted();
+	TagByName.Reset();
+	ColorTexts.Reset();
+	ColorValues.Reset();
+	ColorByText.Reset();
+}
+
+FGISFeatureHandle FGISFeatureStore::Find(const FString& ID) const
+{
+	// 只查找不注册，未知的 ID 不会进入名称表
+	return Find(FName(*ID, FNAME_Find));
+}
+
+FGISFeatureHandle FGISFeatureStore::Find(FName ID) const
+{
+	const int32* Index = HandleByID.Find(ID);
+	return Index ? MakeHandle(*Index) : FGISFeatureHandle();
+}
+
+bool FGISFeatureStore::IsValid(FGISFeatureHandle Handle) const
+{
+	return Serials.IsValidIndex(Handle.Index) && Alive[Handle.Index] && Serials[Handle.Index] == Handle.Serial;
+}
+
+int32 FGISFeatureStore::InternTag(const FString& Tag)
+{
+	if (Tag.IsEmpty())
+	{
+		return 0;
+	}
+	if (const int32* Found = TagByName.Find(Tag))
+	{
+		return *Found;
+	}
+	const int32 TagIndex = Tags.Add(Tag);
+	TagByName.Add(Tag, TagIndex);
+	return TagIndex;
+}
+
+int32 FGISFeatureStore::InternColor(const FString& Text)
+{
+	if (const int32* Found = ColorByText.Find(Text))
+	{
+		return *Found;
+	}
+	const int32 ColorIndex = ColorTexts.Add(Text);
+	ColorValues.Add(ParseColor(Text));
+	ColorByText.Add(Text, ColorIndex);
+	return ColorIndex;
+}
+
+FName FGISFeatureStore::GetIDName(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? IDs[Handle.Index] : NAME_None;
+}
+
+FString FGISFeatureStore::GetID(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? IDs[Handle.Index].ToString() : FString();
+}
+
+const FString& FGISFeatureStore::GetName(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? Names[Handle.Index] : FString::GetEmpty();
+}
+
+EGISFeatureType FGISFeatureStore::GetType(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? Types[Handle.Index] : EGISFeatureType::Custom;
+}
+
+FString FGISFeatureStore::GetParentID(FGISFeatureHandle Handle) const
+{
+	// 页面以 "None" 表示没有父级，与 NAME_None 的文本一致
+	return IsValid(Handle) ? ParentIDs[Handle.Index].ToString() : FString();
+}
+
+const FString& FGISFeatureStore::GetTag(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? Tags[TagIndices[Handle.Index]] : FString::GetEmpty();
+}
+
+FColor FGISFeatureStore::GetFillColor(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? ColorValues[FillColorIndices[Handle.Index]] : FColor::White;
+}
+
+FColor FGISFeatureStore::GetTextColor(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? ColorValues[TextColorIndices[Handle.Index]] : FColor::White;
+}
+
+const FString& FGISFeatureStore::GetFillColorText(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? ColorTexts[FillColorIndices[Handle.Index]] : FString::GetEmpty();
+}
+
+const FString& FGISFeatureStore::GetTextColorText(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? ColorTexts[TextColorIndices[Handle.Index]] : FString::GetEmpty();
+}
+
+float FGISFeatureStore::GetOpacity(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? Opacities[Handle.Index] : 1.0f;
+}
+
+float FGISFeatureStore::GetHeight(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? Heights[Handle.Index] : 0.0f;
+}
+
+FBox2D FGISFeatureStore::GetBounds(FGISFeatureHandle Handle) const
+{
+	return IsValid(Handle) ? Bounds[Handle.Index] : FBox2D(ForceInit);
+}
+
+void FGISFeatureStore::SetName(FGISFeatureHandle Handle, const FString& Name)
+{
+	if (IsValid(Handle))
+	{
+		Names[Handle.Index] = Name;
+	}
+}
+
+void FGISFeatureStore::SetStyle(FGISFeatureHandle Handle, const FString& FillColor, float Opacity, const FString& TextColor)
+{
+	if (IsValid(Handle))
+	{
+		FillColorIndices[Handle.Index] = InternColor(FillColor);
+		Opacities[Handle.Index] = Opacity;
+		TextColorIndices[Handle.Index] = InternColor(TextColor);
+	}
+}
+
+void FGISFeatureStore::SetParentID(FGISFeatureHandle Handle, const FString& ParentID)
+{
+	if (IsValid(Handle))
+	{
+		ParentIDs[Handle.Index] = FName(*ParentID);
+	}
+}
+
+void FGISFeatureStore::SetBounds(FGISFeatureHandle Handle, const FBox2D& InBounds)
+{
+	if (IsValid(Handle))
+	{
+		Bounds[Handle.Index] = InBounds;
+	}
+}
+
+void FGISFeatureStore::Unlink(int32 Index)
+{
+	const int32 ParentIndex = Parents[Index];
+	if (ParentIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	TArray<int32>& Siblings = Children[ParentIndex];
+	const int32 Last = Siblings.Last();
+	Siblings.RemoveAtSwap(IndexInParent[Index], 1, EAllowShrinking::No);
+	if (Last != Index)
+	{
+		IndexInParent[Last] = IndexInParent[Index];
+	}
+	Parents[Index] = INDEX_NONE;
+	IndexInParent[Index] = INDEX_NONE;
+}
+
+bool FGISFeatureStore::SetParent(FGISFeatureHandle Child, FGISFeatureHandle Parent)
+{
+	if (!IsValid(Child))
+	{
+		return false;
+	}
+
+	const int32 ParentIndex = IsValid(Parent) ? Parent.Index : INDEX_NONE;
+
+	// 层级很浅，沿父链上溯即可判断是否成环
+	for (int32 Ancestor = ParentIndex; Ancestor != INDEX_NONE; Ancestor = Parents[Ancestor])
+	{
+		if (Ancestor == Child.Index)
+		{
+			return false;
+		}
+	}
+
+	if (Parents[Child.Index] == ParentIndex)
+	{
+		return true;
+	}
+
+	Unlink(Child.Index);
+	if (ParentIndex != INDEX_NONE)
+	{
+		Parents[Child.Index] = ParentIndex;
+		IndexInParent[Child.Index] = Children[ParentIndex].Add(Child.Index);
+	}
+	return true;
+}
+
+FGISFeatureHandle FGISFeatureStore::GetParent(FGISFeatureHandle Handle) const
+{
+	if (!IsValid(Handle) || Parents[Handle.Index] == INDEX_NONE)
+	{
+		return FGISFeatureHandle();
+	}
+	return MakeHandle(Parents[Handle.Index]);
+}
+
+void FGISFeatureStore::GetChildren(FGISFeatureHandle Handle, TArray<FGISFeatureHandle>& OutChildren) const
+{
+	if (!IsValid(Handle))
+	{
+		return;
+	}
+	const TArray<int32>& ChildIndices = Children[Handle.Index];
+	OutChildren.Reserve(OutChildren.Num() + ChildIndices.Num());
+	for (const int32 ChildIndex : ChildIndices)
+	{
+		OutChildren.Add(MakeHandle(ChildIndex));
+	}
+}
+
+int32 FGISFeatureStore::NumOfType(EGISFeatureType Type) const
+{
+	return MembersByType[static_cast<int32>(Type)].Num();
+}
+
+bool FGISFeatureStore::QueryType(EGISFeatureType Type, const FString& Filter, int32 Offset, int32 Count, TArray<FGISFeatureHandle>& OutFeatures) const
+{
+	int32 Skipped = 0;
+	for (const int32 Index : MembersByType[static_cast<int32>(Type)])
+	{
+		if (!Filter.IsEmpty() && !Names[Index].Contains(Filter) && !IDs[Index].ToString().Contains(Filter))
+		{
+			continue;
+		}
+		if (Skipped < Offset)
+		{
+			++Skipped;
+			continue;
+		}
+		if (Count <= 0)
+		{
+			return true;
+		}
+		OutFeatures.Add(MakeHandle(Index));
+		--Count;
+	}
+	return false;
+}
+
+FColor FGISFeatureStore::ParseColor(const FString& Text)
+{
+	const FString Color = Text.TrimStartAndEnd().ToLower();
+
+	if (Color.StartsWith(TEXT("#")))
+	{
+		const FString Hex = Color.RightChop(1);
+		for (const TCHAR Char : Hex)
+		{
+			if (!FChar::IsHexDigit(Char))
+			{
+				return FColor::White;
+			}
+		}
+		// FromHex 支持 rgb / rgba / rrggbb / rrggbbaa
+		const int32 Len = Hex.Len();
+		return Len == 3 || Len == 4 || Len == 6 || Len == 8 ? FColor::FromHex(Hex) : FColor::White;
+	}
+
+	if (Color.StartsWith(TEXT("rgb")))
+	{
+		int32 Open = INDEX_NONE;
+		int32 Close = INDEX_NONE;
+		if (Color.FindChar(TEXT('('), Open) && Color.FindLastChar(TEXT(')'), Close) && Close > Open)
+		{
+			TArray<FString> Parts;
+			Color.Mid(Open + 1, Close - Open - 1).ParseIntoArray(Parts, TEXT(","));
+			if (Parts.Num() >= 3)
+			{
+				auto Channel = [](const FString& Part)
+				{
+					const FString Value = Part.TrimStartAndEnd();
+					const float Number = FCString::Atof(*Value);
+					return static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Value.EndsWith(TEXT("%")) ? Number * 2.55f : Number), 0, 255));
+				};
+				const uint8 Alpha = Parts.Num() > 3 ? static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(FCString::Atof(*Parts[3]) * 255.0f), 0, 255)) : 255;
+				return FColor(Channel(Parts[0]), Channel(Parts[1]), Channel(Parts[2]), Alpha);
+			}
+		}
+		return FColor::White;
+	}
+
+	// CSS 颜色名 (页面的分析结果等直接使用 "yellow" 之类的名称)
+	static const TMap<FString, uint32> NamedColors = []()
+	{
+		struct FNamedColor
+		{
+			const TCHAR* Name;
+			uint32 Rgb;
+		};
+		static const FNamedColor Table[] = {
+			{ TEXT("aliceblue"), 0xf0f8ff }, { TEXT("antiquewhite"), 0xfaebd7 }, { TEXT("aqua"), 0x00ffff }, { TEXT("aquamarine"), 0x7fffd4 },
+			{ TEXT("azure"), 0xf0ffff }, { TEXT("beige"), 0xf5f5dc }, { TEXT("bisque"), 0xffe4c4 }, { TEXT("black"), 0x000000 },
+			{ TEXT("blanchedalmond"), 0xffebcd }, { TEXT("blue"), 0x0000ff }, { TEXT("blueviolet"), 0x8a2be2 }, { TEXT("brown"), 0xa52a2a },
+			{ TEXT("burlywood"), 0xdeb887 }, { TEXT("cadetblue"), 0x5f9ea0 }, { TEXT("chartreuse"), 0x7fff00 }, { TEXT("chocolate"), 0xd2691e },
+			{ TEXT("coral"), 0xff7f50 }, { TEXT("cornflowerblue"), 0x6495ed }, { TEXT("cornsilk"), 0xfff8dc }, { TEXT("crimson"), 0xdc143c },
+			{ TEXT("cyan"), 0x00ffff }, { TEXT("darkblue"), 0x00008b }, { TEXT("darkcyan"), 0x008b8b }, { TEXT("darkgoldenrod"), 0xb8860b },
+			{ TEXT("darkgray"), 0xa9a9a9 }, { TEXT("darkgreen"), 0x006400 }, { TEXT("darkgrey"), 0xa9a9a9 }, { TEXT("darkkhaki"), 0xbdb76b },
+			{ TEXT("darkmagenta"), 0x8b008b }, { TEXT("darkolivegreen"), 0x556b2f }, { TEXT("darkorange"), 0xff8c00 }, { TEXT("darkorchid"), 0x9932cc },
+			{ TEXT("darkred"), 0x8b0000 }, { TEXT("darksalmon"), 0xe9967a }, { TEXT("darkseagreen"), 0x8fbc8f }, { TEXT("darkslateblue"), 0x483d8b },
+			{ TEXT("darkslategray"), 0x2f4f4f }, { TEXT("darkslategrey"), 0x2f4f4f }, { TEXT("darkturquoise"), 0x00ced1 }, { TEXT("darkviolet"), 0x9400d3 },
+			{ TEXT("deeppink"), 0xff1493 }, { TEXT("deepskyblue"), 0x00bfff }, { TEXT("dimgray"), 0x696969 }, { TEXT("dimgrey"), 0x696969 },
+			{ TEXT("dodgerblue"), 0x1e90ff }, { TEXT("firebrick"), 0xb22222 }, { TEXT("floralwhite"), 0xfffaf0 }, { TEXT("forestgreen"), 0x228b22 },
+			{ TEXT("fuchsia"), 0xff00ff }, { TEXT("gainsboro"), 0xdcdcdc }, { TEXT("ghostwhite"), 0xf8f8ff }, { TEXT("gold"), 0xffd700 },
+			{ TEXT("goldenrod"), 0xdaa520 }, { TEXT("gray"), 0x808080 }, { TEXT("green"), 0x008000 }, { TEXT("greenyellow"), 0xadff2f },
+			{ TEXT("grey"), 0x808080 }, { TEXT("honeydew"), 0xf0fff0 }, { TEXT("hotpink"), 0xff69b4 }, { TEXT("indianred"), 0xcd5c5c },
+			{ TEXT("indigo"), 0x4b0082 }, { TEXT("ivory"), 0xfffff0 }, { TEXT("khaki"), 0xf0e68c }, { TEXT("lavender"), 0xe6e6fa },
+			{ TEXT("lavenderblush"), 0xfff0f5 }, { TEXT("lawngreen"), 0x7cfc00 }, { TEXT("lemonchiffon"), 0xfffacd }, { TEXT("lightblue"), 0xadd8e6 },
+			{ TEXT("lightcoral"), 0xf08080 }, { TEXT("lightcyan"), 0xe0ffff }, { TEXT("lightgoldenrodyellow"), 0xfafad2 }, { TEXT("lightgray"), 0xd3d3d3 },
+			{ TEXT("lightgreen"), 0x90ee90 }, { TEXT("lightgrey"), 0xd3d3d3 }, { TEXT("lightpink"), 0xffb6c1 }, { TEXT("lightsalmon"), 0xffa07a },
+			{ TEXT("lightseagreen"), 0x20b2aa }, { TEXT("lightskyblue"), 0x87cefa }, { TEXT("lightslategray"), 0x778899 }, { TEXT("lightslategrey"), 0x778899 },
+			{ TEXT("lightsteelblue"), 0xb0c4de }, { TEXT("lightyellow"), 0xffffe0 }, { TEXT("lime"), 0x00ff00 }, { TEXT("limegreen"), 0x32cd32 },
+			{ TEXT("linen"), 0xfaf0e6 }, { TEXT("magenta"), 0xff00ff }, { TEXT("maroon"), 0x800000 }, { TEXT("mediumaquamarine"), 0x66cdaa },
+			{ TEXT("mediumblue"), 0x0000cd }, { TEXT("mediumorchid"), 0xba55d3 }, { TEXT("mediumpurple"), 0x9370db }, { TEXT("mediumseagreen"), 0x3cb371 },
+			{ TEXT("mediumslateblue"), 0x7b68ee }, { TEXT("mediumspringgreen"), 0x00fa9a }, { TEXT("mediumturquoise"), 0x48d1cc }, { TEXT("mediumvioletred"), 0xc71585 },
+			{ TEXT("midnightblue"), 0x191970 }, { TEXT("mintcream"), 0xf5fffa }, { TEXT("mistyrose"), 0xffe4e1 }, { TEXT("moccasin"), 0xffe4b5 },
+			{ TEXT("navajowhite"), 0xffdead }, { TEXT("navy"), 0x000080 }, { TEXT("oldlace"), 0xfdf5e6 }, { TEXT("olive"), 0x808000 },
+			{ TEXT("olivedrab"), 0x6b8e23 }, { TEXT("orange"), 0xffa500 }, { TEXT("orangered"), 0xff4500 }, { TEXT("orchid"), 0xda70d6 },
+			{ TEXT("palegoldenrod"), 0xeee8aa }, { TEXT("palegreen"), 0x98fb98 }, { TEXT("paleturquoise"), 0xafeeee }, { TEXT("palevioletred"), 0xdb7093 },
+			{ TEXT("papayawhip"), 0xffefd5 }, { TEXT("peachpuff"), 0xffdab9 }, { TEXT("peru"), 0xcd853f }, { TEXT("pink"), 0xffc0cb },
+			{ TEXT("plum"), 0xdda0dd }, { TEXT("powderblue"), 0xb0e0e6 }, { TEXT("purple"), 0x800080 }, { TEXT("rebeccapurple"), 0x663399 },
+			{ TEXT("red"), 0xff0000 }, { TEXT("rosybrown"), 0xbc8f8f }, { TEXT("royalblue"), 0x4169e1 }, { TEXT("saddlebrown"), 0x8b4513 },
+			{ TEXT("salmon"), 0xfa8072 }, { TEXT("sandybrown"), 0xf4a460 }, { TEXT("seagreen"), 0x2e8b57 }, { TEXT("seashell"), 0xfff5ee },
+			{ TEXT("sienna"), 0xa0522d }, { TEXT("silver"), 0xc0c0c0 }, { TEXT("skyblue"), 0x87ceeb }, { TEXT("slateblue"), 0x6a5acd },
+			{ TEXT("slategray"), 0x708090 }, { TEXT("slategrey"), 0x708090 }, { TEXT("snow"), 0xfffafa }, { TEXT("springgreen"), 0x00ff7f },
+			{ TEXT("steelblue"), 0x4682b4 }, { TEXT("tan"), 0xd2b48c }, { TEXT("teal"), 0x008080 }, { TEXT("thistle"), 0xd8bfd8 },
+			{ TEXT("tomato"), 0xff6347 }, { TEXT("turquoise"), 0x40e0d0 }, { TEXT("violet"), 0xee82ee }, { TEXT("wheat"), 0xf5deb3 },
+			{ TEXT("white"), 0xffffff }, { TEXT("whitesmoke"), 0xf5f5f5 }, { TEXT("yellow"), 0xffff00 }, { TEXT("yellowgreen"), 0x9acd32 }
+		};
+		TMap<FString, uint32> Map;
+		for (const FNamedColor& Entry : Table)
+		{
+			Map.Add(Entry.Name, Entry.Rgb);
+		}
+		return Map;
+	}();
+
+	if (const uint32* Rgb = NamedColors.Find(Color))
+	{
+		return FColor((*Rgb >> 16) & 0xff, (*Rgb >> 8) & 0xff, *Rgb & 0xff);
+	}
+	return FColor::White;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISFeatureStore.generated.h"
+
+// 要素类型 (页面 customType)
+UENUM(BlueprintType)
+enum class EGISFeatureType : uint8
+{
+	District,
+	Street,
+	Community,
+	Custom,
+	Road,
+	Reconstruct
+};
+
+namespace GISFeatureType
+{
+	// 页面中的类型名；无法识别的按 Custom 处理
+	CITYGIS_API EGISFeatureType FromString(const FString& Name);
+	CITYGIS_API const TCHAR* ToString(EGISFeatureType Type);
+
+	// 列表中显示的中文名，如 "街道"
+	CITYGIS_API const TCHAR* GetDisplayName(EGISFeatureType Type);
+
+	// 可作为父级的类型：街道挂在区镇下，小区/自定义/道路挂在街道下；其余没有父级
+	CITYGIS_API bool GetParentType(EGISFeatureType Type, EGISFeatureType& OutParentType);
+}
+
+// 要素句柄：槽位下标 + 序号，要素删除后旧句柄失效，不会误指向复用该槽位的新要素
+struct FGISFeatureHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+	bool operator==(const FGISFeatureHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FGISFeatureHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * 要素属性与层级的列式存储 (C++ 侧的要素列表、体块、统计与评分都从这里读取属性)
+ * 页面上的覆盖物仍由网页自己的 appState.polygons 持有，两边通过要素 ID 对应
+ *
+ * 每个属性一列，按槽位下标对齐，删除的槽位回收复用；类型为枚举，
+ * ID 与父级 ID 驻留为 FName (页面的 "poly_N" 共用一个名称表条目，只存编号)，
+ * 颜色与标签 (区划代码) 驻留在各自的表中只存下标。颜色保留页面给出的原文 (如 "yellow")，
+ * 写回页面与撤销记录时原样使用，另存一份解析后的 FColor 供列表与体块着色。按类型或属性扫描时只触及对应的列。
+ * 几何本身以只读共享的形式由空间索引持有 (工作线程直接引用)，这里只保存包围盒。
+ *
+ * 层级 (区镇->街道->小区/道路) 也按槽位存放：父->子邻接表与按类型的成员表都记录节点在其中的下标，
+ * 挂接/摘除/删除都是交换删除，O(1)；兄弟顺序在摘除时可能改变。仅在游戏线程使用。
+ */
+class CITYGIS_API FGISFeatureStore
+{
+public:
+	struct FAttributes
+	{
+		FString Name;
+		EGISFeatureType Type = EGISFeatureType::Custom;
+		FString ParentID;
+		// 页面的 CSS 颜色原文
+		FString FillColor = TEXT("#ffffff");
+		float Opacity = 1.0f;
+		FString TextColor = TEXT("#ffffff");
+		FString Tag;
+		float Height = 0.0f;
+	};
+
+	// ID 已存在时返回原要素，属性不变
+	FGISFeatureHandle Add(const FString& ID, const FAttributes& Attributes);
+
+	// 删除要素，其子要素变为根并追加到 OutOrphans
+	void Remove(FGISFeatureHandle Handle, TArray<FGISFeatureHandle>* OutOrphans = nullptr);
+	void Reset();
+
+	int32 Num() const { return HandleByID.Num(); }
+	// ID 比较与 FName 一致，不区分大小写
+	FGISFeatureHandle Find(const FString& ID) const;
+	FGISFeatureHandle Find(FName ID) const;
+	bool IsValid(FGISFeatureHandle Handle) const;
+
+	// 列访问；句柄无效时返回空值
+	FName GetIDName(FGISFeatureHandle Handle) const;
+	FString GetID(FGISFeatureHandle Handle) const;
+	const FString& GetName(FGISFeatureHandle Handle) const;
+	EGISFeatureType GetType(FGISFeatureHandle Handle) const;
+	FString GetParentID(FGISFeatureHandle Handle) const;
+	const FString& GetTag(FGISFeatureHandle Handle) const;
+	FColor GetFillColor(FGISFeatureHandle Handle) const;
+	FColor GetTextColor(FGISFeatureHandle Handle) const;
+	const FString& GetFillColorText(FGISFeatureHandle Handle) const;
+	const FString& GetTextColorText(FGISFeatureHandle Handle) const;
+	float GetOpacity(FGISFeatureHandle Handle) const;
+	float GetHeight(FGISFeatureHandle Handle) const;
+	FBox2D GetBounds(FGISFeatureHandle Handle) const;
+
+	void SetName(FGISFeatureHandle Handle, const FString& Name);
+	void SetStyle(FGISFeatureHandle Handle, const FString& FillColor, float Opacity, const FString& TextColor);
+	void SetParentID(FGISFeatureHandle Handle, const FString& ParentID);
+	void SetBounds(FGISFeatureHandle Handle, const FBox2D& Bounds);
+
+	// 层级：Parent 无效时变为根；会形成环时拒绝并返回 false
+	bool SetParent(FGISFeatureHandle Child, FGISFeatureHandle Parent);
+	FGISFeatureHandle GetParent(FGISFeatureHandle Handle) const;
+	void GetChildren(FGISFeatureHandle Handle, TArray<FGISFeatureHandle>& OutChildren) const;
+
+	int32 NumOfType(EGISFeatureType Type) const;
+
+	// 该类型中名称或 ID 包含 Filter (不区分大小写，空为全部) 的要素，跳过前 Offset 个，最多 Count 个
+	// 返回后面是否还有更多匹配
+	bool QueryType(EGISFeatureType Type, const FString& Filter, int32 Offset, int32 Count, TArray<FGISFeatureHandle>& OutFeatures) const;
+
+	// CSS 颜色：#rgb / #rrggbb / #rrggbbaa、rgb()/rgba() 与颜色名；无法识别时为白色
+	static FColor ParseColor(const FString& Text);
+
+private:
+	static constexpr int32 NumTypes = static_cast<int32>(EGISFeatureType::Reconstruct) + 1;
+
+	FGISFeatureHandle MakeHandle(int32 Index) const { return { Index, Serials[Index] }; }
+	int32 InternTag(const FString& Tag);
+	int32 InternColor(const FString& Text);
+	void Unlink(int32 Index);
+
+	// 属性列
+	TArray<FName> IDs;
+	TArray<FString> Names;
+	TArray<EGISFeatureType> Types;
+	TArray<FName> ParentIDs;
+	TArray<int32> FillColorIndices;
+	TArray<int32> TextColorIndices;
+	TArray<float> Opacities;
+	TArray<float> Heights;
+	TArray<int32> TagIndices;
+	TArray<FBox2D> Bounds;
+
+	// 槽位
+	TArray<uint32> Serials;
+	TBitArray<> Alive;
+	TArray<int32> FreeSlots;
+	TMap<FName, int32> HandleByID;
+
+	// 标签表，下标 0 为空标签
+	TArray<FString> Tags = { FString() };
+	TMap<FString, int32> TagByName;
+
+	// 颜色表：原文与解析结果，下标对齐
+	TArray<FString> ColorTexts;
+	TArray<FColor> ColorValues;
+	TMap<FString, int32> ColorByText;
+
+	// 层级列
+	TArray<int32> Parents;
+	TArray<TArray<int32>> Children;
+	TArray<int32> IndexInParent;
+	TArray<int32> IndexInType;
+	TArray<int32> MembersByType[NumTypes];
+};
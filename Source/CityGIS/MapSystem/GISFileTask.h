@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISBinarySave.h"
+#include <atomic>
+
+enum class EGISFileTaskType : uint8
+{
+	Save,
+	Load
+};
+
+/**
+ * 后台存档读写任务的共享状态
+ * 工作线程写进度并检查取消标记，游戏线程在 Tick 中轮询进度并广播
+ */
+class FGISFileTask
+{
+public:
+	explicit FGISFileTask(EGISFileTaskType InType)
+		: Type(InType)
+	{
+	}
+
+	const EGISFileTaskType Type;
+
+	void Cancel()
+	{
+		bCancelled = true;
+	}
+
+	bool IsCancelled() const
+	{
+		return bCancelled;
+	}
+
+	float GetProgress() const
+	{
+		return Progress;
+	}
+
+	// 返回 false 表示已取消，工作线程应尽快退出
+	bool ReportProgress(float Value)
+	{
+		Progress = FMath::Clamp(Value, 0.0f, 1.0f);
+		return !bCancelled;
+	}
+
+	// 任务对象由工作线程的闭包持有，回调期间一定存活
+	FGISSaveProgress MakeProgressCallback()
+	{
+		return [this](float Value)
+		{
+			return ReportProgress(Value);
+		};
+	}
+
+private:
+	std::atomic<bool> bCancelled { false };
+	std::atomic<float> Progress { 0.0f };
+};
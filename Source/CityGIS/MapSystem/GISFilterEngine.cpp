@@ -0,0 +1,279 @@
+#include "GISFilterEngine.h"
+
+void FGISFilterEngine::SetBit(TBitArray<>& Bits, int32 Index, bool bValue)
+{
+	if (Index >= Bits.Num())
+	{
+		if (!bValue)
+		{
+			return;
+		}
+		Bits.SetNum(Index + 1, false);
+	}
+	Bits[Index] = bValue;
+}
+
+int32 FGISFilterEngine::FindOrAddKey(const FString& Name)
+{
+	if (const int32* Found = KeyByName.Find(Name))
+	{
+		return *Found;
+	}
+	const int32 KeyIndex = Keys.AddDefaulted();
+	Keys[KeyIndex].Name = Name;
+	KeyByName.Add(Name, KeyIndex);
+	return KeyIndex;
+}
+
+void FGISFilterEngine::SetFeature(const FString& ID, const TArray<FString>& FeatureKeys)
+{
+	int32 Slot = INDEX_NONE;
+	if (const int32* Found = SlotByID.Find(ID))
+	{
+		Slot = *Found;
+		for (const int32 KeyIndex : SlotKeys[Slot])
+		{
+			SetBit(Keys[KeyIndex].Members, Slot, false);
+		}
+		SlotKeys[Slot].Reset();
+	}
+	else
+	{
+		if (FreeSlots.Num() > 0)
+		{
+			Slot = FreeSlots.Pop(EAllowShrinking::No);
+			SlotIDs[Slot] = ID;
+		}
+		else
+		{
+			Slot = SlotIDs.Add(ID);
+			SlotKeys.AddDefaulted();
+			Alive.Add(false);
+			Published.Add(true);
+			ChangedFlag.Add(false);
+		}
+		SlotByID.Add(ID, Slot);
+		Alive[Slot] = true;
+		Published[Slot] = true;
+		EvaluatePredicates(Slot);
+	}
+
+	for (const FString& Key : FeatureKeys)
+	{
+		if (!Key.IsEmpty())
+		{
+			const int32 KeyIndex = FindOrAddKey(Key);
+			SlotKeys[Slot].AddUnique(KeyIndex);
+			SetBit(Keys[KeyIndex].Members, Slot, true);
+		}
+	}
+	MarkChanged(Slot);
+}
+
+void FGISFilterEngine::RemoveFeature(const FString& ID)
+{
+	int32 Slot = INDEX_NONE;
+	if (!SlotByID.RemoveAndCopyValue(ID, Slot))
+	{
+		return;
+	}
+
+	// 覆盖物随要素一起删除，不需要下发；ChangedFlag 中的残留在 ConsumeChanges 时跳过
+	for (const int32 KeyIndex : SlotKeys[Slot])
+	{
+		SetBit(Keys[KeyIndex].Members, Slot, false);
+	}
+	SlotKeys[Slot].Reset();
+	SlotIDs[Slot].Reset();
+	Alive[Slot] = false;
+	FreeSlots.Add(Slot);
+}
+
+void FGISFilterEngine::Reset()
+{
+	SlotIDs.Reset();
+	SlotKeys.Reset();
+	SlotByID.Reset();
+	FreeSlots.Reset();
+	Alive.Empty();
+	Published.Empty();
+	Changed.Reset();
+	ChangedFlag.Empty();
+	for (FKey& Key : Keys)
+	{
+		Key.Members.Empty();
+	}
+	for (FPredicate& Predicate : Predicates)
+	{
+		Predicate.Passed.Empty();
+	}
+}
+
+void FGISFilterEngine::SetKeyActive(const FString& Key, bool bActive)
+{
+	if (Key.IsEmpty())
+	{
+		return;
+	}
+	FKey& Entry = Keys[FindOrAddKey(Key)];
+	if (Entry.bActive != bActive)
+	{
+		Entry.bActive = bActive;
+		MarkMembersChanged(Entry.Members);
+	}
+}
+
+void FGISFilterEngine::SetAllKeysActive(bool bActive)
+{
+	for (FKey& Entry : Keys)
+	{
+		if (Entry.bActive != bActive)
+		{
+			Entry.bActive = bActive;
+			MarkMembersChanged(Entry.Members);
+		}
+	}
+}
+
+bool FGISFilterEngine::IsKeyActive(const FString& Key) const
+{
+	const int32* Found = KeyByName.Find(Key);
+	return Found && Keys[*Found].bActive;
+}
+
+TArray<FString> FGISFilterEngine::GetActiveKeys() const
+{
+	TArray<FString> Result;
+	for (const FKey& Entry : Keys)
+	{
+		if (Entry.bActive)
+		{
+			Result.Add(Entry.Name);
+		}
+	}
+	return Result;
+}
+
+void FGISFilterEngine::SetPredicate(FName Name, TFunction<bool(const FString& ID)> Test)
+{
+	FPredicate* Predicate = Predicates.FindByPredicate([Name](const FPredicate& Existing) { return Existing.Name == Name; });
+	const bool bNew = Predicate == nullptr;
+	if (bNew)
+	{
+		Predicate = &Predicates.AddDefaulted_GetRef();
+		Predicate->Name = Name;
+	}
+	Predicate->Test = MoveTemp(Test);
+
+	// 谓词本身变化只能整体求值一次，之后只有结果不同的要素进入比较
+	TBitArray<> Passed(false, SlotIDs.Num());
+	for (TConstSetBitIterator<> It(Alive); It; ++It)
+	{
+		const int32 Slot = It.GetIndex();
+		Passed[Slot] = Predicate->Test(SlotIDs[Slot]);
+		if (bNew ? !Passed[Slot] : Passed[Slot] != GetBit(Predicate->Passed, Slot))
+		{
+			MarkChanged(Slot);
+		}
+	}
+	Predicate->Passed = MoveTemp(Passed);
+}
+
+void FGISFilterEngine::ClearPredicate(FName Name)
+{
+	const int32 Index = Predicates.IndexOfByPredicate([Name](const FPredicate& Existing) { return Existing.Name == Name; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const TBitArray<>& Passed = Predicates[Index].Passed;
+	for (TConstSetBitIterator<> It(Alive); It; ++It)
+	{
+		if (!GetBit(Passed, It.GetIndex()))
+		{
+			MarkChanged(It.GetIndex());
+		}
+	}
+	Predicates.RemoveAt(Index);
+}
+
+void FGISFilterEngine::EvaluatePredicates(int32 Slot)
+{
+	for (FPredicate& Predicate : Predicates)
+	{
+		SetBit(Predicate.Passed, Slot, Predicate.Test(SlotIDs[Slot]));
+	}
+}
+
+bool FGISFilterEngine::IsVisible(const FString& ID) const
+{
+	const int32* Slot = SlotByID.Find(ID);
+	return Slot && ComputeVisible(*Slot);
+}
+
+bool FGISFilterEngine::ComputeVisible(int32 Slot) const
+{
+	for (const FPredicate& Predicate : Predicates)
+	{
+		if (!GetBit(Predicate.Passed, Slot))
+		{
+			return false;
+		}
+	}
+	for (const int32 KeyIndex : SlotKeys[Slot])
+	{
+		if (Keys[KeyIndex].bActive)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FGISFilterEngine::MarkChanged(int32 Slot)
+{
+	if (!ChangedFlag[Slot])
+	{
+		ChangedFlag[Slot] = true;
+		Changed.Add(Slot);
+	}
+}
+
+void FGISFilterEngine::MarkMembersChanged(const TBitArray<>& Members)
+{
+	for (TConstSetBitIterator<> It(Members); It; ++It)
+	{
+		MarkChanged(It.GetIndex());
+	}
+}
+
+void FGISFilterEngine::ResetPublished()
+{
+	for (TConstSetBitIterator<> It(Alive); It; ++It)
+	{
+		Published[It.GetIndex()] = true;
+		MarkChanged(It.GetIndex());
+	}
+}
+
+void FGISFilterEngine::ConsumeChanges(TArray<FString>& OutShown, TArray<FString>& OutHidden)
+{
+	OutShown.Reset();
+	OutHidden.Reset();
+	for (const int32 Slot : Changed)
+	{
+		ChangedFlag[Slot] = false;
+		if (!Alive[Slot])
+		{
+			continue;
+		}
+		const bool bVisible = ComputeVisible(Slot);
+		if (bVisible != Published[Slot])
+		{
+			Published[Slot] = bVisible;
+			(bVisible ? OutShown : OutHidden).Add(SlotIDs[Slot]);
+		}
+	}
+	Changed.Reset();
+}
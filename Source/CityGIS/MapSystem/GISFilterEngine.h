@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 要素显示筛选 (类型、标签/区划代码及属性谓词)
+ *
+ * 每个筛选键 (类型名或标签) 一个成员位集，要素可见 = 所属键中任一处于启用状态，且通过全部属性谓词。
+ * 切换一个键只把该键的成员标记为待定，ConsumeChanges 时再与已下发给页面的状态比较，
+ * 只输出可见性真正翻转的要素；开关一个区的代价与该区的要素数成正比，与总数无关。
+ *
+ * 键的启用状态与要素无关，清空要素后保留 (与页面筛选面板一致)。仅在游戏线程使用。
+ */
+class CITYGIS_API FGISFilterEngine
+{
+public:
+	// 加入或更新要素所属的筛选键 (空键忽略)；页面新建的覆盖物默认显示，按可见处理
+	void SetFeature(const FString& ID, const TArray<FString>& FeatureKeys);
+	void RemoveFeature(const FString& ID);
+
+	// 清空要素 (保留键的启用状态与谓词)
+	void Reset();
+
+	void SetKeyActive(const FString& Key, bool bActive);
+	void SetAllKeysActive(bool bActive);
+	bool IsKeyActive(const FString& Key) const;
+	TArray<FString> GetActiveKeys() const;
+
+	// 属性谓词：设置时对全部要素求值一次，之后只在要素加入时求值；同名替换
+	void SetPredicate(FName Name, TFunction<bool(const FString& ID)> Test);
+	void ClearPredicate(FName Name);
+
+	bool IsVisible(const FString& ID) const;
+
+	// 页面重新加载后所有覆盖物回到显示状态，全部要素重新比较
+	void ResetPublished();
+
+	bool HasChanges() const { return Changed.Num() > 0; }
+
+	// 自上次调用以来可见性翻转的要素，调用后视为已下发
+	void ConsumeChanges(TArray<FString>& OutShown, TArray<FString>& OutHidden);
+
+private:
+	struct FKey
+	{
+		FString Name;
+		TBitArray<> Members;
+		bool bActive = false;
+	};
+
+	struct FPredicate
+	{
+		FName Name;
+		TFunction<bool(const FString& ID)> Test;
+		TBitArray<> Passed;
+	};
+
+	int32 FindOrAddKey(const FString& Name);
+	void EvaluatePredicates(int32 Slot);
+	bool ComputeVisible(int32 Slot) const;
+	void MarkChanged(int32 Slot);
+	void MarkMembersChanged(const TBitArray<>& Members);
+
+	static void SetBit(TBitArray<>& Bits, int32 Index, bool bValue);
+	static bool GetBit(const TBitArray<>& Bits, int32 Index) { return Index < Bits.Num() && Bits[Index]; }
+
+	// 要素槽位，删除后回收；键与谓词的位集按需增长，比槽位数短的部分视为 0
+	TArray<FString> SlotIDs;
+	TArray<TArray<int32, TInlineAllocator<2>>> SlotKeys;
+	TMap<FString, int32> SlotByID;
+	TArray<int32> FreeSlots;
+	TBitArray<> Alive;
+
+	// 页面当前的显示状态
+	TBitArray<> Published;
+
+	TArray<FKey> Keys;
+	TMap<FString, int32> KeyByName;
+	TArray<FPredicate> Predicates;
+
+	// 待比较的槽位 (ChangedFlag 去重)
+	TArray<int32> Changed;
+	TBitArray<> ChangedFlag;
+};
@@ -0,0 +1,168 @@
+#include "GISGeoJson.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+namespace
+{
+	bool ParseRing(const TArray<TSharedPtr<FJsonValue>>& Points, FGISRing& OutRing)
+	{
+		OutRing.Reset(Points.Num());
+		for (const TSharedPtr<FJsonValue>& PointValue : Points)
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Coords = nullptr;
+			if (!PointValue.IsValid() || !PointValue->TryGetArray(Coords) || Coords->Num() < 2)
+			{
+				return false;
+			}
+			OutRing.Emplace((*Coords)[0]->AsNumber(), (*Coords)[1]->AsNumber());
+		}
+		return OutRing.Num() >= 3;
+	}
+
+	bool ParsePolygon(const TArray<TSharedPtr<FJsonValue>>& Rings, FGISPolygon& OutPolygon)
+	{
+		for (const TSharedPtr<FJsonValue>& RingValue : Rings)
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Points = nullptr;
+			if (!RingValue.IsValid() || !RingValue->TryGetArray(Points))
+			{
+				return false;
+			}
+
+			FGISRing Ring;
+			if (ParseRing(*Points, Ring))
+			{
+				OutPolygon.Rings.Add(MoveTemp(Ring));
+			}
+			else if (OutPolygon.Rings.Num() == 0)
+			{
+				// 外环无效则整个多边形无效，洞无效时直接丢弃
+				return false;
+			}
+		}
+		return OutPolygon.Rings.Num() > 0;
+	}
+
+	void AppendRing(FString& Out, const FGISRing& Ring)
+	{
+		Out += TEXT("[");
+		for (int32 Idx = 0; Idx < Ring.Num(); ++Idx)
+		{
+			Out.Appendf(TEXT("%s[%.9f,%.9f]"), Idx > 0 ? TEXT(",") : TEXT(""), Ring[Idx].X, Ring[Idx].Y);
+		}
+		Out += TEXT("]");
+	}
+
+	void AppendPolygon(FString& Out, const FGISPolygon& Polygon)
+	{
+		Out += TEXT("[");
+		for (int32 Idx = 0; Idx < Polygon.Rings.Num(); ++Idx)
+		{
+			if (Idx > 0)
+			{
+				Out += TEXT(",");
+			}
+			AppendRing(Out, Polygon.Rings[Idx]);
+		}
+		Out += TEXT("]");
+	}
+}
+
+bool GISGeoJson::ParseGeometry(const FString& Json, FGISMultiPolygon& OutGeometry)
+{
+	TSharedPtr<FJsonObject> Object;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+	if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+	{
+		return false;
+	}
+	return ParseGeometry(Object, OutGeometry);
+}
+
+bool GISGeoJson::ParseGeometry(const TSharedPtr<FJsonObject>& Object, FGISMultiPolygon& OutGeometry)
+{
+	OutGeometry.Reset();
+	if (!Object.IsValid())
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* GeometryObject = nullptr;
+	if (Object->TryGetObjectField(TEXT("geometry"), GeometryObject))
+	{
+		return ParseGeometry(*GeometryObject, OutGeometry);
+	}
+
+	FString Type;
+	const TArray<TSharedPtr<FJsonValue>>* Coordinates = nullptr;
+	if (!Object->TryGetStringField(TEXT("type"), Type) || !Object->TryGetArrayField(TEXT("coordinates"), Coordinates))
+	{
+		return false;
+	}
+
+	if (Type == TEXT("Polygon"))
+	{
+		FGISPolygon Polygon;
+		if (ParsePolygon(*Coordinates, Polygon))
+		{
+			OutGeometry.Add(MoveTemp(Polygon));
+		}
+	}
+	else if (Type == TEXT("MultiPolygon"))
+	{
+		for (const TSharedPtr<FJsonValue>& PolygonValue : *Coordinates)
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Rings = nullptr;
+			FGISPolygon Polygon;
+			if (PolygonValue.IsValid() && PolygonValue->TryGetArray(Rings) && ParsePolygon(*Rings, Polygon))
+			{
+				OutGeometry.Add(MoveTemp(Polygon));
+			}
+		}
+	}
+
+	GISGeometry::Normalize(OutGeometry);
+	return OutGeometry.Num() > 0;
+}
+
+FString GISGeoJson::WriteGeometry(const FGISMultiPolygon& Geometry)
+{
+	if (Geometry.Num() == 0)
+	{
+		return TEXT("null");
+	}
+
+	FString Out;
+	// 每个点约 30 个字符
+	Out.Reserve(GISGeometry::CountVertices(Geometry) * 30 + 64);
+
+	if (Geometry.Num() == 1)
+	{
+		Out += TEXT("{\"type\":\"Polygon\",\"coordinates\":");
+		AppendPolygon(Out, Geometry[0]);
+	}
+	else
+	{
+		Out += TEXT("{\"type\":\"MultiPolygon\",\"coordinates\":[");
+		for (int32 Idx = 0; Idx < Geometry.Num(); ++Idx)
+		{
+			if (Idx > 0)
+			{
+				Out += TEXT(",");
+			}
+			AppendPolygon(Out, Geometry[Idx]);
+		}
+		Out += TEXT("]");
+	}
+	Out += TEXT("}");
+	return Out;
+}
+
+FString GISGeoJson::WriteFeature(const FGISMultiPolygon& Geometry)
+{
+	if (Geometry.Num() == 0)
+	{
+		return TEXT("null");
+	}
+	return TEXT("{\"type\":\"Feature\",\"properties\":{},\"geometry\":") + WriteGeometry(Geometry) + TEXT("}");
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+class FJsonObject;
+
+/**
+ * GeoJSON 几何 <-> FGISMultiPolygon
+ * 只处理面 (Polygon / MultiPolygon)，线要素 (道路) 返回 false
+ */
+namespace GISGeoJson
+{
+	// 输入可以是 geometry 对象，也可以是带 geometry 字段的 Feature
+	CITYGIS_API bool ParseGeometry(const FString& Json, FGISMultiPolygon& OutGeometry);
+	CITYGIS_API bool ParseGeometry(const TSharedPtr<FJsonObject>& Object, FGISMultiPolygon& OutGeometry);
+
+	// 单部件写为 Polygon，多部件写为 MultiPolygon；空几何返回 "null"
+	CITYGIS_API FString WriteGeometry(const FGISMultiPolygon& Geometry);
+
+	// 包装为 { "type": "Feature", "properties": {}, "geometry": ... }，空几何返回 "null"
+	CITYGIS_API FString WriteFeature(const FGISMultiPolygon& Geometry);
+}
@@ -0,0 +1,137 @@
+#include "GISGeometry.h"
+#include "Algo/Reverse.h"
+
+double GISGeometry::SignedArea(const FGISRing& Ring)
+{
+	const int32 Num = Ring.Num();
+	if (Num < 3)
+	{
+		return 0.0;
+	}
+
+	double Sum = 0.0;
+	for (int32 i = 0, j = Num - 1; i < Num; j = i++)
+	{
+		Sum += (Ring[j].X - Ring[i].X) * (Ring[j].Y + Ring[i].Y);
+	}
+	return Sum * 0.5;
+}
+
+FBox2D GISGeometry::ComputeBounds(const FGISRing& Ring)
+{
+	FBox2D Bounds(ForceInit);
+	for (const FVector2D& Point : Ring)
+	{
+		Bounds += Point;
+	}
+	return Bounds;
+}
+
+FBox2D GISGeometry::ComputeBounds(const FGISMultiPolygon& Geometry)
+{
+	FBox2D Bounds(ForceInit);
+	for (const FGISPolygon& Polygon : Geometry)
+	{
+		// 外环已包含所有洞
+		if (Polygon.Rings.Num() > 0)
+		{
+			Bounds += ComputeBounds(Polygon.Rings[0]);
+		}
+	}
+	return Bounds;
+}
+
+int32 GISGeometry::CountVertices(const FGISMultiPolygon& Geometry)
+{
+	int32 Count = 0;
+	for (const FGISPolygon& Polygon : Geometry)
+	{
+		for (const FGISRing& Ring : Polygon.Rings)
+		{
+			Count += Ring.Num();
+		}
+	}
+	return Count;
+}
+
+void GISGeometry::Normalize(FGISMultiPolygon& Geometry)
+{
+	for (int32 PolyIdx = Geometry.Num() - 1; PolyIdx >= 0; --PolyIdx)
+	{
+		TArray<FGISRing>& Rings = Geometry[PolyIdx].Rings;
+		for (int32 RingIdx = Rings.Num() - 1; RingIdx >= 0; --RingIdx)
+		{
+			FGISRing& Ring = Rings[RingIdx];
+			if (Ring.Num() > 0 && Ring[0] != Ring.Last())
+			{
+				Ring.Add(Ring[0]);
+			}
+
+			if (Ring.Num() < 4)
+			{
+				Rings.RemoveAt(RingIdx);
+				continue;
+			}
+
+			const bool bOuter = RingIdx == 0;
+			const double Area = SignedArea(Ring);
+			if ((bOuter && Area < 0.0) || (!bOuter && Area > 0.0))
+			{
+				Algo::Reverse(Ring);
+			}
+		}
+
+		if (Rings.Num() == 0)
+		{
+			Geometry.RemoveAt(PolyIdx);
+		}
+	}
+}
+
+bool GISGeometry::IsPointInRing(const FGISRing& Ring, const FVector2D& Point)
+{
+	bool bInside = false;
+	const int32 Num = Ring.Num();
+	for (int32 i = 0, j = Num - 1; i < Num; j = i++)
+	{
+		const FVector2D& A = Ring[i];
+		const FVector2D& B = Ring[j];
+		if ((A.Y > Point.Y) != (B.Y > Point.Y))
+		{
+			const double CrossX = A.X + (Point.Y - A.Y) * (B.X - A.X) / (B.Y - A.Y);
+			if (Point.X < CrossX)
+			{
+				bInside = !bInside;
+			}
+		}
+	}
+	return bInside;
+}
+
+bool GISGeometry::IsPointInPolygon(const FGISPolygon& Polygon, const FVector2D& Point)
+{
+	if (Polygon.Rings.Num() == 0 || !IsPointInRing(Polygon.Rings[0], Point))
+	{
+		return false;
+	}
+	for (int32 HoleIdx = 1; HoleIdx < Polygon.Rings.Num(); ++HoleIdx)
+	{
+		if (IsPointInRing(Polygon.Rings[HoleIdx], Point))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GISGeometry::IsPointInGeometry(const FGISMultiPolygon& Geometry, const FVector2D& Point)
+{
+	for (const FGISPolygon& Polygon : Geometry)
+	{
+		if (IsPointInPolygon(Polygon, Point))
+		{
+			return true;
+		}
+	}
+	return false;
+}
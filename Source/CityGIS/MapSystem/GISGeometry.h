@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 环：经纬度点序列 (X = lng, Y = lat)，与 GeoJSON 一致首尾闭合
+using FGISRing = TArray<FVector2D>;
+
+// 多边形：Rings[0] 为外环，其余为洞
+struct FGISPolygon
+{
+	TArray<FGISRing> Rings;
+};
+
+// GeoJSON 的 Polygon 视为只有一个元素的 MultiPolygon
+using FGISMultiPolygon = TArray<FGISPolygon>;
+
+namespace GISGeometry
+{
+	// 鞋带公式，逆时针为正 (单位为平方度，仅用于方向/比较)
+	CITYGIS_API double SignedArea(const FGISRing& Ring);
+
+	CITYGIS_API FBox2D ComputeBounds(const FGISRing& Ring);
+	CITYGIS_API FBox2D ComputeBounds(const FGISMultiPolygon& Geometry);
+
+	CITYGIS_API int32 CountVertices(const FGISMultiPolygon& Geometry);
+
+	// 首尾闭合、外环逆时针、洞顺时针，并剔除点数不足的环
+	CITYGIS_API void Normalize(FGISMultiPolygon& Geometry);
+
+	// 射线法点在环内判断 (边界上的点结果不确定)
+	CITYGIS_API bool IsPointInRing(const FGISRing& Ring, const FVector2D& Point);
+	CITYGIS_API bool IsPointInPolygon(const FGISPolygon& Polygon, const FVector2D& Point);
+	CITYGIS_API bool IsPointInGeometry(const FGISMultiPolygon& Geometry, const FVector2D& Point);
+}
@@ -0,0 +1,324 @@
+#include "GISLineBuffer.h"
+#include "GISPolygonClipper.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+namespace
+{
+	constexpr double MetersPerDegree = 111320.0;
+
+	// 相邻两点距离小于此值 (米) 时视为重复点
+	constexpr double MinSegmentMeters = 1e-3;
+
+	// 圆弧最多分段数 (半圆)
+	constexpr int32 MaxArcSteps = 64;
+
+	const TCHAR* const JoinNames[] = { TEXT("round"), TEXT("miter"), TEXT("bevel") };
+	const TCHAR* const CapNames[] = { TEXT("round"), TEXT("flat"), TEXT("square") };
+
+	// 以首点为原点的等距投影 (米)，道路尺度内的变形可以忽略
+	struct FLocalFrame
+	{
+		FVector2D Origin;
+		double MetersPerLng;
+
+		explicit FLocalFrame(const FVector2D& InOrigin)
+			: Origin(InOrigin)
+			, MetersPerLng(MetersPerDegree * FMath::Max(FMath::Cos(FMath::DegreesToRadians(InOrigin.Y)), 0.01))
+		{
+		}
+
+		FVector2D ToLocal(const FVector2D& LngLat) const
+		{
+			return FVector2D((LngLat.X - Origin.X) * MetersPerLng, (LngLat.Y - Origin.Y) * MetersPerDegree);
+		}
+
+		FVector2D ToLngLat(const FVector2D& Local) const
+		{
+			return FVector2D(Origin.X + Local.X / MetersPerLng, Origin.Y + Local.Y / MetersPerDegree);
+		}
+	};
+
+	void AddPiece(TArray<FVector2D>&& Ring, TArray<FGISMultiPolygon>& Pieces)
+	{
+		Ring.Add(Ring[0]);
+		FGISPolygon& Polygon = Pieces.AddDefaulted_GetRef().AddDefaulted_GetRef();
+		Polygon.Rings.Add(MoveTemp(Ring));
+	}
+
+	// 以 Center 为圆心、从 From 扫过 Sweep 弧度到 To 的扇形，半径随之线性过渡 (段宽不同时)
+	// 两端直接用传入的角点，与线段矩形的角点逐位相同，求并时不留缝
+	void AddFan(const FVector2D& Center, const FVector2D& From, const FVector2D& To, double Sweep, TArray<FGISMultiPolygon>& Pieces)
+	{
+		const double R0 = (From - Center).Size();
+		const double R1 = (To - Center).Size();
+		const double Radius = FMath::Max(R0, R1);
+		int32 Steps = 1;
+		if (Radius > GISLineBuffer::ArcToleranceMeters)
+		{
+			const double StepAngle = 2.0 * FMath::Acos(1.0 - GISLineBuffer::ArcToleranceMeters / Radius);
+			Steps = FMath::Clamp(FMath::CeilToInt(FMath::Abs(Sweep) / StepAngle), 1, MaxArcSteps);
+		}
+
+		const double StartAngle = FMath::Atan2(From.Y - Center.Y, From.X - Center.X);
+		TArray<FVector2D> Ring;
+		Ring.Reserve(Steps + 3);
+		Ring.Add(Center);
+		Ring.Add(From);
+		for (int32 Step = 1; Step < Steps; ++Step)
+		{
+			const double T = static_cast<double>(Step) / Steps;
+			const double Angle = StartAngle + Sweep * T;
+			Ring.Add(Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * FMath::Lerp(R0, R1, T));
+		}
+		Ring.Add(To);
+		AddPiece(MoveTemp(Ring), Pieces);
+	}
+
+	struct FSegment
+	{
+		FVector2D Start;
+		FVector2D End;
+		FVector2D Dir;
+		// 左侧法向乘以半宽
+		FVector2D Offset;
+		double HalfWidth;
+	};
+
+	// 段 A 与段 B 在拐点 (A.End == B.Start) 外侧的连接
+	void AddJoin(const FSegment& A, const FSegment& B, EGISLineJoin Join, TArray<FGISMultiPolygon>& Pieces)
+	{
+		const FVector2D& Point = B.Start;
+		const double Cross = FVector2D::CrossProduct(A.Dir, B.Dir);
+		const double Dot = FVector2D::DotProduct(A.Dir, B.Dir);
+		const bool bReverse = Dot < 0.0 && FMath::Abs(Cross) < UE_DOUBLE_KINDA_SMALL_NUMBER;
+		if (Dot > 0.0 && FMath::Abs(Cross) < UE_DOUBLE_KINDA_SMALL_NUMBER)
+		{
+			// 共线：两段矩形已相接
+			return;
+		}
+
+		// 左转时外侧在右 (角点取 -Offset)，扇形逆时针扫过；右转 (及原路折返) 时外侧在左，顺时针扫过
+		const bool bLeftTurn = Cross > 0.0;
+		const FVector2D From = bLeftTurn ? Point - A.Offset : Point + A.Offset;
+		const FVector2D To = bLeftTurn ? Point - B.Offset : Point + B.Offset;
+		const double Turn = FMath::Atan2(Cross, Dot);
+		const double Sweep = bLeftTurn ? Turn : -FMath::Abs(Turn);
+
+		if (Join == EGISLineJoin::Round)
+		{
+			AddFan(Point, From, To, Sweep, Pieces);
+			return;
+		}
+		if (bReverse)
+		{
+			// 原路折返时斜接与倒角都退化为平头
+			return;
+		}
+
+		if (Join == EGISLineJoin::Miter)
+		{
+			// 两条外侧边线的交点
+			const double T = FVector2D::CrossProduct(To - From, B.Dir) / Cross;
+			const FVector2D Tip = From + A.Dir * T;
+			if (T >= 0.0 && (Tip - Point).Size() <= GISLineBuffer::MiterLimit * FMath::Max(A.HalfWidth, B.HalfWidth))
+			{
+				AddPiece({ Point, From, Tip, To }, Pieces);
+				return;
+			}
+		}
+		AddPiece({ Point, From, To }, Pieces);
+	}
+
+	// 端点收头：bEnd 为终点 (沿段方向向外)，否则为起点 (逆段方向向外)
+	void AddCap(const FVector2D& Point, const FSegment& Segment, bool bEnd, EGISLineCap Cap, TArray<FGISMultiPolygon>& Pieces)
+	{
+		// 沿外向方向看，右侧角点逆时针转半圈到左侧角点
+		const FVector2D Right = bEnd ? Point - Segment.Offset : Point + Segment.Offset;
+		const FVector2D Left = bEnd ? Point + Segment.Offset : Point - Segment.Offset;
+		const FVector2D Outward = bEnd ? Segment.Dir : -Segment.Dir;
+
+		switch (Cap)
+		{
+		case EGISLineCap::Round:
+			AddFan(Point, Right, Left, UE_DOUBLE_PI, Pieces);
+			break;
+		case EGISLineCap::Square:
+		{
+			const FVector2D Extent = Outward * Segment.HalfWidth;
+			AddPiece({ Right, Right + Extent, Left + Extent, Left }, Pieces);
+			break;
+		}
+		case EGISLineCap::Flat:
+			break;
+		}
+	}
+
+	template <typename EnumType, int32 Num>
+	bool ParseEnum(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, const TCHAR* const (&Names)[Num], EnumType& OutValue)
+	{
+		FString Name;
+		if (!Object->TryGetStringField(Field, Name))
+		{
+			return true;
+		}
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (Name == Names[Index])
+			{
+				OutValue = static_cast<EnumType>(Index);
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+bool GISLineBuffer::Buffer(const FGISRoadLine& Road, FGISMultiPolygon& OutGeometry)
+{
+	OutGeometry.Reset();
+	const int32 NumInputSegments = Road.Centerline.Num() - 1;
+	if (NumInputSegments < 1 || (Road.Widths.Num() != 1 && Road.Widths.Num() != NumInputSegments)
+		|| Road.Widths.ContainsByPredicate([](float Width) { return !(Width > 0.0f); }))
+	{
+		return false;
+	}
+
+	// 去掉重复点 (连同其所在段的宽度)，相邻段首尾相接，按段建立偏移
+	const FLocalFrame Frame(Road.Centerline[0]);
+	TArray<FSegment> Segments;
+	Segments.Reserve(NumInputSegments);
+	FVector2D Start = Frame.ToLocal(Road.Centerline[0]);
+	for (int32 Index = 0; Index < NumInputSegments; ++Index)
+	{
+		const FVector2D End = Frame.ToLocal(Road.Centerline[Index + 1]);
+		const double Width = Road.Widths[Road.Widths.Num() == 1 ? 0 : Index];
+		const double Length = (End - Start).Size();
+		if (Length < MinSegmentMeters)
+		{
+			continue;
+		}
+
+		FSegment& Segment = Segments.AddDefaulted_GetRef();
+		Segment.Start = Start;
+		Segment.End = End;
+		Segment.Dir = (End - Start) / Length;
+		Segment.HalfWidth = Width * 0.5;
+		Segment.Offset = FVector2D(-Segment.Dir.Y, Segment.Dir.X) * Segment.HalfWidth;
+		Start = End;
+	}
+	if (Segments.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<FGISMultiPolygon> Pieces;
+	Pieces.Reserve(Segments.Num() * 2 + 2);
+	for (const FSegment& Segment : Segments)
+	{
+		AddPiece({ Segment.Start - Segment.Offset, Segment.End - Segment.Offset, Segment.End + Segment.Offset, Segment.Start + Segment.Offset }, Pieces);
+	}
+	for (int32 Index = 1; Index < Segments.Num(); ++Index)
+	{
+		AddJoin(Segments[Index - 1], Segments[Index], Road.Join, Pieces);
+	}
+
+	const bool bClosed = Segments.Num() >= 3 && (Segments.Last().End - Segments[0].Start).Size() < MinSegmentMeters;
+	if (bClosed)
+	{
+		FSegment Last = Segments.Last();
+		Last.End = Segments[0].Start;
+		AddJoin(Last, Segments[0], Road.Join, Pieces);
+	}
+	else
+	{
+		AddCap(Segments[0].Start, Segments[0], false, Road.Cap, Pieces);
+		AddCap(Segments.Last().End, Segments.Last(), true, Road.Cap, Pieces);
+	}
+
+	OutGeometry = FGISPolygonClipper::UnionAll(MoveTemp(Pieces));
+	for (FGISPolygon& Polygon : OutGeometry)
+	{
+		for (FGISRing& Ring : Polygon.Rings)
+		{
+			for (FVector2D& Point : Ring)
+			{
+				Point = Frame.ToLngLat(Point);
+			}
+		}
+	}
+	return OutGeometry.Num() > 0;
+}
+
+void GISLineBuffer::BufferAll(TArrayView<const FGISRoadLine> Roads, TArray<FGISMultiPolygon>& OutGeometries)
+{
+	OutGeometries.Reset();
+	OutGeometries.SetNum(Roads.Num());
+	ParallelFor(Roads.Num(), [Roads, &OutGeometries](int32 Index)
+	{
+		Buffer(Roads[Index], OutGeometries[Index]);
+	});
+}
+
+bool GISLineBuffer::ParseRoad(const FString& Json, FGISRoadLine& OutRoad)
+{
+	TSharedPtr<FJsonObject> Object;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+	if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+	{
+		return false;
+	}
+	return ParseRoad(Object, OutRoad);
+}
+
+bool GISLineBuffer::ParseRoad(const TSharedPtr<FJsonObject>& Object, FGISRoadLine& OutRoad)
+{
+	OutRoad = FGISRoadLine();
+	const TArray<TSharedPtr<FJsonValue>>* Points = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* Widths = nullptr;
+	if (!Object.IsValid() || !Object->TryGetArrayField(TEXT("line"), Points) || !Object->TryGetArrayField(TEXT("widths"), Widths))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& PointValue : *Points)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Coords = nullptr;
+		if (!PointValue.IsValid() || !PointValue->TryGetArray(Coords) || Coords->Num() < 2)
+		{
+			return false;
+		}
+		OutRoad.Centerline.Emplace((*Coords)[0]->AsNumber(), (*Coords)[1]->AsNumber());
+	}
+	for (const TSharedPtr<FJsonValue>& WidthValue : *Widths)
+	{
+		double Width = 0.0;
+		if (!WidthValue.IsValid() || !WidthValue->TryGetNumber(Width) || !(Width > 0.0))
+		{
+			return false;
+		}
+		OutRoad.Widths.Add(static_cast<float>(Width));
+	}
+
+	const int32 NumSegments = OutRoad.Centerline.Num() - 1;
+	return NumSegments >= 1 && (OutRoad.Widths.Num() == 1 || OutRoad.Widths.Num() == NumSegments)
+		&& ParseEnum(Object, TEXT("join"), JoinNames, OutRoad.Join)
+		&& ParseEnum(Object, TEXT("cap"), CapNames, OutRoad.Cap);
+}
+
+FString GISLineBuffer::WriteRoad(const FGISRoadLine& Road)
+{
+	FString Out = TEXT("{\"line\":[");
+	for (int32 Index = 0; Index < Road.Centerline.Num(); ++Index)
+	{
+		Out.Appendf(TEXT("%s[%.9f,%.9f]"), Index > 0 ? TEXT(",") : TEXT(""), Road.Centerline[Index].X, Road.Centerline[Index].Y);
+	}
+	Out += TEXT("],\"widths\":[");
+	for (int32 Index = 0; Index < Road.Widths.Num(); ++Index)
+	{
+		Out.Appendf(TEXT("%s%s"), Index > 0 ? TEXT(",") : TEXT(""), *FString::SanitizeFloat(Road.Widths[Index]));
+	}
+	Out.Appendf(TEXT("],\"join\":\"%s\",\"cap\":\"%s\"}"), JoinNames[static_cast<int32>(Road.Join)], CapNames[static_cast<int32>(Road.Cap)]);
+	return Out;
+}
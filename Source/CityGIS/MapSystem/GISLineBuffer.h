@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+#include "GISLineBuffer.generated.h"
+
+class FJsonObject;
+
+// 折线拐点处外侧的连接方式
+UENUM(BlueprintType)
+enum class EGISLineJoin : uint8
+{
+	Round,
+	// 尖角超过 MiterLimit 倍半宽时退为倒角
+	Miter,
+	Bevel
+};
+
+// 折线两端的收头方式
+UENUM(BlueprintType)
+enum class EGISLineCap : uint8
+{
+	Round,
+	Flat,
+	// 平头再向外延伸半个宽度
+	Square
+};
+
+/**
+ * 道路的源数据：中心线与宽度 (面只是由它生成的结果)
+ * 随页面要素的 properties.road 保存：{"line":[[lng,lat],...],"widths":[米,...],"join":"round","cap":"round"}
+ */
+struct FGISRoadLine
+{
+	// BD09 经纬度；首尾重合时视为环线，不收头
+	TArray<FVector2D> Centerline;
+
+	// 全宽 (米)：只有一个时各段等宽，否则与线段一一对应
+	TArray<float> Widths;
+
+	EGISLineJoin Join = EGISLineJoin::Round;
+	EGISLineCap Cap = EGISLineCap::Round;
+
+	bool operator==(const FGISRoadLine& Other) const
+	{
+		return Join == Other.Join && Cap == Other.Cap && Widths == Other.Widths && Centerline == Other.Centerline;
+	}
+};
+
+/**
+ * 折线缓冲区：按段宽生成线段矩形、拐点连接与两端收头，在米制局部平面上求并后转回经纬度
+ * 纯计算、无共享状态，可在工作线程中调用
+ */
+namespace GISLineBuffer
+{
+	// 尖角长度上限 (相对半宽)，与常见绘图库一致
+	constexpr double MiterLimit = 4.0;
+
+	// 圆弧的弦高容差 (米)
+	constexpr double ArcToleranceMeters = 0.05;
+
+	CITYGIS_API bool Buffer(const FGISRoadLine& Road, FGISMultiPolygon& OutGeometry);
+
+	// 整个路网并行生成，OutGeometries 与 Roads 一一对应 (无效的道路为空)
+	CITYGIS_API void BufferAll(TArrayView<const FGISRoadLine> Roads, TArray<FGISMultiPolygon>& OutGeometries);
+
+	// properties.road 对象 <-> FGISRoadLine；缺省的 join/cap 为 round
+	CITYGIS_API bool ParseRoad(const FString& Json, FGISRoadLine& OutRoad);
+	CITYGIS_API bool ParseRoad(const TSharedPtr<FJsonObject>& Object, FGISRoadLine& OutRoad);
+	CITYGIS_API FString WriteRoad(const FGISRoadLine& Road);
+}
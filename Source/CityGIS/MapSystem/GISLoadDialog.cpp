@@ -1,10 +1,6 @@
 #include "GISLoadDialog.h"
 #include "GISWebWidget.h"
 #include "GISFileItem.h"
-#include "Misc/Paths.h"
-#include "HAL/PlatformFileManager.h"
-#include "Misc/FileHelper.h"
-#include "Serialization/JsonSerializer.h"
 
 void UGISLoadDialog::NativeConstruct()
 {
@@ -14,10 +10,17 @@ void UGISLoadDialog::NativeConstruct()
     if (Btn_Delete) Btn_Delete->OnClicked.AddDynamic(this, &UGISLoadDialog::OnDeleteClicked);
 }
 
+void UGISLoadDialog::NativeDestruct()
+{
+    UnbindFileTask();
+    Super::NativeDestruct();
+}
+
 void UGISLoadDialog::Init(UGISWebWidget* Parent)
 {
     MainUI = Parent;
     AddToViewport(100);
+    SetLoading(false);
     RefreshList();
 }
 
@@ -27,39 +30,19 @@ void UGISLoadDialog::RefreshList()
     FileList->ClearChildren();
     SelectedItem = nullptr;
 
-    FString FolderPath = FPaths::ProjectSavedDir() + TEXT("GISData/");
-    TArray<FString> Files;
-    IFileManager::Get().FindFiles(Files, *FolderPath, TEXT("*.json"));
-
+    // 【修改】元数据来自存档索引，只有新增或变化的文件才会被读取
     TArray<FGISSaveMetadata> MetaList;
-
-    // 1. 读取所有文件信息
-    for (const FString& FileName : Files)
+    if (MainUI)
     {
-        FString FullPath = FolderPath + FileName;
-        FString Content;
-        if (FFileHelper::LoadFileToString(Content, *FullPath))
-        {
-            TSharedPtr<FJsonObject> JsonObj;
-            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
-            if (FJsonSerializer::Deserialize(Reader, JsonObj))
-            {
-                FGISSaveMetadata Meta;
-                Meta.Name = JsonObj->GetStringField("name");
-                Meta.Date = JsonObj->GetStringField("date");
-                Meta.Description = JsonObj->GetStringField("desc");
-                Meta.FilePath = FullPath;
-                MetaList.Add(Meta);
-            }
-        }
+        MainUI->GetSaveIndex().Refresh(MetaList);
     }
 
-    // 2. 排序 (最新在上)
+    // 1. 排序 (最新在上)
     MetaList.Sort([](const FGISSaveMetadata& A, const FGISSaveMetadata& B) {
         return A.Date > B.Date;
     });
 
-    // 3. 生成列表 UI
+    // 2. 生成列表 UI
     for (const auto& Meta : MetaList)
     {
         UGISFileItem* Item = CreateWidget<UGISFileItem>(this, FileItemClass);
@@ -98,23 +81,73 @@ void UGISLoadDialog::OnItemSelected(UGISFileItem* Item)
 
 void UGISLoadDialog::OnLoadClicked()
 {
-    if (MainUI && SelectedItem)
+    if (MainUI && SelectedItem && !bLoading)
     {
+        // 【修改】读取在后台进行，完成后再关闭弹窗 (先发起再绑定，避免收到旧任务的取消通知)
         MainUI->ExecuteLoadFromFile(SelectedItem->GetFilePath());
+        MainUI->OnFileProgress.AddUniqueDynamic(this, &UGISLoadDialog::HandleFileProgress);
+        MainUI->OnLoadCompleted.AddUniqueDynamic(this, &UGISLoadDialog::HandleLoadCompleted);
+        SetLoading(true);
+    }
+}
+
+void UGISLoadDialog::HandleFileProgress(float Progress)
+{
+    if (Progress_Bar) Progress_Bar->SetPercent(Progress);
+}
+
+void UGISLoadDialog::HandleLoadCompleted(bool bSuccess, const FString& FilePath)
+{
+    UnbindFileTask();
+    if (bSuccess)
+    {
         RemoveFromParent();
+        return;
+    }
+
+    SetLoading(false);
+    if (Txt_DescPreview)
+    {
+        Txt_DescPreview->SetText(FText::FromString(TEXT("读取存档失败，文件可能已损坏")));
+    }
+}
+
+void UGISLoadDialog::SetLoading(bool bInLoading)
+{
+    bLoading = bInLoading;
+    if (Btn_Load) Btn_Load->SetIsEnabled(!bInLoading);
+    if (Btn_Delete) Btn_Delete->SetIsEnabled(!bInLoading);
+    if (Progress_Bar)
+    {
+        Progress_Bar->SetPercent(0.0f);
+        Progress_Bar->SetVisibility(bInLoading ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+    }
+}
+
+void UGISLoadDialog::UnbindFileTask()
+{
+    if (MainUI)
+    {
+        MainUI->OnFileProgress.RemoveAll(this);
+        MainUI->OnLoadCompleted.RemoveAll(this);
     }
 }
 
 void UGISLoadDialog::OnDeleteClicked()
 {
-    if (SelectedItem)
+    if (SelectedItem && MainUI && !bLoading)
     {
-        IFileManager::Get().Delete(*SelectedItem->GetFilePath());
+        MainUI->GetSaveIndex().Delete(SelectedItem->GetFilePath());
         RefreshList(); // 刷新列表
     }
 }
 
 void UGISLoadDialog::OnCancelClicked()
 {
+    if (bLoading && MainUI)
+    {
+        UnbindFileTask();
+        MainUI->CancelFileTask();
+    }
     RemoveFromParent();
 }
\ No newline at end of file
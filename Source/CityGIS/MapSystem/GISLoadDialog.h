@@ -4,6 +4,7 @@
 #include "Components/ScrollBox.h"
 #include "Components/Button.h"
 #include "Components/TextBlock.h"
+#include "Components/ProgressBar.h"
 #include "GISLoadDialog.generated.h"
 
 class UGISWebWidget;
@@ -15,6 +16,7 @@ class CITYGIS_API UGISLoadDialog : public UUserWidget
 	GENERATED_BODY()
 public:
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
     
 	void Init(UGISWebWidget* Parent);
 	void OnItemSelected(UGISFileItem* Item);
@@ -25,6 +27,7 @@ protected:
 	UPROPERTY(meta = (BindWidget)) UButton* Btn_Cancel;
 	UPROPERTY(meta = (BindWidget)) UButton* Btn_Delete; // 可选：删除存档功能
 	UPROPERTY(meta = (BindWidget)) UTextBlock* Txt_DescPreview;
+	UPROPERTY(meta = (BindWidgetOptional)) UProgressBar* Progress_Bar; // 可选：后台读取进度
 	
 	// 列表项类
 	UPROPERTY(EditAnywhere, Category = "Config")
@@ -36,9 +39,17 @@ private:
 	UFUNCTION() void OnCancelClicked();
 	UFUNCTION() void OnDeleteClicked();
 
+	// 【新增】后台读取的进度与完成回调
+	UFUNCTION() void HandleFileProgress(float Progress);
+	UFUNCTION() void HandleLoadCompleted(bool bSuccess, const FString& FilePath);
+	void UnbindFileTask();
+	void SetLoading(bool bInLoading);
+
 	UPROPERTY()
 	UGISWebWidget* MainUI = nullptr;
 	
 	UPROPERTY()
 	UGISFileItem* SelectedItem = nullptr;
+
+	bool bLoading = false;
 };
\ No newline at end of file
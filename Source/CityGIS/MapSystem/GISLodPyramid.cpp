@@ -0,0 +1,496 @@
+#include "GISLodPyramid.h"
+#include "Algo/Reverse.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+	struct FLodLevel
+	{
+		float MinZoom;
+		double ToleranceMeters;
+	};
+
+	// 百度地图缩放 z 下约 2^(18-z) 米/像素；每级容差取该级适用的最大缩放 (上一级的 MinZoom) 下半个像素
+	const FLodLevel LodLevels[] = {
+		{ 16.0f, 0.0 },
+		{ 14.0f, 2.0 },
+		{ 12.0f, 8.0 },
+		{ 10.0f, 32.0 },
+		{ 8.0f, 128.0 },
+		{ 0.0f, 512.0 },
+	};
+	constexpr int32 NumLodLevels = UE_ARRAY_COUNT(LodLevels);
+
+	constexpr double CoordScale = 1e7;
+	constexpr double MetersPerDegree = 111320.0;
+
+	// 量化到 1e-7 度后打包，坐标逐位相同的顶点才视为同一点 (吸附产生的公共边满足这一点)
+	using FPointKey = uint64;
+
+	FPointKey MakeKey(const FVector2D& Point)
+	{
+		const uint32 X = static_cast<uint32>(static_cast<int32>(FMath::RoundToDouble(Point.X * CoordScale)));
+		const uint32 Y = static_cast<uint32>(static_cast<int32>(FMath::RoundToDouble(Point.Y * CoordScale)));
+		return (static_cast<uint64>(X) << 32) | Y;
+	}
+
+	// 顶点在所有环中的前后邻点；不同环中邻点不一致的顶点是弧段的分叉点
+	struct FNeighbors
+	{
+		FPointKey Prev = 0;
+		FPointKey Next = 0;
+		bool bJunction = false;
+	};
+
+	// 去掉闭合点与连续重复点后的环
+	struct FRingInput
+	{
+		int32 Feature = 0;
+		int32 Part = 0;
+		int32 Ring = 0;
+		TArray<FPointKey> Keys;
+		TArray<FVector2D> Points;
+	};
+
+	// 环由若干条弧首尾相接组成
+	struct FArcUse
+	{
+		int32 Arc = 0;
+		bool bReversed = false;
+	};
+
+	struct FArc
+	{
+		// 规范方向：两端较小的键在前，保证相邻面引用同一条弧时方向一致
+		TArray<FPointKey> Keys;
+		TArray<FVector2D> Points;
+		// 每级保留的点下标 (下标为级别 - 1)
+		TArray<TArray<int32>> Kept;
+	};
+
+	class FArcSimplifier
+	{
+	public:
+		FArcSimplifier(double InMetersPerDegLng)
+			: MetersPerDegLng(InMetersPerDegLng)
+		{
+		}
+
+		// 端点固定的 Douglas-Peucker；闭合弧先在离起点最远处切开
+		void Simplify(const TArray<FVector2D>& Points, double ToleranceMeters, TArray<int32>& OutKept)
+		{
+			const int32 Last = Points.Num() - 1;
+			Local.SetNumUninitialized(Points.Num());
+			for (int32 Index = 0; Index <= Last; ++Index)
+			{
+				Local[Index] = FVector2D(Points[Index].X * MetersPerDegLng, Points[Index].Y * MetersPerDegree);
+			}
+
+			Keep.Init(false, Points.Num());
+			Keep[0] = true;
+			Keep[Last] = true;
+
+			if (Last >= 2 && Local[0].Equals(Local[Last], 0.0))
+			{
+				int32 Far = 1;
+				double FarDist = -1.0;
+				for (int32 Index = 1; Index < Last; ++Index)
+				{
+					const double Dist = FVector2D::DistSquared(Local[0], Local[Index]);
+					if (Dist > FarDist)
+					{
+						FarDist = Dist;
+						Far = Index;
+					}
+				}
+				Keep[Far] = true;
+				Run(0, Far, ToleranceMeters);
+				Run(Far, Last, ToleranceMeters);
+			}
+			else
+			{
+				Run(0, Last, ToleranceMeters);
+			}
+
+			OutKept.Reset();
+			for (int32 Index = 0; Index <= Last; ++Index)
+			{
+				if (Keep[Index])
+				{
+					OutKept.Add(Index);
+				}
+			}
+		}
+
+	private:
+		void Run(int32 First, int32 Last, double ToleranceMeters)
+		{
+			const double ToleranceSq = ToleranceMeters * ToleranceMeters;
+			Stack.Reset();
+			Stack.Emplace(First, Last);
+			while (Stack.Num() > 0)
+			{
+				const TPair<int32, int32> Range = Stack.Pop(EAllowShrinking::No);
+				const FVector2D A = Local[Range.Key];
+				const FVector2D B = Local[Range.Value];
+				const FVector2D AB = B - A;
+				const double LenSq = AB.SizeSquared();
+
+				int32 Far = INDEX_NONE;
+				double FarDist = ToleranceSq;
+				for (int32 Index = Range.Key + 1; Index < Range.Value; ++Index)
+				{
+					const FVector2D AP = Local[Index] - A;
+					double Dist;
+					if (LenSq <= 0.0)
+					{
+						Dist = AP.SizeSquared();
+					}
+					else
+					{
+						const double T = FMath::Clamp(FVector2D::DotProduct(AP, AB) / LenSq, 0.0, 1.0);
+						Dist = (AP - AB * T).SizeSquared();
+					}
+					if (Dist > FarDist)
+					{
+						FarDist = Dist;
+						Far = Index;
+					}
+				}
+
+				if (Far != INDEX_NONE)
+				{
+					Keep[Far] = true;
+					Stack.Emplace(Range.Key, Far);
+					Stack.Emplace(Far, Range.Value);
+				}
+			}
+		}
+
+		double MetersPerDegLng;
+		TArray<FVector2D> Local;
+		TBitArray<> Keep;
+		TArray<TPair<int32, int32>> Stack;
+	};
+
+	void AppendEscaped(FString& Out, const FString& Text)
+	{
+		for (const TCHAR C : Text)
+		{
+			if (C == TEXT('"') || C == TEXT('\\'))
+			{
+				Out.AppendChar(TEXT('\\'));
+			}
+			Out.AppendChar(C);
+		}
+	}
+}
+
+int32 FGISLodPyramid::NumLevels()
+{
+	return NumLodLevels;
+}
+
+int32 FGISLodPyramid::LevelForZoom(float Zoom)
+{
+	for (int32 Level = 0; Level < NumLodLevels; ++Level)
+	{
+		if (Zoom >= LodLevels[Level].MinZoom)
+		{
+			return Level;
+		}
+	}
+	return NumLodLevels - 1;
+}
+
+double FGISLodPyramid::GetToleranceMeters(int32 Level)
+{
+	return LodLevels[FMath::Clamp(Level, 0, NumLodLevels - 1)].ToleranceMeters;
+}
+
+const FGISMultiPolygon& FGISLodPyramid::GetLevel(const FFeature& Feature, int32 Level)
+{
+	if (Level <= 0 || Feature.Simplified.Num() == 0)
+	{
+		return *Feature.Original;
+	}
+	return Feature.Simplified[FMath::Min(Level, Feature.Simplified.Num()) - 1];
+}
+
+void FGISLodPyramid::Build(const TArray<FFeatureInput>& Inputs)
+{
+	Features.Reset();
+	Features.Reserve(Inputs.Num());
+
+	// 1. 收集环，顺带求整体包围盒 (经度方向的米制比例取中心纬度)
+	TArray<FRingInput> Rings;
+	FBox2D Bounds(ForceInit);
+	for (const FFeatureInput& Input : Inputs)
+	{
+		if (!Input.Geometry.IsValid())
+		{
+			continue;
+		}
+
+		const int32 FeatureIndex = Features.Num();
+		FFeature& Feature = Features.AddDefaulted_GetRef();
+		Feature.ID = Input.ID;
+		Feature.Original = Input.Geometry;
+
+		const FGISMultiPolygon& Geometry = *Input.Geometry;
+		for (int32 Part = 0; Part < Geometry.Num(); ++Part)
+		{
+			for (int32 RingIndex = 0; RingIndex < Geometry[Part].Rings.Num(); ++RingIndex)
+			{
+				const FGISRing& Source = Geometry[Part].Rings[RingIndex];
+				FRingInput Ring;
+				Ring.Feature = FeatureIndex;
+				Ring.Part = Part;
+				Ring.Ring = RingIndex;
+				Ring.Keys.Reserve(Source.Num());
+				Ring.Points.Reserve(Source.Num());
+				for (const FVector2D& Point : Source)
+				{
+					const FPointKey Key = MakeKey(Point);
+					if (Ring.Keys.Num() == 0 || Ring.Keys.Last() != Key)
+					{
+						Ring.Keys.Add(Key);
+						Ring.Points.Add(Point);
+					}
+					Bounds += Point;
+				}
+				while (Ring.Keys.Num() > 1 && Ring.Keys.Last() == Ring.Keys[0])
+				{
+					Ring.Keys.Pop();
+					Ring.Points.Pop();
+				}
+				// 不足三个不同顶点的环无法简化，各级都沿用原环
+				if (Ring.Keys.Num() >= 3)
+				{
+					Rings.Add(MoveTemp(Ring));
+				}
+			}
+		}
+	}
+
+	// 各级先复制原几何，再把可简化的环替换为简化结果
+	for (FFeature& Feature : Features)
+	{
+		Feature.Simplified.Init(*Feature.Original, NumLodLevels - 1);
+	}
+	if (Rings.Num() == 0)
+	{
+		return;
+	}
+
+	// 2. 找分叉点：同一顶点在各环中的前后邻点不一致，说明公共边在此开始或结束
+	TMap<FPointKey, FNeighbors> Neighbors;
+	for (const FRingInput& Ring : Rings)
+	{
+		const int32 Count = Ring.Keys.Num();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FPointKey Prev = Ring.Keys[(Index + Count - 1) % Count];
+			const FPointKey Next = Ring.Keys[(Index + 1) % Count];
+			FNeighbors* Found = Neighbors.Find(Ring.Keys[Index]);
+			if (!Found)
+			{
+				FNeighbors& Added = Neighbors.Add(Ring.Keys[Index]);
+				Added.Prev = Prev;
+				Added.Next = Next;
+			}
+			else if (!Found->bJunction && !((Found->Prev == Prev && Found->Next == Next) || (Found->Prev == Next && Found->Next == Prev)))
+			{
+				Found->bJunction = true;
+			}
+		}
+	}
+
+	// 3. 在分叉点处把环切成弧，相同的弧只保留一份
+	TArray<FArc> Arcs;
+	TMap<uint32, TArray<int32>> ArcBuckets;
+	TArray<TArray<FArcUse>> RingArcs;
+	RingArcs.SetNum(Rings.Num());
+
+	TArray<FPointKey> ArcKeys;
+	TArray<FVector2D> ArcPoints;
+	for (int32 RingIndex = 0; RingIndex < Rings.Num(); ++RingIndex)
+	{
+		const FRingInput& Ring = Rings[RingIndex];
+		const int32 Count = Ring.Keys.Num();
+
+		// 从第一个分叉点开始；没有分叉点的环 (孤立面或与另一环完全重合) 从最小的键开始，使重合的环切法一致
+		int32 Start = INDEX_NONE;
+		for (int32 Index = 0; Index < Count && Start == INDEX_NONE; ++Index)
+		{
+			if (Neighbors[Ring.Keys[Index]].bJunction)
+			{
+				Start = Index;
+			}
+		}
+		const bool bHasJunction = Start != INDEX_NONE;
+		if (!bHasJunction)
+		{
+			Start = 0;
+			for (int32 Index = 1; Index < Count; ++Index)
+			{
+				if (Ring.Keys[Index] < Ring.Keys[Start])
+				{
+					Start = Index;
+				}
+			}
+		}
+
+		ArcKeys.Reset();
+		ArcPoints.Reset();
+		for (int32 Step = 0; Step <= Count; ++Step)
+		{
+			const int32 Index = (Start + Step) % Count;
+			ArcKeys.Add(Ring.Keys[Index]);
+			ArcPoints.Add(Ring.Points[Index]);
+
+			const bool bEnd = Step == Count || (Step > 0 && bHasJunction && Neighbors[Ring.Keys[Index]].bJunction);
+			if (!bEnd)
+			{
+				continue;
+			}
+
+			// 规范方向
+			const int32 Last = ArcKeys.Num() - 1;
+			const bool bReversed = ArcKeys[0] > ArcKeys[Last] || (ArcKeys[0] == ArcKeys[Last] && Last >= 2 && ArcKeys[1] > ArcKeys[Last - 1]);
+			if (bReversed)
+			{
+				Algo::Reverse(ArcKeys);
+				Algo::Reverse(ArcPoints);
+			}
+
+			const uint32 Hash = FCrc::MemCrc32(ArcKeys.GetData(), ArcKeys.Num() * sizeof(FPointKey));
+			TArray<int32>& Bucket = ArcBuckets.FindOrAdd(Hash);
+			int32 ArcIndex = INDEX_NONE;
+			for (const int32 Candidate : Bucket)
+			{
+				if (Arcs[Candidate].Keys == ArcKeys)
+				{
+					ArcIndex = Candidate;
+					break;
+				}
+			}
+			if (ArcIndex == INDEX_NONE)
+			{
+				ArcIndex = Arcs.Num();
+				FArc& Arc = Arcs.AddDefaulted_GetRef();
+				Arc.Keys = ArcKeys;
+				Arc.Points = ArcPoints;
+				Bucket.Add(ArcIndex);
+			}
+			RingArcs[RingIndex].Add({ ArcIndex, bReversed });
+
+			// 下一条弧从当前分叉点开始
+			const FPointKey EndKey = bReversed ? ArcKeys[0] : ArcKeys[Last];
+			const FVector2D EndPoint = bReversed ? ArcPoints[0] : ArcPoints[Last];
+			ArcKeys.Reset();
+			ArcPoints.Reset();
+			ArcKeys.Add(EndKey);
+			ArcPoints.Add(EndPoint);
+		}
+	}
+
+	// 4. 逐弧逐级简化
+	FArcSimplifier Simplifier(MetersPerDegree * FMath::Cos(FMath::DegreesToRadians(Bounds.GetCenter().Y)));
+	for (FArc& Arc : Arcs)
+	{
+		Arc.Kept.SetNum(NumLodLevels - 1);
+		for (int32 Level = 1; Level < NumLodLevels; ++Level)
+		{
+			Simplifier.Simplify(Arc.Points, LodLevels[Level].ToleranceMeters, Arc.Kept[Level - 1]);
+		}
+	}
+
+	// 5. 按弧重新拼环；点数不足的环沿用上一级 (级别 1 沿用原环)
+	for (int32 RingIndex = 0; RingIndex < Rings.Num(); ++RingIndex)
+	{
+		const FRingInput& Ring = Rings[RingIndex];
+		FFeature& Feature = Features[Ring.Feature];
+		for (int32 Level = 1; Level < NumLodLevels; ++Level)
+		{
+			FGISRing Simplified;
+			for (const FArcUse& Use : RingArcs[RingIndex])
+			{
+				const FArc& Arc = Arcs[Use.Arc];
+				const TArray<int32>& Kept = Arc.Kept[Level - 1];
+				// 相邻两条弧共用分叉点，后一条跳过首点
+				const int32 Skip = Simplified.Num() > 0 ? 1 : 0;
+				for (int32 Index = Skip; Index < Kept.Num(); ++Index)
+				{
+					const int32 PointIndex = Use.bReversed ? Kept[Kept.Num() - 1 - Index] : Kept[Index];
+					Simplified.Add(Arc.Points[PointIndex]);
+				}
+			}
+
+			FGISRing& Target = Feature.Simplified[Level - 1][Ring.Part].Rings[Ring.Ring];
+			if (Simplified.Num() >= 4)
+			{
+				Target = MoveTemp(Simplified);
+			}
+			else if (Level > 1)
+			{
+				Target = Feature.Simplified[Level - 2][Ring.Part].Rings[Ring.Ring];
+			}
+		}
+	}
+}
+
+int32 FGISLodPyramid::GetVertexCount(int32 Level) const
+{
+	int32 Count = 0;
+	for (const FFeature& Feature : Features)
+	{
+		Count += GISGeometry::CountVertices(GetLevel(Feature, Level));
+	}
+	return Count;
+}
+
+FString FGISLodPyramid::WriteLevelJson(int32 Level) const
+{
+	if (Level <= 0)
+	{
+		return FString();
+	}
+
+	FString Json;
+	Json.Reserve(GetVertexCount(Level) * 24 + Features.Num() * 16);
+	Json.AppendChar(TEXT('{'));
+	for (int32 FeatureIndex = 0; FeatureIndex < Features.Num(); ++FeatureIndex)
+	{
+		const FFeature& Feature = Features[FeatureIndex];
+		if (FeatureIndex > 0)
+		{
+			Json.AppendChar(TEXT(','));
+		}
+		Json.AppendChar(TEXT('"'));
+		AppendEscaped(Json, Feature.ID);
+		Json += TEXT("\":[");
+
+		const FGISMultiPolygon& Geometry = GetLevel(Feature, Level);
+		for (int32 Part = 0; Part < Geometry.Num(); ++Part)
+		{
+			if (Part > 0)
+			{
+				Json.AppendChar(TEXT(','));
+			}
+			Json.AppendChar(TEXT('['));
+			if (Geometry[Part].Rings.Num() > 0)
+			{
+				const FGISRing& Outer = Geometry[Part].Rings[0];
+				for (int32 Index = 0; Index < Outer.Num(); ++Index)
+				{
+					Json += FString::Printf(Index > 0 ? TEXT(",%.7f,%.7f") : TEXT("%.7f,%.7f"), Outer[Index].X, Outer[Index].Y);
+				}
+			}
+			Json.AppendChar(TEXT(']'));
+		}
+		Json.AppendChar(TEXT(']'));
+	}
+	Json.AppendChar(TEXT('}'));
+	return Json;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+/**
+ * 要素几何的多级简化 (按缩放级别切换)
+ *
+ * 构建时先建立拓扑：所有环按顶点坐标 (1e-7 度量化) 找出相邻面共用的边界，
+ * 在分叉点处切成弧段，同一条弧只简化一次 (Douglas-Peucker，端点固定)，
+ * 相邻面引用同一份结果，公共边在任何级别都逐点一致，不会出现裂缝。
+ * 简化后点数不足的环沿用上一级，保证每级的部件数与原几何相同。
+ *
+ * 构建为纯计算，可在工作线程中进行；建好后只读，可在线程间共享。
+ */
+class CITYGIS_API FGISLodPyramid
+{
+public:
+	struct FFeatureInput
+	{
+		FString ID;
+		TSharedPtr<const FGISMultiPolygon> Geometry;
+	};
+
+	// 级别 0 为原始几何，级别越高越粗
+	static int32 NumLevels();
+	static int32 LevelForZoom(float Zoom);
+
+	// 各级简化容差 (米)，按该级适用的最大缩放下半个像素计算
+	static double GetToleranceMeters(int32 Level);
+
+	void Build(const TArray<FFeatureInput>& Features);
+
+	int32 Num() const { return Features.Num(); }
+	int32 GetVertexCount(int32 Level) const;
+
+	// 该级别下每个要素各部件的外环，写为 {"id":[[lng,lat,lng,lat,...],...],...}
+	// 与网页每个部件一个覆盖物的画法对应；级别 0 返回空串 (网页自己持有原始几何)
+	FString WriteLevelJson(int32 Level) const;
+
+	template <typename Func>
+	void ForEachFeature(int32 Level, Func&& Visitor) const
+	{
+		for (const FFeature& Feature : Features)
+		{
+			Visitor(Feature.ID, GetLevel(Feature, Level));
+		}
+	}
+
+private:
+	struct FFeature
+	{
+		FString ID;
+		TSharedPtr<const FGISMultiPolygon> Original;
+		// 下标为级别 - 1
+		TArray<FGISMultiPolygon> Simplified;
+	};
+
+	static const FGISMultiPolygon& GetLevel(const FFeature& Feature, int32 Level);
+
+	TArray<FFeature> Features;
+};
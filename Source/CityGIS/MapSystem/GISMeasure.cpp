@@ -0,0 +1,264 @@
+#include "GISMeasure.h"
+
+namespace
+{
+	// 1 度纬度约合的米数，只用于把精度换成度
+	constexpr double MetersPerDegree = 111320.0;
+
+	// 不可达极点的搜索上限，防止病态输入长时间细分
+	constexpr int32 MaxPoleCells = 20000;
+
+	// 经度乘以 cos(原点纬度) 后与纬度同尺度
+	struct FScaledPlane
+	{
+		double LngScale = 1.0;
+
+		FVector2D ToPlane(const FVector2D& LngLat) const { return FVector2D(LngLat.X * LngScale, LngLat.Y); }
+		FVector2D FromPlane(const FVector2D& Point) const { return FVector2D(Point.X / LngScale, Point.Y); }
+	};
+
+	// 点到多边形边界的距离，内部为正
+	double SignedDistance(const FVector2D& Point, const TArray<TArray<FVector2D>>& Rings)
+	{
+		bool bInside = false;
+		double MinDistSq = DBL_MAX;
+		for (const TArray<FVector2D>& Ring : Rings)
+		{
+			for (int32 Index = 0, Prev = Ring.Num() - 1; Index < Ring.Num(); Prev = Index++)
+			{
+				const FVector2D& A = Ring[Index];
+				const FVector2D& B = Ring[Prev];
+				if ((A.Y > Point.Y) != (B.Y > Point.Y) && Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X)
+				{
+					bInside = !bInside;
+				}
+				MinDistSq = FMath::Min(MinDistSq, FVector2D::DistSquared(Point, FMath::ClosestPointOnSegment2D(Point, A, B)));
+			}
+		}
+		const double Dist = FMath::Sqrt(MinDistSq);
+		return bInside ? Dist : -Dist;
+	}
+
+	// 去掉闭合重复点，并换到等距平面
+	void ToPlaneRings(const FGISPolygon& Polygon, const FScaledPlane& Plane, TArray<TArray<FVector2D>>& OutRings)
+	{
+		OutRings.Reset();
+		for (const FGISRing& Ring : Polygon.Rings)
+		{
+			int32 Count = Ring.Num();
+			if (Count > 1 && Ring[0] == Ring[Count - 1])
+			{
+				--Count;
+			}
+			if (Count < 3)
+			{
+				continue;
+			}
+			TArray<FVector2D>& Out = OutRings.AddDefaulted_GetRef();
+			Out.Reserve(Count);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Out.Add(Plane.ToPlane(Ring[Index]));
+			}
+		}
+	}
+
+	double PlaneRingArea(const TArray<FVector2D>& Ring)
+	{
+		double Sum = 0.0;
+		for (int32 Index = 0, Prev = Ring.Num() - 1; Index < Ring.Num(); Prev = Index++)
+		{
+			Sum += Ring[Prev].X * Ring[Index].Y - Ring[Index].X * Ring[Prev].Y;
+		}
+		return Sum * 0.5;
+	}
+
+	FVector2D PoleInPlane(const TArray<TArray<FVector2D>>& Rings, double Precision)
+	{
+		FBox2D Box(ForceInit);
+		for (const FVector2D& Point : Rings[0])
+		{
+			Box += Point;
+		}
+		const FVector2D Size = Box.GetSize();
+		const double CellSize = FMath::Min(Size.X, Size.Y);
+		if (CellSize <= 0.0)
+		{
+			return Box.Min;
+		}
+
+		struct FCell
+		{
+			FVector2D Center;
+			double Half = 0.0;
+			double Dist = 0.0;
+			// 格内任一点可能达到的最大距离
+			double Max = 0.0;
+		};
+		auto MakeCell = [&Rings](const FVector2D& Center, double Half)
+		{
+			FCell Cell;
+			Cell.Center = Center;
+			Cell.Half = Half;
+			Cell.Dist = SignedDistance(Center, Rings);
+			Cell.Max = Cell.Dist + Half * UE_DOUBLE_SQRT_2;
+			return Cell;
+		};
+		auto ByMax = [](const FCell& A, const FCell& B) { return A.Max > B.Max; };
+
+		TArray<FCell> Queue;
+		const double Half = CellSize * 0.5;
+		for (double X = Box.Min.X; X < Box.Max.X; X += CellSize)
+		{
+			for (double Y = Box.Min.Y; Y < Box.Max.Y; Y += CellSize)
+			{
+				Queue.HeapPush(MakeCell(FVector2D(X + Half, Y + Half), Half), ByMax);
+			}
+		}
+
+		// 初始最优取外环质心与包围盒中心中较好的一个
+		double Area = 0.0;
+		FVector2D Centroid = FVector2D::ZeroVector;
+		const TArray<FVector2D>& Outer = Rings[0];
+		for (int32 Index = 0, Prev = Outer.Num() - 1; Index < Outer.Num(); Prev = Index++)
+		{
+			const double Cross = Outer[Prev].X * Outer[Index].Y - Outer[Index].X * Outer[Prev].Y;
+			Centroid += (Outer[Prev] + Outer[Index]) * Cross;
+			Area += Cross * 3.0;
+		}
+		FCell Best = MakeCell(Area != 0.0 ? Centroid / Area : Outer[0], 0.0);
+		const FCell BoxCell = MakeCell(Box.GetCenter(), 0.0);
+		if (BoxCell.Dist > Best.Dist)
+		{
+			Best = BoxCell;
+		}
+
+		int32 NumCells = Queue.Num();
+		while (Queue.Num() > 0 && NumCells < MaxPoleCells)
+		{
+			FCell Cell;
+			Queue.HeapPop(Cell, ByMax, EAllowShrinking::No);
+			if (Cell.Dist > Best.Dist)
+			{
+				Best = Cell;
+			}
+			// 堆顶已无法再提升超过精度，之后的格更不可能
+			if (Cell.Max - Best.Dist <= Precision)
+			{
+				break;
+			}
+
+			const double Quarter = Cell.Half * 0.5;
+			for (const FVector2D Offset : { FVector2D(-1.0, -1.0), FVector2D(1.0, -1.0), FVector2D(-1.0, 1.0), FVector2D(1.0, 1.0) })
+			{
+				Queue.HeapPush(MakeCell(Cell.Center + Offset * Quarter, Quarter), ByMax);
+			}
+			NumCells += 4;
+		}
+		return Best.Center;
+	}
+}
+
+FGISFeatureMeasure GISMeasure::Measure(const FGISMultiPolygon& Geometry, EGISCoordSystem Source)
+{
+	FGISFeatureMeasure Result;
+	Result.Bounds = GISGeometry::ComputeBounds(Geometry);
+	if (!Result.Bounds.bIsValid)
+	{
+		return Result;
+	}
+
+	const FVector2D Origin = Result.Bounds.GetCenter();
+	const FGISEnuFrame Frame(Origin, Source);
+	FScaledPlane Plane;
+	Plane.LngScale = FMath::Cos(FMath::DegreesToRadians(Origin.Y));
+
+	TArray<FVector2D> LngLats;
+	TArray<FVector> Local;
+	TArray<TArray<FVector2D>> PlaneRings;
+	double CentroidArea = 0.0;
+	FVector2D CentroidSum = FVector2D::ZeroVector;
+	double LargestArea = -1.0;
+	const FGISPolygon* Largest = nullptr;
+
+	for (const FGISPolygon& Polygon : Geometry)
+	{
+		double PolygonArea = 0.0;
+		for (int32 RingIndex = 0; RingIndex < Polygon.Rings.Num(); ++RingIndex)
+		{
+			const FGISRing& Ring = Polygon.Rings[RingIndex];
+			int32 Count = Ring.Num();
+			if (Count > 1 && Ring[0] == Ring[Count - 1])
+			{
+				--Count;
+			}
+			if (Count < 3)
+			{
+				continue;
+			}
+
+			// 面积、周长在切平面上按米计
+			LngLats.Reset();
+			LngLats.Append(Ring.GetData(), Count);
+			Local.SetNumUninitialized(Count, EAllowShrinking::No);
+			Frame.ToLocalBatch(LngLats, Local);
+
+			double Sum = 0.0;
+			for (int32 Index = 0, Prev = Count - 1; Index < Count; Prev = Index++)
+			{
+				Sum += Local[Prev].X * Local[Index].Y - Local[Index].X * Local[Prev].Y;
+				Result.PerimeterM += FVector::Dist(Local[Prev], Local[Index]) * 0.01;
+			}
+			const double RingArea = FMath::Abs(Sum) * 0.5 * 0.0001;
+			PolygonArea += RingIndex == 0 ? RingArea : -RingArea;
+		}
+		Result.AreaM2 += FMath::Max(PolygonArea, 0.0);
+
+		// 质心：外环加、洞减，洞的方向不可信，统一按绝对值
+		ToPlaneRings(Polygon, Plane, PlaneRings);
+		for (int32 RingIndex = 0; RingIndex < PlaneRings.Num(); ++RingIndex)
+		{
+			const TArray<FVector2D>& Ring = PlaneRings[RingIndex];
+			const double Area = PlaneRingArea(Ring);
+			FVector2D Sum = FVector2D::ZeroVector;
+			for (int32 Index = 0, Prev = Ring.Num() - 1; Index < Ring.Num(); Prev = Index++)
+			{
+				const double Cross = Ring[Prev].X * Ring[Index].Y - Ring[Index].X * Ring[Prev].Y;
+				Sum += (Ring[Prev] + Ring[Index]) * Cross;
+			}
+			// Sum / 6 = 有向面积 × 环质心；外环按 +|A|、洞按 -|A| 计入，与环的方向无关
+			const double Sign = (RingIndex == 0) == (Area >= 0.0) ? 1.0 : -1.0;
+			CentroidSum += Sum * (Sign / 6.0);
+			CentroidArea += Area * Sign;
+		}
+
+		if (PolygonArea > LargestArea)
+		{
+			LargestArea = PolygonArea;
+			Largest = &Polygon;
+		}
+	}
+
+	Result.Centroid = CentroidArea != 0.0 ? Plane.FromPlane(CentroidSum / CentroidArea) : Origin;
+	Result.LabelPoint = Largest ? PoleOfInaccessibility(*Largest) : Result.Centroid;
+	return Result;
+}
+
+FVector2D GISMeasure::PoleOfInaccessibility(const FGISPolygon& Polygon, double PrecisionMeters)
+{
+	if (Polygon.Rings.Num() == 0 || Polygon.Rings[0].Num() == 0)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	FScaledPlane Plane;
+	Plane.LngScale = FMath::Cos(FMath::DegreesToRadians(Polygon.Rings[0][0].Y));
+
+	TArray<TArray<FVector2D>> Rings;
+	ToPlaneRings(Polygon, Plane, Rings);
+	if (Rings.Num() == 0)
+	{
+		return Polygon.Rings[0][0];
+	}
+	return Plane.FromPlane(PoleInPlane(Rings, PrecisionMeters / MetersPerDegree));
+}
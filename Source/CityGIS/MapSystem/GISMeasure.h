@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+#include "GISCoordinates.h"
+
+// 单个要素的量测结果
+struct FGISFeatureMeasure
+{
+	// 椭球面积 (平方米，洞已扣除) 与周长 (米，含洞的边界)
+	double AreaM2 = 0.0;
+	double PerimeterM = 0.0;
+
+	// 面积加权质心与不可达极点 (最适合放标注的内部点)，与输入同一坐标系
+	FVector2D Centroid = FVector2D::ZeroVector;
+	FVector2D LabelPoint = FVector2D::ZeroVector;
+
+	FBox2D Bounds = FBox2D(ForceInit);
+};
+
+/**
+ * 面要素的量测
+ * 面积与周长在以要素包围盒中心为原点的 ENU 切平面上计算 (先经 WGS84 椭球换到米)，
+ * 切平面的投影误差约为 (半径 / 地球半径)²，50 公里宽的区镇也在 1e-4 以内
+ * 质心与不可达极点只用于定位，在按原点纬度缩放经度的等距平面上计算，结果直接是输入坐标
+ * 纯计算，可在工作线程调用
+ */
+namespace GISMeasure
+{
+	CITYGIS_API FGISFeatureMeasure Measure(const FGISMultiPolygon& Geometry, EGISCoordSystem Source = EGISCoordSystem::BD09);
+
+	// polylabel 算法：四叉细分网格，按格内可能的最大内切距离优先搜索，精度以米计
+	CITYGIS_API FVector2D PoleOfInaccessibility(const FGISPolygon& Polygon, double PrecisionMeters = 1.0);
+}
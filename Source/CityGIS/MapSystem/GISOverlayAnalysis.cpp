@@ -0,0 +1,72 @@
+#include "GISOverlayAnalysis.h"
+#include "GISPolygonClipper.h"
+#include "Async/ParallelFor.h"
+
+FGISOverlayResult FGISOverlayAnalysis::Run(const FGISMultiPolygon& Target, const TArray<TSharedPtr<const FGISMultiPolygon>>& Existing)
+{
+	FGISOverlayResult Result;
+
+	// 修复新绘区域的微小自相交
+	const FGISMultiPolygon X = FGISPolygonClipper::Clean(Target);
+	if (X.Num() == 0)
+	{
+		return Result;
+	}
+
+	const FBox2D TargetBounds = GISGeometry::ComputeBounds(X);
+	TArray<const FGISMultiPolygon*> Candidates;
+	for (const TSharedPtr<const FGISMultiPolygon>& Geometry : Existing)
+	{
+		if (Geometry.IsValid() && GISGeometry::ComputeBounds(*Geometry).Intersect(TargetBounds))
+		{
+			Candidates.Add(Geometry.Get());
+		}
+	}
+
+	// 候选裁剪到 X 内 (各自独立，可并行)
+	TArray<FGISMultiPolygon> Clipped;
+	Clipped.SetNum(Candidates.Num());
+	ParallelFor(Candidates.Num(), [&](int32 Idx)
+	{
+		Clipped[Idx] = FGISPolygonClipper::Intersection(FGISPolygonClipper::Clean(*Candidates[Idx]), X);
+	});
+	Clipped.RemoveAll([](const FGISMultiPolygon& Geometry) { return Geometry.Num() == 0; });
+
+	if (Clipped.Num() == 0)
+	{
+		Result.Extension = X;
+		return Result;
+	}
+
+	TArray<FBox2D> ClippedBounds;
+	ClippedBounds.Reserve(Clipped.Num());
+	for (const FGISMultiPolygon& Geometry : Clipped)
+	{
+		ClippedBounds.Add(GISGeometry::ComputeBounds(Geometry));
+	}
+
+	// (Ei ∩ Ej) ∩ X == (Ei ∩ X) ∩ (Ej ∩ X)，只需在裁剪后的候选间求交
+	TArray<FGISMultiPolygon> Overlaps;
+	for (int32 i = 0; i < Clipped.Num(); ++i)
+	{
+		for (int32 j = i + 1; j < Clipped.Num(); ++j)
+		{
+			if (!ClippedBounds[i].Intersect(ClippedBounds[j]))
+			{
+				continue;
+			}
+			FGISMultiPolygon Overlap = FGISPolygonClipper::Intersection(Clipped[i], Clipped[j]);
+			if (Overlap.Num() > 0)
+			{
+				Overlaps.Add(MoveTemp(Overlap));
+			}
+		}
+	}
+
+	Result.OverlapCore = FGISPolygonClipper::UnionAll(MoveTemp(Overlaps));
+
+	const FGISMultiPolygon Covered = FGISPolygonClipper::UnionAll(MoveTemp(Clipped));
+	Result.SingleCoverage = FGISPolygonClipper::Difference(Covered, Result.OverlapCore);
+	Result.Extension = FGISPolygonClipper::Difference(X, Covered);
+	return Result;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+// 重构分析的三类结果 (与原 turf 版本一致)
+struct FGISOverlayResult
+{
+	// 重叠核心：新区域内被两个及以上已有区域同时覆盖的部分
+	FGISMultiPolygon OverlapCore;
+	// 单侧覆盖：新区域内只被一个已有区域覆盖的部分
+	FGISMultiPolygon SingleCoverage;
+	// 新拓展区：新区域内未被任何已有区域覆盖的部分
+	FGISMultiPolygon Extension;
+};
+
+/**
+ * 新绘区域 X 与已有区域集合的叠加分析
+ * 先用包围盒筛出与 X 相交的候选并裁剪到 X 内，只在候选之间求两两交集，
+ * 避免原先对全部已有区域做 O(n²) 求交和逐个折叠求并
+ * 输入为只读快照，可在工作线程中执行
+ */
+class CITYGIS_API FGISOverlayAnalysis
+{
+public:
+	static FGISOverlayResult Run(const FGISMultiPolygon& Target, const TArray<TSharedPtr<const FGISMultiPolygon>>& Existing);
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 汉字拼音首字母 (搜索用)
+ * 覆盖 GB2312 一级字库 (按拼音排序，首字母可由区位直接划分) 及部分上海地名常用的二级字；
+ * 多音字取字库排序所用的读音
+ */
+namespace GISPinyin
+{
+	// 小写首字母；表中没有的字返回 0
+	CITYGIS_API TCHAR GetInitial(TCHAR Char);
+
+	// 汉字转首字母，ASCII 字母与数字转小写保留，其余字符跳过，例如 "长宁区2号" -> "cnq2"
+	CITYGIS_API FString ToInitials(const FString& Text);
+}
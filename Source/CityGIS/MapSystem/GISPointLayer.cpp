@@ -0,0 +1,335 @@
+#include "GISPointLayer.h"
+#include "GISSpatialJoin.h"
+#include "GISTileCache.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// 计数汇总每块的点数 (每块一份局部计数，最后合并)
+	constexpr int32 CountChunkSize = 65536;
+
+	// Web 墨卡托的纵坐标 (与瓦片的 y 同向：北小南大)
+	double MercatorY(double Lat)
+	{
+		const double Rad = FMath::DegreesToRadians(FMath::Clamp(Lat, -85.0511, 85.0511));
+		return (1.0 - FMath::Loge(FMath::Tan(Rad) + 1.0 / FMath::Cos(Rad)) / UE_DOUBLE_PI) * 0.5;
+	}
+
+	// JSON 字符串内容的转义 (控制字符直接去掉)
+	FString EscapeJson(const FString& Text)
+	{
+		FString Out;
+		Out.Reserve(Text.Len());
+		for (const TCHAR Char : Text)
+		{
+			if (Char == TEXT('"') || Char == TEXT('\\'))
+			{
+				Out.AppendChar(TEXT('\\'));
+				Out.AppendChar(Char);
+			}
+			else if (Char >= 0x20)
+			{
+				Out.AppendChar(Char);
+			}
+		}
+		return Out;
+	}
+}
+
+int32 FGISPointLayer::FindOrAddCategory(const FString& Name)
+{
+	if (const int32* Found = CategoryIndex.Find(Name))
+	{
+		return *Found;
+	}
+
+	// 类别按 uint16 存放，超出的并入最后一类
+	if (CategoryNames.Num() > MAX_uint16)
+	{
+		return MAX_uint16;
+	}
+	const int32 Index = CategoryNames.Add(Name);
+	CategoryIndex.Add(Name, Index);
+	return Index;
+}
+
+int32 FGISPointLayer::FindCategory(const FString& Name) const
+{
+	const int32* Found = CategoryIndex.Find(Name);
+	return Found ? *Found : INDEX_NONE;
+}
+
+void FGISPointLayer::Add(const FVector2D& LngLat, int32 Category, const ANSICHAR* NameUtf8, int32 NameLen)
+{
+	Positions.Add(LngLat);
+	Categories.Add(static_cast<uint16>(Category));
+	NameChars.Append(NameUtf8, NameLen);
+	NameOffsets.Add(NameChars.Num());
+}
+
+void FGISPointLayer::Finalize(EGISCoordSystem Source)
+{
+	GISCoordinates::ConvertBatch(Positions, Source, EGISCoordSystem::BD09);
+
+	// 按经度排序的置换，再按置换重排各列
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Positions.Num());
+	for (int32 Index = 0; Index < Order.Num(); ++Index)
+	{
+		Order[Index] = Index;
+	}
+	Order.Sort([this](int32 A, int32 B) { return Positions[A].X < Positions[B].X; });
+
+	TArray<FVector2D> SortedPositions;
+	TArray<uint16> SortedCategories;
+	TArray<int32> SortedOffsets;
+	TArray<ANSICHAR> SortedChars;
+	SortedPositions.SetNumUninitialized(Order.Num());
+	SortedCategories.SetNumUninitialized(Order.Num());
+	SortedOffsets.SetNumUninitialized(Order.Num() + 1);
+	SortedChars.Reserve(NameChars.Num());
+	SortedOffsets[0] = 0;
+	for (int32 Index = 0; Index < Order.Num(); ++Index)
+	{
+		const int32 From = Order[Index];
+		SortedPositions[Index] = Positions[From];
+		SortedCategories[Index] = Categories[From];
+		SortedChars.Append(NameChars.GetData() + NameOffsets[From], NameOffsets[From + 1] - NameOffsets[From]);
+		SortedOffsets[Index + 1] = SortedChars.Num();
+	}
+
+	Positions = MoveTemp(SortedPositions);
+	Categories = MoveTemp(SortedCategories);
+	NameOffsets = MoveTemp(SortedOffsets);
+	NameChars = MoveTemp(SortedChars);
+}
+
+FString FGISPointLayer::GetName(int32 Index) const
+{
+	const int32 Begin = NameOffsets[Index];
+	const int32 Len = NameOffsets[Index + 1] - Begin;
+	if (Len == 0)
+	{
+		return FString();
+	}
+	const FUTF8ToTCHAR Converted(NameChars.GetData() + Begin, Len);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+TArray<uint8> FGISPointLayer::WriteTile(int32 Z, int32 X, int32 Y) const
+{
+	const FBox2D TileBox = FGISTileCache::GetTileBounds(Z, X, Y);
+	const double TopY = MercatorY(TileBox.Max.Y);
+	const double InvHeight = 1.0 / FMath::Max(MercatorY(TileBox.Min.Y) - TopY, UE_DOUBLE_SMALL_NUMBER);
+	const double InvWidth = 1.0 / FMath::Max(TileBox.Max.X - TileBox.Min.X, UE_DOUBLE_SMALL_NUMBER);
+
+	// 经度在 [Min, Max)、纬度在 (Min, Max] 内的点，相邻瓦片不重复
+	TArray<int32> Inside;
+	const int32 First = Algo::LowerBoundBy(Positions, TileBox.Min.X, [](const FVector2D& Point) { return Point.X; });
+	for (int32 Index = First; Index < Positions.Num() && Positions[Index].X < TileBox.Max.X; ++Index)
+	{
+		const double Lat = Positions[Index].Y;
+		if (Lat > TileBox.Min.Y && Lat <= TileBox.Max.Y)
+		{
+			Inside.Add(Index);
+		}
+	}
+
+	FString Clusters;
+	FString Points;
+	auto AppendPoint = [this, &Points](int32 Index)
+	{
+		Points += FString::Printf(TEXT("%s[%.6f,%.6f,%d,\"%s\"]"), Points.IsEmpty() ? TEXT("") : TEXT(","),
+		                          Positions[Index].X, Positions[Index].Y, Categories[Index], *EscapeJson(GetName(Index)));
+	};
+
+	if (Z >= DetailZoom && Inside.Num() <= MaxTilePoints)
+	{
+		for (const int32 Index : Inside)
+		{
+			AppendPoint(Index);
+		}
+	}
+	else
+	{
+		// 按格累加，聚合点取格内点的平均位置
+		struct FCell
+		{
+			int32 Count = 0;
+			int32 First = INDEX_NONE;
+			double SumX = 0.0;
+			double SumY = 0.0;
+		};
+		TArray<FCell> Cells;
+		Cells.SetNum(TileGridSize * TileGridSize);
+		for (const int32 Index : Inside)
+		{
+			const FVector2D& Point = Positions[Index];
+			const int32 CellX = FMath::Clamp(static_cast<int32>((Point.X - TileBox.Min.X) * InvWidth * TileGridSize), 0, TileGridSize - 1);
+			const int32 CellY = FMath::Clamp(static_cast<int32>((MercatorY(Point.Y) - TopY) * InvHeight * TileGridSize), 0, TileGridSize - 1);
+			FCell& Cell = Cells[CellY * TileGridSize + CellX];
+			if (Cell.Count++ == 0)
+			{
+				Cell.First = Index;
+			}
+			Cell.SumX += Point.X;
+			Cell.SumY += Point.Y;
+		}
+
+		for (const FCell& Cell : Cells)
+		{
+			if (Cell.Count == 1)
+			{
+				AppendPoint(Cell.First);
+			}
+			else if (Cell.Count > 1)
+			{
+				Clusters += FString::Printf(TEXT("%s[%.6f,%.6f,%d]"), Clusters.IsEmpty() ? TEXT("") : TEXT(","),
+				                            Cell.SumX / Cell.Count, Cell.SumY / Cell.Count, Cell.Count);
+			}
+		}
+	}
+
+	const FString Json = FString::Printf(TEXT("{\"c\":[%s],\"p\":[%s]}"), *Clusters, *Points);
+	const FTCHARToUTF8 Utf8(*Json);
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+int32 FGISPointJoin::GetCount(const FString& TargetID, int32 Category) const
+{
+	const int32* Target = TargetIndex.Find(TargetID);
+	if (!Target)
+	{
+		return 0;
+	}
+	const int32 Base = *Target * NumCategories;
+	if (Category != INDEX_NONE)
+	{
+		return Category >= 0 && Category < NumCategories ? Counts[Base + Category] : 0;
+	}
+
+	int32 Total = 0;
+	for (int32 Index = 0; Index < NumCategories; ++Index)
+	{
+		Total += Counts[Base + Index];
+	}
+	return Total;
+}
+
+TSharedRef<FGISPointJoin> FGISPointJoin::Run(const FGISPointLayer& Layer, TArray<FGISPointJoinTarget> Streets, TArray<FGISPointJoinTarget> Districts)
+{
+	TSharedRef<FGISPointJoin> Join = MakeShared<FGISPointJoin>();
+	const int32 NumStreets = Streets.Num();
+	Join->Targets = MoveTemp(Streets);
+	Join->Targets.Append(MoveTemp(Districts));
+	for (int32 Index = 0; Index < Join->Targets.Num(); ++Index)
+	{
+		Join->TargetIndex.Add(Join->Targets[Index].ID, Index);
+	}
+
+	// 街道优先；区镇只补全不在任何街道内的点
+	FGISPolygonLocator StreetLocator;
+	FGISPolygonLocator DistrictLocator;
+	for (int32 Index = 0; Index < Join->Targets.Num(); ++Index)
+	{
+		FGISPolygonLocator& Locator = Index < NumStreets ? StreetLocator : DistrictLocator;
+		Locator.Add(*Join->Targets[Index].Geometry);
+	}
+	StreetLocator.Build();
+	DistrictLocator.Build();
+
+	Join->Owners.Init(INDEX_NONE, Layer.Num());
+	StreetLocator.LocateAll(Layer.GetPositions(), Join->Owners);
+
+	TArray<int32> DistrictOwners;
+	DistrictOwners.Init(INDEX_NONE, Layer.Num());
+	for (int32 Index = 0; Index < Layer.Num(); ++Index)
+	{
+		// 已有街道的点不再参与区镇定位
+		if (Join->Owners[Index] != INDEX_NONE)
+		{
+			DistrictOwners[Index] = 0;
+		}
+	}
+	DistrictLocator.LocateAll(Layer.GetPositions(), DistrictOwners);
+	for (int32 Index = 0; Index < Layer.Num(); ++Index)
+	{
+		if (Join->Owners[Index] == INDEX_NONE && DistrictOwners[Index] != INDEX_NONE)
+		{
+			Join->Owners[Index] = NumStreets + DistrictOwners[Index];
+		}
+	}
+
+	// 分块计数后合并，再把各目标的计数逐级计入上级
+	const int32 NumTargets = Join->Targets.Num();
+	const int32 NumCategories = FMath::Max(Layer.GetCategoryNames().Num(), 1);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Layer.Num(), CountChunkSize);
+	TArray<TArray<int32>> ChunkCounts;
+	ChunkCounts.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		TArray<int32>& Local = ChunkCounts[Chunk];
+		Local.SetNumZeroed(NumTargets * NumCategories);
+		const int32 End = FMath::Min((Chunk + 1) * CountChunkSize, Layer.Num());
+		for (int32 Index = Chunk * CountChunkSize; Index < End; ++Index)
+		{
+			const int32 Owner = Join->Owners[Index];
+			if (Owner != INDEX_NONE)
+			{
+				++Local[Owner * NumCategories + FMath::Min(Layer.GetCategory(Index), NumCategories - 1)];
+			}
+		}
+	});
+
+	Join->NumCategories = NumCategories;
+	Join->CategoryNames = Layer.GetCategoryNames();
+	Join->Counts.SetNumZeroed(NumTargets * NumCategories);
+	for (const TArray<int32>& Local : ChunkCounts)
+	{
+		for (int32 Slot = 0; Slot < Local.Num(); ++Slot)
+		{
+			Join->Counts[Slot] += Local[Slot];
+		}
+	}
+
+	// 只有 街道 -> 区镇 一级，直接累加即可
+	for (int32 Target = 0; Target < NumStreets; ++Target)
+	{
+		const int32 Parent = Join->Targets[Target].Parent;
+		if (Parent == INDEX_NONE)
+		{
+			continue;
+		}
+		for (int32 Category = 0; Category < NumCategories; ++Category)
+		{
+			Join->Counts[(NumStreets + Parent) * NumCategories + Category] += Join->Counts[Target * NumCategories + Category];
+		}
+	}
+	return Join;
+}
+
+void FGISPointTileSource::SetLayer(TSharedPtr<const FGISPointLayer> InLayer)
+{
+	FScopeLock ScopeLock(&Lock);
+	Layer = MoveTemp(InLayer);
+}
+
+TSharedPtr<const FGISPointLayer> FGISPointTileSource::GetLayer() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Layer;
+}
+
+TSharedPtr<const TArray<uint8>> FGISPointTileSource::GetTile(const FString& Path) const
+{
+	const TSharedPtr<const FGISPointLayer> Current = GetLayer();
+	int32 Z, X, Y;
+	if (!Current.IsValid() || !FGISTileCache::ParseTilePath(Path, Z, X, Y) || Z < 0 || Z > FGISTileCache::MaxZoom
+		|| X < 0 || Y < 0 || X >= (1 << Z) || Y >= (1 << Z))
+	{
+		return nullptr;
+	}
+	return MakeShared<const TArray<uint8>>(Current->WriteTile(Z, X, Y));
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "GISGeometry.h"
+#include "GISCoordinates.h"
+
+/**
+ * 点资源图层 (学校、车站、商铺等地标)
+ *
+ * 按列紧凑存放：坐标 (BD09，按经度排序)、类别下标、名称 (UTF-8 首尾相接 + 偏移表)，
+ * 一百万个点约 30MB，没有逐点的堆分配。加载完成后只读，以共享指针交给工作线程 (空间连接)
+ * 与资源通道 (视口瓦片)。
+ */
+class CITYGIS_API FGISPointLayer
+{
+public:
+	// 页面每个视口瓦片按 16x16 格 (32 像素) 聚合；达到该级别 (及以上) 时不聚合，直接给出点
+	static constexpr int32 TileGridSize = 16;
+	static constexpr int32 DetailZoom = 17;
+
+	// 不聚合时每块瓦片最多给出的点数，超出仍按格聚合
+	static constexpr int32 MaxTilePoints = 1000;
+
+	int32 FindOrAddCategory(const FString& Name);
+	int32 FindCategory(const FString& Name) const;
+
+	// 加载阶段：追加一个点 (坐标为源坐标系)，名称为 UTF-8
+	void Add(const FVector2D& LngLat, int32 Category, const ANSICHAR* NameUtf8, int32 NameLen);
+
+	// 加载完成后调用一次：坐标批量转为 BD09，并按经度重排各列
+	void Finalize(EGISCoordSystem Source);
+
+	int32 Num() const { return Positions.Num(); }
+	TArrayView<const FVector2D> GetPositions() const { return Positions; }
+	int32 GetCategory(int32 Index) const { return Categories[Index]; }
+	const TArray<FString>& GetCategoryNames() const { return CategoryNames; }
+	FString GetName(int32 Index) const;
+
+	// 视口瓦片 (与要素瓦片相同的 z/x/y 网格)：
+	// {"c":[[lng,lat,个数],...],"p":[[lng,lat,类别,"名称"],...]}，格内只有一个点时直接给出该点
+	TArray<uint8> WriteTile(int32 Z, int32 X, int32 Y) const;
+
+private:
+	TArray<FVector2D> Positions;
+	TArray<uint16> Categories;
+
+	// 第 i 个点的名称为 NameChars[NameOffsets[i] .. NameOffsets[i + 1])
+	TArray<int32> NameOffsets = { 0 };
+	TArray<ANSICHAR> NameChars;
+
+	TArray<FString> CategoryNames;
+	TMap<FString, int32> CategoryIndex;
+};
+
+// 参与空间连接的面要素
+struct FGISPointJoinTarget
+{
+	FString ID;
+	TSharedPtr<const FGISMultiPolygon> Geometry;
+
+	// 街道所属区镇在区镇数组中的下标，没有为 INDEX_NONE (区镇本身不用)
+	int32 Parent = INDEX_NONE;
+};
+
+/**
+ * 点到街道/区镇的空间连接结果
+ * 每个点先与街道连接，不在任何街道内的再与区镇连接；计数包含下级 (区镇的点数含其街道内的点)。
+ */
+struct CITYGIS_API FGISPointJoin
+{
+	// 目标依次为街道与区镇，Owners 与 Counts 中的下标都指向这里
+	TArray<FGISPointJoinTarget> Targets;
+
+	// 每个点直接所在的目标，不在任何面内为 INDEX_NONE
+	TArray<int32> Owners;
+
+	// Counts[目标 * NumCategories + 类别]
+	TArray<int32> Counts;
+	int32 NumCategories = 0;
+	TArray<FString> CategoryNames;
+
+	TMap<FString, int32> TargetIndex;
+
+	// Category 为 INDEX_NONE 时为全部类别之和
+	int32 GetCount(const FString& TargetID, int32 Category = INDEX_NONE) const;
+
+	// 纯计算，可在工作线程调用：预处理面、全核并行定位并汇总计数
+	static TSharedRef<FGISPointJoin> Run(const FGISPointLayer& Layer, TArray<FGISPointJoinTarget> Streets, TArray<FGISPointJoinTarget> Districts);
+};
+
+/**
+ * 资源通道访问点图层的入口：图层在游戏线程替换，瓦片请求在线程池中读取
+ */
+class CITYGIS_API FGISPointTileSource
+{
+public:
+	void SetLayer(TSharedPtr<const FGISPointLayer> InLayer);
+	TSharedPtr<const FGISPointLayer> GetLayer() const;
+
+	// 路径为 z/x/y；没有图层或路径无效时返回空
+	TSharedPtr<const TArray<uint8>> GetTile(const FString& Path) const;
+
+private:
+	mutable FCriticalSection Lock;
+	TSharedPtr<const FGISPointLayer> Layer;
+};
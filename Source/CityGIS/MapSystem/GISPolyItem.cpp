@@ -1,7 +1,5 @@
 #include "GISPolyItem.h"
 #include "GISWebWidget.h"
-#include "Components/CanvasPanelSlot.h"
-#include "Components/VerticalBoxSlot.h"
 
 void UGISPolyItem::NativeConstruct()
 {
@@ -21,145 +19,88 @@ void UGISPolyItem::NativeConstruct()
     }
 }
 
-void UGISPolyItem::SetupItem(FString InID, FString InName, FString InType, FString InParentID, FString InColor, float InOpacity, FString InTextColor, FString InTag, float InHeight, UGISWebWidget* InMainUI)
+void UGISPolyItem::NativeOnListItemObjectSet(UObject* ListItemObject)
 {
-    this->ItemID = InID;
-    this->ItemName = InName;
-    this->ItemType = InType;
-    this->ItemColor = InColor;
-    this->ItemOpacity = InOpacity;
-    this->ItemTextColor = InTextColor;
-    this->ItemTag = InTag;
-    this->ItemHeight = InHeight;
-    this->ItemParentID = InParentID;
-    this->MainUI = InMainUI;
+    ItemData = Cast<UGISPolyItemData>(ListItemObject);
+    RefreshFromData();
+}
 
-    if (Txt_Name)
-    {
-        Txt_Name->SetText(FText::FromString(InName));
-    }
-    
-    FString DisplayType = InType;
-    if (InType == "District")
-    {
-        DisplayType = TEXT("区镇");
-    }
-    else if (InType == "Street")
-    {
-        DisplayType = TEXT("街道");
-    }
-    else if (InType == "Community")
-    {
-        DisplayType = TEXT("小区");
-    }
-    else if (InType == "Reconstruct")
-    {
-        DisplayType = TEXT("重构");
-    }
-    else if (InType == "Custom")
-    {
-        DisplayType = TEXT("自定义");
-    }
-    else if (InType == "Road")
+void UGISPolyItem::RefreshFromData()
+{
+    UGISPolyItemData* Data = ItemData.Get();
+    if (!Data)
     {
-        DisplayType = TEXT("道路");
+        return;
     }
 
-    if (!InTag.IsEmpty()) 
-    {
-        DisplayType += TEXT(" | ") + InTag;
-    }
-    if (InHeight > 0)
+    if (Txt_Name)
     {
-        DisplayType += FString::Printf(TEXT(" | H:%.0fm"), InHeight);
+        Txt_Name->SetText(FText::FromString(Data->GetName()));
     }
-
     if (Txt_Type)
     {
-        Txt_Type->SetText(FText::FromString(DisplayType));
+        Txt_Type->SetText(FText::FromString(Data->GetDisplayType()));
     }
 
     if (Content_Border)
     {
-        float Indent = 0.0f;
         FLinearColor BgColor = FLinearColor::Gray;
-
-        if (InType == "District") 
+        switch (Data->GetType())
         {
+        case EGISFeatureType::District:
             BgColor = FLinearColor(0.8f, 0.1f, 0.1f, 0.6f);
-        } 
-        else if (InType == "Street") 
-        {
+            break;
+        case EGISFeatureType::Street:
             BgColor = FLinearColor(0.1f, 0.1f, 0.8f, 0.6f);
-            Indent = 20.0f;
-        } 
-        else if (InType == "Community") 
-        {
+            break;
+        case EGISFeatureType::Community:
             BgColor = FLinearColor(0.1f, 0.6f, 0.1f, 0.6f);
-            Indent = 40.0f;
-        } 
-        else if (InType == "Custom") 
-        {
+            break;
+        case EGISFeatureType::Custom:
             BgColor = FLinearColor(0.0f, 0.5f, 0.5f, 0.6f);
-            Indent = 40.0f;
-        } 
-        else if (InType == "Road") 
-        {
+            break;
+        case EGISFeatureType::Road:
             BgColor = FLinearColor(0.2f, 0.2f, 0.2f, 0.8f);
-            Indent = 40.0f;
+            break;
+        default:
+            break;
         }
 
-        Content_Border->SetBrushColor(BgColor);
-        if (Child_Container)
+        // 原先靠嵌套 Child_Container 缩进，现在由行控件按层级深度缩进
+        float Indent = 0.0f;
+        for (UGISPolyItemData* Parent = Data->GetParentItem(); Parent; Parent = Parent->GetParentItem())
         {
-            Child_Container->SetRenderTranslation(FVector2D(Indent, 0));
+            Indent += 20.0f;
         }
-    }
-}
-
-void UGISPolyItem::UpdateData(FString NewName, FString NewColor, float NewOpacity, FString NewTextColor, FString NewParentID)
-{
-    this->ItemName = NewName;
-    this->ItemColor = NewColor;
-    this->ItemOpacity = NewOpacity;
-    this->ItemTextColor = NewTextColor;
-    this->ItemParentID = NewParentID;
-
-    if (Txt_Name)
-    {
-        Txt_Name->SetText(FText::FromString(NewName));
-    }
-}
 
-void UGISPolyItem::AddChildItem(UGISPolyItem* ChildWidget) 
-{ 
-    if (Child_Container && ChildWidget) 
-    {
-        Child_Container->AddChild(ChildWidget); 
+        Content_Border->SetBrushColor(BgColor);
+        SetPadding(FMargin(Indent, 0.0f, 0.0f, 0.0f));
     }
 }
 
 void UGISPolyItem::OnFocusClicked() 
 { 
-    if (MainUI.IsValid())
+    UGISPolyItemData* Data = ItemData.Get();
+    if (Data && Data->MainUI.IsValid())
     {
-        MainUI->FocusID(ItemID); 
+        Data->MainUI->FocusID(Data->GetID()); 
     }
 }
 
 void UGISPolyItem::OnDeleteClicked() 
 { 
-    if (MainUI.IsValid())
+    UGISPolyItemData* Data = ItemData.Get();
+    if (Data && Data->MainUI.IsValid())
     {
-        MainUI->DeleteID(ItemID); 
+        Data->MainUI->DeleteID(Data->GetID()); 
     }
-    this->RemoveFromParent(); 
 }
 
 void UGISPolyItem::OnEditClicked() 
 { 
-    if (MainUI.IsValid())
+    UGISPolyItemData* Data = ItemData.Get();
+    if (Data && Data->MainUI.IsValid())
     {
-        MainUI->OpenEditDialog(this); 
+        Data->MainUI->OpenEditDialog(Data); 
     }
-}
\ No newline at end of file
+}
@@ -2,16 +2,19 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Blueprint/IUserObjectListEntry.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
-#include "Components/VerticalBox.h"
 #include "Components/Border.h"
+#include "GISPolyItemData.h"
 #include "GISPolyItem.generated.h"
 
 class UGISWebWidget;
 
+// TreeView 的行控件：只有可见行会被实例化，滚动时复用并重新绑定到 UGISPolyItemData
+// (旧版蓝图的滚动列表中则由主界面为每个要素创建一行)
 UCLASS()
-class CITYGIS_API UGISPolyItem : public UUserWidget
+class CITYGIS_API UGISPolyItem : public UUserWidget, public IUserObjectListEntry
 {
     GENERATED_BODY()
     friend class UGISWebWidget;
@@ -19,41 +22,17 @@ class CITYGIS_API UGISPolyItem : public UUserWidget
 public:
     virtual void NativeConstruct() override;
 
-    void SetupItem(FString InID, FString InName, FString InType, FString InParentID, FString InColor, float InOpacity, FString InTextColor, FString InTag, float InHeight, UGISWebWidget* InMainUI);
+    // 数据变化后刷新显示 (行可能已被复用到其它数据上)
+    void RefreshFromData();
 
-    void AddChildItem(UGISPolyItem* ChildWidget);
-    void UpdateData(FString NewName, FString NewColor, float NewOpacity, FString NewTextColor, FString NewParentID);
-
-    FString GetItemID() const 
-    { 
-        return ItemID; 
-    }
-    FString GetItemName() const 
-    { 
-        return ItemName; 
-    }
-    FString GetItemColor() const 
-    { 
-        return ItemColor; 
-    }
-    float GetItemOpacity() const 
-    { 
-        return ItemOpacity; 
-    }
-    FString GetItemTextColor() const 
-    { 
-        return ItemTextColor; 
-    }
-    FString GetItemParentID() const 
-    { 
-        return ItemParentID; 
-    }
-    FString GetItemType() const 
+    UGISPolyItemData* GetItemData() const 
     { 
-        return ItemType; 
+        return ItemData.Get(); 
     }
 
 protected:
+    virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+
     UPROPERTY(meta = (BindWidget))
     UButton* Btn_Edit;
 
@@ -69,9 +48,6 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (BindWidget))
     UButton* Btn_Delete;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (BindWidget))
-    UVerticalBox* Child_Container;
-
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (BindWidget))
     UBorder* Content_Border;
 
@@ -85,15 +61,5 @@ private:
     UFUNCTION()
     void OnEditClicked();
 
-    FString ItemID;
-    FString ItemName;
-    FString ItemType;
-    FString ItemColor;
-    float ItemOpacity;
-    FString ItemTextColor;
-    FString ItemTag;
-    float ItemHeight;
-    FString ItemParentID;
-
-    TWeakObjectPtr<UGISWebWidget> MainUI;
-};
\ No newline at end of file
+    TWeakObjectPtr<UGISPolyItemData> ItemData;
+};
@@ -0,0 +1,67 @@
+#include "GISPolyItemData.h"
+#include "GISWebWidget.h"
+
+void UGISPolyItemData::Init(FGISFeatureHandle InHandle, UGISWebWidget* InMainUI)
+{
+	Handle = InHandle;
+	MainUI = InMainUI;
+}
+
+const FGISFeatureStore* UGISPolyItemData::GetStore() const
+{
+	const UGISWebWidget* UI = MainUI.Get();
+	return UI ? &UI->GetFeatureStore() : nullptr;
+}
+
+FString UGISPolyItemData::GetID() const
+{
+	const FGISFeatureStore* Store = GetStore();
+	return Store ? Store->GetID(Handle) : FString();
+}
+
+FString UGISPolyItemData::GetName() const
+{
+	const FGISFeatureStore* Store = GetStore();
+	return Store ? Store->GetName(Handle) : FString();
+}
+
+EGISFeatureType UGISPolyItemData::GetType() const
+{
+	const FGISFeatureStore* Store = GetStore();
+	return Store ? Store->GetType(Handle) : EGISFeatureType::Custom;
+}
+
+FString UGISPolyItemData::GetParentID() const
+{
+	const FGISFeatureStore* Store = GetStore();
+	return Store ? Store->GetParentID(Handle) : FString();
+}
+
+UGISPolyItemData* UGISPolyItemData::GetParentItem() const
+{
+	const UGISWebWidget* UI = MainUI.Get();
+	return UI ? UI->GetItemByHandle(UI->GetFeatureStore().GetParent(Handle)) : nullptr;
+}
+
+FString UGISPolyItemData::GetDisplayType() const
+{
+	const FGISFeatureStore* Store = GetStore();
+	if (!Store || !Store->IsValid(Handle))
+	{
+		return FString();
+	}
+
+	FString DisplayType = GISFeatureType::GetDisplayName(Store->GetType(Handle));
+
+	const FString& Tag = Store->GetTag(Handle);
+	if (!Tag.IsEmpty())
+	{
+		DisplayType += TEXT(" | ") + Tag;
+	}
+	const float Height = Store->GetHeight(Handle);
+	if (Height > 0)
+	{
+		DisplayType += FString::Printf(TEXT(" | H:%.0fm"), Height);
+	}
+	return DisplayType;
+}
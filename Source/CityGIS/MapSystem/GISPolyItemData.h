@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GISFeatureStore.h"
+#include "GISPolyItemData.generated.h"
+
+class UGISWebWidget;
+
+/**
+ * 列表中一个要素的数据节点 (TreeView 的 ListItem)
+ * 行控件 UGISPolyItem 只在可见时生成并被复用；要素属性与层级关系 (区镇->街道->小区) 都保存在主界面的 FGISFeatureStore 中，
+ * 这里只记录要素句柄，访问器从存储中读取
+ */
+UCLASS()
+class CITYGIS_API UGISPolyItemData : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(FGISFeatureHandle InHandle, UGISWebWidget* InMainUI);
+
+	FString GetID() const;
+	FString GetName() const;
+	EGISFeatureType GetType() const;
+	FString GetParentID() const;
+
+	// 供 UI 显示的类型文本，例如 "街道 | 310101 | H:20m"
+	FString GetDisplayType() const;
+
+	UGISPolyItemData* GetParentItem() const;
+
+	TWeakObjectPtr<UGISWebWidget> MainUI;
+
+	// 在主界面要素存储中的句柄
+	FGISFeatureHandle Handle;
+
+private:
+	const FGISFeatureStore* GetStore() const;
+};
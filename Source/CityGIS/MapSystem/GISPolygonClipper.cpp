@@ -0,0 +1,929 @@
+#include "GISPolygonClipper.h"
+
+namespace
+{
+	enum class EEdgeType : uint8
+	{
+		Normal,
+		NonContributing,
+		SameTransition,
+		DifferentTransition
+	};
+
+	// 三点有向面积的两倍：>0 表示 P0->P1->P2 逆时针
+	FORCEINLINE double TriangleArea(const FVector2D& P0, const FVector2D& P1, const FVector2D& P2)
+	{
+		return (P0.X - P2.X) * (P1.Y - P2.Y) - (P1.X - P2.X) * (P0.Y - P2.Y);
+	}
+
+	struct FSweepEvent
+	{
+		FVector2D Point;
+		FSweepEvent* Other = nullptr;
+		FSweepEvent* PrevInResult = nullptr;
+		int32 ContourId = 0;
+		int32 OutputContourId = INDEX_NONE;
+		int32 OtherPos = INDEX_NONE;
+		EEdgeType Type = EEdgeType::Normal;
+		int8 ResultTransition = 0;
+		bool bLeft = false;
+		bool bSubject = true;
+		bool bInOut = false;
+		bool bOtherInOut = false;
+
+		bool IsInResult() const
+		{
+			return ResultTransition != 0;
+		}
+
+		bool IsVertical() const
+		{
+			return Point.X == Other->Point.X;
+		}
+
+		bool IsBelow(const FVector2D& P) const
+		{
+			return bLeft ? TriangleArea(Point, Other->Point, P) > 0.0 : TriangleArea(Other->Point, Point, P) > 0.0;
+		}
+
+		bool IsAbove(const FVector2D& P) const
+		{
+			return !IsBelow(P);
+		}
+	};
+
+	// 事件处理顺序：>0 表示 E1 晚于 E2 处理
+	int32 CompareEvents(const FSweepEvent* E1, const FSweepEvent* E2)
+	{
+		const FVector2D& P1 = E1->Point;
+		const FVector2D& P2 = E2->Point;
+
+		if (P1.X != P2.X)
+		{
+			return P1.X > P2.X ? 1 : -1;
+		}
+		if (P1.Y != P2.Y)
+		{
+			return P1.Y > P2.Y ? 1 : -1;
+		}
+
+		// 同一点：右端点先于左端点
+		if (E1->bLeft != E2->bLeft)
+		{
+			return E1->bLeft ? 1 : -1;
+		}
+
+		// 同一点同侧：下方的线段先处理
+		if (TriangleArea(P1, E1->Other->Point, E2->Other->Point) != 0.0)
+		{
+			return !E1->IsBelow(E2->Other->Point) ? 1 : -1;
+		}
+
+		return (!E1->bSubject && E2->bSubject) ? 1 : -1;
+	}
+
+	// 扫描线状态中两条线段的上下顺序
+	int32 CompareSegments(const FSweepEvent* Le1, const FSweepEvent* Le2)
+	{
+		if (Le1 == Le2)
+		{
+			return 0;
+		}
+
+		if (TriangleArea(Le1->Point, Le1->Other->Point, Le2->Point) != 0.0 ||
+			TriangleArea(Le1->Point, Le1->Other->Point, Le2->Other->Point) != 0.0)
+		{
+			// 不共线
+			if (Le1->Point == Le2->Point)
+			{
+				return Le1->IsBelow(Le2->Other->Point) ? -1 : 1;
+			}
+			if (Le1->Point.X == Le2->Point.X)
+			{
+				return Le1->Point.Y < Le2->Point.Y ? -1 : 1;
+			}
+			if (CompareEvents(Le1, Le2) == 1)
+			{
+				return Le2->IsAbove(Le1->Point) ? -1 : 1;
+			}
+			return Le1->IsBelow(Le2->Point) ? -1 : 1;
+		}
+
+		if (Le1->bSubject == Le2->bSubject)
+		{
+			// 同一多边形的共线边
+			if (Le1->Point == Le2->Point)
+			{
+				if (Le1->Other->Point == Le2->Other->Point)
+				{
+					return 0;
+				}
+				return Le1->ContourId > Le2->ContourId ? 1 : -1;
+			}
+		}
+		else
+		{
+			// 共线但分属两个多边形
+			return Le1->bSubject ? -1 : 1;
+		}
+
+		return CompareEvents(Le1, Le2) == 1 ? 1 : -1;
+	}
+
+	// 以 CompareEvents 为序的最小堆
+	class FEventQueue
+	{
+	public:
+		void Push(FSweepEvent* Event)
+		{
+			int32 Index = Heap.Add(Event);
+			while (Index > 0)
+			{
+				const int32 Parent = (Index - 1) / 2;
+				if (CompareEvents(Heap[Index], Heap[Parent]) >= 0)
+				{
+					break;
+				}
+				Swap(Heap[Index], Heap[Parent]);
+				Index = Parent;
+			}
+		}
+
+		FSweepEvent* Pop()
+		{
+			FSweepEvent* Top = Heap[0];
+			FSweepEvent* Last = Heap.Pop();
+			if (Heap.Num() > 0)
+			{
+				Heap[0] = Last;
+				int32 Index = 0;
+				const int32 Num = Heap.Num();
+				while (true)
+				{
+					const int32 Left = Index * 2 + 1;
+					const int32 Right = Left + 1;
+					int32 Smallest = Index;
+					if (Left < Num && CompareEvents(Heap[Left], Heap[Smallest]) < 0)
+					{
+						Smallest = Left;
+					}
+					if (Right < Num && CompareEvents(Heap[Right], Heap[Smallest]) < 0)
+					{
+						Smallest = Right;
+					}
+					if (Smallest == Index)
+					{
+						break;
+					}
+					Swap(Heap[Index], Heap[Smallest]);
+					Index = Smallest;
+				}
+			}
+			return Top;
+		}
+
+		bool IsEmpty() const
+		{
+			return Heap.Num() == 0;
+		}
+
+	private:
+		TArray<FSweepEvent*> Heap;
+	};
+
+	// 扫描线状态：按 CompareSegments 排序的数组
+	// 同时与扫描线相交的线段一般只有 O(sqrt(n)) 条，有序数组的插入/删除比平衡树更省
+	class FSweepLine
+	{
+	public:
+		int32 Insert(FSweepEvent* Event)
+		{
+			int32 Low = 0;
+			int32 High = Segments.Num();
+			while (Low < High)
+			{
+				const int32 Mid = (Low + High) / 2;
+				if (CompareSegments(Segments[Mid], Event) < 0)
+				{
+					Low = Mid + 1;
+				}
+				else
+				{
+					High = Mid;
+				}
+			}
+			Segments.Insert(Event, Low);
+			return Low;
+		}
+
+		int32 Find(const FSweepEvent* Event) const
+		{
+			int32 Low = 0;
+			int32 High = Segments.Num();
+			while (Low < High)
+			{
+				const int32 Mid = (Low + High) / 2;
+				if (CompareSegments(Segments[Mid], Event) < 0)
+				{
+					Low = Mid + 1;
+				}
+				else
+				{
+					High = Mid;
+				}
+			}
+			for (int32 Index = Low; Index < Segments.Num() && CompareSegments(Segments[Index], Event) == 0; ++Index)
+			{
+				if (Segments[Index] == Event)
+				{
+					return Index;
+				}
+			}
+			// 数值误差可能让顺序局部失效，退化为线性查找
+			return Segments.Find(const_cast<FSweepEvent*>(Event));
+		}
+
+		void RemoveAt(int32 Index)
+		{
+			Segments.RemoveAt(Index);
+		}
+
+		FSweepEvent* Get(int32 Index) const
+		{
+			return Segments.IsValidIndex(Index) ? Segments[Index] : nullptr;
+		}
+
+	private:
+		TArray<FSweepEvent*> Segments;
+	};
+
+	struct FContour
+	{
+		FGISRing Points;
+		TArray<int32> HoleIds;
+		int32 HoleOf = INDEX_NONE;
+		int32 Depth = 0;
+	};
+
+	class FMartinezClipper
+	{
+	public:
+		explicit FMartinezClipper(EGISClipOperation InOperation)
+			: Operation(InOperation)
+		{
+		}
+
+		FGISMultiPolygon Run(const FGISMultiPolygon& Subject, const FGISMultiPolygon& Clipping)
+		{
+			FBox2D SubjectBounds(ForceInit);
+			FBox2D ClippingBounds(ForceInit);
+			int32 ContourId = 0;
+			FillQueue(Subject, true, ContourId, SubjectBounds);
+			FillQueue(Clipping, false, ContourId, ClippingBounds);
+
+			TArray<FSweepEvent*> SortedEvents = SubdivideSegments(SubjectBounds, ClippingBounds);
+			return ConnectEdges(SortedEvents);
+		}
+
+	private:
+		FSweepEvent* NewEvent(const FVector2D& Point, bool bLeft, FSweepEvent* Other, bool bSubject)
+		{
+			FSweepEvent* Event = Pool.Add_GetRef(MakeUnique<FSweepEvent>()).Get();
+			Event->Point = Point;
+			Event->bLeft = bLeft;
+			Event->Other = Other;
+			Event->bSubject = bSubject;
+			return Event;
+		}
+
+		void FillQueue(const FGISMultiPolygon& Geometry, bool bSubject, int32& ContourId, FBox2D& OutBounds)
+		{
+			for (const FGISPolygon& Polygon : Geometry)
+			{
+				++ContourId;
+				for (const FGISRing& Ring : Polygon.Rings)
+				{
+					const int32 Num = Ring.Num();
+					if (Num < 3)
+					{
+						continue;
+					}
+
+					// 未闭合的环补上闭合边
+					const int32 EdgeCount = Ring[0] == Ring.Last() ? Num - 1 : Num;
+					for (int32 Idx = 0; Idx < EdgeCount; ++Idx)
+					{
+						const FVector2D& S1 = Ring[Idx];
+						const FVector2D& S2 = Ring[(Idx + 1) % Num];
+						if (S1 == S2)
+						{
+							continue;
+						}
+
+						FSweepEvent* E1 = NewEvent(S1, false, nullptr, bSubject);
+						FSweepEvent* E2 = NewEvent(S2, false, E1, bSubject);
+						E1->Other = E2;
+						E1->ContourId = E2->ContourId = ContourId;
+
+						if (CompareEvents(E1, E2) > 0)
+						{
+							E2->bLeft = true;
+						}
+						else
+						{
+							E1->bLeft = true;
+						}
+
+						OutBounds += S1;
+						Queue.Push(E1);
+						Queue.Push(E2);
+					}
+				}
+			}
+		}
+
+		bool InResult(const FSweepEvent* Event) const
+		{
+			switch (Event->Type)
+			{
+			case EEdgeType::Normal:
+				switch (Operation)
+				{
+				case EGISClipOperation::Intersection:
+					return !Event->bOtherInOut;
+				case EGISClipOperation::Union:
+					return Event->bOtherInOut;
+				case EGISClipOperation::Difference:
+					return (Event->bSubject && Event->bOtherInOut) || (!Event->bSubject && !Event->bOtherInOut);
+				case EGISClipOperation::Xor:
+					return true;
+				}
+				break;
+			case EEdgeType::SameTransition:
+				return Operation == EGISClipOperation::Intersection || Operation == EGISClipOperation::Union;
+			case EEdgeType::DifferentTransition:
+				return Operation == EGISClipOperation::Difference;
+			case EEdgeType::NonContributing:
+				return false;
+			}
+			return false;
+		}
+
+		int8 DetermineResultTransition(const FSweepEvent* Event) const
+		{
+			const bool bThisIn = !Event->bInOut;
+			const bool bThatIn = !Event->bOtherInOut;
+			bool bIsIn = false;
+			switch (Operation)
+			{
+			case EGISClipOperation::Intersection:
+				bIsIn = bThisIn && bThatIn;
+				break;
+			case EGISClipOperation::Union:
+				bIsIn = bThisIn || bThatIn;
+				break;
+			case EGISClipOperation::Xor:
+				bIsIn = bThisIn != bThatIn;
+				break;
+			case EGISClipOperation::Difference:
+				bIsIn = Event->bSubject ? (bThisIn && !bThatIn) : (bThatIn && !bThisIn);
+				break;
+			}
+			return bIsIn ? 1 : -1;
+		}
+
+		void ComputeFields(FSweepEvent* Event, FSweepEvent* Prev) const
+		{
+			if (!Prev)
+			{
+				Event->bInOut = false;
+				Event->bOtherInOut = true;
+			}
+			else
+			{
+				if (Event->bSubject == Prev->bSubject)
+				{
+					Event->bInOut = !Prev->bInOut;
+					Event->bOtherInOut = Prev->bOtherInOut;
+				}
+				else
+				{
+					Event->bInOut = !Prev->bOtherInOut;
+					Event->bOtherInOut = Prev->IsVertical() ? !Prev->bInOut : Prev->bInOut;
+				}
+				Event->PrevInResult = (!Prev->IsInResult() || Prev->IsVertical()) ? Prev->PrevInResult : Prev;
+			}
+
+			Event->ResultTransition = InResult(Event) ? DetermineResultTransition(Event) : 0;
+		}
+
+		// 线段求交：返回交点数 (0/1/2，2 表示共线重叠段的两个端点)
+		static int32 SegmentIntersection(const FVector2D& A1, const FVector2D& A2, const FVector2D& B1, const FVector2D& B2, FVector2D& OutP0, FVector2D& OutP1)
+		{
+			const FVector2D VA = A2 - A1;
+			const FVector2D VB = B2 - B1;
+			const FVector2D E = B1 - A1;
+
+			double Kross = FVector2D::CrossProduct(VA, VB);
+			if (Kross * Kross > 0.0)
+			{
+				const double S = FVector2D::CrossProduct(E, VB) / Kross;
+				if (S < 0.0 || S > 1.0)
+				{
+					return 0;
+				}
+				const double T = FVector2D::CrossProduct(E, VA) / Kross;
+				if (T < 0.0 || T > 1.0)
+				{
+					return 0;
+				}
+				if (S == 0.0 || S == 1.0)
+				{
+					OutP0 = A1 + VA * S;
+					return 1;
+				}
+				if (T == 0.0 || T == 1.0)
+				{
+					OutP0 = B1 + VB * T;
+					return 1;
+				}
+				OutP0 = A1 + VA * S;
+				return 1;
+			}
+
+			Kross = FVector2D::CrossProduct(E, VA);
+			if (Kross * Kross > 0.0)
+			{
+				// 平行不共线
+				return 0;
+			}
+
+			const double SqrLenA = FVector2D::DotProduct(VA, VA);
+			const double SA = FVector2D::DotProduct(VA, E) / SqrLenA;
+			const double SB = SA + FVector2D::DotProduct(VA, VB) / SqrLenA;
+			const double SMin = FMath::Min(SA, SB);
+			const double SMax = FMath::Max(SA, SB);
+
+			if (SMin <= 1.0 && SMax >= 0.0)
+			{
+				if (SMin == 1.0)
+				{
+					OutP0 = A1 + VA * (SMin > 0.0 ? SMin : 0.0);
+					return 1;
+				}
+				if (SMax == 0.0)
+				{
+					OutP0 = A1 + VA * (SMax < 1.0 ? SMax : 1.0);
+					return 1;
+				}
+				OutP0 = A1 + VA * (SMin > 0.0 ? SMin : 0.0);
+				OutP1 = A1 + VA * (SMax < 1.0 ? SMax : 1.0);
+				return 2;
+			}
+			return 0;
+		}
+
+		void DivideSegment(FSweepEvent* Event, const FVector2D& Point)
+		{
+			FSweepEvent* Right = NewEvent(Point, false, Event, Event->bSubject);
+			FSweepEvent* Left = NewEvent(Point, true, Event->Other, Event->bSubject);
+			Right->ContourId = Left->ContourId = Event->ContourId;
+
+			// 避免舍入误差导致左端点晚于右端点处理
+			if (CompareEvents(Left, Event->Other) > 0)
+			{
+				Event->Other->bLeft = true;
+				Left->bLeft = false;
+			}
+
+			Event->Other->Other = Left;
+			Event->Other = Right;
+
+			Queue.Push(Left);
+			Queue.Push(Right);
+		}
+
+		int32 PossibleIntersection(FSweepEvent* Se1, FSweepEvent* Se2)
+		{
+			FVector2D Inter0;
+			FVector2D Inter1;
+			const int32 NumIntersections = SegmentIntersection(Se1->Point, Se1->Other->Point, Se2->Point, Se2->Other->Point, Inter0, Inter1);
+
+			if (NumIntersections == 0)
+			{
+				return 0;
+			}
+
+			// 只在两条线段的端点处相接
+			if (NumIntersections == 1 && (Se1->Point == Se2->Point || Se1->Other->Point == Se2->Other->Point))
+			{
+				return 0;
+			}
+
+			// 同一多边形内部的重叠边不处理
+			if (NumIntersections == 2 && Se1->bSubject == Se2->bSubject)
+			{
+				return 0;
+			}
+
+			if (NumIntersections == 1)
+			{
+				if (Se1->Point != Inter0 && Se1->Other->Point != Inter0)
+				{
+					DivideSegment(Se1, Inter0);
+				}
+				if (Se2->Point != Inter0 && Se2->Other->Point != Inter0)
+				{
+					DivideSegment(Se2, Inter0);
+				}
+				return 1;
+			}
+
+			// 两条线段共线重叠
+			TArray<FSweepEvent*, TInlineAllocator<4>> Events;
+			bool bLeftCoincide = false;
+			bool bRightCoincide = false;
+
+			if (Se1->Point == Se2->Point)
+			{
+				bLeftCoincide = true;
+			}
+			else if (CompareEvents(Se1, Se2) == 1)
+			{
+				Events.Add(Se2);
+				Events.Add(Se1);
+			}
+			else
+			{
+				Events.Add(Se1);
+				Events.Add(Se2);
+			}
+
+			if (Se1->Other->Point == Se2->Other->Point)
+			{
+				bRightCoincide = true;
+			}
+			else if (CompareEvents(Se1->Other, Se2->Other) == 1)
+			{
+				Events.Add(Se2->Other);
+				Events.Add(Se1->Other);
+			}
+			else
+			{
+				Events.Add(Se1->Other);
+				Events.Add(Se2->Other);
+			}
+
+			if (bLeftCoincide)
+			{
+				// 两线段相同，或共享左端点
+				Se2->Type = EEdgeType::NonContributing;
+				Se1->Type = (Se2->bInOut == Se1->bInOut) ? EEdgeType::SameTransition : EEdgeType::DifferentTransition;
+
+				if (!bRightCoincide)
+				{
+					DivideSegment(Events[1]->Other, Events[0]->Point);
+				}
+				return 2;
+			}
+
+			if (bRightCoincide)
+			{
+				// 共享右端点
+				DivideSegment(Events[0], Events[1]->Point);
+				return 3;
+			}
+
+			if (Events[0] != Events[3]->Other)
+			{
+				// 部分重叠
+				DivideSegment(Events[0], Events[1]->Point);
+				DivideSegment(Events[1], Events[2]->Point);
+				return 3;
+			}
+
+			// 一条线段完全包含另一条
+			DivideSegment(Events[0], Events[1]->Point);
+			DivideSegment(Events[3]->Other, Events[2]->Point);
+			return 3;
+		}
+
+		TArray<FSweepEvent*> SubdivideSegments(const FBox2D& SubjectBounds, const FBox2D& ClippingBounds)
+		{
+			TArray<FSweepEvent*> SortedEvents;
+			SortedEvents.Reserve(Pool.Num());
+
+			const double RightBound = FMath::Min(SubjectBounds.Max.X, ClippingBounds.Max.X);
+
+			while (!Queue.IsEmpty())
+			{
+				FSweepEvent* Event = Queue.Pop();
+				SortedEvents.Add(Event);
+
+				// 交集/差集超出范围后不可能再产生结果
+				if ((Operation == EGISClipOperation::Intersection && Event->Point.X > RightBound) ||
+					(Operation == EGISClipOperation::Difference && Event->Point.X > SubjectBounds.Max.X))
+				{
+					break;
+				}
+
+				if (Event->bLeft)
+				{
+					const int32 Index = SweepLine.Insert(Event);
+					FSweepEvent* Prev = SweepLine.Get(Index - 1);
+					FSweepEvent* Next = SweepLine.Get(Index + 1);
+
+					ComputeFields(Event, Prev);
+
+					if (Next && PossibleIntersection(Event, Next) == 2)
+					{
+						ComputeFields(Event, Prev);
+						ComputeFields(Next, Event);
+					}
+
+					if (Prev && PossibleIntersection(Prev, Event) == 2)
+					{
+						ComputeFields(Prev, SweepLine.Get(Index - 2));
+						ComputeFields(Event, Prev);
+					}
+				}
+				else
+				{
+					FSweepEvent* LeftEvent = Event->Other;
+					const int32 Index = SweepLine.Find(LeftEvent);
+					if (Index != INDEX_NONE)
+					{
+						FSweepEvent* Prev = SweepLine.Get(Index - 1);
+						FSweepEvent* Next = SweepLine.Get(Index + 1);
+						SweepLine.RemoveAt(Index);
+
+						if (Prev && Next)
+						{
+							PossibleIntersection(Prev, Next);
+						}
+					}
+				}
+			}
+
+			return SortedEvents;
+		}
+
+		static TArray<FSweepEvent*> OrderEvents(const TArray<FSweepEvent*>& SortedEvents)
+		{
+			TArray<FSweepEvent*> ResultEvents;
+			for (FSweepEvent* Event : SortedEvents)
+			{
+				if ((Event->bLeft && Event->IsInResult()) || (!Event->bLeft && Event->Other->IsInResult()))
+				{
+					ResultEvents.Add(Event);
+				}
+			}
+
+			// 重叠边可能打乱局部顺序，插入排序在近乎有序时为线性
+			for (int32 i = 1; i < ResultEvents.Num(); ++i)
+			{
+				FSweepEvent* Current = ResultEvents[i];
+				int32 j = i - 1;
+				while (j >= 0 && CompareEvents(ResultEvents[j], Current) == 1)
+				{
+					ResultEvents[j + 1] = ResultEvents[j];
+					--j;
+				}
+				ResultEvents[j + 1] = Current;
+			}
+
+			for (int32 i = 0; i < ResultEvents.Num(); ++i)
+			{
+				ResultEvents[i]->OtherPos = i;
+			}
+
+			// 右端点可能在左端点被标记之前出现
+			for (FSweepEvent* Event : ResultEvents)
+			{
+				if (!Event->bLeft)
+				{
+					Swap(Event->OtherPos, Event->Other->OtherPos);
+				}
+			}
+			return ResultEvents;
+		}
+
+		static int32 NextPos(int32 Pos, const TArray<FSweepEvent*>& ResultEvents, const TBitArray<>& Processed, int32 OrigPos)
+		{
+			const int32 Num = ResultEvents.Num();
+			const FVector2D& P = ResultEvents[Pos]->Point;
+
+			int32 NewPos = Pos + 1;
+			while (NewPos < Num && ResultEvents[NewPos]->Point == P)
+			{
+				if (!Processed[NewPos])
+				{
+					return NewPos;
+				}
+				++NewPos;
+			}
+
+			NewPos = Pos - 1;
+			while (NewPos > OrigPos && Processed[NewPos])
+			{
+				--NewPos;
+			}
+			return NewPos;
+		}
+
+		static FContour InitializeContour(const FSweepEvent* Event, TArray<FContour>& Contours, int32 ContourId)
+		{
+			FContour Contour;
+			if (const FSweepEvent* Lower = Event->PrevInResult)
+			{
+				const int32 LowerContourId = Lower->OutputContourId;
+				if (Contours.IsValidIndex(LowerContourId))
+				{
+					if (Lower->ResultTransition > 0)
+					{
+						// 位于结果内部：下方是洞则与其同级，下方是外环则成为它的洞
+						FContour& LowerContour = Contours[LowerContourId];
+						if (LowerContour.HoleOf != INDEX_NONE)
+						{
+							const int32 ParentId = LowerContour.HoleOf;
+							Contours[ParentId].HoleIds.Add(ContourId);
+							Contour.HoleOf = ParentId;
+							Contour.Depth = LowerContour.Depth;
+						}
+						else
+						{
+							LowerContour.HoleIds.Add(ContourId);
+							Contour.HoleOf = LowerContourId;
+							Contour.Depth = LowerContour.Depth + 1;
+						}
+					}
+					else
+					{
+						Contour.Depth = Contours[LowerContourId].Depth;
+					}
+				}
+			}
+			return Contour;
+		}
+
+		static FGISMultiPolygon ConnectEdges(const TArray<FSweepEvent*>& SortedEvents)
+		{
+			TArray<FSweepEvent*> ResultEvents = OrderEvents(SortedEvents);
+			const int32 Num = ResultEvents.Num();
+
+			TBitArray<> Processed(false, Num);
+			TArray<FContour> Contours;
+
+			for (int32 i = 0; i < Num; ++i)
+			{
+				if (Processed[i])
+				{
+					continue;
+				}
+
+				const int32 ContourId = Contours.Num();
+				FContour Contour = InitializeContour(ResultEvents[i], Contours, ContourId);
+
+				auto MarkAsProcessed = [&](int32 Pos)
+				{
+					Processed[Pos] = true;
+					ResultEvents[Pos]->OutputContourId = ContourId;
+				};
+
+				int32 Pos = i;
+				const int32 OrigPos = i;
+				Contour.Points.Add(ResultEvents[i]->Point);
+
+				while (true)
+				{
+					MarkAsProcessed(Pos);
+					Pos = ResultEvents[Pos]->OtherPos;
+					MarkAsProcessed(Pos);
+					Contour.Points.Add(ResultEvents[Pos]->Point);
+
+					Pos = NextPos(Pos, ResultEvents, Processed, OrigPos);
+					if (Pos == OrigPos || Pos < 0 || Pos >= Num)
+					{
+						break;
+					}
+				}
+
+				Contours.Add(MoveTemp(Contour));
+			}
+
+			FGISMultiPolygon Result;
+			for (FContour& Contour : Contours)
+			{
+				if (Contour.HoleOf != INDEX_NONE)
+				{
+					continue;
+				}
+
+				FGISPolygon& Polygon = Result.AddDefaulted_GetRef();
+				Polygon.Rings.Add(MoveTemp(Contour.Points));
+				for (int32 HoleId : Contour.HoleIds)
+				{
+					Polygon.Rings.Add(MoveTemp(Contours[HoleId].Points));
+				}
+			}
+
+			GISGeometry::Normalize(Result);
+			return Result;
+		}
+
+		EGISClipOperation Operation;
+		TArray<TUniquePtr<FSweepEvent>> Pool;
+		FEventQueue Queue;
+		FSweepLine SweepLine;
+	};
+
+	bool IsEmptyGeometry(const FGISMultiPolygon& Geometry)
+	{
+		for (const FGISPolygon& Polygon : Geometry)
+		{
+			if (Polygon.Rings.Num() > 0 && Polygon.Rings[0].Num() >= 3)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+FGISMultiPolygon FGISPolygonClipper::Compute(const FGISMultiPolygon& Subject, const FGISMultiPolygon& Clipping, EGISClipOperation Operation)
+{
+	// 平凡情况：任一为空
+	const bool bSubjectEmpty = IsEmptyGeometry(Subject);
+	const bool bClippingEmpty = IsEmptyGeometry(Clipping);
+	if (bSubjectEmpty || bClippingEmpty)
+	{
+		switch (Operation)
+		{
+		case EGISClipOperation::Intersection:
+			return FGISMultiPolygon();
+		case EGISClipOperation::Difference:
+			return Subject;
+		default:
+			return bSubjectEmpty ? Clipping : Subject;
+		}
+	}
+
+	// 平凡情况：包围盒不相交
+	const FBox2D SubjectBounds = GISGeometry::ComputeBounds(Subject);
+	const FBox2D ClippingBounds = GISGeometry::ComputeBounds(Clipping);
+	if (!SubjectBounds.Intersect(ClippingBounds))
+	{
+		switch (Operation)
+		{
+		case EGISClipOperation::Intersection:
+			return FGISMultiPolygon();
+		case EGISClipOperation::Difference:
+			return Subject;
+		default:
+		{
+			FGISMultiPolygon Result = Subject;
+			Result.Append(Clipping);
+			return Result;
+		}
+		}
+	}
+
+	FMartinezClipper Clipper(Operation);
+	return Clipper.Run(Subject, Clipping);
+}
+
+FGISMultiPolygon FGISPolygonClipper::UnionAll(TArray<FGISMultiPolygon> Geometries)
+{
+	if (Geometries.Num() == 0)
+	{
+		return FGISMultiPolygon();
+	}
+
+	while (Geometries.Num() > 1)
+	{
+		TArray<FGISMultiPolygon> Merged;
+		Merged.Reserve(Geometries.Num() / 2 + 1);
+		for (int32 Idx = 0; Idx + 1 < Geometries.Num(); Idx += 2)
+		{
+			Merged.Add(Union(Geometries[Idx], Geometries[Idx + 1]));
+		}
+		if (Geometries.Num() % 2 == 1)
+		{
+			Merged.Add(MoveTemp(Geometries.Last()));
+		}
+		Geometries = MoveTemp(Merged);
+	}
+	return MoveTemp(Geometries[0]);
+}
+
+FGISMultiPolygon FGISPolygonClipper::Clean(const FGISMultiPolygon& Geometry)
+{
+	if (IsEmptyGeometry(Geometry))
+	{
+		return FGISMultiPolygon();
+	}
+
+	// 与空集求并：所有边都进入结果，自相交处被切分，内外按奇偶规则判定
+	FMartinezClipper Clipper(EGISClipOperation::Union);
+	return Clipper.Run(Geometry, FGISMultiPolygon());
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+enum class EGISClipOperation : uint8
+{
+	Intersection,
+	Union,
+	Difference,
+	Xor
+};
+
+/**
+ * 多边形布尔运算 (Martinez-Rueda-Feito 扫描线算法，双精度)
+ * 支持带洞多边形、多部件多边形和共线/重叠边；结果已 Normalize (外环逆时针、洞顺时针)
+ * 纯计算、无共享状态，可在工作线程中并行调用
+ */
+class CITYGIS_API FGISPolygonClipper
+{
+public:
+	static FGISMultiPolygon Compute(const FGISMultiPolygon& Subject, const FGISMultiPolygon& Clipping, EGISClipOperation Operation);
+
+	static FGISMultiPolygon Intersection(const FGISMultiPolygon& A, const FGISMultiPolygon& B)
+	{
+		return Compute(A, B, EGISClipOperation::Intersection);
+	}
+	static FGISMultiPolygon Union(const FGISMultiPolygon& A, const FGISMultiPolygon& B)
+	{
+		return Compute(A, B, EGISClipOperation::Union);
+	}
+	static FGISMultiPolygon Difference(const FGISMultiPolygon& A, const FGISMultiPolygon& B)
+	{
+		return Compute(A, B, EGISClipOperation::Difference);
+	}
+
+	// 两两归并求并集 (平衡树形合并，避免逐个折叠导致结果越滚越大)
+	static FGISMultiPolygon UnionAll(TArray<FGISMultiPolygon> Geometries);
+
+	// 修复自相交/重复边 (相当于 turf 的 buffer(0))，按奇偶规则重建轮廓
+	static FGISMultiPolygon Clean(const FGISMultiPolygon& Geometry);
+};
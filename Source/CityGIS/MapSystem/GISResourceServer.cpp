@@ -0,0 +1,267 @@
+#include "GISResourceServer.h"
+#include "WebBrowserModule.h"
+#include "IWebBrowserSingleton.h"
+#include "Misc/ScopeLock.h"
+#include "Async/Async.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISResourceServer, Log, All);
+
+const TCHAR* FGISResourceServer::Scheme = TEXT("https");
+const TCHAR* FGISResourceServer::Domain = TEXT("citygis.data");
+
+namespace
+{
+	// 单个请求的响应：按浏览器给的块大小逐段拷出，不一次性复制整份数据
+	class FGISResourceHandler : public IWebBrowserSchemeHandler
+	{
+	public:
+		FGISResourceHandler(TSharedPtr<const TArray<uint8>> InBytes, FString InMimeType)
+			: Bytes(MoveTemp(InBytes))
+			, MimeType(MoveTemp(InMimeType))
+		{
+		}
+
+		virtual bool ProcessRequest(const FString& Verb, const FString& Url, const FSimpleDelegate& OnHeadersReady) override
+		{
+			// 数据已在内存中，响应头立即可用
+			OnHeadersReady.ExecuteIfBound();
+			return true;
+		}
+
+		virtual void GetResponseHeaders(IHeaders* OutHeaders) override
+		{
+			// 页面从 file:// 加载，跨源读取需要 CORS 头
+			OutHeaders->SetHeader(TEXT("Access-Control-Allow-Origin"), TEXT("*"));
+			OutHeaders->SetHeader(TEXT("Cache-Control"), TEXT("no-store"));
+			if (!Bytes.IsValid())
+			{
+				OutHeaders->SetStatusCode(404);
+				OutHeaders->SetMimeType(TEXT("text/plain"));
+				OutHeaders->SetContentLength(0);
+				return;
+			}
+			OutHeaders->SetStatusCode(200);
+			OutHeaders->SetMimeType(*MimeType);
+			OutHeaders->SetContentLength(Bytes->Num());
+		}
+
+		virtual bool ReadResponse(uint8* OutBytes, int32 BytesToRead, int32& BytesRead, const FSimpleDelegate& OnMoreDataReady) override
+		{
+			const int32 Remaining = Bytes.IsValid() ? Bytes->Num() - Offset : 0;
+			BytesRead = FMath::Min(BytesToRead, Remaining);
+			if (BytesRead <= 0)
+			{
+				BytesRead = 0;
+				return false;
+			}
+			FMemory::Memcpy(OutBytes, Bytes->GetData() + Offset, BytesRead);
+			Offset += BytesRead;
+			return true;
+		}
+
+		virtual void Cancel() override
+		{
+		}
+
+		const FString& GetMimeType() const { return MimeType; }
+
+	private:
+		TSharedPtr<const TArray<uint8>> Bytes;
+		FString MimeType;
+		int32 Offset = 0;
+	};
+
+	// 按需生成的响应：生成在线程池中完成后再通知响应头就绪
+	// 浏览器可能先取消请求，生成结果放在共享状态里，处理器销毁后回调也不会访问悬空对象
+	class FGISProvidedResourceHandler : public IWebBrowserSchemeHandler
+	{
+	public:
+		FGISProvidedResourceHandler(TSharedPtr<const FGISResourceServer::FProvider> InProvider, FString InPath, FString InMimeType)
+			: Provider(MoveTemp(InProvider))
+			, Path(MoveTemp(InPath))
+			, State(MakeShared<FState, ESPMode::ThreadSafe>())
+		{
+			State->Inner = MakeUnique<FGISResourceHandler>(nullptr, MoveTemp(InMimeType));
+		}
+
+		virtual bool ProcessRequest(const FString& Verb, const FString& Url, const FSimpleDelegate& OnHeadersReady) override
+		{
+			Async(EAsyncExecution::ThreadPool, [Provider = Provider, Path = Path, State = State, OnHeadersReady]()
+			{
+				TSharedPtr<const TArray<uint8>> Bytes = (*Provider)(Path);
+				if (State->bCancelled)
+				{
+					return;
+				}
+				State->Inner = MakeUnique<FGISResourceHandler>(MoveTemp(Bytes), State->Inner->GetMimeType());
+				OnHeadersReady.ExecuteIfBound();
+			});
+			return true;
+		}
+
+		virtual void GetResponseHeaders(IHeaders* OutHeaders) override
+		{
+			State->Inner->GetResponseHeaders(OutHeaders);
+		}
+
+		virtual bool ReadResponse(uint8* OutBytes, int32 BytesToRead, int32& BytesRead, const FSimpleDelegate& OnMoreDataReady) override
+		{
+			return State->Inner->ReadResponse(OutBytes, BytesToRead, BytesRead, OnMoreDataReady);
+		}
+
+		virtual void Cancel() override
+		{
+			State->bCancelled = true;
+		}
+
+	private:
+		struct FState
+		{
+			TUniquePtr<FGISResourceHandler> Inner;
+			std::atomic<bool> bCancelled { false };
+		};
+
+		TSharedPtr<const FGISResourceServer::FProvider> Provider;
+		FString Path;
+		TSharedRef<FState, ESPMode::ThreadSafe> State;
+	};
+}
+
+FGISResourceServer::~FGISResourceServer()
+{
+	Unregister();
+}
+
+bool FGISResourceServer::Register()
+{
+	if (bRegistered)
+	{
+		return true;
+	}
+
+	IWebBrowserSingleton* Singleton = IWebBrowserModule::Get().GetSingleton();
+	if (!Singleton || !Singleton->RegisterSchemeHandlerFactory(Scheme, Domain, this))
+	{
+		UE_LOG(LogGISResourceServer, Warning, TEXT("无法注册网页资源通道 %s://%s，将退回脚本传参"), Scheme, Domain);
+		return false;
+	}
+	bRegistered = true;
+	return true;
+}
+
+void FGISResourceServer::Unregister()
+{
+	if (!bRegistered)
+	{
+		return;
+	}
+	bRegistered = false;
+
+	if (IWebBrowserModule::IsAvailable())
+	{
+		if (IWebBrowserSingleton* Singleton = IWebBrowserModule::Get().GetSingleton())
+		{
+			Singleton->UnregisterSchemeHandlerFactory(this);
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	Resources.Reset();
+	Providers.Reset();
+}
+
+FString FGISResourceServer::Publish(const FString& Name, TArray<uint8>&& Bytes, const FString& MimeType)
+{
+	FResource Resource;
+	Resource.Bytes = MakeShared<const TArray<uint8>>(MoveTemp(Bytes));
+	Resource.MimeType = MimeType;
+	Resource.Name = Name;
+
+	FString Key;
+	{
+		FScopeLock ScopeLock(&Lock);
+		Resource.Version = ++Serial;
+		Key = FString::Printf(TEXT("%s?v=%d"), *Name, Resource.Version);
+
+		// 同名未读取的超过上限时丢弃最旧的一份
+		int32 NumPending = 0;
+		const FString* Oldest = nullptr;
+		int32 OldestVersion = MAX_int32;
+		for (const TPair<FString, FResource>& Pair : Resources)
+		{
+			if (Pair.Value.Name == Name)
+			{
+				++NumPending;
+				if (Pair.Value.Version < OldestVersion)
+				{
+					OldestVersion = Pair.Value.Version;
+					Oldest = &Pair.Key;
+				}
+			}
+		}
+		if (NumPending >= MaxPendingPerName && Oldest)
+		{
+			UE_LOG(LogGISResourceServer, Warning, TEXT("网页资源 %s 一直未被读取，已丢弃"), **Oldest);
+			Resources.Remove(FString(*Oldest));
+		}
+		Resources.Add(Key, MoveTemp(Resource));
+	}
+	return FString::Printf(TEXT("%s://%s/%s"), Scheme, Domain, *Key);
+}
+
+FString FGISResourceServer::AddProvider(const FString& Prefix, FProvider Provider, const FString& MimeType)
+{
+	FProviderEntry Entry;
+	Entry.Prefix = Prefix;
+	Entry.Provider = MakeShared<const FProvider>(MoveTemp(Provider));
+	Entry.MimeType = MimeType;
+	{
+		FScopeLock ScopeLock(&Lock);
+		Providers.RemoveAll([&Prefix](const FProviderEntry& Existing) { return Existing.Prefix == Prefix; });
+		Providers.Add(MoveTemp(Entry));
+	}
+	return FString::Printf(TEXT("%s://%s/%s"), Scheme, Domain, *Prefix);
+}
+
+void FGISResourceServer::RemoveProvider(const FString& Prefix)
+{
+	FScopeLock ScopeLock(&Lock);
+	Providers.RemoveAll([&Prefix](const FProviderEntry& Existing) { return Existing.Prefix == Prefix; });
+}
+
+TUniquePtr<IWebBrowserSchemeHandler> FGISResourceServer::Create(FString Verb, FString Url)
+{
+	// https://citygis.data/<名称>?v=<序号>：发布的数据按带序号的完整路径查找，提供者按不含查询串的名称匹配
+	FString Key = Url;
+	const FString Prefix = FString::Printf(TEXT("%s://%s/"), Scheme, Domain);
+	if (Key.StartsWith(Prefix, ESearchCase::IgnoreCase))
+	{
+		Key.RightChopInline(Prefix.Len());
+	}
+	FString Name = Key;
+	int32 QueryStart = INDEX_NONE;
+	if (Name.FindChar(TEXT('?'), QueryStart))
+	{
+		Name.LeftInline(QueryStart);
+	}
+
+	FResource Resource;
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (const FProviderEntry& Entry : Providers)
+		{
+			if (Name.StartsWith(Entry.Prefix))
+			{
+				return MakeUnique<FGISProvidedResourceHandler>(Entry.Provider, Name.RightChop(Entry.Prefix.Len()), Entry.MimeType);
+			}
+		}
+		Resources.RemoveAndCopyValue(Key, Resource);
+	}
+
+	if (!Resource.Bytes.IsValid())
+	{
+		UE_LOG(LogGISResourceServer, Warning, TEXT("请求的网页资源不存在或已被读取: %s"), *Url);
+	}
+	return MakeUnique<FGISResourceHandler>(MoveTemp(Resource.Bytes), MoveTemp(Resource.MimeType));
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IWebBrowserSchemeHandler.h"
+
+/**
+ * 网页资源通道：大块数据 (存档要素数组等) 发布为 https://citygis.data/<名称>，由页面 fetch 读取
+ * 代替拼进 ExecuteJavascript 的脚本字面量：不经过脚本编译和转义，浏览器按 UTF-8 字节流读取
+ *
+ * 发布在游戏线程，请求由浏览器 IO 线程处理，内部加锁；数据以共享指针交给请求，读取期间替换也安全
+ * 每次发布得到各自带序号的 URL，按该 URL 被读取一次后释放；同名发布互不覆盖，
+ * 页面尚未读取的同名数据最多保留 MaxPendingPerName 份 (页面重载等情况下不会无限堆积)
+ *
+ * 另可按名称前缀注册提供者 (如 tile/<z>/<x>/<y>)，请求到达时在线程池中按需生成，提供者须线程安全
+ */
+class CITYGIS_API FGISResourceServer : public IWebBrowserSchemeHandlerFactory
+{
+public:
+	// 参数为去掉前缀后的路径；返回空指针时响应 404
+	using FProvider = TFunction<TSharedPtr<const TArray<uint8>>(const FString& Path)>;
+
+	static const TCHAR* Scheme;
+	static const TCHAR* Domain;
+
+	virtual ~FGISResourceServer();
+
+	// 向浏览器注册 Scheme/Domain 处理器 (在页面加载前调用)；没有 CEF 时失败，调用方应退回脚本字面量
+	bool Register();
+	void Unregister();
+	bool IsRegistered() const { return bRegistered; }
+
+	// 返回页面可 fetch 的 URL (带序号，避免命中缓存)
+	FString Publish(const FString& Name, TArray<uint8>&& Bytes, const FString& MimeType = TEXT("application/json"));
+
+	// 前缀形如 "tile/"；返回该前缀对应的 URL 根
+	FString AddProvider(const FString& Prefix, FProvider Provider, const FString& MimeType = TEXT("application/json"));
+	void RemoveProvider(const FString& Prefix);
+
+	virtual TUniquePtr<IWebBrowserSchemeHandler> Create(FString Verb, FString Url) override;
+
+private:
+	struct FResource
+	{
+		TSharedPtr<const TArray<uint8>> Bytes;
+		FString MimeType;
+		FString Name;
+		int32 Version = 0;
+	};
+
+	static constexpr int32 MaxPendingPerName = 16;
+
+	struct FProviderEntry
+	{
+		FString Prefix;
+		TSharedPtr<const FProvider> Provider;
+		FString MimeType;
+	};
+
+	FCriticalSection Lock;
+	// 键为 "<名称>?v=<序号>"，即 URL 中域名之后的部分
+	TMap<FString, FResource> Resources;
+	TArray<FProviderEntry> Providers;
+	int32 Serial = 0;
+	bool bRegistered = false;
+};
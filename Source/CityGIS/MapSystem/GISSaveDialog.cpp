@@ -9,6 +9,12 @@ void UGISSaveDialog::NativeConstruct()
 	if (Btn_Cancel) Btn_Cancel->OnClicked.AddDynamic(this, &UGISSaveDialog::OnCancel);
 }
 
+void UGISSaveDialog::NativeDestruct()
+{
+	UnbindFileTask();
+	Super::NativeDestruct();
+}
+
 void UGISSaveDialog::Init(UGISWebWidget* Parent, FString InJsonData)
 {
 	MainUI = Parent;
@@ -21,22 +27,76 @@ void UGISSaveDialog::Init(UGISWebWidget* Parent, FString InJsonData)
 		Input_Name->SetText(FText::FromString(DefaultName));
 	}
 	if (Input_Desc) Input_Desc->SetText(FText::GetEmpty());
+	if (Progress_Bar) Progress_Bar->SetVisibility(ESlateVisibility::Collapsed);
     
 	AddToViewport(100); // 确保显示在最上层
 }
 
 void UGISSaveDialog::OnConfirm()
 {
-	if (MainUI)
+	if (!MainUI)
 	{
-		FString Name = Input_Name ? Input_Name->GetText().ToString() : "Unamed";
-		FString Desc = Input_Desc ? Input_Desc->GetText().ToString() : "";
-		MainUI->ExecuteSaveToFile(PendingJsonData, Name, Desc);
+		RemoveFromParent();
+		return;
+	}
+	if (bSaving)
+	{
+		return;
+	}
+
+	FString Name = Input_Name ? Input_Name->GetText().ToString() : "Unamed";
+	FString Desc = Input_Desc ? Input_Desc->GetText().ToString() : "";
+	MainUI->ExecuteSaveToFile(PendingJsonData, Name, Desc);
+
+	// 【修改】保存在后台进行，完成后再关闭弹窗
+	// 先发起再绑定：发起时被取消的旧任务会广播完成，不能让它关掉本弹窗
+	bSaving = true;
+	MainUI->OnFileProgress.AddUniqueDynamic(this, &UGISSaveDialog::HandleFileProgress);
+	MainUI->OnSaveCompleted.AddUniqueDynamic(this, &UGISSaveDialog::HandleSaveCompleted);
+
+	if (Btn_Confirm) Btn_Confirm->SetIsEnabled(false);
+	if (Progress_Bar)
+	{
+		Progress_Bar->SetPercent(0.0f);
+		Progress_Bar->SetVisibility(ESlateVisibility::HitTestInvisible);
 	}
-	RemoveFromParent();
 }
 
 void UGISSaveDialog::OnCancel()
 {
+	if (bSaving && MainUI)
+	{
+		UnbindFileTask();
+		MainUI->CancelFileTask();
+	}
 	RemoveFromParent();
+}
+
+void UGISSaveDialog::HandleFileProgress(float Progress)
+{
+	if (Progress_Bar) Progress_Bar->SetPercent(Progress);
+}
+
+void UGISSaveDialog::HandleSaveCompleted(bool bSuccess, const FString& FilePath)
+{
+	UnbindFileTask();
+	if (bSuccess)
+	{
+		RemoveFromParent();
+		return;
+	}
+
+	// 失败时保留弹窗，允许重试或取消
+	if (Btn_Confirm) Btn_Confirm->SetIsEnabled(true);
+	if (Progress_Bar) Progress_Bar->SetVisibility(ESlateVisibility::Collapsed);
+}
+
+void UGISSaveDialog::UnbindFileTask()
+{
+	bSaving = false;
+	if (MainUI)
+	{
+		MainUI->OnFileProgress.RemoveAll(this);
+		MainUI->OnSaveCompleted.RemoveAll(this);
+	}
 }
\ No newline at end of file
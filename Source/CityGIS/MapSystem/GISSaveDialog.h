@@ -4,6 +4,7 @@
 #include "Components/EditableText.h"
 #include "Components/MultiLineEditableText.h"
 #include "Components/Button.h"
+#include "Components/ProgressBar.h"
 #include "GISSaveDialog.generated.h"
 
 class UGISWebWidget;
@@ -14,6 +15,7 @@ class CITYGIS_API UGISSaveDialog : public UUserWidget
 	GENERATED_BODY()
 public:
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
     
 	// 打开弹窗，传入等待保存的 JSON 数据
 	void Init(UGISWebWidget* Parent, FString InJsonData);
@@ -23,13 +25,20 @@ protected:
 	UPROPERTY(meta = (BindWidget)) UMultiLineEditableText* Input_Desc;
 	UPROPERTY(meta = (BindWidget)) UButton* Btn_Confirm;
 	UPROPERTY(meta = (BindWidget)) UButton* Btn_Cancel;
+	UPROPERTY(meta = (BindWidgetOptional)) UProgressBar* Progress_Bar; // 可选：后台保存进度
 
 private:
 	UFUNCTION() void OnConfirm();
 	UFUNCTION() void OnCancel();
 
+	// 【新增】后台保存的进度与完成回调
+	UFUNCTION() void HandleFileProgress(float Progress);
+	UFUNCTION() void HandleSaveCompleted(bool bSuccess, const FString& FilePath);
+	void UnbindFileTask();
+
 	UPROPERTY()
 	UGISWebWidget* MainUI = nullptr;
 	
 	FString PendingJsonData;
+	bool bSaving = false;
 };
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "GISSaveIndex.h"
+#include "GISBinarySave.h"
+#include "GISEditJournal.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISSaveIndex, Log, All);
+
+namespace
+{
+	constexpr int32 IndexVersion = 1;
+	const TCHAR* const IndexFileName = TEXT("index.json");
+
+	FString GetIndexPath()
+	{
+		return FGISSaveIndex::GetSaveFolder() + IndexFileName;
+	}
+}
+
+FString FGISSaveIndex::GetSaveFolder()
+{
+	return FPaths::ProjectSavedDir() + TEXT("GISData/");
+}
+
+bool FGISSaveIndex::IsSaveFile(const FString& FilePath)
+{
+	if (FGISBinarySave::IsBinarySave(FilePath))
+	{
+		return true;
+	}
+	return FilePath.EndsWith(TEXT(".json"), ESearchCase::IgnoreCase) && FPaths::GetCleanFilename(FilePath) != IndexFileName;
+}
+
+bool FGISSaveIndex::ReadMetadata(const FString& FilePath, FGISSaveMetadata& OutMeta)
+{
+	OutMeta = FGISSaveMetadata();
+	OutMeta.FilePath = FilePath;
+
+	if (FGISBinarySave::IsBinarySave(FilePath))
+	{
+		FGISSaveHeader Header;
+		if (!FGISBinarySave::ReadHeader(FilePath, Header))
+		{
+			return false;
+		}
+		OutMeta.ID = Header.ID;
+		OutMeta.Name = Header.Name;
+		OutMeta.Description = Header.Description;
+		OutMeta.Date = Header.Date;
+		return true;
+	}
+
+	// 旧版 JSON 没有独立的文件头，只能整体解析 (每个文件只在首次或变化后解析一次)
+	FString Content;
+	if (!FFileHelper::LoadFileToString(Content, *FilePath))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObj;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObj))
+	{
+		return false;
+	}
+
+	JsonObj->TryGetStringField(TEXT("id"), OutMeta.ID);
+	JsonObj->TryGetStringField(TEXT("name"), OutMeta.Name);
+	JsonObj->TryGetStringField(TEXT("desc"), OutMeta.Description);
+	JsonObj->TryGetStringField(TEXT("date"), OutMeta.Date);
+	return true;
+}
+
+void FGISSaveIndex::LoadIfNeeded()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+	Entries.Reset();
+
+	FString Content;
+	if (!FFileHelper::LoadFileToString(Content, *GetIndexPath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+	int32 Version = 0;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root->TryGetNumberField(TEXT("version"), Version) || Version != IndexVersion)
+	{
+		// 索引损坏或版本不符时丢弃，下次扫描重建
+		UE_LOG(LogGISSaveIndex, Warning, TEXT("存档索引无效，将重建"));
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+	if (!Root->TryGetArrayField(TEXT("files"), Files))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *Files)
+	{
+		const TSharedPtr<FJsonObject>* FileObj = nullptr;
+		if (!Value.IsValid() || !Value->TryGetObject(FileObj))
+		{
+			continue;
+		}
+
+		FString FileName;
+		FString SizeText;
+		FString TicksText;
+		if (!(*FileObj)->TryGetStringField(TEXT("file"), FileName)
+			|| !(*FileObj)->TryGetStringField(TEXT("size"), SizeText)
+			|| !(*FileObj)->TryGetStringField(TEXT("time"), TicksText))
+		{
+			continue;
+		}
+
+		// 64 位数值按字符串保存，避免经过 double 丢精度
+		FEntry Entry;
+		Entry.Size = FCString::Atoi64(*SizeText);
+		Entry.Timestamp = FDateTime(FCString::Atoi64(*TicksText));
+		(*FileObj)->TryGetBoolField(TEXT("valid"), Entry.bValid);
+		(*FileObj)->TryGetStringField(TEXT("id"), Entry.Meta.ID);
+		(*FileObj)->TryGetStringField(TEXT("name"), Entry.Meta.Name);
+		(*FileObj)->TryGetStringField(TEXT("desc"), Entry.Meta.Description);
+		(*FileObj)->TryGetStringField(TEXT("date"), Entry.Meta.Date);
+		Entry.Meta.FilePath = GetSaveFolder() + FileName;
+		Entries.Add(FileName, Entry);
+	}
+}
+
+void FGISSaveIndex::SaveIndexFile()
+{
+	TArray<TSharedPtr<FJsonValue>> Files;
+	Files.Reserve(Entries.Num());
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		const FEntry& Entry = Pair.Value;
+		TSharedPtr<FJsonObject> FileObj = MakeShareable(new FJsonObject);
+		FileObj->SetStringField(TEXT("file"), Pair.Key);
+		FileObj->SetStringField(TEXT("size"), LexToString(Entry.Size));
+		FileObj->SetStringField(TEXT("time"), LexToString(Entry.Timestamp.GetTicks()));
+		FileObj->SetBoolField(TEXT("valid"), Entry.bValid);
+		FileObj->SetStringField(TEXT("id"), Entry.Meta.ID);
+		FileObj->SetStringField(TEXT("name"), Entry.Meta.Name);
+		FileObj->SetStringField(TEXT("desc"), Entry.Meta.Description);
+		FileObj->SetStringField(TEXT("date"), Entry.Meta.Date);
+		Files.Add(MakeShareable(new FJsonValueObject(FileObj)));
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetNumberField(TEXT("version"), IndexVersion);
+	Root->SetArrayField(TEXT("files"), Files);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+	// 先写临时文件再替换，写到一半崩溃也不会留下半个索引
+	const FString IndexPath = GetIndexPath();
+	const FString TempPath = IndexPath + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(OutputString, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*IndexPath, *TempPath, true, true))
+	{
+		UE_LOG(LogGISSaveIndex, Warning, TEXT("写入存档索引失败: %s"), *IndexPath);
+	}
+}
+
+void FGISSaveIndex::Refresh(TArray<FGISSaveMetadata>& OutList)
+{
+	LoadIfNeeded();
+
+	bool bChanged = false;
+	TSet<FString> Seen;
+	const FString Folder = GetSaveFolder();
+
+	// 一次目录遍历同时拿到大小和修改时间
+	IFileManager::Get().IterateDirectoryStat(*Folder, [&](const TCHAR* Path, const FFileStatData& Stat)
+	{
+		const FString FilePath(Path);
+		if (Stat.bIsDirectory || !IsSaveFile(FilePath))
+		{
+			return true;
+		}
+
+		const FString FileName = FPaths::GetCleanFilename(FilePath);
+		Seen.Add(FileName);
+
+		FEntry* Entry = Entries.Find(FileName);
+		if (!Entry || Entry->Size != Stat.FileSize || Entry->Timestamp != Stat.ModificationTime)
+		{
+			FEntry NewEntry;
+			NewEntry.Size = Stat.FileSize;
+			NewEntry.Timestamp = Stat.ModificationTime;
+			NewEntry.bValid = ReadMetadata(FilePath, NewEntry.Meta);
+			Entry = &Entries.Add(FileName, NewEntry);
+			bChanged = true;
+		}
+
+		if (Entry->bValid)
+		{
+			Entry->Meta.FilePath = FilePath;
+			OutList.Add(Entry->Meta);
+		}
+		return true;
+	});
+
+	// 目录外被删掉的文件
+	TArray<FString> Missing;
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		if (!Seen.Contains(Pair.Key))
+		{
+			Missing.Add(Pair.Key);
+		}
+	}
+	for (const FString& FileName : Missing)
+	{
+		Entries.Remove(FileName);
+		bChanged = true;
+	}
+
+	if (bChanged)
+	{
+		SaveIndexFile();
+	}
+}
+
+void FGISSaveIndex::Update(const FGISSaveMetadata& Meta)
+{
+	LoadIfNeeded();
+
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*Meta.FilePath);
+	if (!Stat.bIsValid)
+	{
+		return;
+	}
+
+	FEntry Entry;
+	Entry.Meta = Meta;
+	Entry.Size = Stat.FileSize;
+	Entry.Timestamp = Stat.ModificationTime;
+	Entry.bValid = true;
+	Entries.Add(FPaths::GetCleanFilename(Meta.FilePath), Entry);
+	SaveIndexFile();
+}
+
+bool FGISSaveIndex::Delete(const FString& FilePath)
+{
+	LoadIfNeeded();
+
+	const bool bDeleted = IFileManager::Get().Delete(*FilePath);
+	// 存档的编辑日志随之删除 (没有日志时静默)
+	IFileManager::Get().Delete(*FGISEditJournal::GetJournalPath(FilePath), false, false, true);
+	if (Entries.Remove(FPaths::GetCleanFilename(FilePath)) > 0)
+	{
+		SaveIndexFile();
+	}
+	return bDeleted;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISSaveIndex.generated.h"
+
+USTRUCT(BlueprintType)
+struct FGISSaveMetadata
+{
+	GENERATED_BODY()
+	FString ID;
+	FString Name;
+	FString Description;
+	FString Date;
+	FString FilePath;
+};
+
+/**
+ * 存档元数据索引 (GISData/index.json)
+ * 按文件大小 + 修改时间校验，未变化的存档直接使用索引中的元数据；
+ * 新增或变化的存档才读取：.gisb 只读文件头，旧版 .json 需完整解析一次
+ * 仅在游戏线程使用
+ */
+class CITYGIS_API FGISSaveIndex
+{
+public:
+	static FString GetSaveFolder();
+	static bool IsSaveFile(const FString& FilePath);
+
+	// 扫描存档目录，返回全部可读存档的元数据 (未排序)
+	void Refresh(TArray<FGISSaveMetadata>& OutList);
+
+	// 保存完成后登记，免得下次列表时再读文件
+	void Update(const FGISSaveMetadata& Meta);
+
+	// 删除存档文件 (连同编辑日志) 并移除索引项
+	bool Delete(const FString& FilePath);
+
+private:
+	struct FEntry
+	{
+		FGISSaveMetadata Meta;
+		int64 Size = 0;
+		FDateTime Timestamp;
+		// 无法读取的文件也记下来，文件未变化前不再重复解析
+		bool bValid = false;
+	};
+
+	void LoadIfNeeded();
+	void SaveIndexFile();
+	static bool ReadMetadata(const FString& FilePath, FGISSaveMetadata& OutMeta);
+
+	// 键为文件名 (不含目录)
+	TMap<FString, FEntry> Entries;
+	bool bLoaded = false;
+};
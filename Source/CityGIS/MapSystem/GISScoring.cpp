@@ -0,0 +1,603 @@
+#include "GISScoring.h"
+#include "GISMeasure.h"
+#include "GISPolygonClipper.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+	// 1 度纬度约合的米数，缓冲距离换算为度
+	constexpr double MetersPerDegree = 111320.0;
+
+	// 分级设色 (ColorBrewer YlOrRd 5 级)，低分到高分
+	const TCHAR* const ScoreClassColors[] = { TEXT("#ffffb2"), TEXT("#fecc5c"), TEXT("#fd8d3c"), TEXT("#f03b20"), TEXT("#bd0026") };
+	constexpr int32 NumScoreClasses = UE_ARRAY_COUNT(ScoreClassColors);
+
+	FBox2D ExpandMeters(const FBox2D& Box, double Meters)
+	{
+		if (Meters <= 0.0 || !Box.bIsValid)
+		{
+			return Box;
+		}
+		const double LatPad = Meters / MetersPerDegree;
+		const double Cos = FMath::Max(FMath::Cos(FMath::DegreesToRadians(Box.GetCenter().Y)), 0.01);
+		return FBox2D(Box.Min - FVector2D(LatPad / Cos, LatPad), Box.Max + FVector2D(LatPad / Cos, LatPad));
+	}
+
+	// 带洞面积 (平方度)，与环的方向无关；只用于求同一地点的面积比
+	double NetArea(const FGISMultiPolygon& Geometry)
+	{
+		double Area = 0.0;
+		for (const FGISPolygon& Polygon : Geometry)
+		{
+			for (int32 RingIndex = 0; RingIndex < Polygon.Rings.Num(); ++RingIndex)
+			{
+				const double RingArea = FMath::Abs(GISGeometry::SignedArea(Polygon.Rings[RingIndex]));
+				Area += RingIndex == 0 ? RingArea : -RingArea;
+			}
+		}
+		return FMath::Max(Area, 0.0);
+	}
+
+	// 点到要素边界的最短距离是否不超过 Limit (经度乘以 LngScale 后与纬度同尺度，单位为度)
+	bool IsWithinDistance(const FGISMultiPolygon& Geometry, const FVector2D& Point, double LngScale, double Limit)
+	{
+		const FVector2D P(Point.X * LngScale, Point.Y);
+		const double LimitSq = Limit * Limit;
+		for (const FGISPolygon& Polygon : Geometry)
+		{
+			for (const FGISRing& Ring : Polygon.Rings)
+			{
+				for (int32 Index = 0, Prev = Ring.Num() - 1; Index < Ring.Num(); Prev = Index++)
+				{
+					const FVector2D A(Ring[Prev].X * LngScale, Ring[Prev].Y);
+					const FVector2D B(Ring[Index].X * LngScale, Ring[Index].Y);
+					if (FVector2D::DistSquared(P, FMath::ClosestPointOnSegment2D(P, A, B)) <= LimitSq)
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	// 按经度排序的点中，落在街道内或缓冲距离内的个数
+	int32 CountLandmarks(const FGISMultiPolygon& Geometry, const FBox2D& Bounds, const TArray<FVector2D>& Points, double BufferMeters)
+	{
+		const FBox2D Search = ExpandMeters(Bounds, BufferMeters);
+		const double LngScale = FMath::Max(FMath::Cos(FMath::DegreesToRadians(Bounds.GetCenter().Y)), 0.01);
+		const double Limit = BufferMeters / MetersPerDegree;
+
+		int32 Count = 0;
+		const int32 First = Algo::LowerBoundBy(Points, Search.Min.X, [](const FVector2D& Point) { return Point.X; });
+		for (int32 Index = First; Index < Points.Num() && Points[Index].X <= Search.Max.X; ++Index)
+		{
+			const FVector2D& Point = Points[Index];
+			if (Point.Y < Search.Min.Y || Point.Y > Search.Max.Y)
+			{
+				continue;
+			}
+			if (GISGeometry::IsPointInGeometry(Geometry, Point) || (Limit > 0.0 && IsWithinDistance(Geometry, Point, LngScale, Limit)))
+			{
+				++Count;
+			}
+		}
+		return Count;
+	}
+
+	// 被重构区域覆盖的面积比例：先裁剪到街道内再合并，互相重叠的区域只计一次
+	double ComputeOverlap(const FGISMultiPolygon& Geometry, const FBox2D& Bounds, const FGISScoringBatch& Batch)
+	{
+		const double StreetArea = NetArea(Geometry);
+		if (StreetArea <= 0.0)
+		{
+			return 0.0;
+		}
+
+		FGISMultiPolygon Street;
+		TArray<FGISMultiPolygon> Pieces;
+		for (int32 ZoneIndex = 0; ZoneIndex < Batch.Zones.Num(); ++ZoneIndex)
+		{
+			if (!Batch.ZoneBounds[ZoneIndex].Intersect(Bounds))
+			{
+				continue;
+			}
+			if (Street.Num() == 0)
+			{
+				Street = FGISPolygonClipper::Clean(Geometry);
+			}
+			FGISMultiPolygon Piece = FGISPolygonClipper::Intersection(FGISPolygonClipper::Clean(*Batch.Zones[ZoneIndex]), Street);
+			if (Piece.Num() > 0)
+			{
+				Pieces.Add(MoveTemp(Piece));
+			}
+		}
+		if (Pieces.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		const FGISMultiPolygon Covered = Pieces.Num() == 1 ? MoveTemp(Pieces[0]) : FGISPolygonClipper::UnionAll(MoveTemp(Pieces));
+		return FMath::Clamp(NetArea(Covered) / StreetArea, 0.0, 1.0);
+	}
+}
+
+void FGISScoringEngine::SetTerms(const TArray<FGISScoreTerm>& InTerms)
+{
+	Terms = InTerms;
+	++TermsVersion;
+	bAllDirty = true;
+	ChangedIDs.Reset();
+	Resources.Reset();
+	LandmarkPoints.Reset();
+
+	MaxBufferMeters = 0.0;
+	for (const FGISScoreTerm& Term : Terms)
+	{
+		if (Term.Metric == EGISScoreMetric::LandmarkCount)
+		{
+			MaxBufferMeters = FMath::Max(MaxBufferMeters, static_cast<double>(Term.BufferMeters));
+		}
+	}
+
+	if (!IsEnabled())
+	{
+		Streets.Reset();
+		bAllDirty = false;
+		bStyleDirty = true;
+	}
+}
+
+void FGISScoringEngine::MarkFeatureChanged(const FString& ID)
+{
+	// 未启用时不记录，启用时整体重算
+	if (IsEnabled() && !bAllDirty)
+	{
+		ChangedIDs.Add(ID);
+	}
+}
+
+bool FGISScoringEngine::MatchesResource(const FGISScoreTerm& Term, const FGISFeatureStore& Store, FGISFeatureHandle Handle)
+{
+	if (Term.ResourceKey.IsEmpty())
+	{
+		return Store.GetType(Handle) == EGISFeatureType::Custom;
+	}
+	return Term.ResourceKey == GISFeatureType::ToString(Store.GetType(Handle)) || Term.ResourceKey == Store.GetTag(Handle);
+}
+
+void FGISScoringEngine::AddResource(const FGISSpatialItem& Item, const FGISFeatureStore& Store, const FGISFeatureStats& Stats, bool bInsertSorted)
+{
+	const FGISFeatureHandle Handle = Store.Find(Item.ID);
+	if (!Store.IsValid(Handle))
+	{
+		return;
+	}
+
+	const EGISFeatureType Type = Store.GetType(Handle);
+	if (Type == EGISFeatureType::Reconstruct)
+	{
+		Resources.Add(Item.ID).Bounds = Item.Bounds;
+		return;
+	}
+	if (Type == EGISFeatureType::District || Type == EGISFeatureType::Street)
+	{
+		return;
+	}
+
+	FResource Resource;
+	const FGISFeatureMeasure* Measure = Stats.GetMeasure(Handle);
+	Resource.Point = Measure ? Measure->LabelPoint : Item.Bounds.GetCenter();
+	for (int32 TermIndex = 0; TermIndex < Terms.Num(); ++TermIndex)
+	{
+		if (Terms[TermIndex].Metric != EGISScoreMetric::LandmarkCount || !MatchesResource(Terms[TermIndex], Store, Handle))
+		{
+			continue;
+		}
+		TArray<FVector2D>& Points = LandmarkPoints[TermIndex];
+		if (bInsertSorted)
+		{
+			Points.Insert(Resource.Point, Algo::UpperBoundBy(Points, Resource.Point.X, [](const FVector2D& Point) { return Point.X; }));
+		}
+		else
+		{
+			Points.Add(Resource.Point);
+		}
+		Resource.LandmarkTerms.Add(TermIndex);
+	}
+	if (Resource.LandmarkTerms.Num() > 0)
+	{
+		Resource.Bounds = ExpandMeters(FBox2D(Resource.Point, Resource.Point), MaxBufferMeters);
+		Resources.Add(Item.ID, MoveTemp(Resource));
+	}
+}
+
+void FGISScoringEngine::RemoveResource(const FString& ID)
+{
+	FResource Resource;
+	if (!Resources.RemoveAndCopyValue(ID, Resource))
+	{
+		return;
+	}
+	for (const int32 TermIndex : Resource.LandmarkTerms)
+	{
+		// 同一经度可能有多个点，在等经度的一段里找到完全相同的一个移除
+		TArray<FVector2D>& Points = LandmarkPoints[TermIndex];
+		for (int32 Index = Algo::LowerBoundBy(Points, Resource.Point.X, [](const FVector2D& Point) { return Point.X; }); Index < Points.Num() && Points[Index].X == Resource.Point.X; ++Index)
+		{
+			if (Points[Index] == Resource.Point)
+			{
+				Points.RemoveAt(Index);
+				break;
+			}
+		}
+	}
+}
+
+TSharedPtr<FGISScoringBatch> FGISScoringEngine::PrepareBatch(const FGISFeatureStore& Store, const FGISSpatialIndex& Index, const FGISFeatureStats& Stats)
+{
+	if (!IsEnabled() || !HasPendingChanges())
+	{
+		return nullptr;
+	}
+
+	auto IsStreet = [&Store](const FString& ID)
+	{
+		const FGISFeatureHandle Handle = Store.Find(ID);
+		return Store.IsValid(Handle) && Store.GetType(Handle) == EGISFeatureType::Street;
+	};
+
+	// 受影响的街道：变动的街道本身，以及资源要素新旧影响范围覆盖到的街道
+	TSet<FString> Dirty;
+	auto AddStreetsIn = [&](const FBox2D& Box)
+	{
+		TArray<const FGISSpatialItem*> Hits;
+		Index.QueryBox(Box, Hits);
+		for (const FGISSpatialItem* Hit : Hits)
+		{
+			if (IsStreet(Hit->ID))
+			{
+				Dirty.Add(Hit->ID);
+			}
+		}
+	};
+
+	// 整体重算时一遍扫描重新登记全部资源；否则只重新登记变动的要素 (量测完成后标注点变化也会经 MarkFeatureChanged 到达)
+	bool bRemoved = false;
+	if (bAllDirty)
+	{
+		Resources.Reset();
+		LandmarkPoints.Reset();
+		LandmarkPoints.SetNum(Terms.Num());
+		Index.ForEach([&](const FGISSpatialItem& Item)
+		{
+			AddResource(Item, Store, Stats, false);
+		});
+		for (TArray<FVector2D>& Points : LandmarkPoints)
+		{
+			Points.Sort([](const FVector2D& A, const FVector2D& B) { return A.X < B.X; });
+		}
+
+		for (auto It = Streets.CreateIterator(); It; ++It)
+		{
+			if (!IsStreet(It.Key()) || !Index.Find(It.Key()))
+			{
+				It.RemoveCurrent();
+				bRemoved = true;
+			}
+		}
+		Index.ForEach([&](const FGISSpatialItem& Item)
+		{
+			if (IsStreet(Item.ID))
+			{
+				Dirty.Add(Item.ID);
+			}
+		});
+	}
+	else
+	{
+		for (const FString& ID : ChangedIDs)
+		{
+			if (IsStreet(ID) && Index.Find(ID))
+			{
+				Dirty.Add(ID);
+			}
+			else if (Streets.Remove(ID) > 0)
+			{
+				bRemoved = true;
+			}
+			if (const FResource* Old = Resources.Find(ID))
+			{
+				AddStreetsIn(Old->Bounds);
+				RemoveResource(ID);
+			}
+			if (const FGISSpatialItem* Item = Index.Find(ID))
+			{
+				AddResource(*Item, Store, Stats, true);
+				if (const FResource* New = Resources.Find(ID))
+				{
+					AddStreetsIn(New->Bounds);
+				}
+			}
+		}
+	}
+	ChangedIDs.Reset();
+	bAllDirty = false;
+
+	if (Dirty.Num() == 0 && !bRemoved)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FGISScoringBatch> Batch = MakeShared<FGISScoringBatch>();
+	Batch->Terms = Terms;
+	Batch->TermsVersion = TermsVersion;
+	Batch->Landmarks = LandmarkPoints;
+
+	// 只带上与本批街道相交的重构区域
+	FBox2D DirtyBounds(ForceInit);
+	Batch->Streets.Reserve(Dirty.Num());
+	for (const FString& ID : Dirty)
+	{
+		const FGISSpatialItem* Item = Index.Find(ID);
+		FGISScoringBatch::FStreet& Street = Batch->Streets.AddDefaulted_GetRef();
+		Street.ID = ID;
+		Street.Geometry = Item->Geometry;
+		if (const FGISFeatureMeasure* Measure = Stats.GetMeasure(Store.Find(ID)))
+		{
+			Street.AreaM2 = Measure->AreaM2;
+		}
+		DirtyBounds += Item->Bounds;
+	}
+
+	const bool bNeedsZones = Terms.ContainsByPredicate([](const FGISScoreTerm& Term) { return Term.Metric == EGISScoreMetric::ReconstructOverlap; });
+	if (bNeedsZones && DirtyBounds.bIsValid)
+	{
+		TArray<const FGISSpatialItem*> Hits;
+		Index.QueryBox(DirtyBounds, Hits);
+		for (const FGISSpatialItem* Hit : Hits)
+		{
+			const FGISFeatureHandle Handle = Store.Find(Hit->ID);
+			if (Store.IsValid(Handle) && Store.GetType(Handle) == EGISFeatureType::Reconstruct)
+			{
+				Batch->Zones.Add(Hit->Geometry);
+				Batch->ZoneBounds.Add(Hit->Bounds);
+			}
+		}
+	}
+	return Batch;
+}
+
+void FGISScoringEngine::Evaluate(FGISScoringBatch& Batch)
+{
+	ParallelFor(Batch.Streets.Num(), [&Batch](int32 StreetIndex)
+	{
+		FGISScoringBatch::FStreet& Street = Batch.Streets[StreetIndex];
+		const FGISMultiPolygon& Geometry = *Street.Geometry;
+		const FBox2D Bounds = GISGeometry::ComputeBounds(Geometry);
+
+		double Overlap = -1.0;
+		Street.Metrics.SetNumZeroed(Batch.Terms.Num());
+		for (int32 TermIndex = 0; TermIndex < Batch.Terms.Num(); ++TermIndex)
+		{
+			const FGISScoreTerm& Term = Batch.Terms[TermIndex];
+			switch (Term.Metric)
+			{
+			case EGISScoreMetric::Area:
+				if (Street.AreaM2 < 0.0)
+				{
+					Street.AreaM2 = GISMeasure::Measure(Geometry).AreaM2;
+				}
+				Street.Metrics[TermIndex] = Street.AreaM2 / 1.0e6;
+				break;
+			case EGISScoreMetric::LandmarkCount:
+				Street.Metrics[TermIndex] = CountLandmarks(Geometry, Bounds, Batch.Landmarks[TermIndex], Term.BufferMeters);
+				break;
+			case EGISScoreMetric::ReconstructOverlap:
+				if (Overlap < 0.0)
+				{
+					Overlap = ComputeOverlap(Geometry, Bounds, Batch);
+				}
+				Street.Metrics[TermIndex] = Overlap;
+				break;
+			case EGISScoreMetric::PointCount:
+				// 由 ApplyBatch 填写
+				break;
+			}
+		}
+	});
+}
+
+void FGISScoringEngine::ApplyBatch(const FGISScoringBatch& Batch, const FGISFeatureStore& Store)
+{
+	// 计算期间更换了打分项：已整体标脏，下一批重算
+	if (Batch.TermsVersion != TermsVersion)
+	{
+		return;
+	}
+
+	// 计算期间被删除的街道已记入 ChangedIDs，下一批移出
+	for (const FGISScoringBatch::FStreet& Street : Batch.Streets)
+	{
+		const FGISFeatureHandle Handle = Store.Find(Street.ID);
+		if (Store.IsValid(Handle) && Store.GetType(Handle) == EGISFeatureType::Street)
+		{
+			TArray<double>& Metrics = Streets.FindOrAdd(Street.ID).Metrics;
+			Metrics = Street.Metrics;
+			FillPointCounts(Street.ID, Metrics);
+		}
+	}
+	Rescore();
+}
+
+void FGISScoringEngine::SetPointJoin(TSharedPtr<const FGISPointJoin> InJoin)
+{
+	PointJoin = MoveTemp(InJoin);
+	if (!Terms.ContainsByPredicate([](const FGISScoreTerm& Term) { return Term.Metric == EGISScoreMetric::PointCount; }))
+	{
+		return;
+	}
+	for (TPair<FString, FStreetScore>& Pair : Streets)
+	{
+		FillPointCounts(Pair.Key, Pair.Value.Metrics);
+	}
+	Rescore();
+}
+
+void FGISScoringEngine::FillPointCounts(const FString& ID, TArray<double>& Metrics) const
+{
+	for (int32 TermIndex = 0; TermIndex < Terms.Num() && TermIndex < Metrics.Num(); ++TermIndex)
+	{
+		const FGISScoreTerm& Term = Terms[TermIndex];
+		if (Term.Metric != EGISScoreMetric::PointCount)
+		{
+			continue;
+		}
+
+		// 图层中没有该类别时计 0，而不是全部
+		int32 Count = 0;
+		if (PointJoin.IsValid())
+		{
+			const int32 Category = Term.ResourceKey.IsEmpty() ? INDEX_NONE : PointJoin->CategoryNames.IndexOfByKey(Term.ResourceKey);
+			if (Term.ResourceKey.IsEmpty() || Category != INDEX_NONE)
+			{
+				Count = PointJoin->GetCount(ID, Category);
+			}
+		}
+		Metrics[TermIndex] = Count;
+	}
+}
+
+void FGISScoringEngine::Rescore()
+{
+	const int32 NumTerms = Terms.Num();
+	TArray<double> Min;
+	TArray<double> Max;
+	Min.Init(DBL_MAX, NumTerms);
+	Max.Init(-DBL_MAX, NumTerms);
+	for (const TPair<FString, FStreetScore>& Pair : Streets)
+	{
+		for (int32 TermIndex = 0; TermIndex < NumTerms && TermIndex < Pair.Value.Metrics.Num(); ++TermIndex)
+		{
+			Min[TermIndex] = FMath::Min(Min[TermIndex], Pair.Value.Metrics[TermIndex]);
+			Max[TermIndex] = FMath::Max(Max[TermIndex], Pair.Value.Metrics[TermIndex]);
+		}
+	}
+
+	// 各项线性归一化到 0~1 (全部相同时记 0) 后加权求和
+	MinScore = DBL_MAX;
+	MaxScore = -DBL_MAX;
+	TArray<FStreetScore*> Order;
+	Order.Reserve(Streets.Num());
+	for (TPair<FString, FStreetScore>& Pair : Streets)
+	{
+		FStreetScore& Entry = Pair.Value;
+		Entry.Score = 0.0;
+		for (int32 TermIndex = 0; TermIndex < NumTerms && TermIndex < Entry.Metrics.Num(); ++TermIndex)
+		{
+			const double Range = Max[TermIndex] - Min[TermIndex];
+			if (Range > 0.0)
+			{
+				Entry.Score += Terms[TermIndex].Weight * (Entry.Metrics[TermIndex] - Min[TermIndex]) / Range;
+			}
+		}
+		MinScore = FMath::Min(MinScore, Entry.Score);
+		MaxScore = FMath::Max(MaxScore, Entry.Score);
+		Order.Add(&Entry);
+	}
+	if (Order.Num() == 0)
+	{
+		MinScore = MaxScore = 0.0;
+	}
+
+	// 同分同名次
+	Order.Sort([](const FStreetScore& A, const FStreetScore& B) { return A.Score > B.Score; });
+	for (int32 Index = 0; Index < Order.Num(); ++Index)
+	{
+		Order[Index]->Rank = Index > 0 && Order[Index]->Score == Order[Index - 1]->Score ? Order[Index - 1]->Rank : Index + 1;
+	}
+	bStyleDirty = true;
+}
+
+void FGISScoringEngine::Reset()
+{
+	Streets.Reset();
+	Resources.Reset();
+	LandmarkPoints.Reset();
+	LandmarkPoints.SetNum(Terms.Num());
+	ChangedIDs.Reset();
+	bAllDirty = false;
+	MinScore = MaxScore = 0.0;
+	bStyleDirty = PublishedColors.Num() > 0;
+}
+
+TArray<FGISScoreRow> FGISScoringEngine::GetTable(const FGISFeatureStore& Store, int32 SortColumn, bool bDescending) const
+{
+	TArray<FGISScoreRow> Rows;
+	Rows.Reserve(Streets.Num());
+	for (const TPair<FString, FStreetScore>& Pair : Streets)
+	{
+		const FGISFeatureHandle Handle = Store.Find(Pair.Key);
+		FGISScoreRow& Row = Rows.AddDefaulted_GetRef();
+		Row.ID = Pair.Key;
+		Row.Name = Store.GetName(Handle);
+		Row.ParentID = Store.GetParentID(Handle);
+		Row.Metrics = Pair.Value.Metrics;
+		Row.Score = Pair.Value.Score;
+		Row.Rank = Pair.Value.Rank;
+	}
+
+	// 相等时按名次，保证每次排序结果一致
+	const bool bByMetric = Terms.IsValidIndex(SortColumn);
+	Rows.Sort([SortColumn, bDescending, bByMetric](const FGISScoreRow& A, const FGISScoreRow& B)
+	{
+		const double KeyA = bByMetric && A.Metrics.IsValidIndex(SortColumn) ? A.Metrics[SortColumn] : A.Score;
+		const double KeyB = bByMetric && B.Metrics.IsValidIndex(SortColumn) ? B.Metrics[SortColumn] : B.Score;
+		if (KeyA != KeyB)
+		{
+			return bDescending ? KeyA > KeyB : KeyA < KeyB;
+		}
+		return A.Rank != B.Rank ? A.Rank < B.Rank : A.ID < B.ID;
+	});
+	return Rows;
+}
+
+bool FGISScoringEngine::GetScoreColor(const FString& ID, FString& OutColor) const
+{
+	const FStreetScore* Entry = Streets.Find(ID);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	// 全部同分时取中间一级
+	const double Range = MaxScore - MinScore;
+	const int32 Class = Range > 0.0 ? FMath::Min(static_cast<int32>((Entry->Score - MinScore) / Range * NumScoreClasses), NumScoreClasses - 1) : NumScoreClasses / 2;
+	OutColor = ScoreClassColors[Class];
+	return true;
+}
+
+void FGISScoringEngine::ConsumeStyleChanges(TMap<FString, FString>& OutChanged, TArray<FString>& OutCleared)
+{
+	bStyleDirty = false;
+	for (const TPair<FString, FStreetScore>& Pair : Streets)
+	{
+		FString Color;
+		GetScoreColor(Pair.Key, Color);
+		FString& Published = PublishedColors.FindOrAdd(Pair.Key);
+		if (Published != Color)
+		{
+			Published = Color;
+			OutChanged.Add(Pair.Key, Color);
+		}
+	}
+	for (auto It = PublishedColors.CreateIterator(); It; ++It)
+	{
+		if (!Streets.Contains(It.Key()))
+		{
+			OutCleared.Add(It.Key());
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISFeatureStore.h"
+#include "GISFeatureStats.h"
+#include "GISSpatialIndex.h"
+#include "GISPointLayer.h"
+#include "GISScoring.generated.h"
+
+// 街道打分的指标
+UENUM(BlueprintType)
+enum class EGISScoreMetric : uint8
+{
+	// 街道面积 (平方公里)
+	Area,
+	// 落在街道内、或距街道边界不超过 BufferMeters 的地标资源个数
+	LandmarkCount,
+	// 被重构区域覆盖的面积占街道面积的比例 (0~1，重叠的重构区域只计一次)
+	ReconstructOverlap,
+	// 点资源图层中落在街道内的点数 (按 ResourceKey 类别筛选，空为全部类别)
+	PointCount
+};
+
+// 打分的一项：指标在全部街道间线性归一化到 0~1 后乘以权重累加 (权重可为负，作为扣分项)
+USTRUCT(BlueprintType)
+struct FGISScoreTerm
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) EGISScoreMetric Metric = EGISScoreMetric::Area;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) float Weight = 1.0f;
+
+	// 地标资源的筛选键：类型名 (如 "Custom") 或标签，空为全部自定义要素；PointCount 时为点的类别
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FString ResourceKey;
+
+	// 街道外扩的缓冲距离 (米)，0 为只计街道内部；仅 LandmarkCount 使用
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0")) float BufferMeters = 0.0f;
+};
+
+// 打分表的一行
+USTRUCT(BlueprintType)
+struct FGISScoreRow
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly) FString ID;
+	UPROPERTY(BlueprintReadOnly) FString Name;
+	UPROPERTY(BlueprintReadOnly) FString ParentID;
+
+	// 与打分项一一对应的原始指标值
+	UPROPERTY(BlueprintReadOnly) TArray<double> Metrics;
+
+	UPROPERTY(BlueprintReadOnly) double Score = 0.0;
+
+	// 按总分从高到低的名次 (从 1 开始)
+	UPROPERTY(BlueprintReadOnly) int32 Rank = 0;
+};
+
+// 一次增量计算：游戏线程拍下的只读快照，工作线程只填写各街道的指标
+struct FGISScoringBatch
+{
+	struct FStreet
+	{
+		FString ID;
+		TSharedPtr<const FGISMultiPolygon> Geometry;
+		// 已量测的面积，尚未量测为负 (在工作线程补算)
+		double AreaM2 = -1.0;
+		TArray<double> Metrics;
+	};
+
+	TArray<FGISScoreTerm> Terms;
+	int32 TermsVersion = 0;
+	TArray<FStreet> Streets;
+
+	// 每个 LandmarkCount 项一组按经度排序的地标点 (其余项为空)
+	TArray<TArray<FVector2D>> Landmarks;
+
+	// 与本批街道包围盒相交的重构区域
+	TArray<TSharedPtr<const FGISMultiPolygon>> Zones;
+	TArray<FBox2D> ZoneBounds;
+};
+
+/**
+ * 街道 + 地标资源的可配置打分
+ *
+ * 两类区域统一处理：行政区划的街道是被打分的对象，资源类别的区域 (自定义要素按类型/标签筛选，以及重构区域)
+ * 是打分的依据。每条街道缓存各项原始指标；要素几何增删时只重算受其影响的街道 ——
+ * 街道本身，或新旧影响范围 (地标点外扩最大缓冲距离 / 重构区域包围盒) 与之相交的街道。
+ * 归一化、加权与排名对全部街道的缓存指标重做，代价 O(街道数 × 项数)，与几何复杂度无关。
+ *
+ * PrepareBatch / ApplyBatch 仅在游戏线程调用；Evaluate 只读写批次本身，可在工作线程执行。
+ */
+class CITYGIS_API FGISScoringEngine
+{
+public:
+	// 更换打分项，全部街道重算
+	void SetTerms(const TArray<FGISScoreTerm>& InTerms);
+	const TArray<FGISScoreTerm>& GetTerms() const { return Terms; }
+	bool IsEnabled() const { return Terms.Num() > 0; }
+
+	// 要素几何加入或删除后调用
+	void MarkFeatureChanged(const FString& ID);
+	bool HasPendingChanges() const { return bAllDirty || ChangedIDs.Num() > 0; }
+
+	// 点资源的空间连接更新后调用：只改写各街道的 PointCount 指标并重新排名，不重算几何指标
+	void SetPointJoin(TSharedPtr<const FGISPointJoin> InJoin);
+
+	// 把待定变动解析为需要重算的街道并拍下快照 (被删街道直接移出)；无事可做时返回空
+	TSharedPtr<FGISScoringBatch> PrepareBatch(const FGISFeatureStore& Store, const FGISSpatialIndex& Index, const FGISFeatureStats& Stats);
+
+	// 在 ParallelFor 中逐条街道计算指标
+	static void Evaluate(FGISScoringBatch& Batch);
+
+	// 写回指标并重新归一化、排名；打分项在计算期间被更换的批次丢弃
+	void ApplyBatch(const FGISScoringBatch& Batch, const FGISFeatureStore& Store);
+
+	// 清空街道与影响范围 (保留打分项)
+	void Reset();
+
+	int32 NumStreets() const { return Streets.Num(); }
+
+	// SortColumn 为 INDEX_NONE 时按总分排序，否则按第 SortColumn 项的原始指标；名称与父级取自要素存储的当前值
+	TArray<FGISScoreRow> GetTable(const FGISFeatureStore& Store, int32 SortColumn = INDEX_NONE, bool bDescending = true) const;
+
+	// 分级设色：总分等距分为 5 级 (黄 -> 红)
+	bool GetScoreColor(const FString& ID, FString& OutColor) const;
+
+	// 设色自上次调用以来变化的街道，OutCleared 为已不再打分的街道；调用后视为已下发
+	void ConsumeStyleChanges(TMap<FString, FString>& OutChanged, TArray<FString>& OutCleared);
+
+	// 页面重新加载或重新打开设色后全部重发
+	void ResetPublished() { PublishedColors.Reset(); bStyleDirty = true; }
+	bool HasStyleChanges() const { return bStyleDirty; }
+
+private:
+	struct FStreetScore
+	{
+		TArray<double> Metrics;
+		double Score = 0.0;
+		int32 Rank = 0;
+	};
+
+	// 已登记的资源要素 (地标或重构区域)
+	struct FResource
+	{
+		// 影响范围：地标点外扩最大缓冲距离，或重构区域的包围盒
+		FBox2D Bounds;
+		// 登记时的地标点 (已量测的取标注点，否则取包围盒中心)
+		FVector2D Point = FVector2D::ZeroVector;
+		// 该点所在的 LandmarkCount 项
+		TArray<int32> LandmarkTerms;
+	};
+
+	// 地标资源是否匹配打分项的筛选键
+	static bool MatchesResource(const FGISScoreTerm& Term, const FGISFeatureStore& Store, FGISFeatureHandle Handle);
+
+	// PointCount 项直接取自当前的连接结果 (在游戏线程填写，计算期间连接更新也不会写回旧值)
+	void FillPointCounts(const FString& ID, TArray<double>& Metrics) const;
+
+	// 重新归一化、加权并排名
+	void Rescore();
+
+	// 按要素当前的类型与量测结果登记资源，并把地标点放入 LandmarkPoints (bInsertSorted 为假时只追加，由调用方统一排序)
+	void AddResource(const FGISSpatialItem& Item, const FGISFeatureStore& Store, const FGISFeatureStats& Stats, bool bInsertSorted);
+	void RemoveResource(const FString& ID);
+
+	TArray<FGISScoreTerm> Terms;
+	int32 TermsVersion = 0;
+
+	TMap<FString, FStreetScore> Streets;
+	TSharedPtr<const FGISPointJoin> PointJoin;
+	double MinScore = 0.0;
+	double MaxScore = 0.0;
+
+	// 上次快照时各资源要素的登记，用于找出其移动或删除前覆盖的街道
+	TMap<FString, FResource> Resources;
+
+	// 每个 LandmarkCount 项一组按经度排序的地标点 (其余项为空)，随要素变动增量维护，拍快照时复制
+	TArray<TArray<FVector2D>> LandmarkPoints;
+	double MaxBufferMeters = 0.0;
+
+	TSet<FString> ChangedIDs;
+	bool bAllDirty = false;
+
+	TMap<FString, FString> PublishedColors;
+	bool bStyleDirty = false;
+};
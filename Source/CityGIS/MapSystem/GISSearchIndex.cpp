@@ -0,0 +1,342 @@
+#include "GISSearchIndex.h"
+#include "GISPinyin.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	// 失效条目超过该数且多于有效条目时重建
+	constexpr int32 CompactDeadCount = 4096;
+
+	// 同一得分内按名称长度排序
+	constexpr int32 MaxRankLength = 1023;
+
+	struct FRankedDoc
+	{
+		int32 Rank = 0;
+		int32 DocIndex = 0;
+	};
+}
+
+FString FGISSearchIndex::Normalize(const FString& Text)
+{
+	FString Result;
+	Result.Reserve(Text.Len());
+	for (TCHAR Char : Text)
+	{
+		// 全角 ASCII (！~～) 转半角，全角空格按空白处理
+		if (Char >= 0xFF01 && Char <= 0xFF5E)
+		{
+			Char = static_cast<TCHAR>(Char - 0xFEE0);
+		}
+		if (Char == 0x3000 || FChar::IsWhitespace(Char))
+		{
+			continue;
+		}
+		Result.AppendChar(FChar::ToLower(Char));
+	}
+	return Result;
+}
+
+uint64 FGISSearchIndex::MakeGram(TCHAR A, TCHAR B)
+{
+	// 单字的 B 为 0，不会与双字冲突
+	return (static_cast<uint64>(static_cast<uint32>(A)) << 32) | static_cast<uint32>(B);
+}
+
+void FGISSearchIndex::Add(const FString& ID, const FString& Name)
+{
+	if (ID.IsEmpty())
+	{
+		return;
+	}
+
+	if (const int32* Existing = DocumentByID.Find(ID))
+	{
+		if (Documents[*Existing].Name.Equals(Name, ESearchCase::CaseSensitive))
+		{
+			return;
+		}
+		Documents[*Existing].bAlive = false;
+		++DeadCount;
+	}
+
+	const int32 DocIndex = Documents.Num();
+	FDocument& Document = Documents.AddDefaulted_GetRef();
+	Document.ID = ID;
+	Document.Name = Name;
+	DocumentByID.Add(ID, DocIndex);
+	IndexDocument(DocIndex);
+	++Revision;
+
+	if (DeadCount > CompactDeadCount && DeadCount > DocumentByID.Num())
+	{
+		Rebuild();
+	}
+}
+
+bool FGISSearchIndex::Remove(const FString& ID)
+{
+	int32 DocIndex = INDEX_NONE;
+	if (!DocumentByID.RemoveAndCopyValue(ID, DocIndex))
+	{
+		return false;
+	}
+
+	Documents[DocIndex].bAlive = false;
+	++DeadCount;
+	++Revision;
+
+	if (DeadCount > CompactDeadCount && DeadCount > DocumentByID.Num())
+	{
+		Rebuild();
+	}
+	return true;
+}
+
+void FGISSearchIndex::Reset()
+{
+	Documents.Reset();
+	DocumentByID.Reset();
+	Postings.Reset();
+	DeadCount = 0;
+	LastQuery.Reset();
+	LastMatches.Reset();
+	++Revision;
+}
+
+void FGISSearchIndex::SetPinyinEnabled(bool bEnabled)
+{
+	if (bPinyinEnabled != bEnabled)
+	{
+		bPinyinEnabled = bEnabled;
+		Rebuild();
+	}
+}
+
+void FGISSearchIndex::IndexDocument(int32 DocIndex)
+{
+	FDocument& Document = Documents[DocIndex];
+	Document.Keys[Key_Name] = Normalize(Document.Name);
+	Document.Keys[Key_ID] = Normalize(Document.ID);
+	Document.Keys[Key_Initials].Reset();
+	if (bPinyinEnabled)
+	{
+		// 纯 ASCII 名称的首字母就是名称本身，不重复索引
+		FString Initials = GISPinyin::ToInitials(Document.Name);
+		if (Initials != Document.Keys[Key_Name])
+		{
+			Document.Keys[Key_Initials] = MoveTemp(Initials);
+		}
+	}
+
+	TArray<uint64> Grams;
+	for (const FString& Key : Document.Keys)
+	{
+		for (int32 Index = 0; Index < Key.Len(); ++Index)
+		{
+			Grams.Add(MakeGram(Key[Index], 0));
+			if (Index + 1 < Key.Len())
+			{
+				Grams.Add(MakeGram(Key[Index], Key[Index + 1]));
+			}
+		}
+	}
+	Algo::Sort(Grams);
+
+	// 文档下标只增不减，直接追加即保持倒排表有序
+	for (int32 Index = 0; Index < Grams.Num(); ++Index)
+	{
+		if (Index == 0 || Grams[Index] != Grams[Index - 1])
+		{
+			Postings.FindOrAdd(Grams[Index]).Add(DocIndex);
+		}
+	}
+}
+
+void FGISSearchIndex::Rebuild()
+{
+	TArray<FDocument> OldDocuments = MoveTemp(Documents);
+	Documents.Reset(DocumentByID.Num());
+	DocumentByID.Reset();
+	Postings.Reset();
+	DeadCount = 0;
+
+	for (FDocument& Document : OldDocuments)
+	{
+		if (Document.bAlive)
+		{
+			const int32 DocIndex = Documents.Add(MoveTemp(Document));
+			DocumentByID.Add(Documents[DocIndex].ID, DocIndex);
+			IndexDocument(DocIndex);
+		}
+	}
+	++Revision;
+}
+
+void FGISSearchIndex::CollectCandidates(const FString& Query, TArray<int32>& InOutDocs, bool bHasPrevious) const
+{
+	TArray<const TArray<int32>*, TInlineAllocator<16>> Lists;
+	if (Query.Len() == 1)
+	{
+		Lists.Add(Postings.Find(MakeGram(Query[0], 0)));
+	}
+	for (int32 Index = 0; Index + 1 < Query.Len(); ++Index)
+	{
+		Lists.AddUnique(Postings.Find(MakeGram(Query[Index], Query[Index + 1])));
+	}
+	if (Lists.Contains(nullptr))
+	{
+		InOutDocs.Reset();
+		return;
+	}
+
+	// 上一次的候选不比最短的倒排表多时直接沿用，交给逐个核对
+	Algo::SortBy(Lists, [](const TArray<int32>* List) { return List->Num(); });
+	if (bHasPrevious && InOutDocs.Num() <= Lists[0]->Num())
+	{
+		return;
+	}
+
+	// 从最短的倒排表开始，逐个在其余表中二分确认
+	InOutDocs = *Lists[0];
+	for (int32 ListIndex = 1; ListIndex < Lists.Num() && InOutDocs.Num() > 0; ++ListIndex)
+	{
+		const TArray<int32>& List = *Lists[ListIndex];
+		InOutDocs.RemoveAll([&List](int32 DocIndex) { return Algo::BinarySearch(List, DocIndex) == INDEX_NONE; });
+	}
+}
+
+int32 FGISSearchIndex::ScoreBound(const FDocument& Document, const FString& Query)
+{
+	// 只比较首字符与长度，结果不大于 ScoreDocument
+	const TCHAR First = Query[0];
+	const FString& Name = Document.Keys[Key_Name];
+	if (Name.Len() >= Query.Len() && Name[0] == First)
+	{
+		return 0;
+	}
+	const FString& ID = Document.Keys[Key_ID];
+	if (ID.Len() == Query.Len() && ID[0] == First)
+	{
+		return 2;
+	}
+	const FString& Initials = Document.Keys[Key_Initials];
+	if (Initials.Len() >= Query.Len() && Initials[0] == First)
+	{
+		return 3;
+	}
+	return 4;
+}
+
+int32 FGISSearchIndex::ScoreDocument(const FDocument& Document, const FString& Query)
+{
+	const FString& Name = Document.Keys[Key_Name];
+	const FString& ID = Document.Keys[Key_ID];
+	const FString& Initials = Document.Keys[Key_Initials];
+
+	if (Name.Equals(Query, ESearchCase::CaseSensitive))
+	{
+		return 0;
+	}
+	if (Name.StartsWith(Query, ESearchCase::CaseSensitive))
+	{
+		return 1;
+	}
+	if (ID.Equals(Query, ESearchCase::CaseSensitive))
+	{
+		return 2;
+	}
+	if (Initials.StartsWith(Query, ESearchCase::CaseSensitive))
+	{
+		return 3;
+	}
+	if (Name.Contains(Query, ESearchCase::CaseSensitive))
+	{
+		return 4;
+	}
+	if (Initials.Contains(Query, ESearchCase::CaseSensitive))
+	{
+		return 5;
+	}
+	if (ID.Contains(Query, ESearchCase::CaseSensitive))
+	{
+		return 6;
+	}
+	return INDEX_NONE;
+}
+
+void FGISSearchIndex::Search(const FString& Query, int32 MaxResults, TArray<FGISSearchHit>& OutHits)
+{
+	OutHits.Reset();
+
+	const FString Normalized = Normalize(Query);
+	if (Normalized.IsEmpty())
+	{
+		LastQuery.Reset();
+		LastMatches.Reset();
+		return;
+	}
+
+	TArray<int32> Candidates;
+	const bool bIncremental = LastRevision == Revision && !LastQuery.IsEmpty() && Normalized.StartsWith(LastQuery, ESearchCase::CaseSensitive);
+	if (bIncremental)
+	{
+		Candidates = MoveTemp(LastMatches);
+	}
+	CollectCandidates(Normalized, Candidates, bIncremental);
+
+	TArray<int32> Remaining;
+	Remaining.Reserve(Candidates.Num());
+	TArray<FRankedDoc> Top;
+	Top.Reserve(MaxResults + 1);
+
+	for (const int32 DocIndex : Candidates)
+	{
+		const FDocument& Document = Documents[DocIndex];
+		if (!Document.bAlive)
+		{
+			continue;
+		}
+		const int32 Length = FMath::Min(Document.Keys[Key_Name].Len(), MaxRankLength);
+
+		// 名次已不可能进入前 MaxResults 的候选不做子串核对，原样留给下一次过滤
+		const int32 BoundRank = ScoreBound(Document, Normalized) * (MaxRankLength + 1) + Length;
+		if (MaxResults <= 0 || (Top.Num() == MaxResults && BoundRank >= Top.Last().Rank))
+		{
+			Remaining.Add(DocIndex);
+			continue;
+		}
+
+		const int32 Score = ScoreDocument(Document, Normalized);
+		if (Score == INDEX_NONE)
+		{
+			continue;
+		}
+		Remaining.Add(DocIndex);
+
+		// 候选按文档下标升序，同分时先加入的靠前
+		const int32 Rank = Score * (MaxRankLength + 1) + Length;
+		if (Top.Num() == MaxResults && Rank >= Top.Last().Rank)
+		{
+			continue;
+		}
+		const int32 Position = Algo::UpperBoundBy(Top, Rank, &FRankedDoc::Rank);
+		Top.Insert(FRankedDoc{ Rank, DocIndex }, Position);
+		if (Top.Num() > MaxResults)
+		{
+			Top.Pop(EAllowShrinking::No);
+		}
+	}
+
+	OutHits.Reserve(Top.Num());
+	for (const FRankedDoc& Ranked : Top)
+	{
+		const FDocument& Document = Documents[Ranked.DocIndex];
+		OutHits.Add(FGISSearchHit{ Document.ID, Document.Name, Ranked.Rank / (MaxRankLength + 1) });
+	}
+
+	LastQuery = Normalized;
+	LastMatches = MoveTemp(Remaining);
+	LastRevision = Revision;
+}
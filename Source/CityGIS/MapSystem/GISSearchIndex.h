@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 一条搜索结果，Score 越小越靠前
+struct FGISSearchHit
+{
+	FString ID;
+	FString Name;
+	int32 Score = 0;
+};
+
+/**
+ * 要素名称与 ID 的搜索索引 (Ctrl+F)
+ *
+ * 每个要素取三个检索键：规范化的名称、小写 ID、名称的拼音首字母；规范化为转小写、全角转半角、去空白。
+ * 所有键的单字与相邻双字建倒排表，查询时取查询串各双字的倒排表求交得到候选，再逐个核对子串。
+ * 排序：名称完全相同 > 名称前缀 > ID 相同 > 首字母前缀 > 名称包含 > 首字母包含 > ID 包含，同级名称短的靠前。
+ *
+ * 逐字输入时查询串是上一次的延长，上一次留下的候选比最短的倒排表还少时直接在其中过滤；
+ * 名次下界已排不进结果的候选跳过子串核对，单字查询命中数万条时也只做首字符比较。
+ * 删除只做标记，失效条目过多时整体重建。仅在游戏线程使用。
+ */
+class CITYGIS_API FGISSearchIndex
+{
+public:
+	// 同一 ID 再次加入时更新名称
+	void Add(const FString& ID, const FString& Name);
+	bool Remove(const FString& ID);
+	void Reset();
+
+	int32 Num() const { return DocumentByID.Num(); }
+
+	// 切换是否按拼音首字母匹配，会重建索引
+	void SetPinyinEnabled(bool bEnabled);
+
+	// 按得分排序的前 MaxResults 条；查询为空时没有结果
+	void Search(const FString& Query, int32 MaxResults, TArray<FGISSearchHit>& OutHits);
+
+	static FString Normalize(const FString& Text);
+
+private:
+	enum EKey
+	{
+		Key_Name,
+		Key_ID,
+		Key_Initials,
+		Key_Count
+	};
+
+	struct FDocument
+	{
+		FString ID;
+		FString Name;
+		FString Keys[Key_Count];
+		bool bAlive = true;
+	};
+
+	static uint64 MakeGram(TCHAR A, TCHAR B);
+
+	void IndexDocument(int32 DocIndex);
+	void Rebuild();
+	// bHasPrevious 时 InOutDocs 为上一次留下的候选，比倒排表求交更少时原样保留
+	void CollectCandidates(const FString& Query, TArray<int32>& InOutDocs, bool bHasPrevious) const;
+
+	// 不匹配时返回 INDEX_NONE；ScoreBound 为不做子串查找的得分下界
+	static int32 ScoreBound(const FDocument& Document, const FString& Query);
+	static int32 ScoreDocument(const FDocument& Document, const FString& Query);
+
+	TArray<FDocument> Documents;
+	TMap<FString, int32> DocumentByID;
+	int32 DeadCount = 0;
+
+	// 单字与双字 -> 升序的文档下标 (可能含已删除的文档)
+	TMap<uint64, TArray<int32>> Postings;
+
+	bool bPinyinEnabled = true;
+
+	// 增量搜索：索引未变且查询串以上一次为前缀时，只过滤上一次留下的候选
+	// (已核对的匹配，加上因名次不够而跳过核对的候选)
+	uint32 Revision = 0;
+	uint32 LastRevision = MAX_uint32;
+	FString LastQuery;
+	TArray<int32> LastMatches;
+};
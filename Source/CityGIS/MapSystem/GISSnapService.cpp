@@ -0,0 +1,386 @@
+#include "GISSnapService.h"
+
+namespace
+{
+	// 相邻两个吸附点之间最多补入的已有顶点数
+	constexpr int32 MaxSeamVertices = 4096;
+
+	double PointSegmentDistanceSquared(const FVector2D& P, const FVector2D& A, const FVector2D& B, double& OutT)
+	{
+		const FVector2D AB = B - A;
+		const double LenSq = AB.SizeSquared();
+		OutT = LenSq > 0.0 ? FMath::Clamp(FVector2D::DotProduct(P - A, AB) / LenSq, 0.0, 1.0) : 0.0;
+		return FVector2D::DistSquared(P, A + AB * OutT);
+	}
+}
+
+void FGISSnapService::Reset()
+{
+	GeoVertices.Reset();
+	LocalVertices.Reset();
+	VertexRing.Reset();
+	Rings.Reset();
+	VertexCells.Reset();
+	EdgeCells.Reset();
+	MetersPerDegLng = 0.0;
+}
+
+FVector2D FGISSnapService::ToLocal(const FVector2D& Geo) const
+{
+	return FVector2D(Geo.X * MetersPerDegLng, (Geo.Y - RefLat) * MetersPerDegLat);
+}
+
+int64 FGISSnapService::CellKey(int32 X, int32 Y) const
+{
+	return (static_cast<int64>(X) << 32) | static_cast<uint32>(Y);
+}
+
+FIntPoint FGISSnapService::CellOf(const FVector2D& Local) const
+{
+	return FIntPoint(FMath::FloorToInt(Local.X / ToleranceMeters), FMath::FloorToInt(Local.Y / ToleranceMeters));
+}
+
+int32 FGISSnapService::NextVertex(int32 Vertex) const
+{
+	const FRingRange& Range = Rings[VertexRing[Vertex]];
+	return Vertex + 1 < Range.Start + Range.Num ? Vertex + 1 : Range.Start;
+}
+
+void FGISSnapService::Bucket(int32 Vertex)
+{
+	// 以格子为单位的坐标
+	const FVector2D A = LocalVertices[Vertex] / ToleranceMeters;
+	const FVector2D B = LocalVertices[NextVertex(Vertex)] / ToleranceMeters;
+	FIntPoint Cell(FMath::FloorToInt(A.X), FMath::FloorToInt(A.Y));
+	const FIntPoint End(FMath::FloorToInt(B.X), FMath::FloorToInt(B.Y));
+
+	VertexCells.FindOrAdd(CellKey(Cell.X, Cell.Y)).Add(Vertex);
+	EdgeCells.FindOrAdd(CellKey(Cell.X, Cell.Y)).Add(Vertex);
+
+	// 边只登记到它实际穿过的格子 (网格遍历，代价与边长/容差成正比)；
+	// 与边距离不超过容差的点必在所穿格子的 3x3 邻域内，查询时再用精确距离过滤
+	const FVector2D Dir = B - A;
+	const int32 StepX = Dir.X > 0.0 ? 1 : -1;
+	const int32 StepY = Dir.Y > 0.0 ? 1 : -1;
+	const double DeltaX = Dir.X != 0.0 ? FMath::Abs(1.0 / Dir.X) : TNumericLimits<double>::Max();
+	const double DeltaY = Dir.Y != 0.0 ? FMath::Abs(1.0 / Dir.Y) : TNumericLimits<double>::Max();
+	double NextX = Dir.X != 0.0 ? (StepX > 0 ? Cell.X + 1 - A.X : A.X - Cell.X) * DeltaX : TNumericLimits<double>::Max();
+	double NextY = Dir.Y != 0.0 ? (StepY > 0 ? Cell.Y + 1 - A.Y : A.Y - Cell.Y) * DeltaY : TNumericLimits<double>::Max();
+
+	const int32 NumSteps = FMath::Abs(End.X - Cell.X) + FMath::Abs(End.Y - Cell.Y);
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		if (NextX < NextY)
+		{
+			Cell.X += StepX;
+			NextX += DeltaX;
+		}
+		else if (NextY < NextX)
+		{
+			Cell.Y += StepY;
+			NextY += DeltaY;
+		}
+		else
+		{
+			// 恰好穿过格点：两侧的格子都登记，再斜向前进 (算两步)
+			EdgeCells.FindOrAdd(CellKey(Cell.X + StepX, Cell.Y)).Add(Vertex);
+			EdgeCells.FindOrAdd(CellKey(Cell.X, Cell.Y + StepY)).Add(Vertex);
+			Cell.X += StepX;
+			Cell.Y += StepY;
+			NextX += DeltaX;
+			NextY += DeltaY;
+			++Step;
+		}
+		EdgeCells.FindOrAdd(CellKey(Cell.X, Cell.Y)).Add(Vertex);
+	}
+
+	// 浮点误差使遍历停在相邻格子时，终点格子仍要登记
+	if (Cell != End)
+	{
+		EdgeCells.FindOrAdd(CellKey(End.X, End.Y)).Add(Vertex);
+	}
+}
+
+void FGISSnapService::Rebucket()
+{
+	VertexCells.Reset();
+	EdgeCells.Reset();
+	for (int32 Vertex = 0; Vertex < LocalVertices.Num(); ++Vertex)
+	{
+		Bucket(Vertex);
+	}
+}
+
+void FGISSnapService::SetTolerance(double InToleranceMeters)
+{
+	InToleranceMeters = FMath::Max(InToleranceMeters, MinToleranceMeters);
+	if (InToleranceMeters != ToleranceMeters)
+	{
+		ToleranceMeters = InToleranceMeters;
+		Rebucket();
+	}
+}
+
+void FGISSnapService::AddGeometry(const FGISMultiPolygon& Geometry)
+{
+	for (const FGISPolygon& Polygon : Geometry)
+	{
+		for (const FGISRing& Ring : Polygon.Rings)
+		{
+			// 环已闭合，末点不重复存储
+			const int32 Num = Ring.Num() > 0 && Ring[0] == Ring.Last() ? Ring.Num() - 1 : Ring.Num();
+			if (Num < 3)
+			{
+				continue;
+			}
+
+			if (MetersPerDegLng == 0.0)
+			{
+				RefLat = Ring[0].Y;
+				MetersPerDegLat = 110574.0;
+				MetersPerDegLng = 111320.0 * FMath::Cos(FMath::DegreesToRadians(RefLat));
+			}
+
+			const int32 RingIndex = Rings.Num();
+			FRingRange& Range = Rings.AddDefaulted_GetRef();
+			Range.Start = GeoVertices.Num();
+			Range.Num = Num;
+
+			for (int32 Idx = 0; Idx < Num; ++Idx)
+			{
+				GeoVertices.Add(Ring[Idx]);
+				LocalVertices.Add(ToLocal(Ring[Idx]));
+				VertexRing.Add(RingIndex);
+			}
+			for (int32 Idx = 0; Idx < Num; ++Idx)
+			{
+				Bucket(Range.Start + Idx);
+			}
+		}
+	}
+}
+
+bool FGISSnapService::FindSnap(const FVector2D& Geo, FSnapHit& OutHit) const
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	const FVector2D Local = ToLocal(Geo);
+	const FIntPoint Cell = CellOf(Local);
+	const double ToleranceSq = ToleranceMeters * ToleranceMeters;
+
+	// 先找顶点
+	int32 BestVertex = INDEX_NONE;
+	double BestDistSq = ToleranceSq;
+	for (int32 X = Cell.X - 1; X <= Cell.X + 1; ++X)
+	{
+		for (int32 Y = Cell.Y - 1; Y <= Cell.Y + 1; ++Y)
+		{
+			if (const TArray<int32>* Vertices = VertexCells.Find(CellKey(X, Y)))
+			{
+				for (int32 Vertex : *Vertices)
+				{
+					const double DistSq = FVector2D::DistSquared(Local, LocalVertices[Vertex]);
+					if (DistSq <= BestDistSq)
+					{
+						BestDistSq = DistSq;
+						BestVertex = Vertex;
+					}
+				}
+			}
+		}
+	}
+
+	if (BestVertex != INDEX_NONE)
+	{
+		OutHit.Point = GeoVertices[BestVertex];
+		OutHit.Ring = VertexRing[BestVertex];
+		OutHit.Param = BestVertex - Rings[OutHit.Ring].Start;
+		return true;
+	}
+
+	// 再找边
+	int32 BestEdge = INDEX_NONE;
+	double BestT = 0.0;
+	BestDistSq = ToleranceSq;
+	for (int32 X = Cell.X - 1; X <= Cell.X + 1; ++X)
+	{
+		for (int32 Y = Cell.Y - 1; Y <= Cell.Y + 1; ++Y)
+		{
+			if (const TArray<int32>* Edges = EdgeCells.Find(CellKey(X, Y)))
+			{
+				for (int32 Edge : *Edges)
+				{
+					double T = 0.0;
+					const double DistSq = PointSegmentDistanceSquared(Local, LocalVertices[Edge], LocalVertices[NextVertex(Edge)], T);
+					if (DistSq <= BestDistSq)
+					{
+						BestDistSq = DistSq;
+						BestEdge = Edge;
+						BestT = T;
+					}
+				}
+			}
+		}
+	}
+
+	if (BestEdge != INDEX_NONE)
+	{
+		// 在经纬度空间插值 (投影是线性的，与米制空间的垂足一致)
+		const FVector2D& A = GeoVertices[BestEdge];
+		const FVector2D& B = GeoVertices[NextVertex(BestEdge)];
+		OutHit.Point = A + (B - A) * BestT;
+		OutHit.Ring = VertexRing[BestEdge];
+		OutHit.Param = (BestEdge - Rings[OutHit.Ring].Start) + BestT;
+		return true;
+	}
+	return false;
+}
+
+bool FGISSnapService::SnapPoint(const FVector2D& Point, FVector2D& OutPoint) const
+{
+	FSnapHit Hit;
+	if (FindSnap(Point, Hit))
+	{
+		OutPoint = Hit.Point;
+		return true;
+	}
+	OutPoint = Point;
+	return false;
+}
+
+bool FGISSnapService::CollectSeam(const FSnapHit& From, const FSnapHit& To, bool bForward, TArray<int32>& OutVertices) const
+{
+	const FRingRange& Range = Rings[From.Ring];
+	const int32 Num = Range.Num;
+
+	// 沿环方向从 From 到 To 的参数跨度
+	const double Span = bForward ? FMath::Fmod(To.Param - From.Param + Num, static_cast<double>(Num))
+	                             : FMath::Fmod(From.Param - To.Param + Num, static_cast<double>(Num));
+
+	const FVector2D A = ToLocal(From.Point);
+	const FVector2D B = ToLocal(To.Point);
+	const double ToleranceSq = ToleranceMeters * ToleranceMeters;
+
+	OutVertices.Reset();
+	int32 Local = bForward ? FMath::FloorToInt(From.Param) + 1 : FMath::CeilToInt(From.Param) - 1;
+	while (OutVertices.Num() <= MaxSeamVertices)
+	{
+		const int32 Wrapped = ((Local % Num) + Num) % Num;
+		const double Offset = bForward ? FMath::Fmod(Wrapped - From.Param + Num, static_cast<double>(Num))
+		                               : FMath::Fmod(From.Param - Wrapped + Num, static_cast<double>(Num));
+		if (Offset <= 0.0 || Offset >= Span)
+		{
+			return true;
+		}
+
+		// 补入的顶点必须贴着新画的这条边，否则说明新边并非沿已有边界走
+		const int32 Vertex = Range.Start + Wrapped;
+		double T = 0.0;
+		if (PointSegmentDistanceSquared(LocalVertices[Vertex], A, B, T) > ToleranceSq)
+		{
+			return false;
+		}
+		OutVertices.Add(Vertex);
+		Local += bForward ? 1 : -1;
+	}
+	return false;
+}
+
+void FGISSnapService::AppendSeam(const FSnapHit& From, const FSnapHit& To, FGISRing& OutRing) const
+{
+	if (From.Ring == INDEX_NONE || From.Ring != To.Ring)
+	{
+		return;
+	}
+
+	TArray<int32> Forward;
+	TArray<int32> Backward;
+	const bool bForward = CollectSeam(From, To, true, Forward);
+	const bool bBackward = CollectSeam(From, To, false, Backward);
+
+	const TArray<int32>* Seam = nullptr;
+	if (bForward && bBackward)
+	{
+		Seam = Forward.Num() <= Backward.Num() ? &Forward : &Backward;
+	}
+	else if (bForward)
+	{
+		Seam = &Forward;
+	}
+	else if (bBackward)
+	{
+		Seam = &Backward;
+	}
+
+	if (Seam)
+	{
+		for (int32 Vertex : *Seam)
+		{
+			OutRing.Add(GeoVertices[Vertex]);
+		}
+	}
+}
+
+FGISRing FGISSnapService::SnapRing(const FGISRing& Ring) const
+{
+	const int32 Num = Ring.Num() > 0 && Ring[0] == Ring.Last() ? Ring.Num() - 1 : Ring.Num();
+	if (IsEmpty() || Num < 3)
+	{
+		return Ring;
+	}
+
+	TArray<FSnapHit> Hits;
+	Hits.SetNum(Num);
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		if (!FindSnap(Ring[Idx], Hits[Idx]))
+		{
+			Hits[Idx].Point = Ring[Idx];
+			Hits[Idx].Ring = INDEX_NONE;
+		}
+	}
+
+	FGISRing Result;
+	Result.Reserve(Num + 1);
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		const FSnapHit& Hit = Hits[Idx];
+		if (Result.Num() == 0 || Result.Last() != Hit.Point)
+		{
+			Result.Add(Hit.Point);
+		}
+		AppendSeam(Hit, Hits[(Idx + 1) % Num], Result);
+	}
+
+	while (Result.Num() > 1 && Result[0] == Result.Last())
+	{
+		Result.Pop();
+	}
+
+	// 吸附后退化 (所有点塌到同一处) 则放弃吸附
+	if (Result.Num() < 3)
+	{
+		return Ring;
+	}
+	Result.Add(Result[0]);
+	return Result;
+}
+
+FGISMultiPolygon FGISSnapService::SnapGeometry(const FGISMultiPolygon& Geometry) const
+{
+	FGISMultiPolygon Result;
+	Result.Reserve(Geometry.Num());
+	for (const FGISPolygon& Polygon : Geometry)
+	{
+		FGISPolygon& Snapped = Result.AddDefaulted_GetRef();
+		for (const FGISRing& Ring : Polygon.Rings)
+		{
+			Snapped.Rings.Add(SnapRing(Ring));
+		}
+	}
+	GISGeometry::Normalize(Result);
+	return Result;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+/**
+ * 顶点/边吸附服务
+ * 已提交要素的所有环投影到局部米制平面 (等距圆柱，以首个要素纬度为基准)，
+ * 顶点和边按容差大小的网格分桶，单点查询只检查 3x3 个格子
+ * 吸附优先级：容差内最近顶点 > 容差内最近边上的垂足 > 保持原样
+ * 相邻两点吸附到同一条已有边界时，会补上其间的已有顶点，使两个面的公共边完全重合
+ */
+class CITYGIS_API FGISSnapService
+{
+public:
+	void Reset();
+	void AddGeometry(const FGISMultiPolygon& Geometry);
+	bool IsEmpty() const { return Rings.Num() == 0; }
+
+	// 容差下限 (米)，与 UGISWebWidget::SnapToleranceMeters 的 ClampMin 一致
+	static constexpr double MinToleranceMeters = 0.1;
+
+	// 容差 (米)，改变时按新格子大小重新分桶
+	void SetTolerance(double InToleranceMeters);
+	double GetTolerance() const { return ToleranceMeters; }
+
+	bool SnapPoint(const FVector2D& Point, FVector2D& OutPoint) const;
+	FGISRing SnapRing(const FGISRing& Ring) const;
+	FGISMultiPolygon SnapGeometry(const FGISMultiPolygon& Geometry) const;
+
+private:
+	struct FRingRange
+	{
+		int32 Start = 0;
+		int32 Num = 0;
+	};
+
+	// 吸附结果：Param 为所在环上的位置 (整数部分为边序号，小数部分为边上比例)
+	struct FSnapHit
+	{
+		FVector2D Point = FVector2D::ZeroVector;
+		int32 Ring = INDEX_NONE;
+		double Param = 0.0;
+	};
+
+	FVector2D ToLocal(const FVector2D& Geo) const;
+	int64 CellKey(int32 X, int32 Y) const;
+	FIntPoint CellOf(const FVector2D& Local) const;
+	int32 NextVertex(int32 Vertex) const;
+	void Bucket(int32 Vertex);
+	void Rebucket();
+
+	bool FindSnap(const FVector2D& Geo, FSnapHit& OutHit) const;
+	void AppendSeam(const FSnapHit& From, const FSnapHit& To, FGISRing& OutRing) const;
+	bool CollectSeam(const FSnapHit& From, const FSnapHit& To, bool bForward, TArray<int32>& OutVertices) const;
+
+	double ToleranceMeters = 50.0;
+	double RefLat = 0.0;
+	double MetersPerDegLng = 0.0;
+	double MetersPerDegLat = 0.0;
+
+	// 顶点原始经纬度 (输出用，保证公共边坐标逐位相同) 与局部米制坐标
+	TArray<FVector2D> GeoVertices;
+	TArray<FVector2D> LocalVertices;
+	TArray<int32> VertexRing;
+	TArray<FRingRange> Rings;
+
+	// 每个格子里的顶点，以及经过该格子的边 (以起点顶点序号表示)
+	TMap<int64, TArray<int32>> VertexCells;
+	TMap<int64, TArray<int32>> EdgeCells;
+};
@@ -0,0 +1,277 @@
+#include "GISSpatialIndex.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	constexpr int32 NodeCapacity = 16;
+
+	double BoxDistanceSquared(const FBox2D& Box, const FVector2D& Point, double ScaleX)
+	{
+		const double DX = FMath::Max3(Box.Min.X - Point.X, 0.0, Point.X - Box.Max.X) * ScaleX;
+		const double DY = FMath::Max3(Box.Min.Y - Point.Y, 0.0, Point.Y - Box.Max.Y);
+		return DX * DX + DY * DY;
+	}
+
+	double SegmentDistanceSquared(const FVector2D& Point, const FVector2D& A, const FVector2D& B, double ScaleX)
+	{
+		const FVector2D P(Point.X * ScaleX, Point.Y);
+		const FVector2D SA(A.X * ScaleX, A.Y);
+		const FVector2D SB(B.X * ScaleX, B.Y);
+		const FVector2D AB = SB - SA;
+		const double LenSq = AB.SizeSquared();
+		const double T = LenSq > 0.0 ? FMath::Clamp(FVector2D::DotProduct(P - SA, AB) / LenSq, 0.0, 1.0) : 0.0;
+		return FVector2D::DistSquared(P, SA + AB * T);
+	}
+
+	double GeometryDistanceSquared(const FGISMultiPolygon& Geometry, const FVector2D& Point, double ScaleX)
+	{
+		if (GISGeometry::IsPointInGeometry(Geometry, Point))
+		{
+			return 0.0;
+		}
+
+		double Best = TNumericLimits<double>::Max();
+		for (const FGISPolygon& Polygon : Geometry)
+		{
+			for (const FGISRing& Ring : Polygon.Rings)
+			{
+				for (int32 Idx = 1; Idx < Ring.Num(); ++Idx)
+				{
+					Best = FMath::Min(Best, SegmentDistanceSquared(Point, Ring[Idx - 1], Ring[Idx], ScaleX));
+				}
+			}
+		}
+		return Best;
+	}
+
+	struct FNearestEntry
+	{
+		double DistanceSq;
+		int32 Level;
+		int32 Position;
+		bool bExact;
+	};
+}
+
+void FGISSpatialIndex::Add(const FString& ID, TSharedPtr<const FGISMultiPolygon> Geometry)
+{
+	if (!Geometry.IsValid() || Geometry->Num() == 0)
+	{
+		return;
+	}
+
+	Remove(ID);
+
+	FGISSpatialItem& Item = Items.AddDefaulted_GetRef();
+	Item.ID = ID;
+	Item.Bounds = GISGeometry::ComputeBounds(*Geometry);
+	Item.Geometry = MoveTemp(Geometry);
+	ItemIndex.Add(ID, Items.Num() - 1);
+	bDirty = true;
+}
+
+bool FGISSpatialIndex::Remove(const FString& ID)
+{
+	int32 Index = INDEX_NONE;
+	if (!ItemIndex.RemoveAndCopyValue(ID, Index))
+	{
+		return false;
+	}
+
+	// 与末尾交换删除，修正被移动元素的下标
+	const int32 LastIndex = Items.Num() - 1;
+	if (Index != LastIndex)
+	{
+		Items.Swap(Index, LastIndex);
+		ItemIndex[Items[Index].ID] = Index;
+	}
+	Items.RemoveAt(LastIndex);
+	bDirty = true;
+	return true;
+}
+
+void FGISSpatialIndex::Reset()
+{
+	Items.Reset();
+	ItemIndex.Reset();
+	NodeBounds.Reset();
+	LevelStarts.Reset();
+	LeafItems.Reset();
+	bDirty = false;
+}
+
+const FGISSpatialItem* FGISSpatialIndex::Find(const FString& ID) const
+{
+	const int32* Index = ItemIndex.Find(ID);
+	return Index ? &Items[*Index] : nullptr;
+}
+
+void FGISSpatialIndex::EnsureBuilt() const
+{
+	if (!bDirty)
+	{
+		return;
+	}
+	bDirty = false;
+
+	NodeBounds.Reset();
+	LevelStarts.Reset();
+	LeafItems.Reset();
+
+	const int32 NumItems = Items.Num();
+	if (NumItems == 0)
+	{
+		return;
+	}
+
+	// STR：按中心 X 切成 S 条竖带，带内按中心 Y 排序，连续每 NodeCapacity 个组成一个叶节点
+	LeafItems.SetNumUninitialized(NumItems);
+	for (int32 Idx = 0; Idx < NumItems; ++Idx)
+	{
+		LeafItems[Idx] = Idx;
+	}
+
+	Algo::Sort(LeafItems, [this](int32 A, int32 B)
+	{
+		return Items[A].Bounds.GetCenter().X < Items[B].Bounds.GetCenter().X;
+	});
+
+	const int32 NumLeafNodes = FMath::DivideAndRoundUp(NumItems, NodeCapacity);
+	const int32 NumSlices = FMath::CeilToInt(FMath::Sqrt(static_cast<double>(NumLeafNodes)));
+	const int32 SliceSize = NumSlices * NodeCapacity;
+	for (int32 SliceStart = 0; SliceStart < NumItems; SliceStart += SliceSize)
+	{
+		const int32 Count = FMath::Min(SliceSize, NumItems - SliceStart);
+		TArrayView<int32> Slice(LeafItems.GetData() + SliceStart, Count);
+		Algo::Sort(Slice, [this](int32 A, int32 B)
+		{
+			return Items[A].Bounds.GetCenter().Y < Items[B].Bounds.GetCenter().Y;
+		});
+	}
+
+	// 第 0 层为要素本身，其上逐层打包直到只剩根节点
+	NodeBounds.Reserve(NumItems + NumItems / (NodeCapacity - 1) + 1);
+	LevelStarts.Add(0);
+	for (int32 ItemIdx : LeafItems)
+	{
+		NodeBounds.Add(Items[ItemIdx].Bounds);
+	}
+
+	int32 LevelStart = 0;
+	int32 LevelCount = NumItems;
+	while (LevelCount > 1)
+	{
+		const int32 ParentStart = NodeBounds.Num();
+		LevelStarts.Add(ParentStart);
+		for (int32 ChildIdx = 0; ChildIdx < LevelCount; ChildIdx += NodeCapacity)
+		{
+			FBox2D Bounds(ForceInit);
+			const int32 ChildEnd = FMath::Min(ChildIdx + NodeCapacity, LevelCount);
+			for (int32 Child = ChildIdx; Child < ChildEnd; ++Child)
+			{
+				Bounds += NodeBounds[LevelStart + Child];
+			}
+			NodeBounds.Add(Bounds);
+		}
+		LevelStart = ParentStart;
+		LevelCount = NodeBounds.Num() - ParentStart;
+	}
+}
+
+void FGISSpatialIndex::QueryBox(const FBox2D& Box, TArray<const FGISSpatialItem*>& OutItems) const
+{
+	EnsureBuilt();
+	if (NodeBounds.Num() == 0 || !Box.bIsValid)
+	{
+		return;
+	}
+
+	// (层, 层内序号)
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Stack;
+	Stack.Emplace(LevelStarts.Num() - 1, 0);
+
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, int32> Node = Stack.Pop(EAllowShrinking::No);
+		const int32 Level = Node.Key;
+		if (!NodeBounds[LevelStarts[Level] + Node.Value].Intersect(Box))
+		{
+			continue;
+		}
+
+		if (Level == 0)
+		{
+			OutItems.Add(&Items[LeafItems[Node.Value]]);
+			continue;
+		}
+
+		const int32 ChildLevelCount = LevelStarts[Level] - LevelStarts[Level - 1];
+		const int32 ChildEnd = FMath::Min((Node.Value + 1) * NodeCapacity, ChildLevelCount);
+		for (int32 Child = Node.Value * NodeCapacity; Child < ChildEnd; ++Child)
+		{
+			Stack.Emplace(Level - 1, Child);
+		}
+	}
+}
+
+void FGISSpatialIndex::QueryPoint(const FVector2D& Point, TArray<const FGISSpatialItem*>& OutItems) const
+{
+	TArray<const FGISSpatialItem*> Candidates;
+	QueryBox(FBox2D(Point, Point), Candidates);
+	for (const FGISSpatialItem* Item : Candidates)
+	{
+		if (GISGeometry::IsPointInGeometry(*Item->Geometry, Point))
+		{
+			OutItems.Add(Item);
+		}
+	}
+}
+
+void FGISSpatialIndex::QueryNearest(const FVector2D& Point, int32 K, TArray<const FGISSpatialItem*>& OutItems) const
+{
+	EnsureBuilt();
+	if (NodeBounds.Num() == 0 || K <= 0)
+	{
+		return;
+	}
+
+	const double ScaleX = FMath::Cos(FMath::DegreesToRadians(Point.Y));
+	auto Closer = [](const FNearestEntry& A, const FNearestEntry& B)
+	{
+		return A.DistanceSq < B.DistanceSq;
+	};
+
+	// 按下界距离的最小堆；叶子先以包围盒距离入堆，弹出时再换成精确距离重新入堆
+	TArray<FNearestEntry> Heap;
+	const int32 RootLevel = LevelStarts.Num() - 1;
+	Heap.HeapPush({ BoxDistanceSquared(NodeBounds[LevelStarts[RootLevel]], Point, ScaleX), RootLevel, 0, false }, Closer);
+
+	while (Heap.Num() > 0 && OutItems.Num() < K)
+	{
+		FNearestEntry Entry;
+		Heap.HeapPop(Entry, Closer, EAllowShrinking::No);
+
+		if (Entry.Level == 0)
+		{
+			const FGISSpatialItem& Item = Items[LeafItems[Entry.Position]];
+			if (Entry.bExact)
+			{
+				OutItems.Add(&Item);
+			}
+			else
+			{
+				Heap.HeapPush({ GeometryDistanceSquared(*Item.Geometry, Point, ScaleX), 0, Entry.Position, true }, Closer);
+			}
+			continue;
+		}
+
+		const int32 ChildLevel = Entry.Level - 1;
+		const int32 ChildLevelCount = LevelStarts[Entry.Level] - LevelStarts[ChildLevel];
+		const int32 ChildEnd = FMath::Min((Entry.Position + 1) * NodeCapacity, ChildLevelCount);
+		for (int32 Child = Entry.Position * NodeCapacity; Child < ChildEnd; ++Child)
+		{
+			const double DistanceSq = BoxDistanceSquared(NodeBounds[LevelStarts[ChildLevel] + Child], Point, ScaleX);
+			Heap.HeapPush({ DistanceSq, ChildLevel, Child, false }, Closer);
+		}
+	}
+}
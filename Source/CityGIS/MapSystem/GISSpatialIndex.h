@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+// 索引中的一个要素
+struct FGISSpatialItem
+{
+	FString ID;
+	FBox2D Bounds = FBox2D(ForceInit);
+	TSharedPtr<const FGISMultiPolygon> Geometry;
+};
+
+/**
+ * 要素包围盒上的 STR 批量装载 R 树 (packed，扁平数组存储)
+ * 增删只标记脏，下次查询时整体重建；几千个要素的重建在毫秒级，远比维护动态树简单
+ * 仅在游戏线程使用，异步任务应先查询出候选几何的共享指针再交给工作线程
+ */
+class CITYGIS_API FGISSpatialIndex
+{
+public:
+	void Add(const FString& ID, TSharedPtr<const FGISMultiPolygon> Geometry);
+	bool Remove(const FString& ID);
+	void Reset();
+
+	int32 Num() const { return Items.Num(); }
+	const FGISSpatialItem* Find(const FString& ID) const;
+
+	// 包围盒相交的候选 (不做精确几何判断)
+	void QueryBox(const FBox2D& Box, TArray<const FGISSpatialItem*>& OutItems) const;
+
+	// 精确包含该点的要素 (射线法)
+	void QueryPoint(const FVector2D& Point, TArray<const FGISSpatialItem*>& OutItems) const;
+
+	// 距离最近的 K 个要素，点在要素内部时距离为 0
+	// 距离按查询点纬度把经度缩放为近似等距，仅用于排序
+	void QueryNearest(const FVector2D& Point, int32 K, TArray<const FGISSpatialItem*>& OutItems) const;
+
+	template <typename Func>
+	void ForEach(Func&& Visitor) const
+	{
+		for (const FGISSpatialItem& Item : Items)
+		{
+			Visitor(Item);
+		}
+	}
+
+private:
+	void EnsureBuilt() const;
+
+	TArray<FGISSpatialItem> Items;
+	TMap<FString, int32> ItemIndex;
+
+	// 扁平树：先是按 STR 顺序排列的叶子，后面依次是各层父节点，最后一个是根
+	mutable TArray<FBox2D> NodeBounds;
+	mutable TArray<int32> LevelStarts;
+	mutable TArray<int32> LeafItems;
+	mutable bool bDirty = false;
+};
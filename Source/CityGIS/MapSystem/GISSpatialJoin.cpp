@@ -0,0 +1,225 @@
+#include "GISSpatialJoin.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// 平均每带约这么多条边
+	constexpr int32 EdgesPerBand = 4;
+	constexpr int32 MaxBands = 4096;
+
+	// 网格边长上限 (格)，面少时按面数缩小
+	constexpr int32 MaxGridSize = 256;
+
+	// LocateAll 每块的点数
+	constexpr int32 LocateChunkSize = 16384;
+}
+
+FGISPreparedPolygon::FGISPreparedPolygon(const FGISMultiPolygon& Geometry)
+{
+	for (const FGISPolygon& Polygon : Geometry)
+	{
+		for (const FGISRing& Ring : Polygon.Rings)
+		{
+			for (int32 Index = 0, Prev = Ring.Num() - 1; Index < Ring.Num(); Prev = Index++)
+			{
+				const FVector2D& A = Ring[Prev];
+				const FVector2D& B = Ring[Index];
+				Bounds += B;
+
+				// 水平边与闭合重复点对射线法没有贡献
+				if (A.Y == B.Y)
+				{
+					continue;
+				}
+				Edges.Add(A.Y < B.Y ? FEdge{ A.X, A.Y, B.X, B.Y } : FEdge{ B.X, B.Y, A.X, A.Y });
+			}
+		}
+	}
+	if (Edges.Num() == 0)
+	{
+		return;
+	}
+
+	NumBands = FMath::Clamp(Edges.Num() / EdgesPerBand, 1, MaxBands);
+	MinY = Bounds.Min.Y;
+	const double Height = Bounds.Max.Y - Bounds.Min.Y;
+	InvBandHeight = Height > 0.0 ? NumBands / Height : 0.0;
+
+	auto BandOf = [this](double Y)
+	{
+		return FMath::Clamp(static_cast<int32>((Y - MinY) * InvBandHeight), 0, NumBands - 1);
+	};
+
+	// 两遍：先计数再填充，得到紧凑的 CSR 布局
+	BandStarts.SetNumZeroed(NumBands + 1);
+	for (const FEdge& Edge : Edges)
+	{
+		for (int32 Band = BandOf(Edge.Y0), Last = BandOf(Edge.Y1); Band <= Last; ++Band)
+		{
+			++BandStarts[Band + 1];
+		}
+	}
+	for (int32 Band = 0; Band < NumBands; ++Band)
+	{
+		BandStarts[Band + 1] += BandStarts[Band];
+	}
+
+	TArray<int32> Cursor(BandStarts.GetData(), NumBands);
+	BandEdges.SetNumUninitialized(BandStarts[NumBands]);
+	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
+	{
+		const FEdge& Edge = Edges[EdgeIndex];
+		for (int32 Band = BandOf(Edge.Y0), Last = BandOf(Edge.Y1); Band <= Last; ++Band)
+		{
+			BandEdges[Cursor[Band]++] = EdgeIndex;
+		}
+	}
+}
+
+bool FGISPreparedPolygon::Contains(const FVector2D& Point) const
+{
+	if (NumBands == 0 || !Bounds.IsInsideOrOn(Point))
+	{
+		return false;
+	}
+
+	const int32 Band = FMath::Clamp(static_cast<int32>((Point.Y - MinY) * InvBandHeight), 0, NumBands - 1);
+	bool bInside = false;
+	for (int32 Slot = BandStarts[Band]; Slot < BandStarts[Band + 1]; ++Slot)
+	{
+		// 半开区间 [Y0, Y1)，顶点恰在射线上时只计一次
+		const FEdge& Edge = Edges[BandEdges[Slot]];
+		if (Edge.Y0 <= Point.Y && Point.Y < Edge.Y1
+			&& Point.X < Edge.X0 + (Point.Y - Edge.Y0) * (Edge.X1 - Edge.X0) / (Edge.Y1 - Edge.Y0))
+		{
+			bInside = !bInside;
+		}
+	}
+	return bInside;
+}
+
+int32 FGISPolygonLocator::Add(const FGISMultiPolygon& Geometry)
+{
+	return Pending.Add(&Geometry);
+}
+
+void FGISPolygonLocator::Build()
+{
+	Polygons.SetNum(Pending.Num());
+	ParallelFor(Pending.Num(), [this](int32 Index)
+	{
+		Polygons[Index] = FGISPreparedPolygon(*Pending[Index]);
+	});
+	Pending.Reset();
+
+	Bounds = FBox2D(ForceInit);
+	for (const FGISPreparedPolygon& Polygon : Polygons)
+	{
+		if (Polygon.GetBounds().bIsValid)
+		{
+			Bounds += Polygon.GetBounds();
+		}
+	}
+	CellStarts.Reset();
+	CellItems.Reset();
+	if (!Bounds.bIsValid)
+	{
+		GridX = GridY = 0;
+		return;
+	}
+
+	// 每个面平均约占一格
+	const int32 Side = FMath::Clamp(FMath::CeilToInt(FMath::Sqrt(static_cast<double>(Polygons.Num()))) * 2, 1, MaxGridSize);
+	GridX = GridY = Side;
+	const FVector2D Size = Bounds.GetSize();
+	InvCellSize = FVector2D(Size.X > 0.0 ? GridX / Size.X : 0.0, Size.Y > 0.0 ? GridY / Size.Y : 0.0);
+
+	auto CellRange = [this](const FBox2D& Box, FIntPoint& OutMin, FIntPoint& OutMax)
+	{
+		OutMin.X = FMath::Clamp(static_cast<int32>((Box.Min.X - Bounds.Min.X) * InvCellSize.X), 0, GridX - 1);
+		OutMin.Y = FMath::Clamp(static_cast<int32>((Box.Min.Y - Bounds.Min.Y) * InvCellSize.Y), 0, GridY - 1);
+		OutMax.X = FMath::Clamp(static_cast<int32>((Box.Max.X - Bounds.Min.X) * InvCellSize.X), 0, GridX - 1);
+		OutMax.Y = FMath::Clamp(static_cast<int32>((Box.Max.Y - Bounds.Min.Y) * InvCellSize.Y), 0, GridY - 1);
+	};
+
+	const int32 NumCells = GridX * GridY;
+	CellStarts.SetNumZeroed(NumCells + 1);
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		TArray<int32> Cursor;
+		if (Pass == 1)
+		{
+			for (int32 Cell = 0; Cell < NumCells; ++Cell)
+			{
+				CellStarts[Cell + 1] += CellStarts[Cell];
+			}
+			Cursor = TArray<int32>(CellStarts.GetData(), NumCells);
+			CellItems.SetNumUninitialized(CellStarts[NumCells]);
+		}
+
+		// 下标升序登记，格内候选也按下标升序
+		for (int32 Index = 0; Index < Polygons.Num(); ++Index)
+		{
+			const FBox2D& Box = Polygons[Index].GetBounds();
+			if (!Box.bIsValid)
+			{
+				continue;
+			}
+			FIntPoint Min, Max;
+			CellRange(Box, Min, Max);
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				for (int32 X = Min.X; X <= Max.X; ++X)
+				{
+					const int32 Cell = Y * GridX + X;
+					if (Pass == 0)
+					{
+						++CellStarts[Cell + 1];
+					}
+					else
+					{
+						CellItems[Cursor[Cell]++] = Index;
+					}
+				}
+			}
+		}
+	}
+}
+
+int32 FGISPolygonLocator::Locate(const FVector2D& Point) const
+{
+	if (GridX == 0 || !Bounds.IsInsideOrOn(Point))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 X = FMath::Clamp(static_cast<int32>((Point.X - Bounds.Min.X) * InvCellSize.X), 0, GridX - 1);
+	const int32 Y = FMath::Clamp(static_cast<int32>((Point.Y - Bounds.Min.Y) * InvCellSize.Y), 0, GridY - 1);
+	const int32 Cell = Y * GridX + X;
+	for (int32 Slot = CellStarts[Cell]; Slot < CellStarts[Cell + 1]; ++Slot)
+	{
+		const int32 Index = CellItems[Slot];
+		if (Polygons[Index].Contains(Point))
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FGISPolygonLocator::LocateAll(TArrayView<const FVector2D> Points, TArrayView<int32> InOutOwners) const
+{
+	check(Points.Num() == InOutOwners.Num());
+	const int32 NumChunks = FMath::DivideAndRoundUp(Points.Num(), LocateChunkSize);
+	ParallelFor(NumChunks, [this, Points, InOutOwners](int32 Chunk)
+	{
+		const int32 End = FMath::Min((Chunk + 1) * LocateChunkSize, Points.Num());
+		for (int32 Index = Chunk * LocateChunkSize; Index < End; ++Index)
+		{
+			if (InOutOwners[Index] == INDEX_NONE)
+			{
+				InOutOwners[Index] = Locate(Points[Index]);
+			}
+		}
+	});
+}
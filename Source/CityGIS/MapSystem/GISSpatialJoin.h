@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+/**
+ * 预处理过的面 (点在面内判断专用)
+ * 全部环的边按纬度分带建索引：每条非水平边登记到它跨过的带中，判断时只对点所在带的边做射线法，
+ * 代价从 O(边数) 降为 O(带内边数)。奇偶规则，洞与多部件自然正确。构建后只读，可多线程同时查询。
+ */
+class CITYGIS_API FGISPreparedPolygon
+{
+public:
+	FGISPreparedPolygon() = default;
+	explicit FGISPreparedPolygon(const FGISMultiPolygon& Geometry);
+
+	const FBox2D& GetBounds() const { return Bounds; }
+	bool Contains(const FVector2D& Point) const;
+
+private:
+	// Y0 <= Y1
+	struct FEdge
+	{
+		double X0;
+		double Y0;
+		double X1;
+		double Y1;
+	};
+
+	TArray<FEdge> Edges;
+
+	// 带 i 的边为 BandEdges[BandStarts[i] .. BandStarts[i + 1])
+	TArray<int32> BandStarts;
+	TArray<int32> BandEdges;
+	double MinY = 0.0;
+	double InvBandHeight = 0.0;
+	int32 NumBands = 0;
+
+	FBox2D Bounds = FBox2D(ForceInit);
+};
+
+/**
+ * 点落在哪个面内 (空间连接)
+ * 面的包围盒登记到均匀网格中，点先按格子取候选，再经包围盒与预处理面精确判断；
+ * 面之间不应重叠 (街道、区镇)，重叠时返回下标最小的一个。
+ * Build 后只读；LocateAll 按块在 ParallelFor 中并行处理。
+ */
+class CITYGIS_API FGISPolygonLocator
+{
+public:
+	// 返回该面的下标 (按加入顺序)；几何在 Build 之前须保持有效
+	int32 Add(const FGISMultiPolygon& Geometry);
+
+	// 预处理全部面 (并行) 并建网格
+	void Build();
+
+	int32 Num() const { return Polygons.Num(); }
+
+	// 包含该点的面下标，不在任何面内为 INDEX_NONE
+	int32 Locate(const FVector2D& Point) const;
+
+	// 只处理 InOutOwners 中仍为 INDEX_NONE 的点，可先后用不同层级的面集合补全
+	void LocateAll(TArrayView<const FVector2D> Points, TArrayView<int32> InOutOwners) const;
+
+private:
+	TArray<const FGISMultiPolygon*> Pending;
+	TArray<FGISPreparedPolygon> Polygons;
+
+	FBox2D Bounds = FBox2D(ForceInit);
+	FVector2D InvCellSize = FVector2D::ZeroVector;
+	int32 GridX = 0;
+	int32 GridY = 0;
+	TArray<int32> CellStarts;
+	TArray<int32> CellItems;
+};
@@ -0,0 +1,699 @@
+#include "GISTileCache.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/FileManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISTileCache, Log, All);
+
+namespace
+{
+	// 瓦片格式变化时递增，旧的磁盘缓存随之失效
+	constexpr int32 TileFormatVersion = 1;
+
+	// Web 墨卡托可表示的纬度范围
+	constexpr double MaxMercatorLat = 85.05112878;
+
+	const TCHAR* StampFileName = TEXT("stamp");
+
+	uint32 HashGeometry(const FGISMultiPolygon& Geometry)
+	{
+		uint32 Crc = 0;
+		for (const FGISPolygon& Polygon : Geometry)
+		{
+			const int32 RingCount = Polygon.Rings.Num();
+			Crc = FCrc::MemCrc32(&RingCount, sizeof(RingCount), Crc);
+			for (const FGISRing& Ring : Polygon.Rings)
+			{
+				Crc = FCrc::MemCrc32(Ring.GetData(), Ring.Num() * sizeof(FVector2D), Crc);
+			}
+		}
+		return Crc;
+	}
+
+	double LngToTileX(double Lng, int32 Count)
+	{
+		return (Lng + 180.0) / 360.0 * Count;
+	}
+
+	double LatToTileY(double Lat, int32 Count)
+	{
+		const double LatRad = FMath::DegreesToRadians(FMath::Clamp(Lat, -MaxMercatorLat, MaxMercatorLat));
+		return (1.0 - FMath::Loge(FMath::Tan(LatRad) + 1.0 / FMath::Cos(LatRad)) / PI) * 0.5 * Count;
+	}
+
+	double TileYToLat(double Y, int32 Count)
+	{
+		const double N = PI * (1.0 - 2.0 * Y / Count);
+		return FMath::RadiansToDegrees(FMath::Atan(0.5 * (FMath::Exp(N) - FMath::Exp(-N))));
+	}
+
+	// 裁剪边：0 为 X >= Min.X，1 为 X <= Max.X，2 为 Y >= Min.Y，3 为 Y <= Max.Y
+	bool IsInsideEdge(const FVector2D& Point, const FBox2D& Box, int32 Edge)
+	{
+		switch (Edge)
+		{
+		case 0: return Point.X >= Box.Min.X;
+		case 1: return Point.X <= Box.Max.X;
+		case 2: return Point.Y >= Box.Min.Y;
+		default: return Point.Y <= Box.Max.Y;
+		}
+	}
+
+	FVector2D IntersectEdge(const FVector2D& A, const FVector2D& B, const FBox2D& Box, int32 Edge)
+	{
+		if (Edge < 2)
+		{
+			const double X = Edge == 0 ? Box.Min.X : Box.Max.X;
+			const double T = (X - A.X) / (B.X - A.X);
+			return FVector2D(X, A.Y + (B.Y - A.Y) * T);
+		}
+		const double Y = Edge == 2 ? Box.Min.Y : Box.Max.Y;
+		const double T = (Y - A.Y) / (B.Y - A.Y);
+		return FVector2D(A.X + (B.X - A.X) * T, Y);
+	}
+
+	// Sutherland-Hodgman：凹多边形多次进出瓦片时会在边界上留下零面积的连接边，填充不受影响
+	void ClipRingFill(const FGISRing& Ring, const FBox2D& Box, TArray<FVector2D>& OutFill)
+	{
+		OutFill = Ring;
+		if (OutFill.Num() > 1 && OutFill[0] == OutFill.Last())
+		{
+			OutFill.Pop(EAllowShrinking::No);
+		}
+
+		TArray<FVector2D> Input;
+		for (int32 Edge = 0; Edge < 4 && OutFill.Num() > 0; ++Edge)
+		{
+			Swap(Input, OutFill);
+			OutFill.Reset();
+
+			FVector2D Previous = Input.Last();
+			bool bPreviousInside = IsInsideEdge(Previous, Box, Edge);
+			for (const FVector2D& Point : Input)
+			{
+				const bool bInside = IsInsideEdge(Point, Box, Edge);
+				if (bInside != bPreviousInside)
+				{
+					OutFill.Add(IntersectEdge(Previous, Point, Box, Edge));
+				}
+				if (bInside)
+				{
+					OutFill.Add(Point);
+				}
+				Previous = Point;
+				bPreviousInside = bInside;
+			}
+		}
+
+		if (OutFill.Num() < 3)
+		{
+			OutFill.Reset();
+		}
+	}
+
+	// Liang-Barsky 线段裁剪
+	bool ClipSegment(FVector2D& A, FVector2D& B, const FBox2D& Box)
+	{
+		const FVector2D D = B - A;
+		const double P[4] = { -D.X, D.X, -D.Y, D.Y };
+		const double Q[4] = { A.X - Box.Min.X, Box.Max.X - A.X, A.Y - Box.Min.Y, Box.Max.Y - A.Y };
+
+		double T0 = 0.0;
+		double T1 = 1.0;
+		for (int32 Edge = 0; Edge < 4; ++Edge)
+		{
+			if (P[Edge] == 0.0)
+			{
+				if (Q[Edge] < 0.0)
+				{
+					return false;
+				}
+				continue;
+			}
+			const double R = Q[Edge] / P[Edge];
+			if (P[Edge] < 0.0)
+			{
+				if (R > T1)
+				{
+					return false;
+				}
+				T0 = FMath::Max(T0, R);
+			}
+			else
+			{
+				if (R < T0)
+				{
+					return false;
+				}
+				T1 = FMath::Min(T1, R);
+			}
+		}
+
+		const FVector2D Start = A;
+		A = Start + D * T0;
+		B = Start + D * T1;
+		return true;
+	}
+
+	// 描边只保留环自身的线段，连续的线段接成一条折线
+	void ClipRingOutline(const FGISRing& Ring, const FBox2D& Box, TArray<TArray<FVector2D>>& OutLines)
+	{
+		for (int32 Index = 0; Index + 1 < Ring.Num(); ++Index)
+		{
+			FVector2D A = Ring[Index];
+			FVector2D B = Ring[Index + 1];
+			if (A == B || !ClipSegment(A, B, Box))
+			{
+				continue;
+			}
+			if (OutLines.Num() > 0 && OutLines.Last().Last() == A)
+			{
+				OutLines.Last().Add(B);
+			}
+			else
+			{
+				OutLines.Add({ A, B });
+			}
+		}
+	}
+
+	void AppendEscaped(FString& Out, const FString& Text)
+	{
+		for (const TCHAR C : Text)
+		{
+			if (C == TEXT('"') || C == TEXT('\\'))
+			{
+				Out.AppendChar(TEXT('\\'));
+			}
+			Out.AppendChar(C);
+		}
+	}
+
+	void AppendPoints(FString& Out, const TArray<FVector2D>& Points)
+	{
+		Out.AppendChar(TEXT('['));
+		for (int32 Index = 0; Index < Points.Num(); ++Index)
+		{
+			Out += FString::Printf(Index > 0 ? TEXT(",%.7f,%.7f") : TEXT("%.7f,%.7f"), Points[Index].X, Points[Index].Y);
+		}
+		Out.AppendChar(TEXT(']'));
+	}
+}
+
+TSharedRef<const FGISTileCache::FSource> FGISTileCache::BuildSource(TSharedPtr<const FGISLodPyramid> Pyramid, const FSource* Previous)
+{
+	TSharedRef<FSource> Result = MakeShared<FSource>();
+	const int32 NumLevels = FGISLodPyramid::NumLevels();
+	Result->Levels.SetNum(NumLevels);
+	Result->ChangedBounds.SetNum(NumLevels);
+	Result->Pyramid = Pyramid;
+	if (!Pyramid.IsValid())
+	{
+		return Result;
+	}
+
+	for (int32 Level = 0; Level < NumLevels; ++Level)
+	{
+		TArray<FSource::FFeature>& Features = Result->Levels[Level];
+		Features.Reserve(Pyramid->Num());
+		Pyramid->ForEachFeature(Level, [&Features](const FString& ID, const FGISMultiPolygon& Geometry)
+		{
+			FSource::FFeature& Feature = Features.AddDefaulted_GetRef();
+			Feature.ID = ID;
+			Feature.Bounds = GISGeometry::ComputeBounds(Geometry);
+			Feature.Geometry = &Geometry;
+			Feature.Hash = HashGeometry(Geometry);
+		});
+	}
+
+	// 各级要素顺序一致，逐要素合并各级摘要；按和累加，与要素顺序无关
+	const int32 NumFeatures = Result->Levels[0].Num();
+	uint32 Stamp = 0;
+	for (int32 Index = 0; Index < NumFeatures; ++Index)
+	{
+		uint32 FeatureHash = FCrc::StrCrc32(*Result->Levels[0][Index].ID);
+		for (int32 Level = 0; Level < NumLevels; ++Level)
+		{
+			FeatureHash = HashCombine(FeatureHash, Result->Levels[Level][Index].Hash);
+		}
+		Stamp += FeatureHash;
+	}
+	Result->Stamp = HashCombine(Stamp, static_cast<uint32>(NumFeatures));
+
+	if (!Previous || Previous->Levels.Num() != NumLevels)
+	{
+		return Result;
+	}
+	Result->bFullyChanged = false;
+
+	const TArray<FSource::FFeature>& PreviousBase = Previous->Levels[0];
+	TMap<FString, int32> PreviousIndex;
+	PreviousIndex.Reserve(PreviousBase.Num());
+	for (int32 Index = 0; Index < PreviousBase.Num(); ++Index)
+	{
+		PreviousIndex.Add(PreviousBase[Index].ID, Index);
+	}
+
+	TBitArray<> Matched(false, PreviousBase.Num());
+	for (int32 Index = 0; Index < NumFeatures; ++Index)
+	{
+		const int32* Found = PreviousIndex.Find(Result->Levels[0][Index].ID);
+		if (Found)
+		{
+			Matched[*Found] = true;
+		}
+		for (int32 Level = 0; Level < NumLevels; ++Level)
+		{
+			const FSource::FFeature& Feature = Result->Levels[Level][Index];
+			if (!Found)
+			{
+				Result->ChangedBounds[Level].Add(Feature.Bounds);
+				continue;
+			}
+			const FSource::FFeature& Old = Previous->Levels[Level][*Found];
+			if (Old.Hash != Feature.Hash)
+			{
+				Result->ChangedBounds[Level].Add(Old.Bounds);
+				Result->ChangedBounds[Level].Add(Feature.Bounds);
+			}
+		}
+	}
+
+	// 已删除的要素
+	for (int32 Index = 0; Index < PreviousBase.Num(); ++Index)
+	{
+		if (!Matched[Index])
+		{
+			for (int32 Level = 0; Level < NumLevels; ++Level)
+			{
+				Result->ChangedBounds[Level].Add(Previous->Levels[Level][Index].Bounds);
+			}
+		}
+	}
+	return Result;
+}
+
+FBox2D FGISTileCache::GetTileBounds(int32 Z, int32 X, int32 Y)
+{
+	const int32 Count = 1 << Z;
+	return FBox2D(
+		FVector2D(X * 360.0 / Count - 180.0, TileYToLat(Y + 1, Count)),
+		FVector2D((X + 1) * 360.0 / Count - 180.0, TileYToLat(Y, Count)));
+}
+
+FGISTileRange FGISTileCache::GetTileRange(int32 Z, const FBox2D& Bounds)
+{
+	const int32 Count = 1 << Z;
+	FGISTileRange Range;
+	Range.Z = Z;
+	Range.MinX = FMath::Clamp(FMath::FloorToInt32(LngToTileX(Bounds.Min.X, Count)), 0, Count - 1);
+	Range.MaxX = FMath::Clamp(FMath::FloorToInt32(LngToTileX(Bounds.Max.X, Count)), 0, Count - 1);
+	// 瓦片 Y 自北向南增长
+	Range.MinY = FMath::Clamp(FMath::FloorToInt32(LatToTileY(Bounds.Max.Y, Count)), 0, Count - 1);
+	Range.MaxY = FMath::Clamp(FMath::FloorToInt32(LatToTileY(Bounds.Min.Y, Count)), 0, Count - 1);
+	return Range;
+}
+
+bool FGISTileCache::ParseTilePath(const FString& Path, int32& OutZ, int32& OutX, int32& OutY)
+{
+	TArray<FString> Parts;
+	if (Path.ParseIntoArray(Parts, TEXT("/")) != 3)
+	{
+		return false;
+	}
+	for (const FString& Part : Parts)
+	{
+		if (!Part.IsNumeric())
+		{
+			return false;
+		}
+	}
+	OutZ = FCString::Atoi(*Parts[0]);
+	OutX = FCString::Atoi(*Parts[1]);
+	OutY = FCString::Atoi(*Parts[2]);
+	return true;
+}
+
+TArray<uint8> FGISTileCache::WriteTile(const FSource& Source, int32 Z, int32 X, int32 Y)
+{
+	const int32 Level = FMath::Min(FGISLodPyramid::LevelForZoom(Z + ZoomOffset), Source.Levels.Num() - 1);
+	const FBox2D TileBox = GetTileBounds(Z, X, Y);
+
+	FString Json = FString::Printf(TEXT("{\"z\":%d,\"x\":%d,\"y\":%d,\"f\":["), Z, X, Y);
+	bool bFirstFeature = true;
+
+	TArray<FVector2D> Fill;
+	TArray<TArray<FVector2D>> Lines;
+	FString Parts;
+	if (Source.Levels.IsValidIndex(Level))
+	{
+		for (const FSource::FFeature& Feature : Source.Levels[Level])
+		{
+			if (!Feature.Bounds.bIsValid || !Feature.Bounds.Intersect(TileBox))
+			{
+				continue;
+			}
+
+			Parts.Reset();
+			const FGISMultiPolygon& Geometry = *Feature.Geometry;
+			for (int32 Part = 0; Part < Geometry.Num(); ++Part)
+			{
+				if (Geometry[Part].Rings.Num() == 0)
+				{
+					continue;
+				}
+
+				// 只取外环，与网页每个部件一个覆盖物的画法一致
+				const FGISRing& Outer = Geometry[Part].Rings[0];
+				const FBox2D RingBounds = GISGeometry::ComputeBounds(Outer);
+				if (!RingBounds.Intersect(TileBox))
+				{
+					continue;
+				}
+
+				Lines.Reset();
+				if (TileBox.IsInside(RingBounds))
+				{
+					Fill = Outer;
+					if (Fill.Num() > 1 && Fill[0] == Fill.Last())
+					{
+						Fill.Pop(EAllowShrinking::No);
+					}
+					Lines.Add(Outer);
+				}
+				else
+				{
+					ClipRingFill(Outer, TileBox, Fill);
+					ClipRingOutline(Outer, TileBox, Lines);
+				}
+				if (Fill.Num() == 0 && Lines.Num() == 0)
+				{
+					continue;
+				}
+
+				if (!Parts.IsEmpty())
+				{
+					Parts.AppendChar(TEXT(','));
+				}
+				Parts += FString::Printf(TEXT("{\"i\":%d,\"fill\":"), Part);
+				AppendPoints(Parts, Fill);
+				Parts += TEXT(",\"line\":[");
+				for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+				{
+					if (LineIndex > 0)
+					{
+						Parts.AppendChar(TEXT(','));
+					}
+					AppendPoints(Parts, Lines[LineIndex]);
+				}
+				Parts += TEXT("]}");
+			}
+
+			if (Parts.IsEmpty())
+			{
+				continue;
+			}
+			if (!bFirstFeature)
+			{
+				Json.AppendChar(TEXT(','));
+			}
+			bFirstFeature = false;
+			Json += TEXT("{\"id\":\"");
+			AppendEscaped(Json, Feature.ID);
+			Json += TEXT("\",\"p\":[");
+			Json += Parts;
+			Json += TEXT("]}");
+		}
+	}
+	Json += TEXT("]}");
+
+	FTCHARToUTF8 Utf8(*Json);
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+void FGISTileCache::Open(const FString& DocumentPath)
+{
+	FString NewDir;
+	if (!DocumentPath.IsEmpty())
+	{
+		const FString FullPath = FPaths::ConvertRelativePathToFull(DocumentPath);
+		NewDir = FPaths::ProjectSavedDir() / TEXT("GISTiles") / FString::Printf(TEXT("%08x"), FCrc::StrCrc32(*FullPath));
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (NewDir == DiskDir)
+	{
+		return;
+	}
+	DiskDir = MoveTemp(NewDir);
+	DiskTiles.Reset();
+	bDiskSynced = false;
+	SyncDiskLocked();
+}
+
+void FGISTileCache::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Source.Reset();
+	++Generation;
+	Memory.Reset();
+	DiskDir.Empty();
+	DiskTiles.Reset();
+	bDiskSynced = false;
+}
+
+void FGISTileCache::SetSource(TSharedRef<const FSource> NewSource, TArray<FGISTileRange>& OutChanged, bool& bOutAll)
+{
+	OutChanged.Reset();
+
+	FScopeLock ScopeLock(&Lock);
+	Source = NewSource;
+	++Generation;
+
+	bOutAll = NewSource->bFullyChanged;
+	if (bOutAll)
+	{
+		// 整体替换 (读档)：磁盘缓存按摘要决定整体保留还是清空
+		Memory.Reset();
+		DiskTiles.Reset();
+		bDiskSynced = false;
+		SyncDiskLocked();
+		return;
+	}
+
+	for (int32 Z = MinZoom; Z <= MaxZoom; ++Z)
+	{
+		const int32 Level = FGISLodPyramid::LevelForZoom(Z + ZoomOffset);
+		if (!NewSource->ChangedBounds.IsValidIndex(Level))
+		{
+			continue;
+		}
+		for (const FBox2D& Bounds : NewSource->ChangedBounds[Level])
+		{
+			if (Bounds.bIsValid)
+			{
+				OutChanged.Add(GetTileRange(Z, Bounds));
+			}
+		}
+	}
+	if (OutChanged.Num() == 0)
+	{
+		return;
+	}
+
+	// 只检查已缓存的瓦片，不按范围逐个枚举 (高缩放下范围内的瓦片数可能很大)
+	TArray<uint64> Keys;
+	Memory.GetKeys(Keys);
+	Keys.Append(DiskTiles.Array());
+	for (const uint64 Key : Keys)
+	{
+		int32 Z, X, Y;
+		SplitKey(Key, Z, X, Y);
+		for (const FGISTileRange& Range : OutChanged)
+		{
+			if (Range.Z == Z && X >= Range.MinX && X <= Range.MaxX && Y >= Range.MinY && Y <= Range.MaxY)
+			{
+				RemoveTileLocked(Key);
+				break;
+			}
+		}
+	}
+
+	// 失效文件删除后再更新摘要，中途退出时下次打开会因摘要不符整体清空
+	if (bDiskSynced)
+	{
+		WriteStampLocked();
+	}
+}
+
+TSharedPtr<const FGISTileCache::FSource> FGISTileCache::GetSource() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Source;
+}
+
+TSharedPtr<const TArray<uint8>> FGISTileCache::GetTile(int32 Z, int32 X, int32 Y)
+{
+	if (Z < MinZoom || Z > MaxZoom || X < 0 || Y < 0 || X >= (1 << Z) || Y >= (1 << Z))
+	{
+		return nullptr;
+	}
+
+	const uint64 Key = MakeKey(Z, X, Y);
+	TSharedPtr<const FSource> Snapshot;
+	uint32 SnapshotGeneration = 0;
+	FString DiskFile;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!Source.IsValid())
+		{
+			return nullptr;
+		}
+		if (FMemoryTile* Hit = Memory.Find(Key))
+		{
+			Hit->LastUse = ++UseCounter;
+			return Hit->Bytes;
+		}
+		Snapshot = Source;
+		SnapshotGeneration = Generation;
+		if (DiskTiles.Contains(Key))
+		{
+			DiskFile = GetTileFile(Key);
+		}
+	}
+
+	if (!DiskFile.IsEmpty())
+	{
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *DiskFile, FILEREAD_Silent))
+		{
+			TSharedPtr<const TArray<uint8>> Shared = MakeShared<const TArray<uint8>>(MoveTemp(Bytes));
+			FScopeLock ScopeLock(&Lock);
+			if (SnapshotGeneration == Generation)
+			{
+				AddMemoryLocked(Key, Shared);
+			}
+			return Shared;
+		}
+	}
+
+	TSharedPtr<const TArray<uint8>> Shared = MakeShared<const TArray<uint8>>(WriteTile(*Snapshot, Z, X, Y));
+	{
+		// 写盘放在锁内，避免与作废删除交错留下过期文件；单块瓦片很小
+		FScopeLock ScopeLock(&Lock);
+		if (SnapshotGeneration == Generation)
+		{
+			AddMemoryLocked(Key, Shared);
+			if (bDiskSynced && !DiskTiles.Contains(Key) && FFileHelper::SaveArrayToFile(*Shared, *GetTileFile(Key)))
+			{
+				DiskTiles.Add(Key);
+			}
+		}
+	}
+	return Shared;
+}
+
+void FGISTileCache::SetMaxMemoryTiles(int32 InMaxMemoryTiles)
+{
+	FScopeLock ScopeLock(&Lock);
+	MaxMemoryTiles = FMath::Max(1, InMaxMemoryTiles);
+}
+
+uint64 FGISTileCache::MakeKey(int32 Z, int32 X, int32 Y)
+{
+	return (static_cast<uint64>(Z) << 56) | (static_cast<uint64>(X) << 28) | static_cast<uint64>(Y);
+}
+
+void FGISTileCache::SplitKey(uint64 Key, int32& OutZ, int32& OutX, int32& OutY)
+{
+	OutZ = static_cast<int32>(Key >> 56);
+	OutX = static_cast<int32>((Key >> 28) & 0x0FFFFFFF);
+	OutY = static_cast<int32>(Key & 0x0FFFFFFF);
+}
+
+FString FGISTileCache::GetTileFile(uint64 Key) const
+{
+	int32 Z, X, Y;
+	SplitKey(Key, Z, X, Y);
+	return DiskDir / FString::Printf(TEXT("%d_%d_%d.json"), Z, X, Y);
+}
+
+void FGISTileCache::AddMemoryLocked(uint64 Key, TSharedPtr<const TArray<uint8>> Bytes)
+{
+	FMemoryTile& Tile = Memory.FindOrAdd(Key);
+	Tile.Bytes = MoveTemp(Bytes);
+	Tile.LastUse = ++UseCounter;
+
+	while (Memory.Num() > MaxMemoryTiles)
+	{
+		uint64 Oldest = Key;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<uint64, FMemoryTile>& Pair : Memory)
+		{
+			if (Pair.Value.LastUse < OldestUse)
+			{
+				Oldest = Pair.Key;
+				OldestUse = Pair.Value.LastUse;
+			}
+		}
+		Memory.Remove(Oldest);
+	}
+}
+
+void FGISTileCache::RemoveTileLocked(uint64 Key)
+{
+	Memory.Remove(Key);
+	if (DiskTiles.Remove(Key) > 0)
+	{
+		IFileManager::Get().Delete(*GetTileFile(Key), false, false, true);
+	}
+}
+
+void FGISTileCache::SyncDiskLocked()
+{
+	if (bDiskSynced || DiskDir.IsEmpty() || !Source.IsValid())
+	{
+		return;
+	}
+	bDiskSynced = true;
+	DiskTiles.Reset();
+
+	IFileManager& FileManager = IFileManager::Get();
+	FString StampText;
+	const FString Expected = FString::Printf(TEXT("%d:%08x"), TileFormatVersion, Source->Stamp);
+	if (FFileHelper::LoadFileToString(StampText, *(DiskDir / StampFileName)) && StampText == Expected)
+	{
+		TArray<FString> Files;
+		FileManager.FindFiles(Files, *(DiskDir / TEXT("*.json")), true, false);
+		TArray<FString> Parts;
+		for (const FString& File : Files)
+		{
+			if (FPaths::GetBaseFilename(File).ParseIntoArray(Parts, TEXT("_")) == 3)
+			{
+				DiskTiles.Add(MakeKey(FCString::Atoi(*Parts[0]), FCString::Atoi(*Parts[1]), FCString::Atoi(*Parts[2])));
+			}
+		}
+		UE_LOG(LogGISTileCache, Log, TEXT("复用磁盘瓦片缓存 %d 块: %s"), DiskTiles.Num(), *DiskDir);
+	}
+	else
+	{
+		FileManager.DeleteDirectory(*DiskDir, false, true);
+		FileManager.MakeDirectory(*DiskDir, true);
+	}
+	WriteStampLocked();
+}
+
+void FGISTileCache::WriteStampLocked() const
+{
+	if (!Source.IsValid())
+	{
+		return;
+	}
+	const FString Stamp = FString::Printf(TEXT("%d:%08x"), TileFormatVersion, Source->Stamp);
+	if (!FFileHelper::SaveStringToFile(Stamp, *(DiskDir / StampFileName)))
+	{
+		UE_LOG(LogGISTileCache, Warning, TEXT("无法写入瓦片缓存摘要: %s"), *DiskDir);
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "GISLodPyramid.h"
+
+// 一个缩放级别上的瓦片范围 (含两端)
+struct FGISTileRange
+{
+	int32 Z = 0;
+	int32 MinX = 0;
+	int32 MinY = 0;
+	int32 MaxX = -1;
+	int32 MaxY = -1;
+};
+
+/**
+ * 要素覆盖物的矢量瓦片 (z/x/y，Web 墨卡托网格)
+ *
+ * 瓦片取该缩放对应级别的简化几何，外环按瓦片范围裁剪：填充裁成面 (Sutherland-Hodgman)，
+ * 描边单独裁成折线，瓦片边界上的裁剪边不描边，相邻瓦片拼起来看不出接缝。
+ * 格式为紧凑 JSON：{"z":..,"x":..,"y":..,"f":[{"id":"..","p":[{"i":部件,"fill":[lng,lat,...],"line":[[lng,lat,...],...]}]}]}
+ *
+ * 生成结果缓存在内存 (LRU) 与磁盘 (Saved/GISTiles/<存档>/)。几何源更新时逐要素比对各级简化结果，
+ * 只作废变化要素新旧范围覆盖到的瓦片；磁盘缓存以整份几何的摘要校验，重新打开存档时仍可复用。
+ *
+ * Open/Reset/SetSource 在游戏线程调用；GetTile 可在任意线程调用 (资源通道在线程池中生成瓦片)。
+ */
+class CITYGIS_API FGISTileCache
+{
+public:
+	static constexpr int32 MinZoom = 2;
+	static constexpr int32 MaxZoom = 19;
+
+	// 瓦片按 512 像素切：z 级瓦片在地图缩放 z + 1 时铺满，网页按 floor(缩放) - 1 请求
+	static constexpr int32 ZoomOffset = 1;
+
+	// 一次几何快照：各级别下每个要素的几何与摘要，以及相对上一份快照的变化范围
+	struct FSource
+	{
+		struct FFeature
+		{
+			FString ID;
+			FBox2D Bounds = FBox2D(ForceInit);
+			const FGISMultiPolygon* Geometry = nullptr;
+			uint32 Hash = 0;
+		};
+
+		// 持有几何，Levels 中的指针指向这里
+		TSharedPtr<const FGISLodPyramid> Pyramid;
+		TArray<TArray<FFeature>> Levels;
+
+		// 下标为级别：新旧几何不同的要素的新旧包围盒
+		TArray<TArray<FBox2D>> ChangedBounds;
+		bool bFullyChanged = true;
+
+		// 整份几何的摘要，校验磁盘缓存用
+		uint32 Stamp = 0;
+	};
+
+	// 纯计算，可在工作线程调用；Previous 为空时视为全部变化
+	static TSharedRef<const FSource> BuildSource(TSharedPtr<const FGISLodPyramid> Pyramid, const FSource* Previous);
+
+	static FBox2D GetTileBounds(int32 Z, int32 X, int32 Y);
+	static FGISTileRange GetTileRange(int32 Z, const FBox2D& Bounds);
+	static bool ParseTilePath(const FString& Path, int32& OutZ, int32& OutX, int32& OutY);
+	static TArray<uint8> WriteTile(const FSource& Source, int32 Z, int32 X, int32 Y);
+
+	// 切换存档 (路径为空时只用内存缓存)，保留当前几何源
+	void Open(const FString& DocumentPath);
+
+	// 清空几何源与内存缓存，并脱离磁盘目录
+	void Reset();
+
+	// 替换几何源；OutChanged 为需要重新请求的瓦片范围，bOutAll 为 true 时页面应全部重取
+	void SetSource(TSharedRef<const FSource> NewSource, TArray<FGISTileRange>& OutChanged, bool& bOutAll);
+	TSharedPtr<const FSource> GetSource() const;
+
+	// 缓存未命中时在调用线程中生成；坐标越界或没有几何源时返回空
+	TSharedPtr<const TArray<uint8>> GetTile(int32 Z, int32 X, int32 Y);
+
+	void SetMaxMemoryTiles(int32 InMaxMemoryTiles);
+
+private:
+	struct FMemoryTile
+	{
+		TSharedPtr<const TArray<uint8>> Bytes;
+		uint64 LastUse = 0;
+	};
+
+	static uint64 MakeKey(int32 Z, int32 X, int32 Y);
+	static void SplitKey(uint64 Key, int32& OutZ, int32& OutX, int32& OutY);
+
+	FString GetTileFile(uint64 Key) const;
+	void AddMemoryLocked(uint64 Key, TSharedPtr<const TArray<uint8>> Bytes);
+	void RemoveTileLocked(uint64 Key);
+	void SyncDiskLocked();
+	void WriteStampLocked() const;
+
+	mutable FCriticalSection Lock;
+	TSharedPtr<const FSource> Source;
+
+	// 每次替换几何源自增，生成期间几何源被替换的结果不进入缓存
+	uint32 Generation = 0;
+
+	TMap<uint64, FMemoryTile> Memory;
+	uint64 UseCounter = 0;
+	int32 MaxMemoryTiles = 512;
+
+	FString DiskDir;
+	TSet<uint64> DiskTiles;
+	bool bDiskSynced = false;
+};
@@ -0,0 +1,769 @@
+#include "GISTriangulator.h"
+
+namespace
+{
+	// 链表节点存放在数组中，以下标相互引用 (新增节点可能使数组扩容，不持有引用)
+	struct FNode
+	{
+		int32 Vertex = INDEX_NONE;
+		double X = 0.0;
+		double Y = 0.0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+
+		// z-order 曲线上的前后节点
+		int32 Z = 0;
+		int32 PrevZ = INDEX_NONE;
+		int32 NextZ = INDEX_NONE;
+
+		// 只有一个点的洞 (Steiner 点)，不参与去重
+		bool bSteiner = false;
+	};
+
+	class FEarcut
+	{
+	public:
+		FEarcut(const TArray<FVector2D>& InPoints, TArray<int32>& InTriangles)
+			: Points(InPoints)
+			, Triangles(InTriangles)
+		{
+		}
+
+		void Run(const TArray<int32>& HoleStarts)
+		{
+			const int32 OuterEnd = HoleStarts.Num() > 0 ? HoleStarts[0] : Points.Num();
+			Nodes.Reserve(Points.Num() * 3 / 2 + 8);
+
+			int32 Outer = LinkedList(0, OuterEnd, true);
+			if (Outer == INDEX_NONE || N(Outer).Next == N(Outer).Prev)
+			{
+				return;
+			}
+			if (HoleStarts.Num() > 0)
+			{
+				Outer = EliminateHoles(HoleStarts, Outer);
+			}
+
+			// 点数较多时用 z-order 哈希加速割耳判断
+			if (Points.Num() > 80)
+			{
+				MinX = MaxX = Points[0].X;
+				MinY = MaxY = Points[0].Y;
+				for (int32 Index = 1; Index < OuterEnd; ++Index)
+				{
+					MinX = FMath::Min(MinX, Points[Index].X);
+					MinY = FMath::Min(MinY, Points[Index].Y);
+					MaxX = FMath::Max(MaxX, Points[Index].X);
+					MaxY = FMath::Max(MaxY, Points[Index].Y);
+				}
+				const double Size = FMath::Max(MaxX - MinX, MaxY - MinY);
+				InvSize = Size > 0.0 ? 32767.0 / Size : 0.0;
+			}
+
+			EarcutLinked(Outer, 0);
+		}
+
+	private:
+		FNode& N(int32 Index) { return Nodes[Index]; }
+
+		static double Area(const FNode& P, const FNode& Q, const FNode& R)
+		{
+			return (Q.Y - P.Y) * (R.X - Q.X) - (Q.X - P.X) * (R.Y - Q.Y);
+		}
+
+		double Area(int32 P, int32 Q, int32 R) { return Area(N(P), N(Q), N(R)); }
+
+		bool Equals(int32 A, int32 B) { return N(A).X == N(B).X && N(A).Y == N(B).Y; }
+
+		static bool PointInTriangle(double Ax, double Ay, double Bx, double By, double Cx, double Cy, double Px, double Py)
+		{
+			return (Cx - Px) * (Ay - Py) >= (Ax - Px) * (Cy - Py)
+				&& (Ax - Px) * (By - Py) >= (Bx - Px) * (Ay - Py)
+				&& (Bx - Px) * (Cy - Py) >= (Cx - Px) * (By - Py);
+		}
+
+		static int32 Sign(double Value)
+		{
+			return Value > 0.0 ? 1 : (Value < 0.0 ? -1 : 0);
+		}
+
+		bool OnSegment(int32 P, int32 Q, int32 R)
+		{
+			return N(Q).X <= FMath::Max(N(P).X, N(R).X) && N(Q).X >= FMath::Min(N(P).X, N(R).X)
+				&& N(Q).Y <= FMath::Max(N(P).Y, N(R).Y) && N(Q).Y >= FMath::Min(N(P).Y, N(R).Y);
+		}
+
+		bool Intersects(int32 P1, int32 Q1, int32 P2, int32 Q2)
+		{
+			const int32 O1 = Sign(Area(P1, Q1, P2));
+			const int32 O2 = Sign(Area(P1, Q1, Q2));
+			const int32 O3 = Sign(Area(P2, Q2, P1));
+			const int32 O4 = Sign(Area(P2, Q2, Q1));
+
+			if (O1 != O2 && O3 != O4)
+			{
+				return true;
+			}
+			return (O1 == 0 && OnSegment(P1, P2, Q1))
+				|| (O2 == 0 && OnSegment(P1, Q2, Q1))
+				|| (O3 == 0 && OnSegment(P2, P1, Q2))
+				|| (O4 == 0 && OnSegment(P2, Q1, Q2));
+		}
+
+		int32 InsertNode(int32 Vertex, int32 Last)
+		{
+			const int32 Index = Nodes.AddDefaulted();
+			FNode& Node = Nodes[Index];
+			Node.Vertex = Vertex;
+			Node.X = Points[Vertex].X;
+			Node.Y = Points[Vertex].Y;
+			if (Last == INDEX_NONE)
+			{
+				Node.Prev = Index;
+				Node.Next = Index;
+			}
+			else
+			{
+				Node.Next = N(Last).Next;
+				Node.Prev = Last;
+				N(N(Last).Next).Prev = Index;
+				N(Last).Next = Index;
+			}
+			return Index;
+		}
+
+		void RemoveNode(int32 P)
+		{
+			FNode& Node = N(P);
+			N(Node.Next).Prev = Node.Prev;
+			N(Node.Prev).Next = Node.Next;
+			if (Node.PrevZ != INDEX_NONE)
+			{
+				N(Node.PrevZ).NextZ = Node.NextZ;
+			}
+			if (Node.NextZ != INDEX_NONE)
+			{
+				N(Node.NextZ).PrevZ = Node.PrevZ;
+			}
+		}
+
+		// 按要求的方向建立环形链表
+		int32 LinkedList(int32 Start, int32 End, bool bClockwise)
+		{
+			double Sum = 0.0;
+			for (int32 Index = Start, Prev = End - 1; Index < End; Prev = Index++)
+			{
+				Sum += (Points[Prev].X - Points[Index].X) * (Points[Index].Y + Points[Prev].Y);
+			}
+
+			int32 Last = INDEX_NONE;
+			if (bClockwise == (Sum > 0.0))
+			{
+				for (int32 Index = Start; Index < End; ++Index)
+				{
+					Last = InsertNode(Index, Last);
+				}
+			}
+			else
+			{
+				for (int32 Index = End - 1; Index >= Start; --Index)
+				{
+					Last = InsertNode(Index, Last);
+				}
+			}
+
+			if (Last != INDEX_NONE && Equals(Last, N(Last).Next))
+			{
+				const int32 Next = N(Last).Next;
+				RemoveNode(Last);
+				Last = Next;
+			}
+			return Last;
+		}
+
+		// 去掉重复点与共线点
+		int32 FilterPoints(int32 Start, int32 End = INDEX_NONE)
+		{
+			if (Start == INDEX_NONE)
+			{
+				return Start;
+			}
+			if (End == INDEX_NONE)
+			{
+				End = Start;
+			}
+
+			int32 P = Start;
+			bool bAgain;
+			do
+			{
+				bAgain = false;
+				if (!N(P).bSteiner && (Equals(P, N(P).Next) || Area(N(P).Prev, P, N(P).Next) == 0.0))
+				{
+					RemoveNode(P);
+					P = End = N(P).Prev;
+					if (P == N(P).Next)
+					{
+						break;
+					}
+					bAgain = true;
+				}
+				else
+				{
+					P = N(P).Next;
+				}
+			}
+			while (bAgain || P != End);
+
+			return End;
+		}
+
+		void EarcutLinked(int32 Ear, int32 Pass)
+		{
+			if (Ear == INDEX_NONE)
+			{
+				return;
+			}
+			if (Pass == 0 && InvSize > 0.0)
+			{
+				IndexCurve(Ear);
+			}
+
+			int32 Stop = Ear;
+			while (N(Ear).Prev != N(Ear).Next)
+			{
+				const int32 Prev = N(Ear).Prev;
+				const int32 Next = N(Ear).Next;
+
+				if (InvSize > 0.0 ? IsEarHashed(Ear) : IsEar(Ear))
+				{
+					Triangles.Add(N(Prev).Vertex);
+					Triangles.Add(N(Ear).Vertex);
+					Triangles.Add(N(Next).Vertex);
+					RemoveNode(Ear);
+
+					// 跳过下一个顶点，产生的三角形更匀称
+					Ear = N(Next).Next;
+					Stop = Ear;
+					continue;
+				}
+
+				Ear = Next;
+				if (Ear == Stop)
+				{
+					if (Pass == 0)
+					{
+						EarcutLinked(FilterPoints(Ear), 1);
+					}
+					else if (Pass == 1)
+					{
+						Ear = CureLocalIntersections(FilterPoints(Ear));
+						EarcutLinked(Ear, 2);
+					}
+					else
+					{
+						SplitEarcut(Ear);
+					}
+					break;
+				}
+			}
+		}
+
+		bool IsEar(int32 Ear)
+		{
+			const int32 A = N(Ear).Prev;
+			const int32 C = N(Ear).Next;
+			if (Area(A, Ear, C) >= 0.0)
+			{
+				return false;
+			}
+
+			const FNode& NA = N(A);
+			const FNode& NB = N(Ear);
+			const FNode& NC = N(C);
+			const double X0 = FMath::Min3(NA.X, NB.X, NC.X);
+			const double Y0 = FMath::Min3(NA.Y, NB.Y, NC.Y);
+			const double X1 = FMath::Max3(NA.X, NB.X, NC.X);
+			const double Y1 = FMath::Max3(NA.Y, NB.Y, NC.Y);
+
+			for (int32 P = NC.Next; P != A; P = N(P).Next)
+			{
+				const FNode& NP = N(P);
+				if (NP.X >= X0 && NP.X <= X1 && NP.Y >= Y0 && NP.Y <= Y1
+					&& PointInTriangle(NA.X, NA.Y, NB.X, NB.Y, NC.X, NC.Y, NP.X, NP.Y)
+					&& Area(NP.Prev, P, NP.Next) >= 0.0)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool IsBlocking(int32 P, int32 A, int32 C, double X0, double Y0, double X1, double Y1, const FNode& NA, const FNode& NB, const FNode& NC)
+		{
+			const FNode& NP = N(P);
+			return NP.X >= X0 && NP.X <= X1 && NP.Y >= Y0 && NP.Y <= Y1 && P != A && P != C
+				&& PointInTriangle(NA.X, NA.Y, NB.X, NB.Y, NC.X, NC.Y, NP.X, NP.Y)
+				&& Area(NP.Prev, P, NP.Next) >= 0.0;
+		}
+
+		bool IsEarHashed(int32 Ear)
+		{
+			const int32 A = N(Ear).Prev;
+			const int32 C = N(Ear).Next;
+			if (Area(A, Ear, C) >= 0.0)
+			{
+				return false;
+			}
+
+			const FNode NA = N(A);
+			const FNode NB = N(Ear);
+			const FNode NC = N(C);
+			const double X0 = FMath::Min3(NA.X, NB.X, NC.X);
+			const double Y0 = FMath::Min3(NA.Y, NB.Y, NC.Y);
+			const double X1 = FMath::Max3(NA.X, NB.X, NC.X);
+			const double Y1 = FMath::Max3(NA.Y, NB.Y, NC.Y);
+
+			// 只检查三角形包围盒对应的 z-order 区间内的点，两个方向交替前进
+			const int32 MinZ = ZOrder(X0, Y0);
+			const int32 MaxZ = ZOrder(X1, Y1);
+			int32 P = NB.PrevZ;
+			int32 Q = NB.NextZ;
+
+			while (P != INDEX_NONE && N(P).Z >= MinZ && Q != INDEX_NONE && N(Q).Z <= MaxZ)
+			{
+				if (IsBlocking(P, A, C, X0, Y0, X1, Y1, NA, NB, NC))
+				{
+					return false;
+				}
+				P = N(P).PrevZ;
+				if (IsBlocking(Q, A, C, X0, Y0, X1, Y1, NA, NB, NC))
+				{
+					return false;
+				}
+				Q = N(Q).NextZ;
+			}
+			while (P != INDEX_NONE && N(P).Z >= MinZ)
+			{
+				if (IsBlocking(P, A, C, X0, Y0, X1, Y1, NA, NB, NC))
+				{
+					return false;
+				}
+				P = N(P).PrevZ;
+			}
+			while (Q != INDEX_NONE && N(Q).Z <= MaxZ)
+			{
+				if (IsBlocking(Q, A, C, X0, Y0, X1, Y1, NA, NB, NC))
+				{
+					return false;
+				}
+				Q = N(Q).NextZ;
+			}
+			return true;
+		}
+
+		int32 CureLocalIntersections(int32 Start)
+		{
+			int32 P = Start;
+			do
+			{
+				const int32 A = N(P).Prev;
+				const int32 B = N(N(P).Next).Next;
+
+				if (!Equals(A, B) && Intersects(A, P, N(P).Next, B) && LocallyInside(A, B) && LocallyInside(B, A))
+				{
+					Triangles.Add(N(A).Vertex);
+					Triangles.Add(N(P).Vertex);
+					Triangles.Add(N(B).Vertex);
+
+					RemoveNode(N(P).Next);
+					RemoveNode(P);
+					P = Start = B;
+				}
+				P = N(P).Next;
+			}
+			while (P != Start);
+
+			return FilterPoints(P);
+		}
+
+		void SplitEarcut(int32 Start)
+		{
+			int32 A = Start;
+			do
+			{
+				int32 B = N(N(A).Next).Next;
+				while (B != N(A).Prev)
+				{
+					if (N(A).Vertex != N(B).Vertex && IsValidDiagonal(A, B))
+					{
+						int32 C = SplitPolygon(A, B);
+						A = FilterPoints(A, N(A).Next);
+						C = FilterPoints(C, N(C).Next);
+						EarcutLinked(A, 0);
+						EarcutLinked(C, 0);
+						return;
+					}
+					B = N(B).Next;
+				}
+				A = N(A).Next;
+			}
+			while (A != Start);
+		}
+
+		int32 EliminateHoles(const TArray<int32>& HoleStarts, int32 Outer)
+		{
+			TArray<int32> Queue;
+			Queue.Reserve(HoleStarts.Num());
+			for (int32 Hole = 0; Hole < HoleStarts.Num(); ++Hole)
+			{
+				const int32 Start = HoleStarts[Hole];
+				const int32 End = Hole + 1 < HoleStarts.Num() ? HoleStarts[Hole + 1] : Points.Num();
+				const int32 List = LinkedList(Start, End, false);
+				if (List == INDEX_NONE)
+				{
+					continue;
+				}
+				if (List == N(List).Next)
+				{
+					N(List).bSteiner = true;
+				}
+				Queue.Add(GetLeftmost(List));
+			}
+
+			// 从左到右依次桥接
+			Queue.Sort([this](int32 A, int32 B) { return Nodes[A].X < Nodes[B].X; });
+			for (const int32 Hole : Queue)
+			{
+				Outer = EliminateHole(Hole, Outer);
+			}
+			return Outer;
+		}
+
+		int32 EliminateHole(int32 Hole, int32 Outer)
+		{
+			const int32 Bridge = FindHoleBridge(Hole, Outer);
+			if (Bridge == INDEX_NONE)
+			{
+				return Outer;
+			}
+			const int32 BridgeReverse = SplitPolygon(Bridge, Hole);
+			FilterPoints(BridgeReverse, N(BridgeReverse).Next);
+			return FilterPoints(Bridge, N(Bridge).Next);
+		}
+
+		// 找到外环上与洞最左点相连不穿过任何边的点 (David Eberly 的方法)
+		int32 FindHoleBridge(int32 Hole, int32 Outer)
+		{
+			const double Hx = N(Hole).X;
+			const double Hy = N(Hole).Y;
+			double Qx = -DBL_MAX;
+			int32 M = INDEX_NONE;
+
+			// 向左的水平射线与外环的最近交点
+			int32 P = Outer;
+			do
+			{
+				const FNode& NP = N(P);
+				const FNode& NN = N(NP.Next);
+				if (Hy <= NP.Y && Hy >= NN.Y && NN.Y != NP.Y)
+				{
+					const double X = NP.X + (Hy - NP.Y) * (NN.X - NP.X) / (NN.Y - NP.Y);
+					if (X <= Hx && X > Qx)
+					{
+						Qx = X;
+						M = NP.X < NN.X ? P : NP.Next;
+						if (X == Hx)
+						{
+							return M;
+						}
+					}
+				}
+				P = NP.Next;
+			}
+			while (P != Outer);
+
+			if (M == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+
+			// 交点与端点构成的三角形内若有外环顶点，取与射线夹角最小的那个
+			const int32 Stop = M;
+			const double Mx = N(M).X;
+			const double My = N(M).Y;
+			double TanMin = DBL_MAX;
+
+			P = M;
+			do
+			{
+				const FNode& NP = N(P);
+				if (Hx >= NP.X && NP.X >= Mx && Hx != NP.X
+					&& PointInTriangle(Hy < My ? Hx : Qx, Hy, Mx, My, Hy < My ? Qx : Hx, Hy, NP.X, NP.Y))
+				{
+					const double Tan = FMath::Abs(Hy - NP.Y) / (Hx - NP.X);
+					if (LocallyInside(P, Hole)
+						&& (Tan < TanMin || (Tan == TanMin && (NP.X > N(M).X || (NP.X == N(M).X && SectorContainsSector(M, P))))))
+					{
+						M = P;
+						TanMin = Tan;
+					}
+				}
+				P = NP.Next;
+			}
+			while (P != Stop);
+
+			return M;
+		}
+
+		bool SectorContainsSector(int32 M, int32 P)
+		{
+			return Area(N(M).Prev, M, N(P).Prev) < 0.0 && Area(N(P).Next, M, N(M).Next) < 0.0;
+		}
+
+		int32 GetLeftmost(int32 Start)
+		{
+			int32 P = Start;
+			int32 Leftmost = Start;
+			do
+			{
+				if (N(P).X < N(Leftmost).X || (N(P).X == N(Leftmost).X && N(P).Y < N(Leftmost).Y))
+				{
+					Leftmost = P;
+				}
+				P = N(P).Next;
+			}
+			while (P != Start);
+			return Leftmost;
+		}
+
+		bool IsValidDiagonal(int32 A, int32 B)
+		{
+			const FNode& NA = N(A);
+			const FNode& NB = N(B);
+			if (N(NA.Next).Vertex == NB.Vertex || N(NA.Prev).Vertex == NB.Vertex || IntersectsPolygon(A, B))
+			{
+				return false;
+			}
+			if (LocallyInside(A, B) && LocallyInside(B, A) && MiddleInside(A, B)
+				&& (Area(NA.Prev, A, NB.Prev) != 0.0 || Area(A, NB.Prev, B) != 0.0))
+			{
+				return true;
+			}
+			// 重合的两点，两侧都是凸角
+			return Equals(A, B) && Area(NA.Prev, A, NA.Next) > 0.0 && Area(NB.Prev, B, NB.Next) > 0.0;
+		}
+
+		bool IntersectsPolygon(int32 A, int32 B)
+		{
+			const int32 VA = N(A).Vertex;
+			const int32 VB = N(B).Vertex;
+			int32 P = A;
+			do
+			{
+				const int32 Next = N(P).Next;
+				if (N(P).Vertex != VA && N(Next).Vertex != VA && N(P).Vertex != VB && N(Next).Vertex != VB && Intersects(P, Next, A, B))
+				{
+					return true;
+				}
+				P = Next;
+			}
+			while (P != A);
+			return false;
+		}
+
+		bool LocallyInside(int32 A, int32 B)
+		{
+			const FNode& NA = N(A);
+			return Area(NA.Prev, A, NA.Next) < 0.0
+				? Area(A, B, NA.Next) >= 0.0 && Area(A, NA.Prev, B) >= 0.0
+				: Area(A, B, NA.Prev) < 0.0 || Area(A, NA.Next, B) < 0.0;
+		}
+
+		bool MiddleInside(int32 A, int32 B)
+		{
+			const double Px = (N(A).X + N(B).X) * 0.5;
+			const double Py = (N(A).Y + N(B).Y) * 0.5;
+			bool bInside = false;
+			int32 P = A;
+			do
+			{
+				const FNode& NP = N(P);
+				const FNode& NN = N(NP.Next);
+				if ((NP.Y > Py) != (NN.Y > Py) && NN.Y != NP.Y && Px < (NN.X - NP.X) * (Py - NP.Y) / (NN.Y - NP.Y) + NP.X)
+				{
+					bInside = !bInside;
+				}
+				P = NP.Next;
+			}
+			while (P != A);
+			return bInside;
+		}
+
+		// 沿对角线 A-B 把环拆成两个；返回新环上 B 的副本
+		int32 SplitPolygon(int32 A, int32 B)
+		{
+			// 先拷贝再添加，Add 可能使数组扩容
+			const FNode CopyA = N(A);
+			const FNode CopyB = N(B);
+			const int32 A2 = Nodes.Add(CopyA);
+			const int32 B2 = Nodes.Add(CopyB);
+			const int32 An = N(A).Next;
+			const int32 Bp = N(B).Prev;
+
+			for (const int32 Copy : { A2, B2 })
+			{
+				N(Copy).PrevZ = INDEX_NONE;
+				N(Copy).NextZ = INDEX_NONE;
+			}
+
+			N(A).Next = B;
+			N(B).Prev = A;
+
+			N(A2).Next = An;
+			N(An).Prev = A2;
+
+			N(B2).Next = A2;
+			N(A2).Prev = B2;
+
+			N(Bp).Next = B2;
+			N(B2).Prev = Bp;
+
+			return B2;
+		}
+
+		int32 ZOrder(double X, double Y) const
+		{
+			uint32 Ix = static_cast<uint32>((X - MinX) * InvSize);
+			uint32 Iy = static_cast<uint32>((Y - MinY) * InvSize);
+
+			Ix = (Ix | (Ix << 8)) & 0x00FF00FF;
+			Ix = (Ix | (Ix << 4)) & 0x0F0F0F0F;
+			Ix = (Ix | (Ix << 2)) & 0x33333333;
+			Ix = (Ix | (Ix << 1)) & 0x55555555;
+
+			Iy = (Iy | (Iy << 8)) & 0x00FF00FF;
+			Iy = (Iy | (Iy << 4)) & 0x0F0F0F0F;
+			Iy = (Iy | (Iy << 2)) & 0x33333333;
+			Iy = (Iy | (Iy << 1)) & 0x55555555;
+
+			return static_cast<int32>(Ix | (Iy << 1));
+		}
+
+		void IndexCurve(int32 Start)
+		{
+			int32 P = Start;
+			do
+			{
+				FNode& Node = N(P);
+				Node.Z = ZOrder(Node.X, Node.Y);
+				Node.PrevZ = Node.Prev;
+				Node.NextZ = Node.Next;
+				P = Node.Next;
+			}
+			while (P != Start);
+
+			N(N(P).PrevZ).NextZ = INDEX_NONE;
+			N(P).PrevZ = INDEX_NONE;
+			SortLinked(P);
+		}
+
+		// 按 z 值对 Z 链表做自底向上的归并排序
+		int32 SortLinked(int32 List)
+		{
+			int32 InSize = 1;
+			int32 NumMerges;
+			do
+			{
+				int32 P = List;
+				List = INDEX_NONE;
+				int32 Tail = INDEX_NONE;
+				NumMerges = 0;
+
+				while (P != INDEX_NONE)
+				{
+					++NumMerges;
+					int32 Q = P;
+					int32 PSize = 0;
+					for (int32 Step = 0; Step < InSize; ++Step)
+					{
+						++PSize;
+						Q = N(Q).NextZ;
+						if (Q == INDEX_NONE)
+						{
+							break;
+						}
+					}
+					int32 QSize = InSize;
+
+					while (PSize > 0 || (QSize > 0 && Q != INDEX_NONE))
+					{
+						int32 E;
+						if (PSize != 0 && (QSize == 0 || Q == INDEX_NONE || N(P).Z <= N(Q).Z))
+						{
+							E = P;
+							P = N(P).NextZ;
+							--PSize;
+						}
+						else
+						{
+							E = Q;
+							Q = N(Q).NextZ;
+							--QSize;
+						}
+
+						if (Tail != INDEX_NONE)
+						{
+							N(Tail).NextZ = E;
+						}
+						else
+						{
+							List = E;
+						}
+						N(E).PrevZ = Tail;
+						Tail = E;
+					}
+					P = Q;
+				}
+				N(Tail).NextZ = INDEX_NONE;
+				InSize *= 2;
+			}
+			while (NumMerges > 1);
+
+			return List;
+		}
+
+		const TArray<FVector2D>& Points;
+		TArray<int32>& Triangles;
+		TArray<FNode> Nodes;
+
+		double MinX = 0.0;
+		double MinY = 0.0;
+		double MaxX = 0.0;
+		double MaxY = 0.0;
+		double InvSize = 0.0;
+	};
+}
+
+void GISTriangulator::Triangulate(const TArray<FVector2D>& Points, const TArray<int32>& HoleStarts, TArray<int32>& OutTriangles)
+{
+	OutTriangles.Reset();
+	if (Points.Num() < 3)
+	{
+		return;
+	}
+
+	FEarcut(Points, OutTriangles).Run(HoleStarts);
+
+	// earcut 按顺时针链表输出，统一翻成 y 轴向上平面内的逆时针
+	for (int32 Index = 0; Index + 2 < OutTriangles.Num(); Index += 3)
+	{
+		const FVector2D& A = Points[OutTriangles[Index]];
+		const FVector2D& B = Points[OutTriangles[Index + 1]];
+		const FVector2D& C = Points[OutTriangles[Index + 2]];
+		if ((B.X - A.X) * (C.Y - A.Y) - (B.Y - A.Y) * (C.X - A.X) < 0.0)
+		{
+			Swap(OutTriangles[Index + 1], OutTriangles[Index + 2]);
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GISGeometry.h"
+
+/**
+ * 带洞多边形的三角剖分 (earcut 算法：洞先桥接进外环，再按 z-order 哈希加速的割耳法剖分，
+ * 剖不动时依次尝试消除局部自交、沿对角线拆分)
+ *
+ * 输入为平面坐标 (建议先投影到米制局部坐标，经纬度直接剖分会因 cos(lat) 产生狭长三角形)。
+ * 纯计算，可在工作线程调用。
+ */
+namespace GISTriangulator
+{
+	// Points 中 [0, HoleStarts[0]) 为外环，之后每段为一个洞；环不重复首点
+	// 输出的三角形在 y 轴向上的平面内均为逆时针；退化输入输出为空
+	CITYGIS_API void Triangulate(const TArray<FVector2D>& Points, const TArray<int32>& HoleStarts, TArray<int32>& OutTriangles);
+
+	// 把多边形的各环 (经 Project 投影) 展开为 Triangulate 的输入，去掉闭合的重复首点
+	template <typename ProjectFunc>
+	void Flatten(const FGISPolygon& Polygon, ProjectFunc&& Project, TArray<FVector2D>& OutPoints, TArray<int32>& OutHoleStarts)
+	{
+		OutPoints.Reset();
+		OutHoleStarts.Reset();
+		for (int32 RingIndex = 0; RingIndex < Polygon.Rings.Num(); ++RingIndex)
+		{
+			const FGISRing& Ring = Polygon.Rings[RingIndex];
+			int32 Count = Ring.Num();
+			if (Count > 1 && Ring[0] == Ring[Count - 1])
+			{
+				--Count;
+			}
+			if (Count < 3)
+			{
+				// 外环退化时整个多边形无效
+				if (RingIndex == 0)
+				{
+					return;
+				}
+				continue;
+			}
+			if (RingIndex > 0)
+			{
+				OutHoleStarts.Add(OutPoints.Num());
+			}
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				OutPoints.Add(Project(Ring[Index]));
+			}
+		}
+	}
+}
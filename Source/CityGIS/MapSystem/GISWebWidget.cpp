@@ -7,11 +7,104 @@
 #include "Serialization/JsonSerializer.h"
 #include "Dom/JsonObject.h"
 #include "WebBrowserWidget/Public/WebBrowser.h"
+#include "SWebBrowser.h"
+#include "GISGeoJson.h"
+#include "GISOverlayAnalysis.h"
+#include "Async/Async.h"
+#include "GISCsvImporter.h"
+#include "GISBinarySave.h"
+#include "HAL/FileManager.h"
+#include "GISExtrusion.h"
+#include "GISCityMeshActor.h"
+#include "GISMeasure.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGISWebWidget, Log, All);
+
+namespace
+{
+	// 筛选面板默认勾选的基础类型 (与页面 activeFilters 的初值一致)
+	const TCHAR* DefaultFilterTypes[] = { TEXT("District"), TEXT("Street"), TEXT("Community"), TEXT("Custom"), TEXT("Road"), TEXT("Reconstruct") };
+
+	const TCHAR* NoParentOption = TEXT("None (无)");
+	const TCHAR* MoreParentsOption = TEXT("… (输入关键字查看更多)");
+
+	// 拼出页面函数调用，字符串参数经 JSON 转义 (名称等可能含引号、反斜杠或换行)
+	FString MakeScriptCall(const TCHAR* Function, const TArray<FString>& Arguments)
+	{
+		FString Output;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+		Writer->WriteArrayStart();
+		for (const FString& Argument : Arguments)
+		{
+			Writer->WriteValue(Argument);
+		}
+		Writer->WriteArrayEnd();
+		Writer->Close();
+
+		// 去掉数组的方括号，剩下的就是参数列表
+		return FString(Function) + TEXT("(") + Output.Mid(1, Output.Len() - 2) + TEXT(");");
+	}
+}
 
 void UGISWebWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
 
+	BindBridge();
+
+	SearchIndex.SetPinyinEnabled(bSearchPinyin);
+	History.SetMemoryLimit(static_cast<int64>(UndoMemoryLimitMB * 1024.0f * 1024.0f));
+	Scoring.SetTerms(ScoreTerms);
+	for (const TCHAR* Type : DefaultFilterTypes)
+	{
+		FilterEngine.SetKeyActive(Type, true);
+	}
+
+	// 【新增】大数据经 https://citygis.data/ 提供给页面，需在加载页面前注册
+	ResourceServer.Register();
+
+	// 【新增】瓦片请求在线程池中生成，提供者只持有缓存的弱引用
+	if (bTiledOverlays && ResourceServer.IsRegistered())
+	{
+		TileCache->SetMaxMemoryTiles(MaxMemoryTiles);
+		TWeakPtr<FGISTileCache> WeakCache = TileCache;
+		TileBaseUrl = ResourceServer.AddProvider(TEXT("tile/"), [WeakCache](const FString& Path) -> TSharedPtr<const TArray<uint8>>
+		{
+			TSharedPtr<FGISTileCache> Cache = WeakCache.Pin();
+			int32 Z, X, Y;
+			if (!Cache.IsValid() || !FGISTileCache::ParseTilePath(Path, Z, X, Y))
+			{
+				return nullptr;
+			}
+			return Cache->GetTile(Z, X, Y);
+		});
+	}
+
+	// 【新增】点资源图层的视口瓦片 (聚合后的点)，同样在线程池中生成
+	if (ResourceServer.IsRegistered())
+	{
+		TWeakPtr<FGISPointTileSource> WeakPoints = PointTiles;
+		PointTileBaseUrl = ResourceServer.AddProvider(TEXT("poi/"), [WeakPoints](const FString& Path) -> TSharedPtr<const TArray<uint8>>
+		{
+			TSharedPtr<FGISPointTileSource> Points = WeakPoints.Pin();
+			return Points.IsValid() ? Points->GetTile(Path) : nullptr;
+		});
+	}
+
+	for (UTreeView* Tree : { Tree_Admin, Tree_Reconstruct, Tree_Road })
+	{
+		if (Tree)
+		{
+			Tree->SetOnGetItemChildren(this, &UGISWebWidget::OnGetItemChildren);
+		}
+	}
+	if (UsesLegacyLists())
+	{
+		UE_LOG(LogGISWebWidget, Warning, TEXT("主界面蓝图仍使用 ScrollBox 列表 (List_*)，要素较多时请换成 Tree View (Tree_*)"));
+	}
+
 	if (MapBrowser)
 	{
 		FString HtmlPath = FPaths::ProjectContentDir() + TEXT("HTML/map_engine.html");
@@ -48,6 +141,14 @@ void UGISWebWidget::NativeConstruct()
 	{
 		Slider_Text_B->OnValueChanged.AddUniqueDynamic(this, &UGISWebWidget::OnTextColorSliderChanged);
 	}
+	if (Edit_Input_Parent)
+	{
+		Edit_Input_Parent->OnOpening.AddUniqueDynamic(this, &UGISWebWidget::OnParentPickerOpening);
+	}
+	if (Edit_Parent_Search)
+	{
+		Edit_Parent_Search->OnTextChanged.AddUniqueDynamic(this, &UGISWebWidget::OnParentSearchChanged);
+	}
 
 	// 【新增】初始化上海区划代码
 	DistrictNameMap.Add("310101", TEXT("黄浦区"));
@@ -68,6 +169,31 @@ void UGISWebWidget::NativeConstruct()
 	DistrictNameMap.Add("310151", TEXT("崇明区"));
 }
 
+void UGISWebWidget::NativeDestruct()
+{
+	// 退出前把尚未写出的编辑同步追加到日志 (只写增量，不做压实)
+	if (EditFlushFuture.IsValid())
+	{
+		EditFlushFuture.Wait();
+		EditFlushFuture.Reset();
+	}
+	for (const FGISEditBatch& Batch : EditJournal.TakeBatches(0))
+	{
+		FGISEditJournal::Append(FGISEditJournal::GetJournalPath(Batch.SnapshotPath), Batch.Records);
+	}
+
+	ResourceServer.Unregister();
+
+	// 体块由本控件生成，随控件一起销毁
+	if (CityMeshActor.IsValid())
+	{
+		CityMeshActor->Destroy();
+	}
+	CityMeshActor.Reset();
+
+	Super::NativeDestruct();
+}
+
 void UGISWebWidget::ActivateReconstructionTool()
 {
 	if (MapBrowser)
@@ -77,422 +203,2365 @@ void UGISWebWidget::ActivateReconstructionTool()
 	}
 }
 
-void UGISWebWidget::HandleConsoleMessage(const FString& Message, const FString& Source, int32 Line)
+void UGISWebWidget::BindBridge()
 {
-	if (!Message.StartsWith("UE_"))
+	if (!Bridge)
 	{
-		return;
+		Bridge = NewObject<UGISBridge>(this);
+		Bridge->OnFeatures().BindUObject(this, &UGISWebWidget::HandleFeatureBatch);
+		Bridge->RegisterHandler(TEXT("EXPORT_DATA"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleExportData));
+		Bridge->RegisterHandler(TEXT("DBLCLICK"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleDoubleClick));
+		Bridge->RegisterHandler(TEXT("ANALYZE"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleAnalyze));
+		Bridge->RegisterHandler(TEXT("SNAP"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleSnap));
+		Bridge->RegisterHandler(TEXT("SNAP_POINT"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleSnapPoint));
+		Bridge->RegisterHandler(TEXT("BUFFER"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleBuffer));
+		Bridge->RegisterHandler(TEXT("EDITS"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleEdits));
+		Bridge->RegisterHandler(TEXT("VIEW"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleView));
+		Bridge->RegisterHandler(TEXT("IMPORT_DONE"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleImportDone));
+		Bridge->RegisterHandler(TEXT("READY"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandlePageReady));
+		Bridge->RegisterHandler(TEXT("SEARCH"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleSearch));
+		Bridge->RegisterHandler(TEXT("SEARCH_PICK"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleSearchPick));
+		Bridge->RegisterHandler(TEXT("FILTER"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleFilter));
+		Bridge->RegisterHandler(TEXT("UNDO"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleUndo));
+		Bridge->RegisterHandler(TEXT("REDO"), FGISBridgeHandler::CreateUObject(this, &UGISWebWidget::HandleRedo));
 	}
 
-	double CurrentTime = FPlatformTime::Seconds();
-	if (CurrentTime - LastLogTime < 0.02)
+	// UWebBrowser 未公开 BindUObject，运行时其 Slate 控件即 SWebBrowser
+	// 必须在 LoadURL 之前以常驻方式绑定，页面脚本执行时 window.ue.gisbridge 才可用
+	if (MapBrowser)
 	{
-		return;
+		TSharedPtr<SWebBrowser> BrowserWidget = StaticCastSharedPtr<SWebBrowser>(MapBrowser->GetCachedWidget());
+		if (BrowserWidget.IsValid())
+		{
+			BrowserWidget->BindUObject(UGISBridge::BindingName, Bridge, true);
+		}
 	}
-	LastLogTime = CurrentTime;
+}
 
-	if (Message.StartsWith("UE_ADD:"))
+void UGISWebWidget::HandleConsoleMessage(const FString& Message, const FString& Source, int32 Line)
+{
+	// 旧通道兜底：浏览器没有注入绑定对象时，页面仍会用 console.log 发送
+	if (!Message.StartsWith("UE_") || !Bridge)
 	{
-		FString Content = Message.RightChop(7);
-		TArray<FString> Parts;
-		Content.ParseIntoArray(Parts, TEXT("|"), false);
+		return;
+	}
 
-		if (Parts.Num() >= 10)
-		{
-			FString ID = Parts[0];
-			FString Name = Parts[1];
-			FString Type = Parts[2];
-			FString ParentID = Parts[3];
-			FString Color = Parts[4];
-			float Opacity = FCString::Atof(*Parts[5]);
-			FString TextColor = Parts[6];
-			FString Tag = Parts[7];
-			float Height = FCString::Atof(*Parts[8]);
+	Bridge->DispatchConsoleMessage(Message);
+}
 
-			if (ID.Equals(LastProcessedID, ESearchCase::IgnoreCase))
-			{
-				return;
-			}
-			LastProcessedID = ID;
+void UGISWebWidget::HandleFeatureBatch(const TArray<FGISFeatureRecord>& Records)
+{
+	// 只入队不处理，具体创建工作在 NativeTick 中按预算完成
+	PendingFeatures.Append(Records);
+}
 
-			ProcessAddPolyItem(ID, Name, Type, ParentID, Color, Opacity, TextColor, Tag, Height);
-		}
+void UGISWebWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	ProcessPendingFeatures();
+	TickFileTaskProgress();
+	TickAutosave(InDeltaTime);
+	TickLod();
+	TickFilter();
+	TickExtrusion();
+	TickMeasure();
+	TickScoring();
+	TickPointJoin();
+	TickLegacyLists();
+}
+
+void UGISWebWidget::ProcessPendingFeatures()
+{
+	if (PendingFeatureHead >= PendingFeatures.Num())
+	{
+		return;
 	}
-	else if (Message.StartsWith("UE_EXPORT_DATA:"))
+
+	const double Deadline = FPlatformTime::Seconds() + IngestBudgetMs * 0.001;
+	do
 	{
-		FString RawJson = Message.RightChop(15);
-		if (SaveDialogClass)
+		const FGISFeatureRecord& Record = PendingFeatures[PendingFeatureHead++];
+		ProcessAddPolyItem(Record.ID, Record.Name, Record.Type, Record.ParentID, Record.Color, Record.Opacity, Record.TextColor, Record.Tag, Record.Height);
+		StoreFeatureGeometry(Record.ID, Record.Geometry);
+
+		// C++ 重建道路后页面会以原 id 回报一次，此时以 C++ 侧已有的中心线为准
+		FGISRoadLine Road;
+		if (!Record.Road.IsEmpty() && !Roads.Contains(Record.ID) && GISLineBuffer::ParseRoad(Record.Road, Road))
 		{
-			UGISSaveDialog* Dialog = CreateWidget<UGISSaveDialog>(this, SaveDialogClass);
-			if (Dialog)
-			{
-				Dialog->Init(this, RawJson);
-			}
+			Roads.Add(Record.ID, MoveTemp(Road));
 		}
 	}
-	// 【新增】处理双击高亮
-	else if (Message.StartsWith("UE_DBLCLICK:"))
+	while (PendingFeatureHead < PendingFeatures.Num() && FPlatformTime::Seconds() < Deadline);
+
+	if (PendingFeatureHead >= PendingFeatures.Num())
 	{
-		FString TargetID = Message.RightChop(12);
-		HighlightListUI(TargetID);
+		PendingFeatures.Reset();
+		PendingFeatureHead = 0;
 	}
 }
 
-void UGISWebWidget::HighlightListUI(FString ID)
+void UGISWebWidget::HandlePageReady(const FString& Payload)
 {
-	// 先取消所有高亮 (简化处理)
-	// 实际项目中可以在 GISPolyItem 里加 SetHighlight 函数改变颜色
-	// 这里演示逻辑：找到该 Widget 并 Scroll 到它
-	if (WidgetMap.Contains(ID))
+	// 页面 (重新) 加载后覆盖物都是原始精度、全部显示
+	ViewLodLevel = 0;
+	FilterEngine.ResetPublished();
+	PushFilterKeys();
+	Scoring.ResetPublished();
+	if (MapBrowser && !TileBaseUrl.IsEmpty())
 	{
-		UGISPolyItem* Item = WidgetMap[ID];
-		if (Item)
-		{
-			if (List_Admin)
-			{
-				List_Admin->ScrollWidgetIntoView(Item);
-			}
-			// 这里可以扩展 Item->SetHighlight(true);
-		}
+		MapBrowser->ExecuteJavascript(FString::Printf(TEXT("setTileMode('%s');"), *TileBaseUrl));
 	}
+	PushPointLayer();
 }
 
-void UGISWebWidget::ProcessAddPolyItem(FString ID, FString Name, FString Type, FString ParentID, FString Color,
-                                       float Opacity, FString TextColor, FString Tag, float Height)
+void UGISWebWidget::HandleView(const FString& Payload)
 {
-	if (!PolyItemClass)
+	// 瓦片本身按缩放取对应级别的简化几何
+	if (!TileBaseUrl.IsEmpty())
 	{
 		return;
 	}
 
-	// 【核心修复】自动构建父级逻辑
-	// 如果是街道(Street)且没有指定父级(None)，则尝试根据 Tag(行政区代码) 自动创建/查找父级
-	if (Type == "Street" && (ParentID == "None" || ParentID.IsEmpty()) && !Tag.IsEmpty())
+	const int32 Level = FGISLodPyramid::LevelForZoom(FCString::Atof(*Payload));
+	if (Level != ViewLodLevel)
 	{
-		// 构造父级ID，例如 District_310101
-		FString DistrictID = "District_" + Tag; 
-        
-		// 检查这个父级是否已经存在
-		if (!WidgetMap.Contains(DistrictID))
-		{
-			// 不存在则创建一个新的 District 节点
-			UGISPolyItem* ParentItem = CreateWidget<UGISPolyItem>(this, PolyItemClass);
-			if (ParentItem)
-			{
-				// 【关键修改】这里调用 GetDistrictNameByCode 获取真实中文名
-				FString RealName = GetDistrictNameByCode(Tag);
-                
-				// 初始化父级节点
-				ParentItem->SetupItem(DistrictID, RealName, "District", "None", "#808080", 1.0f, "#FFFFFF", "", 0, this);
-				WidgetMap.Add(DistrictID, ParentItem);
-                
-				if (List_Admin)
-				{
-					List_Admin->AddChild(ParentItem);
-				}
-			}
-		}
-		// 将当前街道的父级ID修正为这个区ID
-		ParentID = DistrictID;
+		ViewLodLevel = Level;
+		PushLodLevel(Level);
 	}
+}
 
-	UGISPolyItem* NewItem = CreateWidget<UGISPolyItem>(this, PolyItemClass);
-	if (!NewItem)
+void UGISWebWidget::TickLod()
+{
+	// 入队要素全部消化、且页面已导入完整个存档后再建，避免读档期间反复重建；
+	// 瓦片源的摘要据此与磁盘缓存比对，不完整的文档会使磁盘缓存每次都被判为过期
+	if (!bLodDirty || bLodBuildInFlight || bImportPending || PendingFeatureHead < PendingFeatures.Num())
 	{
 		return;
 	}
+	bLodDirty = false;
+	bLodBuildInFlight = true;
+	const int32 Serial = ++LodBuildSerial;
+
+	TArray<FGISLodPyramid::FFeatureInput> Inputs;
+	Inputs.Reserve(SpatialIndex.Num());
+	SpatialIndex.ForEach([&Inputs](const FGISSpatialItem& Item)
+	{
+		Inputs.Add({ Item.ID, Item.Geometry });
+	});
 
-	NewItem->SetupItem(ID, Name, Type, ParentID, Color, Opacity, TextColor, Tag, Height, this);
-	WidgetMap.Add(ID, NewItem);
+	// 瓦片模式下顺带生成瓦片几何源，与上一份比对出变化范围
+	const bool bBuildTiles = !TileBaseUrl.IsEmpty();
+	TSharedPtr<const FGISTileCache::FSource> PreviousTiles = bBuildTiles ? TileCache->GetSource() : nullptr;
 
-	if (Type == "Reconstruct")
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, bBuildTiles, PreviousTiles, Inputs = MoveTemp(Inputs)]()
 	{
-		if (List_Reconstruct)
+		TSharedPtr<FGISLodPyramid> Pyramid = MakeShared<FGISLodPyramid>();
+		Pyramid->Build(Inputs);
+
+		TSharedPtr<const FGISTileCache::FSource> Tiles;
+		if (bBuildTiles)
 		{
-			List_Reconstruct->AddChild(NewItem);
+			Tiles = FGISTileCache::BuildSource(Pyramid, PreviousTiles.Get());
 		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Pyramid, Tiles]()
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget)
+			{
+				return;
+			}
+			Widget->bLodBuildInFlight = false;
+			if (Serial != Widget->LodBuildSerial)
+			{
+				return;
+			}
+			Widget->LodPyramid = Pyramid;
+			UE_LOG(LogGISWebWidget, Verbose, TEXT("LOD 重建完成: %d 个要素"), Pyramid->Num());
+
+			if (Tiles.IsValid())
+			{
+				TArray<FGISTileRange> Changed;
+				bool bAll = false;
+				Widget->TileCache->SetSource(Tiles.ToSharedRef(), Changed, bAll);
+				Widget->PushTileChanges(Changed, bAll);
+			}
+			// 新建或改动的覆盖物是原始精度，按当前缩放重新下发一次
+			else if (Widget->ViewLodLevel > 0)
+			{
+				Widget->PushLodLevel(Widget->ViewLodLevel);
+			}
+		});
+	});
+}
+
+void UGISWebWidget::TickExtrusion()
+{
+	// 读档时等页面导入完整个存档：局部坐标原点取自首次构建的数据范围，只用部分要素会使原点偏离
+	if (!bExtrudeFeatures || !bExtrusionDirty || bExtrusionBuildInFlight || bImportPending || PendingFeatureHead < PendingFeatures.Num())
+	{
+		return;
 	}
-	else if (Type == "District")
+	bExtrusionDirty = false;
+
+	TArray<FGISExtrusionInput> Inputs;
+	Inputs.Reserve(SpatialIndex.Num());
+	FBox2D DataBounds(ForceInit);
+	SpatialIndex.ForEach([this, &Inputs, &DataBounds](const FGISSpatialItem& Item)
 	{
-		if (List_Admin)
+		const FGISFeatureHandle Handle = FeatureStore.Find(Item.ID);
+		const float Height = FeatureStore.GetHeight(Handle);
+		if (Height <= 0.0f)
 		{
-			List_Admin->AddChild(NewItem);
+			return;
 		}
-	}
-	else if (Type == "Road")
+		FColor Color = FeatureStore.GetFillColor(Handle);
+		Color.A = static_cast<uint8>(FMath::Clamp(FeatureStore.GetOpacity(Handle), 0.0f, 1.0f) * 255.0f);
+		Inputs.Add({ GetExtrusionGroup(Handle), Item.Geometry, Height, Color });
+		DataBounds += Item.Bounds;
+	});
+
+	// 原点固定后后续要素都在同一局部坐标系中，体块不会随数据增减而移动
+	if (!ExtrusionFrame.IsValid())
 	{
-		if (List_Road)
+		if (Inputs.Num() == 0)
 		{
-			List_Road->AddChild(NewItem);
+			return;
 		}
+		ExtrusionFrame = FGISEnuFrame(DataBounds.GetCenter(), EGISCoordSystem::BD09);
 	}
-	else if (Type == "Street" || Type == "Community" || Type == "Custom")
+
+	if (!CityMeshActor.IsValid())
 	{
-		UGISPolyItem** ParentWidgetPtr = WidgetMap.Find(ParentID);
-		if (ParentWidgetPtr && *ParentWidgetPtr)
+		UWorld* World = GetWorld();
+		if (!World)
 		{
-			(*ParentWidgetPtr)->AddChildItem(NewItem);
+			return;
 		}
-		else if (List_Admin)
+		CityMeshActor = World->SpawnActor<AGISCityMeshActor>();
+		if (!CityMeshActor.IsValid())
 		{
-			List_Admin->AddChild(NewItem);
+			return;
 		}
+		CityMeshActor->SetMeshMaterial(ExtrusionMaterial);
+		CityMeshActor->SetCollisionEnabled(bExtrusionCollision);
 	}
+
+	bExtrusionBuildInFlight = true;
+	const int32 Serial = ++ExtrusionBuildSerial;
+
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, Frame = ExtrusionFrame, Inputs = MoveTemp(Inputs)]()
+	{
+		TSharedPtr<TArray<FGISMeshSection>> Sections = MakeShared<TArray<FGISMeshSection>>();
+		FGISExtrusion::Build(Inputs, Frame, *Sections);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Sections]()
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget)
+			{
+				return;
+			}
+			Widget->bExtrusionBuildInFlight = false;
+			if (Serial != Widget->ExtrusionBuildSerial || !Widget->CityMeshActor.IsValid())
+			{
+				return;
+			}
+			Widget->CityMeshActor->ApplySections(*Sections);
+			UE_LOG(LogGISWebWidget, Verbose, TEXT("体块重建完成: %d 个区镇"), Sections->Num());
+		});
+	});
 }
 
-void UGISWebWidget::OpenEditDialog(UGISPolyItem* ItemToEdit)
+void UGISWebWidget::TickMeasure()
 {
-	if (!ItemToEdit)
+	if (!bMeasureDirty || bMeasureInFlight || PendingFeatureHead < PendingFeatures.Num())
 	{
 		return;
 	}
-	CurrentEditingItem = ItemToEdit;
+	bMeasureDirty = false;
 
-	if (Edit_Input_Name)
+	// 只量测几何版本变过的要素
+	struct FMeasureJob
 	{
-		Edit_Input_Name->SetText(FText::FromString(ItemToEdit->GetItemName()));
-	}
-	if (Edit_Input_Opacity)
+		FGISFeatureHandle Handle;
+		TSharedPtr<const FGISMultiPolygon> Geometry;
+		FGISFeatureMeasure Result;
+	};
+	TSharedRef<TArray<FMeasureJob>> Jobs = MakeShared<TArray<FMeasureJob>>();
+	SpatialIndex.ForEach([this, &Jobs](const FGISSpatialItem& Item)
+	{
+		const FGISFeatureHandle Handle = FeatureStore.Find(Item.ID);
+		if (Handle.IsSet() && FeatureStats.NeedsMeasure(Handle, Item.Geometry))
+		{
+			Jobs->Add({ Handle, Item.Geometry, FGISFeatureMeasure() });
+		}
+	});
+	if (Jobs->Num() == 0)
 	{
-		Edit_Input_Opacity->SetText(FText::AsNumber(ItemToEdit->GetItemOpacity()));
+		return;
 	}
 
-	FColor FillColor = FColor::FromHex(ItemToEdit->GetItemColor());
-	UpdateColorUI(FLinearColor::FromSRGBColor(FillColor));
-	FColor TextCol = FColor::FromHex(ItemToEdit->GetItemTextColor());
-	UpdateTextColorUI(FLinearColor::FromSRGBColor(TextCol));
+	bMeasureInFlight = true;
+	const int32 Serial = MeasureSerial;
 
-	if (Edit_Input_Parent)
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, Jobs]()
 	{
-		Edit_Input_Parent->ClearOptions();
-		Edit_Input_Parent->AddOption(TEXT("None (无)"));
-
-		FString TargetParentType = "";
-		FString CurrentType = ItemToEdit->GetItemType();
-
-		if (CurrentType == "Street")
-		{
-			TargetParentType = "District";
-		}
-		else if (CurrentType == "Community" || CurrentType == "Custom" || CurrentType == "Road")
+		ParallelFor(Jobs->Num(), [&Jobs](int32 Index)
 		{
-			TargetParentType = "Street";
-		}
-
-		FString CurrentParentName = "None (无)";
+			FMeasureJob& Job = (*Jobs)[Index];
+			Job.Result = GISMeasure::Measure(*Job.Geometry);
+		});
 
-		if (!TargetParentType.IsEmpty())
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Jobs]()
 		{
-			for (auto& Elem : WidgetMap)
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget)
 			{
-				UGISPolyItem* Item = Elem.Value;
-				if (Item && Item->GetItemType() == TargetParentType)
-				{
-					FString OptionStr = FString::Printf(TEXT("%s [%s]"), *Item->GetItemName(), *Item->GetItemID());
-					Edit_Input_Parent->AddOption(OptionStr);
+				return;
+			}
+			Widget->bMeasureInFlight = false;
+			if (Serial != Widget->MeasureSerial)
+			{
+				return;
+			}
 
-					if (Item->GetItemID() == ItemToEdit->GetItemParentID())
+			// 量测期间被删除或换了几何的要素跳过，后者已重新标脏
+			// 标注点变了的要素通知打分：地标按标注点计数
+			for (const FMeasureJob& Job : *Jobs)
+			{
+				const FGISFeatureStore& Store = Widget->FeatureStore;
+				const FGISSpatialItem* Item = Store.IsValid(Job.Handle) ? Widget->SpatialIndex.Find(Store.GetID(Job.Handle)) : nullptr;
+				if (Item && Item->Geometry == Job.Geometry)
+				{
+					const FGISFeatureMeasure* Old = Widget->FeatureStats.GetMeasure(Job.Handle);
+					const bool bLabelMoved = !Old || Old->LabelPoint != Job.Result.LabelPoint;
+					Widget->FeatureStats.SetMeasure(Job.Handle, Job.Geometry, Job.Result);
+					if (bLabelMoved)
 					{
-						CurrentParentName = OptionStr;
+						Widget->Scoring.MarkFeatureChanged(Item->ID);
 					}
 				}
 			}
-		}
-		Edit_Input_Parent->SetSelectedOption(CurrentParentName);
+			UE_LOG(LogGISWebWidget, Verbose, TEXT("量测完成: %d 个要素"), Jobs->Num());
+		});
+	});
+}
+
+bool UGISWebWidget::GetFeatureSummary(FString ID, FGISFeatureSummary& OutSummary) const
+{
+	return FeatureStats.GetSummary(FeatureStore.Find(ID), OutSummary);
+}
+
+void UGISWebWidget::TickScoring()
+{
+	if (bShowScoreChoropleth && Scoring.HasStyleChanges())
+	{
+		PushScoreStyle();
 	}
 
-	if (Edit_Dialog_Overlay)
+	// 面积与地标标注点取自量测缓存，等量测稳定后再算
+	if (!Scoring.HasPendingChanges() || bScoringInFlight || bMeasureDirty || bMeasureInFlight || PendingFeatureHead < PendingFeatures.Num())
 	{
-		Edit_Dialog_Overlay->SetVisibility(ESlateVisibility::Visible);
+		return;
 	}
-}
 
-void UGISWebWidget::SaveEditChanges()
-{
-	if (CurrentEditingItem.IsValid() && MapBrowser)
+	TSharedPtr<FGISScoringBatch> Batch = Scoring.PrepareBatch(FeatureStore, SpatialIndex, FeatureStats);
+	if (!Batch.IsValid())
 	{
-		FString NewName = Edit_Input_Name->GetText().ToString();
-		FString NewColor = Edit_Input_Color->GetText().ToString();
-		FString NewOpacityStr = Edit_Input_Opacity->GetText().ToString();
-		float NewOpacity = FCString::Atof(*NewOpacityStr);
-		FString NewTextColor = Edit_Input_TextColor->GetText().ToString();
-		FString ID = CurrentEditingItem->GetItemID();
+		return;
+	}
 
-		FString NewParentID = "None";
-		if (Edit_Input_Parent)
-		{
-			FString SelectedStr = Edit_Input_Parent->GetSelectedOption();
-			int32 LeftBracketIdx, RightBracketIdx;
-			if (SelectedStr.FindChar('[', LeftBracketIdx) && SelectedStr.FindChar(']', RightBracketIdx))
-			{
-				NewParentID = SelectedStr.Mid(LeftBracketIdx + 1, RightBracketIdx - LeftBracketIdx - 1);
-			}
-		}
+	// 只有街道被删除时不必进线程池，直接重新排名
+	if (Batch->Streets.Num() == 0)
+	{
+		Scoring.ApplyBatch(*Batch, FeatureStore);
+		OnScoresUpdated.Broadcast();
+		return;
+	}
+
+	bScoringInFlight = true;
+	const int32 Serial = ScoringSerial;
 
-		FString OldParentID = CurrentEditingItem->GetItemParentID();
-		if (NewParentID != OldParentID)
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, Batch]()
+	{
+		FGISScoringEngine::Evaluate(*Batch);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Batch]()
 		{
-			CurrentEditingItem->RemoveFromParent();
-			UGISPolyItem** NewParentWidgetPtr = WidgetMap.Find(NewParentID);
-			if (NewParentWidgetPtr && *NewParentWidgetPtr)
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget)
 			{
-				(*NewParentWidgetPtr)->AddChildItem(CurrentEditingItem.Get());
+				return;
 			}
-			else
+			Widget->bScoringInFlight = false;
+			if (Serial != Widget->ScoringSerial)
 			{
-				FString Type = CurrentEditingItem->GetItemType();
-				if (Type == "Road" && List_Road)
-				{
-					List_Road->AddChild(CurrentEditingItem.Get());
-				}
-				else if (List_Admin)
-				{
-					List_Admin->AddChild(CurrentEditingItem.Get());
-				}
+				return;
 			}
-		}
-
-		FString Script = FString::Printf(TEXT("updatePolyAttributes('%s', '%s', '%s', '%s', '%s', '%s');"),
-		                                 *ID, *NewName, *NewColor, *NewOpacityStr, *NewTextColor, *NewParentID);
-
-		MapBrowser->ExecuteJavascript(Script);
 
-		CurrentEditingItem->UpdateData(NewName, NewColor, NewOpacity, NewTextColor, NewParentID);
-	}
-	CloseEditDialog();
+			Widget->Scoring.ApplyBatch(*Batch, Widget->FeatureStore);
+			UE_LOG(LogGISWebWidget, Verbose, TEXT("街道打分完成: 重算 %d 条，共 %d 条"), Batch->Streets.Num(), Widget->Scoring.NumStreets());
+			Widget->OnScoresUpdated.Broadcast();
+		});
+	});
 }
 
-void UGISWebWidget::CloseEditDialog()
+void UGISWebWidget::PushScoreStyle()
 {
-	if (Edit_Dialog_Overlay)
+	if (!MapBrowser)
 	{
-		Edit_Dialog_Overlay->SetVisibility(ESlateVisibility::Collapsed);
+		return;
 	}
-	CurrentEditingItem = nullptr;
-}
 
-void UGISWebWidget::OnColorSliderChanged(float Value)
-{
-	if (Slider_R && Slider_G && Slider_B)
+	TMap<FString, FString> Changed;
+	TArray<FString> Cleared;
+	Scoring.ConsumeStyleChanges(Changed, Cleared);
+	if (Changed.Num() == 0 && Cleared.Num() == 0)
 	{
-		FLinearColor NewColor(Slider_R->GetValue(), Slider_G->GetValue(), Slider_B->GetValue());
-		if (Color_Preview)
-		{
-			Color_Preview->SetBrushColor(NewColor);
-		}
-		if (Edit_Input_Color)
-		{
-			Edit_Input_Color->SetText(FText::FromString("#" + NewColor.ToFColor(true).ToHex()));
-		}
+		return;
+	}
+
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	Writer->WriteObjectStart();
+	Writer->WriteObjectStart(TEXT("set"));
+	for (const TPair<FString, FString>& Pair : Changed)
+	{
+		Writer->WriteValue(Pair.Key, Pair.Value);
 	}
+	Writer->WriteObjectEnd();
+	Writer->WriteValue(TEXT("clear"), Cleared);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	MapBrowser->ExecuteJavascript(TEXT("applyScoreStyle(") + Output + TEXT(");"));
 }
 
-void UGISWebWidget::OnTextColorSliderChanged(float Value)
+void UGISWebWidget::SetScoreTerms(const TArray<FGISScoreTerm>& Terms)
 {
-	if (Slider_Text_R && Slider_Text_G && Slider_Text_B)
+	ScoreTerms = Terms;
+	Scoring.SetTerms(Terms);
+	++ScoringSerial;
+	if (!Scoring.IsEnabled())
 	{
-		FLinearColor NewColor(Slider_Text_R->GetValue(), Slider_Text_G->GetValue(), Slider_Text_B->GetValue());
-		if (TextColor_Preview)
-		{
-			TextColor_Preview->SetBrushColor(NewColor);
-		}
-		if (Edit_Input_TextColor)
-		{
-			Edit_Input_TextColor->SetText(FText::FromString("#" + NewColor.ToFColor(true).ToHex()));
-		}
+		OnScoresUpdated.Broadcast();
 	}
 }
 
-void UGISWebWidget::OnPresetColorClicked(FLinearColor NewColor)
+TArray<FGISScoreRow> UGISWebWidget::GetScoreTable(int32 SortColumn, bool bDescending) const
 {
-	UpdateColorUI(NewColor);
+	return Scoring.GetTable(FeatureStore, SortColumn, bDescending);
 }
 
-void UGISWebWidget::UpdateColorUI(FLinearColor Color)
+void UGISWebWidget::SetScoreChoroplethVisible(bool bVisible)
 {
-	if (Slider_R) Slider_R->SetValue(Color.R);
-	if (Slider_G) Slider_G->SetValue(Color.G);
-	if (Slider_B) Slider_B->SetValue(Color.B);
-	if (Color_Preview) Color_Preview->SetBrushColor(Color);
-	if (Edit_Input_Color) Edit_Input_Color->SetText(FText::FromString("#" + Color.ToFColor(true).ToHex()));
+	if (bShowScoreChoropleth == bVisible)
+	{
+		return;
+	}
+	bShowScoreChoropleth = bVisible;
+
+	// 重新打开时全部重发
+	Scoring.ResetPublished();
+	if (!bVisible && MapBrowser)
+	{
+		MapBrowser->ExecuteJavascript(TEXT("applyScoreStyle(null);"));
+	}
 }
 
-void UGISWebWidget::UpdateTextColorUI(FLinearColor Color)
+bool UGISWebWidget::IsPointJoinTarget(const FString& ID) const
 {
-	if (Slider_Text_R) Slider_Text_R->SetValue(Color.R);
+	const FGISFeatureHandle Handle = FeatureStore.Find(ID);
+	if (!FeatureStore.IsValid(Handle))
+	{
+		return false;
+	}
+	const EGISFeatureType Type = FeatureStore.GetType(Handle);
+	return Type == EGISFeatureType::Street || Type == EGISFeatureType::District;
+}
+
+void UGISWebWidget::TickPointJoin()
+{
+	// 等要素全部入库后再连接，读大存档时不反复重做
+	if (!bPointJoinDirty || bPointJoinInFlight || !PointLayer.IsValid() || PendingFeatureHead < PendingFeatures.Num())
+	{
+		return;
+	}
+	bPointJoinDirty = false;
+
+	// 几何本身只读共享，这里只取出街道与区镇的列表及街道所属的区镇
+	TArray<FGISPointJoinTarget> Streets;
+	TArray<FGISPointJoinTarget> Districts;
+	TMap<FString, int32> DistrictIndex;
+	SpatialIndex.ForEach([&](const FGISSpatialItem& Item)
+	{
+		const FGISFeatureHandle Handle = FeatureStore.Find(Item.ID);
+		if (!FeatureStore.IsValid(Handle))
+		{
+			return;
+		}
+		const EGISFeatureType Type = FeatureStore.GetType(Handle);
+		if (Type == EGISFeatureType::Street)
+		{
+			Streets.Add({ Item.ID, Item.Geometry });
+		}
+		else if (Type == EGISFeatureType::District)
+		{
+			DistrictIndex.Add(Item.ID, Districts.Num());
+			Districts.Add({ Item.ID, Item.Geometry });
+		}
+	});
+	for (FGISPointJoinTarget& Street : Streets)
+	{
+		if (const int32* Parent = DistrictIndex.Find(FeatureStore.GetParentID(FeatureStore.Find(Street.ID))))
+		{
+			Street.Parent = *Parent;
+		}
+	}
+
+	bPointJoinInFlight = true;
+	const int32 Serial = PointJoinSerial;
+	TSharedPtr<const FGISPointLayer> Layer = PointLayer;
+
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, Layer, Streets = MoveTemp(Streets), Districts = MoveTemp(Districts)]() mutable
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const int32 NumTargets = Streets.Num() + Districts.Num();
+		TSharedPtr<const FGISPointJoin> Join = FGISPointJoin::Run(*Layer, MoveTemp(Streets), MoveTemp(Districts));
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Join, NumTargets, Elapsed]()
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget)
+			{
+				return;
+			}
+			Widget->bPointJoinInFlight = false;
+			if (Serial != Widget->PointJoinSerial)
+			{
+				return;
+			}
+
+			Widget->PointJoin = Join;
+			Widget->Scoring.SetPointJoin(Join);
+			UE_LOG(LogGISWebWidget, Log, TEXT("点资源空间连接完成: %d 个点，%d 个面，用时 %.2f 秒"), Join->Owners.Num(), NumTargets, Elapsed);
+			Widget->OnPointsJoined.Broadcast(Join->Owners.Num());
+			if (Widget->Scoring.IsEnabled())
+			{
+				Widget->OnScoresUpdated.Broadcast();
+			}
+		});
+	});
+}
+
+void UGISWebWidget::PushPointLayer()
+{
+	if (!MapBrowser || PointTileBaseUrl.IsEmpty())
+	{
+		return;
+	}
+	if (!PointLayer.IsValid())
+	{
+		MapBrowser->ExecuteJavascript(TEXT("setPoiLayer(null);"));
+		return;
+	}
+
+	// 页面按瓦片中的类别下标取类别名
+	FString Categories;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Categories);
+	Writer->WriteArrayStart();
+	for (const FString& Name : PointLayer->GetCategoryNames())
+	{
+		Writer->WriteValue(Name);
+	}
+	Writer->WriteArrayEnd();
+	Writer->Close();
+
+	MapBrowser->ExecuteJavascript(FString::Printf(TEXT("setPoiLayer('%s', %s);"), *PointTileBaseUrl, *Categories));
+}
+
+void UGISWebWidget::SetPointLayer(TSharedPtr<const FGISPointLayer> Layer)
+{
+	PointLayer = Layer;
+	PointTiles->SetLayer(MoveTemp(Layer));
+
+	// 旧图层的连接结果作废
+	PointJoin.Reset();
+	Scoring.SetPointJoin(nullptr);
+	++PointJoinSerial;
+	bPointJoinDirty = PointLayer.IsValid();
+	PushPointLayer();
+}
+
+bool UGISWebWidget::ImportPointsCSV(FString CsvPath, EGISCoordSystem SourceCoords)
+{
+	if (FPaths::IsRelative(CsvPath))
+	{
+		CsvPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir() + TEXT("HTML/"), CsvPath);
+	}
+	if (!FPaths::FileExists(CsvPath))
+	{
+		UE_LOG(LogGISWebWidget, Warning, TEXT("点 CSV 不存在: %s"), *CsvPath);
+		return false;
+	}
+
+	// 读入与坐标转换都在线程池中进行，较晚开始的导入覆盖较早的
+	const int32 Serial = ++PointLoadSerial;
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, CsvPath, SourceCoords]()
+	{
+		TSharedRef<FGISPointLayer> Layer = MakeShared<FGISPointLayer>();
+		const FGISCsvImportResult Result = FGISCsvImporter::ImportPoints(CsvPath, SourceCoords, *Layer);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Layer, Result]()
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget || Serial != Widget->PointLoadSerial)
+			{
+				return;
+			}
+			if (!Result.bSuccess)
+			{
+				if (Widget->MapBrowser)
+				{
+					Widget->MapBrowser->ExecuteJavascript(FString::Printf(TEXT("alert('%s');"), *Result.Error.ReplaceCharWithEscapedChar()));
+				}
+				return;
+			}
+			Widget->SetPointLayer(Layer);
+		});
+	});
+	return true;
+}
+
+void UGISWebWidget::ClearPoints()
+{
+	++PointLoadSerial;
+	SetPointLayer(nullptr);
+}
+
+int32 UGISWebWidget::GetNumPoints() const
+{
+	return PointLayer.IsValid() ? PointLayer->Num() : 0;
+}
+
+int32 UGISWebWidget::GetPointCount(FString FeatureID, FString Category) const
+{
+	if (!PointJoin.IsValid())
+	{
+		return 0;
+	}
+	if (Category.IsEmpty())
+	{
+		return PointJoin->GetCount(FeatureID);
+	}
+	const int32 CategoryIndex = PointJoin->CategoryNames.IndexOfByKey(Category);
+	return CategoryIndex != INDEX_NONE ? PointJoin->GetCount(FeatureID, CategoryIndex) : 0;
+}
+
+FString UGISWebWidget::GetExtrusionGroup(FGISFeatureHandle Handle) const
+{
+	// 向上找到所属区镇；不在任何区镇下的按标签归组
+	for (FGISFeatureHandle Current = Handle; FeatureStore.IsValid(Current); Current = FeatureStore.GetParent(Current))
+	{
+		if (FeatureStore.GetType(Current) == EGISFeatureType::District)
+		{
+			return FeatureStore.GetID(Current);
+		}
+	}
+	const FString& Tag = FeatureStore.GetTag(Handle);
+	return Tag.IsEmpty() ? FString(TEXT("Ungrouped")) : TEXT("Tag:") + Tag;
+}
+
+void UGISWebWidget::PushLodLevel(int32 Level)
+{
+	const int32 Serial = ++LodPushSerial;
+	if (!MapBrowser)
+	{
+		return;
+	}
+
+	// 级别 0 由网页用自己持有的原始几何恢复
+	if (Level == 0 || !LodPyramid.IsValid())
+	{
+		MapBrowser->ExecuteJavascript(TEXT("applyLod(0, null);"));
+		return;
+	}
+
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, Level, Pyramid = LodPyramid]()
+	{
+		FTCHARToUTF8 Utf8(*Pyramid->WriteLevelJson(Level));
+		TArray<uint8> LevelData(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Level, LevelData = MoveTemp(LevelData)]() mutable
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget || Serial != Widget->LodPushSerial || !Widget->MapBrowser)
+			{
+				return;
+			}
+
+			if (Widget->ResourceServer.IsRegistered())
+			{
+				const FString Url = Widget->ResourceServer.Publish(TEXT("lod"), MoveTemp(LevelData));
+				Widget->MapBrowser->ExecuteJavascript(FString::Printf(TEXT("applyLod(%d, '%s');"), Level, *Url));
+			}
+			else
+			{
+				FUTF8ToTCHAR LevelStr(reinterpret_cast<const ANSICHAR*>(LevelData.GetData()), LevelData.Num());
+				Widget->MapBrowser->ExecuteJavascript(FString::Printf(TEXT("applyLod(%d, "), Level) + FString(LevelStr.Length(), LevelStr.Get()) + TEXT(");"));
+			}
+		});
+	});
+}
+
+void UGISWebWidget::PushTileChanges(const TArray<FGISTileRange>& Changed, bool bAll)
+{
+	if (!MapBrowser || (!bAll && Changed.Num() == 0))
+	{
+		return;
+	}
+	if (bAll)
+	{
+		MapBrowser->ExecuteJavascript(TEXT("onTilesChanged(null);"));
+		return;
+	}
+
+	FString Ranges;
+	for (const FGISTileRange& Range : Changed)
+	{
+		Ranges += FString::Printf(TEXT("%s[%d,%d,%d,%d,%d]"), Ranges.IsEmpty() ? TEXT("") : TEXT(","), Range.Z, Range.MinX, Range.MinY, Range.MaxX, Range.MaxY);
+	}
+	MapBrowser->ExecuteJavascript(TEXT("onTilesChanged([") + Ranges + TEXT("]);"));
+}
+
+void UGISWebWidget::HandleExportData(const FString& Payload)
+{
+	if (SaveDialogClass)
+	{
+		UGISSaveDialog* Dialog = CreateWidget<UGISSaveDialog>(this, SaveDialogClass);
+		if (Dialog)
+		{
+			Dialog->Init(this, Payload);
+		}
+	}
+}
+
+void UGISWebWidget::HandleDoubleClick(const FString& Payload)
+{
+	HighlightListUI(Payload);
+}
+
+void UGISWebWidget::StoreFeatureGeometry(const FString& ID, const FString& GeometryJson)
+{
+	// 线要素或解析失败的几何不参与面分析
+	if (GeometryJson.IsEmpty() || SpatialIndex.Find(ID))
+	{
+		return;
+	}
+
+	FGISMultiPolygon Geometry;
+	if (GISGeoJson::ParseGeometry(GeometryJson, Geometry))
+	{
+		AddFeatureGeometry(ID, MakeShared<const FGISMultiPolygon>(MoveTemp(Geometry)));
+	}
+}
+
+void UGISWebWidget::AddFeatureGeometry(const FString& ID, TSharedPtr<const FGISMultiPolygon> Geometry)
+{
+	if (!bSnapServiceDirty)
+	{
+		SnapService.AddGeometry(*Geometry);
+	}
+	FeatureStore.SetBounds(FeatureStore.Find(ID), GISGeometry::ComputeBounds(*Geometry));
+	SpatialIndex.Add(ID, MoveTemp(Geometry));
+	bLodDirty = true;
+	bExtrusionDirty = true;
+	bMeasureDirty = true;
+	Scoring.MarkFeatureChanged(ID);
+	bPointJoinDirty |= PointLayer.IsValid() && IsPointJoinTarget(ID);
+}
+
+void UGISWebWidget::HandleBuffer(const FString& Payload)
+{
+	// 载荷: { "id": 请求号, "road": { line, widths, join, cap } }，单条道路直接在游戏线程生成
+	TSharedPtr<FJsonObject> Request;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload);
+	if (!FJsonSerializer::Deserialize(Reader, Request) || !Request.IsValid() || !MapBrowser)
+	{
+		return;
+	}
+
+	const int32 RequestID = static_cast<int32>(Request->GetNumberField(TEXT("id")));
+	const TSharedPtr<FJsonObject>* RoadObject = nullptr;
+	FGISRoadLine Road;
+	FGISMultiPolygon Geometry;
+	if (Request->TryGetObjectField(TEXT("road"), RoadObject))
+	{
+		if (GISLineBuffer::ParseRoad(*RoadObject, Road))
+		{
+			GISLineBuffer::Buffer(Road, Geometry);
+		}
+	}
+	MapBrowser->ExecuteJavascript(FString::Printf(TEXT("onBufferResult(%d, %s);"), RequestID, *GISGeoJson::WriteGeometry(Geometry)));
+}
+
+bool UGISWebWidget::UpdateRoad(const FString& ID, const FGISRoadLine& Road)
+{
+	TArray<FGISMultiPolygon> Geometries;
+	if (!Roads.Contains(ID) || !GISLineBuffer::Buffer(Road, Geometries.AddDefaulted_GetRef()))
+	{
+		return false;
+	}
+	Roads.Add(ID, Road);
+	ApplyRoadGeometries({ ID }, Geometries);
+	return true;
+}
+
+void UGISWebWidget::ApplyRoadGeometries(const TArray<FString>& IDs, TArray<FGISMultiPolygon>& Geometries)
+{
+	// 页面的载荷：[{ id, geometry, road }]，页面据此原地替换要素的几何与 properties.road
+	// geometry 与 road 已是 JSON 文本，原样写入；id 由写入器转义
+	FString Updates;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Updates);
+	Writer->WriteArrayStart();
+	for (int32 Index = 0; Index < IDs.Num(); ++Index)
+	{
+		const FString& ID = IDs[Index];
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("id"), ID);
+		Writer->WriteRawJSONValue(TEXT("geometry"), GISGeoJson::WriteGeometry(Geometries[Index]));
+		Writer->WriteRawJSONValue(TEXT("road"), GISLineBuffer::WriteRoad(Roads.FindChecked(ID)));
+		Writer->WriteObjectEnd();
+
+		// 旧几何从空间索引中移除后按新增处理，量测、打分、瓦片等随之增量更新
+		if (SpatialIndex.Remove(ID))
+		{
+			bSnapServiceDirty = true;
+		}
+		AddFeatureGeometry(ID, MakeShared<const FGISMultiPolygon>(MoveTemp(Geometries[Index])));
+	}
+	Writer->WriteArrayEnd();
+	Writer->Close();
+
+	if (!MapBrowser)
+	{
+		return;
+	}
+	if (ResourceServer.IsRegistered())
+	{
+		FTCHARToUTF8 Utf8(*Updates);
+		const FString Url = ResourceServer.Publish(TEXT("roads"), TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()));
+		MapBrowser->ExecuteJavascript(FString::Printf(TEXT("updateRoads('%s');"), *Url));
+	}
+	else
+	{
+		MapBrowser->ExecuteJavascript(TEXT("updateRoads(") + Updates + TEXT(");"));
+	}
+}
+
+const FGISRoadLine* UGISWebWidget::FindRoadLine(const FString& ID) const
+{
+	const FGISRoadLine* Road = Roads.Find(ID);
+	if (!Road)
+	{
+		const FGISFeatureHandle Handle = FeatureStore.Find(ID);
+		if (FeatureStore.IsValid(Handle) && FeatureStore.GetType(Handle) == EGISFeatureType::Road)
+		{
+			UE_LOG(LogGISWebWidget, Warning, TEXT("道路 %s 来自旧存档，没有中心线，不能修改或重建"), *ID);
+		}
+	}
+	return Road;
+}
+
+bool UGISWebWidget::SetRoadWidth(FString ID, float WidthMeters)
+{
+	const FGISRoadLine* Road = FindRoadLine(ID);
+	if (!Road || !(WidthMeters > 0.0f))
+	{
+		return false;
+	}
+	FGISRoadLine Updated = *Road;
+	Updated.Widths = { WidthMeters };
+	return UpdateRoad(ID, Updated);
+}
+
+bool UGISWebWidget::SetRoadSegmentWidths(FString ID, const TArray<float>& WidthsMeters)
+{
+	const FGISRoadLine* Road = FindRoadLine(ID);
+	if (!Road || WidthsMeters.Num() != Road->Centerline.Num() - 1)
+	{
+		return false;
+	}
+	FGISRoadLine Updated = *Road;
+	Updated.Widths = WidthsMeters;
+	return UpdateRoad(ID, Updated);
+}
+
+bool UGISWebWidget::SetRoadCenterline(FString ID, const TArray<FVector2D>& Centerline)
+{
+	const FGISRoadLine* Road = FindRoadLine(ID);
+	if (!Road || Centerline.Num() < 2)
+	{
+		return false;
+	}
+	FGISRoadLine Updated = *Road;
+	Updated.Centerline = Centerline;
+	if (Updated.Widths.Num() > 1 && Updated.Widths.Num() != Centerline.Num() - 1)
+	{
+		Updated.Widths.SetNum(1);
+	}
+	return UpdateRoad(ID, Updated);
+}
+
+bool UGISWebWidget::SetRoadStyle(FString ID, EGISLineJoin Join, EGISLineCap Cap)
+{
+	const FGISRoadLine* Road = FindRoadLine(ID);
+	if (!Road)
+	{
+		return false;
+	}
+	FGISRoadLine Updated = *Road;
+	Updated.Join = Join;
+	Updated.Cap = Cap;
+	return UpdateRoad(ID, Updated);
+}
+
+bool UGISWebWidget::GetRoadCenterline(FString ID, TArray<FVector2D>& OutCenterline, TArray<float>& OutWidths) const
+{
+	const FGISRoadLine* Road = Roads.Find(ID);
+	if (!Road)
+	{
+		return false;
+	}
+	OutCenterline = Road->Centerline;
+	OutWidths = Road->Widths;
+	return true;
+}
+
+void UGISWebWidget::RebuildRoadNetwork()
+{
+	// 旧存档的道路没有中心线，保持原几何
+	int32 NumLegacy = 0;
+	SpatialIndex.ForEach([this, &NumLegacy](const FGISSpatialItem& Item)
+	{
+		const FGISFeatureHandle Handle = FeatureStore.Find(Item.ID);
+		if (FeatureStore.IsValid(Handle) && FeatureStore.GetType(Handle) == EGISFeatureType::Road && !Roads.Contains(Item.ID))
+		{
+			++NumLegacy;
+		}
+	});
+	if (NumLegacy > 0)
+	{
+		UE_LOG(LogGISWebWidget, Warning, TEXT("路网重建跳过 %d 条没有中心线的旧道路"), NumLegacy);
+	}
+
+	if (Roads.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FString> IDs;
+	TArray<FGISRoadLine> Snapshot;
+	Roads.GenerateKeyArray(IDs);
+	Roads.GenerateValueArray(Snapshot);
+	const int32 Serial = ++RoadBuildSerial;
+
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, IDs = MoveTemp(IDs), Snapshot = MoveTemp(Snapshot)]() mutable
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<FGISMultiPolygon> Geometries;
+		GISLineBuffer::BufferAll(Snapshot, Geometries);
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, IDs = MoveTemp(IDs), Snapshot = MoveTemp(Snapshot), Geometries = MoveTemp(Geometries), Elapsed]() mutable
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget || Serial != Widget->RoadBuildSerial)
+			{
+				return;
+			}
+
+			// 期间被删除或单独改过的道路不用旧快照的结果
+			TArray<FString> AppliedIDs;
+			TArray<FGISMultiPolygon> Applied;
+			for (int32 Index = 0; Index < IDs.Num(); ++Index)
+			{
+				const FGISRoadLine* Road = Widget->Roads.Find(IDs[Index]);
+				if (Road && *Road == Snapshot[Index] && Geometries[Index].Num() > 0)
+				{
+					AppliedIDs.Add(IDs[Index]);
+					Applied.Add(MoveTemp(Geometries[Index]));
+				}
+			}
+			UE_LOG(LogGISWebWidget, Log, TEXT("路网重建完成: %d 条道路，用时 %.2f 秒"), AppliedIDs.Num(), Elapsed);
+			if (AppliedIDs.Num() > 0)
+			{
+				Widget->ApplyRoadGeometries(AppliedIDs, Applied);
+			}
+		});
+	});
+}
+
+const FGISSnapService& UGISWebWidget::GetSnapService()
+{
+	if (bSnapServiceDirty)
+	{
+		bSnapServiceDirty = false;
+		SnapService.Reset();
+		SpatialIndex.ForEach([this](const FGISSpatialItem& Item)
+		{
+			SnapService.AddGeometry(*Item.Geometry);
+		});
+	}
+	SnapService.SetTolerance(SnapToleranceMeters);
+	return SnapService;
+}
+
+void UGISWebWidget::HandleSnap(const FString& Payload)
+{
+	// 载荷: { "id": 请求号, "geometries": [geometry, ...] }，按原顺序返回吸附后的几何 (无法解析的返回 null)
+	TSharedPtr<FJsonObject> Request;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload);
+	if (!FJsonSerializer::Deserialize(Reader, Request) || !Request.IsValid() || !MapBrowser)
+	{
+		return;
+	}
+
+	const int32 RequestID = static_cast<int32>(Request->GetNumberField(TEXT("id")));
+	const TArray<TSharedPtr<FJsonValue>>* Geometries = nullptr;
+	Request->TryGetArrayField(TEXT("geometries"), Geometries);
+
+	const FGISSnapService& Snap = GetSnapService();
+	FString Results = TEXT("[");
+	if (Geometries)
+	{
+		for (int32 Idx = 0; Idx < Geometries->Num(); ++Idx)
+		{
+			if (Idx > 0)
+			{
+				Results += TEXT(",");
+			}
+
+			const TSharedPtr<FJsonObject>* GeometryObject = nullptr;
+			FGISMultiPolygon Geometry;
+			if ((*Geometries)[Idx]->TryGetObject(GeometryObject) && GISGeoJson::ParseGeometry(*GeometryObject, Geometry))
+			{
+				Results += GISGeoJson::WriteGeometry(Snap.SnapGeometry(Geometry));
+			}
+			else
+			{
+				Results += TEXT("null");
+			}
+		}
+	}
+	Results += TEXT("]");
+
+	MapBrowser->ExecuteJavascript(FString::Printf(TEXT("onSnapResult(%d, %s);"), RequestID, *Results));
+}
+
+void UGISWebWidget::HandleSnapPoint(const FString& Payload)
+{
+	// 载荷: { "id": 请求号, "lng": 经度, "lat": 纬度 }
+	TSharedPtr<FJsonObject> Request;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload);
+	if (!FJsonSerializer::Deserialize(Reader, Request) || !Request.IsValid() || !MapBrowser)
+	{
+		return;
+	}
+
+	const int32 RequestID = static_cast<int32>(Request->GetNumberField(TEXT("id")));
+	const FVector2D Point(Request->GetNumberField(TEXT("lng")), Request->GetNumberField(TEXT("lat")));
+
+	FVector2D Snapped;
+	const bool bSnapped = GetSnapService().SnapPoint(Point, Snapped);
+	MapBrowser->ExecuteJavascript(FString::Printf(TEXT("onSnapPoint(%d, %.9f, %.9f, %s);"),
+	                                              RequestID, Snapped.X, Snapped.Y, bSnapped ? TEXT("true") : TEXT("false")));
+}
+
+void UGISWebWidget::HandleAnalyze(const FString& Payload)
+{
+	const int32 Serial = ++AnalysisSerial;
+
+	FGISMultiPolygon Target;
+	if (!GISGeoJson::ParseGeometry(Payload, Target))
+	{
+		if (MapBrowser)
+		{
+			MapBrowser->ExecuteJavascript(TEXT("onAnalysisResult(null);"));
+		}
+		return;
+	}
+
+	// 只把包围盒与新区域相交的要素交给工作线程
+	TArray<const FGISSpatialItem*> Candidates;
+	SpatialIndex.QueryBox(GISGeometry::ComputeBounds(Target), Candidates);
+
+	TArray<TSharedPtr<const FGISMultiPolygon>> Existing;
+	Existing.Reserve(Candidates.Num());
+	for (const FGISSpatialItem* Item : Candidates)
+	{
+		Existing.Add(Item->Geometry);
+	}
+
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, Target = MoveTemp(Target), Existing = MoveTemp(Existing)]()
+	{
+		FGISOverlayResult Result = FGISOverlayAnalysis::Run(Target, Existing);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Result = MoveTemp(Result)]()
+		{
+			if (UGISWebWidget* Widget = WeakThis.Get())
+			{
+				Widget->ApplyAnalysisResult(Serial, Result);
+			}
+		});
+	});
+}
+
+void UGISWebWidget::ApplyAnalysisResult(int32 Serial, const FGISOverlayResult& Result)
+{
+	if (Serial != AnalysisSerial || !MapBrowser)
+	{
+		return;
+	}
+
+	const FString Script = FString::Printf(TEXT("onAnalysisResult({\"pink\":%s,\"purple\":%s,\"yellow\":%s});"),
+	                                       *GISGeoJson::WriteFeature(Result.OverlapCore),
+	                                       *GISGeoJson::WriteFeature(Result.SingleCoverage),
+	                                       *GISGeoJson::WriteFeature(Result.Extension));
+	MapBrowser->ExecuteJavascript(Script);
+}
+
+FString UGISWebWidget::FindFeatureAt(double Lng, double Lat) const
+{
+	TArray<const FGISSpatialItem*> Hits;
+	SpatialIndex.QueryPoint(FVector2D(Lng, Lat), Hits);
+
+	// 层级嵌套时 (区 > 街道 > 小区) 取面积最小的一个
+	const FGISSpatialItem* Best = nullptr;
+	double BestArea = TNumericLimits<double>::Max();
+	for (const FGISSpatialItem* Item : Hits)
+	{
+		double Area = 0.0;
+		for (const FGISPolygon& Polygon : *Item->Geometry)
+		{
+			Area += FMath::Abs(GISGeometry::SignedArea(Polygon.Rings[0]));
+		}
+		if (Area < BestArea)
+		{
+			BestArea = Area;
+			Best = Item;
+		}
+	}
+	return Best ? Best->ID : FString();
+}
+
+TArray<FString> UGISWebWidget::FindNearestFeatures(double Lng, double Lat, int32 Count) const
+{
+	TArray<const FGISSpatialItem*> Nearest;
+	SpatialIndex.QueryNearest(FVector2D(Lng, Lat), Count, Nearest);
+
+	TArray<FString> IDs;
+	IDs.Reserve(Nearest.Num());
+	for (const FGISSpatialItem* Item : Nearest)
+	{
+		IDs.Add(Item->ID);
+	}
+	return IDs;
+}
+
+TArray<FString> UGISWebWidget::SearchFeatures(FString Query, int32 MaxResults)
+{
+	TArray<FGISSearchHit> Hits;
+	SearchIndex.Search(Query, MaxResults, Hits);
+
+	TArray<FString> IDs;
+	IDs.Reserve(Hits.Num());
+	for (const FGISSearchHit& Hit : Hits)
+	{
+		IDs.Add(Hit.ID);
+	}
+	return IDs;
+}
+
+void UGISWebWidget::SelectSearchResult(FString ID)
+{
+	if (FeatureStore.Find(ID).IsSet())
+	{
+		FocusID(ID);
+		HighlightListUI(ID);
+	}
+}
+
+void UGISWebWidget::HandleSearch(const FString& Payload)
+{
+	if (!MapBrowser)
+	{
+		return;
+	}
+
+	TArray<FGISSearchHit> Hits;
+	SearchIndex.Search(Payload, MaxSearchResults, Hits);
+
+	// 回传原始查询串，页面据此丢弃过期的结果
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("q"), Payload);
+	Writer->WriteArrayStart(TEXT("hits"));
+	for (const FGISSearchHit& Hit : Hits)
+	{
+		const FGISFeatureHandle Handle = FeatureStore.Find(Hit.ID);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("id"), Hit.ID);
+		Writer->WriteValue(TEXT("name"), Hit.Name);
+		Writer->WriteValue(TEXT("type"), Handle.IsSet() ? FString(GISFeatureType::ToString(FeatureStore.GetType(Handle))) : FString());
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	MapBrowser->ExecuteJavascript(TEXT("onSearchResults(") + Output + TEXT(");"));
+}
+
+void UGISWebWidget::HandleSearchPick(const FString& Payload)
+{
+	SelectSearchResult(Payload);
+}
+
+void UGISWebWidget::HighlightListUI(FString ID)
+{
+	// 找到数据节点，展开其所有上级并滚动到该行 (行控件可能尚未生成)
+	UGISPolyItemData* Item = FindItem(ID);
+	if (!Item)
+	{
+		return;
+	}
+
+	if (UTreeView* Tree = FindOwningTree(Item))
+	{
+		for (UGISPolyItemData* Parent = Item->GetParentItem(); Parent; Parent = Parent->GetParentItem())
+		{
+			Tree->SetItemExpansion(Parent, true);
+		}
+		Tree->SetSelectedItem(Item);
+		Tree->RequestScrollItemIntoView(Item);
+	}
+	else if (UGISPolyItem* Row = LegacyRows.FindRef(Item))
+	{
+		for (UScrollBox* List : { List_Admin, List_Reconstruct, List_Road })
+		{
+			if (List && List->HasChild(Row))
+			{
+				List->ScrollWidgetIntoView(Row);
+			}
+		}
+	}
+}
+
+void UGISWebWidget::OnGetItemChildren(UObject* Item, TArray<UObject*>& OutChildren)
+{
+	if (UGISPolyItemData* Data = Cast<UGISPolyItemData>(Item))
+	{
+		TArray<FGISFeatureHandle> Children;
+		FeatureStore.GetChildren(Data->Handle, Children);
+		for (const FGISFeatureHandle Child : Children)
+		{
+			if (UGISPolyItemData* ChildItem = GetItemByHandle(Child))
+			{
+				OutChildren.Add(ChildItem);
+			}
+		}
+	}
+}
+
+UGISPolyItemData* UGISWebWidget::GetItemByHandle(FGISFeatureHandle Handle) const
+{
+	return FeatureStore.IsValid(Handle) && ItemsByHandle.IsValidIndex(Handle.Index) ? ItemsByHandle[Handle.Index] : nullptr;
+}
+
+UGISPolyItemData* UGISWebWidget::FindItem(const FString& ID) const
+{
+	return GetItemByHandle(FeatureStore.Find(ID));
+}
+
+UGISPolyItemData* UGISWebWidget::RegisterItem(const FString& ID, const FGISFeatureStore::FAttributes& Attributes)
+{
+	const FGISFeatureHandle Handle = FeatureStore.Add(ID, Attributes);
+	if (Handle.Index >= ItemsByHandle.Num())
+	{
+		ItemsByHandle.SetNumZeroed(Handle.Index + 1);
+	}
+
+	UGISPolyItemData* Item = NewObject<UGISPolyItemData>(this);
+	Item->Init(Handle, this);
+	ItemsByHandle[Handle.Index] = Item;
+	return Item;
+}
+
+void UGISWebWidget::AttachItem(UGISPolyItemData* Item, bool bKeepRoadsInRoadList)
+{
+	bLegacyListsDirty = true;
+	const EGISFeatureType Type = Item->GetType();
+	if (Type == EGISFeatureType::Reconstruct)
+	{
+		if (Tree_Reconstruct)
+		{
+			Tree_Reconstruct->AddItem(Item);
+		}
+		return;
+	}
+
+	const bool bRoadRoot = Type == EGISFeatureType::Road && bKeepRoadsInRoadList;
+	if (Type != EGISFeatureType::District && !bRoadRoot)
+	{
+		// 父级不存在或会形成环时挂到根列表
+		UGISPolyItemData* Parent = FindItem(FeatureStore.GetParentID(Item->Handle));
+		if (Parent && FeatureStore.SetParent(Item->Handle, Parent->Handle))
+		{
+			FeatureStats.SyncParent(FeatureStore, Item->Handle);
+			if (UTreeView* Tree = FindOwningTree(Parent))
+			{
+				Tree->RequestRefresh();
+			}
+			return;
+		}
+	}
+
+	if (Type == EGISFeatureType::Road && Tree_Road)
+	{
+		Tree_Road->AddItem(Item);
+	}
+	else if (Tree_Admin)
+	{
+		Tree_Admin->AddItem(Item);
+	}
+}
+
+void UGISWebWidget::DetachItem(UGISPolyItemData* Item)
+{
+	bLegacyListsDirty = true;
+	if (UGISPolyItemData* Parent = Item->GetParentItem())
+	{
+		UTreeView* Tree = FindOwningTree(Parent);
+		FeatureStore.SetParent(Item->Handle, FGISFeatureHandle());
+		FeatureStats.SyncParent(FeatureStore, Item->Handle);
+		if (Tree)
+		{
+			Tree->RequestRefresh();
+		}
+		return;
+	}
+
+	for (UTreeView* Tree : { Tree_Admin, Tree_Reconstruct, Tree_Road })
+	{
+		if (Tree)
+		{
+			Tree->RemoveItem(Item);
+		}
+	}
+}
+
+UTreeView* UGISWebWidget::FindOwningTree(UGISPolyItemData* Item) const
+{
+	UGISPolyItemData* Root = Item;
+	while (Root && Root->GetParentItem())
+	{
+		Root = Root->GetParentItem();
+	}
+
+	for (UTreeView* Tree : { Tree_Admin, Tree_Reconstruct, Tree_Road })
+	{
+		if (Tree && Tree->GetIndexForItem(Root) != INDEX_NONE)
+		{
+			return Tree;
+		}
+	}
+	return nullptr;
+}
+
+void UGISWebWidget::RefreshItemEntry(UGISPolyItemData* Item)
+{
+	if (UTreeView* Tree = FindOwningTree(Item))
+	{
+		if (UGISPolyItem* Entry = Tree->GetEntryWidgetFromItem<UGISPolyItem>(Item))
+		{
+			Entry->RefreshFromData();
+		}
+	}
+	else if (UGISPolyItem* Row = LegacyRows.FindRef(Item))
+	{
+		Row->RefreshFromData();
+	}
+}
+
+bool UGISWebWidget::UsesLegacyLists() const
+{
+	return !Tree_Admin && !Tree_Reconstruct && !Tree_Road && (List_Admin || List_Reconstruct || List_Road) && PolyItemClass;
+}
+
+void UGISWebWidget::TickLegacyLists()
+{
+	// 与树列表相同的归属：重构区域、留在道路列表根部的道路、其余根节点分别进三个列表，下级紧跟在上级之后
+	if (!bLegacyListsDirty || PendingFeatureHead < PendingFeatures.Num() || !UsesLegacyLists())
+	{
+		return;
+	}
+	bLegacyListsDirty = false;
+
+	for (UScrollBox* List : { List_Admin, List_Reconstruct, List_Road })
+	{
+		if (List)
+		{
+			List->ClearChildren();
+		}
+	}
+
+	TMap<UGISPolyItemData*, UGISPolyItem*> Rows;
+	TArray<UGISPolyItemData*> Stack;
+	TArray<FGISFeatureHandle> Children;
+	for (UGISPolyItemData* Root : ItemsByHandle)
+	{
+		if (!Root || !FeatureStore.IsValid(Root->Handle) || Root->GetParentItem())
+		{
+			continue;
+		}
+
+		const EGISFeatureType Type = Root->GetType();
+		UScrollBox* List = Type == EGISFeatureType::Reconstruct ? List_Reconstruct : Type == EGISFeatureType::Road ? List_Road : List_Admin;
+		if (!List)
+		{
+			continue;
+		}
+
+		Stack.Reset();
+		Stack.Add(Root);
+		while (Stack.Num() > 0)
+		{
+			UGISPolyItemData* Item = Stack.Pop();
+			UGISPolyItem* Row = LegacyRows.FindRef(Item);
+			if (!Row)
+			{
+				Row = CreateWidget<UGISPolyItem>(this, PolyItemClass);
+			}
+			Row->NativeOnListItemObjectSet(Item);
+			List->AddChild(Row);
+			Rows.Add(Item, Row);
+
+			Children.Reset();
+			FeatureStore.GetChildren(Item->Handle, Children);
+			for (int32 Index = Children.Num() - 1; Index >= 0; --Index)
+			{
+				if (UGISPolyItemData* Child = GetItemByHandle(Children[Index]))
+				{
+					Stack.Add(Child);
+				}
+			}
+		}
+	}
+	LegacyRows = MoveTemp(Rows);
+}
+
+void UGISWebWidget::ClearAllLists()
+{
+	bLegacyListsDirty = true;
+	for (UTreeView* Tree : { Tree_Admin, Tree_Reconstruct, Tree_Road })
+	{
+		if (Tree)
+		{
+			Tree->ClearListItems();
+		}
+	}
+	FeatureStore.Reset();
+	ItemsByHandle.Reset();
+	ParentOptions.Reset();
+	SpatialIndex.Reset();
+	SearchIndex.Reset();
+	FilterEngine.Reset();
+	History.Reset();
+	PendingReattach.Reset();
+	SnapService.Reset();
+	bSnapServiceDirty = false;
+
+	// 进行中的构建结果作废
+	LodPyramid.Reset();
+	bLodDirty = false;
+	++LodBuildSerial;
+	TileCache->Reset();
+
+	// 换存档 (可能是另一座城市) 后按新数据重新确定局部坐标原点
+	ExtrusionFrame = FGISEnuFrame();
+	bExtrusionDirty = false;
+	++ExtrusionBuildSerial;
+
+	FeatureStats.Reset();
+	bMeasureDirty = false;
+	++MeasureSerial;
+
+	Scoring.Reset();
+	++ScoringSerial;
+
+	Roads.Reset();
+	++RoadBuildSerial;
+
+	bImportPending = false;
+	++ImportSerial;
+
+	// 点图层本身保留，等新的要素入库后重新连接
+	PointJoin.Reset();
+	Scoring.SetPointJoin(nullptr);
+	++PointJoinSerial;
+	bPointJoinDirty = PointLayer.IsValid();
+	if (CityMeshActor.IsValid())
+	{
+		CityMeshActor->ClearSections();
+	}
+}
+
+void UGISWebWidget::ProcessAddPolyItem(FString ID, FString Name, FString Type, FString ParentID, FString Color,
+                                       float Opacity, FString TextColor, FString Tag, float Height)
+{
+	// 同一 ID 重复上报时只保留第一次
+	if (FeatureStore.Find(ID).IsSet())
+	{
+		return;
+	}
+
+	// 【核心修复】自动构建父级逻辑
+	// 如果是街道(Street)且没有指定父级(None)，则尝试根据 Tag(行政区代码) 自动创建/查找父级
+	if (Type == "Street" && (ParentID == "None" || ParentID.IsEmpty()) && !Tag.IsEmpty())
+	{
+		// 构造父级ID，例如 District_310101
+		FString DistrictID = "District_" + Tag; 
+        
+		// 检查这个父级是否已经存在
+		if (!FeatureStore.Find(DistrictID).IsSet())
+		{
+			// 不存在则创建一个新的 District 节点
+			FGISFeatureStore::FAttributes District;
+
+			// 【关键修改】这里调用 GetDistrictNameByCode 获取真实中文名
+			District.Name = GetDistrictNameByCode(Tag);
+			District.Type = EGISFeatureType::District;
+			District.ParentID = TEXT("None");
+			District.FillColor = TEXT("#808080");
+
+			UGISPolyItemData* ParentItem = RegisterItem(DistrictID, District);
+			SearchIndex.Add(DistrictID, District.Name);
+			AttachItem(ParentItem, true);
+		}
+		// 将当前街道的父级ID修正为这个区ID
+		ParentID = DistrictID;
+	}
+
+	// 类型与颜色在入库时解析一次，之后列表与编辑框直接读取；颜色原文一并保存，写回页面时原样使用
+	FGISFeatureStore::FAttributes Attributes;
+	Attributes.Name = Name;
+	Attributes.Type = GISFeatureType::FromString(Type);
+	Attributes.ParentID = ParentID;
+	Attributes.FillColor = Color;
+	Attributes.Opacity = Opacity;
+	Attributes.TextColor = TextColor;
+	Attributes.Tag = Tag;
+	Attributes.Height = Height;
+
+	UGISPolyItemData* NewItem = RegisterItem(ID, Attributes);
+	SearchIndex.Add(ID, Name);
+	FilterEngine.SetFeature(ID, { Type, Tag });
+	AttachItem(NewItem, true);
+
+	// 撤销删除恢复的要素：删除时变为根的子要素挂回来
+	TArray<FString> Children;
+	if (PendingReattach.RemoveAndCopyValue(ID, Children))
+	{
+		for (const FString& ChildID : Children)
+		{
+			UGISPolyItemData* Child = FindItem(ChildID);
+			if (Child && !Child->GetParentItem() && Child->GetParentID() == ID)
+			{
+				DetachItem(Child);
+				AttachItem(Child, true);
+			}
+		}
+	}
+}
+
+void UGISWebWidget::OpenEditDialog(UGISPolyItemData* ItemToEdit)
+{
+	if (!ItemToEdit)
+	{
+		return;
+	}
+	CurrentEditingItem = ItemToEdit;
+
+	if (Edit_Input_Name)
+	{
+		Edit_Input_Name->SetText(FText::FromString(FeatureStore.GetName(ItemToEdit->Handle)));
+	}
+	if (Edit_Input_Opacity)
+	{
+		Edit_Input_Opacity->SetText(FText::AsNumber(FeatureStore.GetOpacity(ItemToEdit->Handle)));
+	}
+
+	UpdateColorUI(FLinearColor::FromSRGBColor(FeatureStore.GetFillColor(ItemToEdit->Handle)));
+	UpdateTextColorUI(FLinearColor::FromSRGBColor(FeatureStore.GetTextColor(ItemToEdit->Handle)));
+
+	// 输入框显示颜色原文 ("yellow" 等)，未改动时原样写回
+	if (Edit_Input_Color)
+	{
+		Edit_Input_Color->SetText(FText::FromString(FeatureStore.GetFillColorText(ItemToEdit->Handle)));
+	}
+	if (Edit_Input_TextColor)
+	{
+		Edit_Input_TextColor->SetText(FText::FromString(FeatureStore.GetTextColorText(ItemToEdit->Handle)));
+	}
+
+	// 【修改】打开时只放入 "无" 与当前父级，候选在展开下拉时再查询
+	if (Edit_Input_Parent)
+	{
+		Edit_Input_Parent->ClearOptions();
+		ParentOptions.Reset();
+		bParentOptionsLoaded = false;
+
+		AddParentOption(FGISFeatureHandle());
+		const FGISFeatureHandle CurrentParent = FeatureStore.Find(ItemToEdit->GetParentID());
+		AddParentOption(CurrentParent);
+		Edit_Input_Parent->SetSelectedOption(CurrentParent.IsSet() ? Edit_Input_Parent->GetOptionAtIndex(1) : FString(NoParentOption));
+	}
+	if (Edit_Parent_Search)
+	{
+		Edit_Parent_Search->SetText(FText::GetEmpty());
+	}
+
+	if (Edit_Dialog_Overlay)
+	{
+		Edit_Dialog_Overlay->SetVisibility(ESlateVisibility::Visible);
+	}
+}
+
+void UGISWebWidget::SaveEditChanges()
+{
+	if (CurrentEditingItem.IsValid() && MapBrowser)
+	{
+		UGISPolyItemData* Item = CurrentEditingItem.Get();
+		FGISHistoryChange Change;
+		Change.Op = EGISHistoryOp::Attributes;
+		Change.ID = Item->GetID();
+		Change.Before = ReadFeatureEdit(Item->Handle);
+
+		FGISFeatureEdit& Edit = Change.After;
+		Edit.Name = Edit_Input_Name->GetText().ToString();
+		Edit.Color = Edit_Input_Color->GetText().ToString();
+		Edit.Opacity = FCString::Atof(*Edit_Input_Opacity->GetText().ToString());
+		Edit.TextColor = Edit_Input_TextColor->GetText().ToString();
+
+		// 选项经句柄对应到父级；"更多" 提示等未知选项保持原父级
+		Edit.ParentID = Change.Before.ParentID;
+		if (Edit_Input_Parent)
+		{
+			if (const FGISFeatureHandle* Chosen = ParentOptions.Find(Edit_Input_Parent->GetSelectedOption()))
+			{
+				Edit.ParentID = Chosen->IsSet() ? FeatureStore.GetID(*Chosen) : FString(TEXT("None"));
+			}
+		}
+
+		ApplyFeatureEdit(Change.ID, Edit);
+
+		TArray<FGISHistoryChange> Changes;
+		Changes.Add(MoveTemp(Change));
+		History.Record(MoveTemp(Changes));
+	}
+	CloseEditDialog();
+}
+
+FGISFeatureEdit UGISWebWidget::ReadFeatureEdit(FGISFeatureHandle Handle) const
+{
+	FGISFeatureEdit Edit;
+	Edit.Name = FeatureStore.GetName(Handle);
+	Edit.Color = FeatureStore.GetFillColorText(Handle);
+	Edit.Opacity = FeatureStore.GetOpacity(Handle);
+	Edit.TextColor = FeatureStore.GetTextColorText(Handle);
+	Edit.ParentID = FeatureStore.GetParentID(Handle);
+	return Edit;
+}
+
+void UGISWebWidget::ApplyFeatureEdit(const FString& ID, const FGISFeatureEdit& Edit)
+{
+	UGISPolyItemData* Item = FindItem(ID);
+	if (!Item)
+	{
+		return;
+	}
+
+	if (Edit.ParentID != FeatureStore.GetParentID(Item->Handle))
+	{
+		DetachItem(Item);
+		FeatureStore.SetParentID(Item->Handle, Edit.ParentID);
+		AttachItem(Item, false);
+
+		// 街道换了区镇，区镇的点数随之变化
+		bPointJoinDirty |= PointLayer.IsValid() && FeatureStore.GetType(Item->Handle) == EGISFeatureType::Street;
+	}
+
+	if (MapBrowser)
+	{
+		MapBrowser->ExecuteJavascript(MakeScriptCall(TEXT("updatePolyAttributes"), { ID, Edit.Name, Edit.Color, FString::SanitizeFloat(Edit.Opacity), Edit.TextColor, Edit.ParentID }));
+	}
+
+	FeatureStore.SetName(Item->Handle, Edit.Name);
+	FeatureStore.SetStyle(Item->Handle, Edit.Color, Edit.Opacity, Edit.TextColor);
+	RefreshItemEntry(Item);
+	bExtrusionDirty = true;
+	SearchIndex.Add(ID, Edit.Name);
+}
+
+void UGISWebWidget::AddParentOption(FGISFeatureHandle Handle)
+{
+	if (Handle.IsSet() && !FeatureStore.IsValid(Handle))
+	{
+		return;
+	}
+
+	// 同名要素靠 ID 区分
+	const FString Option = Handle.IsSet() ? FString::Printf(TEXT("%s [%s]"), *FeatureStore.GetName(Handle), *FeatureStore.GetID(Handle)) : FString(NoParentOption);
+	if (!ParentOptions.Contains(Option))
+	{
+		ParentOptions.Add(Option, Handle);
+		Edit_Input_Parent->AddOption(Option);
+	}
+}
+
+void UGISWebWidget::PopulateParentPicker(const FString& Filter)
+{
+	UGISPolyItemData* Item = CurrentEditingItem.Get();
+	if (!Edit_Input_Parent || !Item)
+	{
+		return;
+	}
+
+	// 保留当前选中项，即使它不在筛选结果中
+	const FString Selected = Edit_Input_Parent->GetSelectedOption();
+	const FGISFeatureHandle* SelectedHandle = ParentOptions.Find(Selected);
+	const FGISFeatureHandle Keep = SelectedHandle ? *SelectedHandle : FGISFeatureHandle();
+
+	Edit_Input_Parent->ClearOptions();
+	ParentOptions.Reset();
+	AddParentOption(FGISFeatureHandle());
+	AddParentOption(Keep);
+
+	EGISFeatureType ParentType;
+	if (GISFeatureType::GetParentType(Item->GetType(), ParentType))
+	{
+		TArray<FGISFeatureHandle> Candidates;
+		const bool bMore = FeatureStore.QueryType(ParentType, Filter, 0, ParentPickerPageSize, Candidates);
+		for (const FGISFeatureHandle Candidate : Candidates)
+		{
+			if (Candidate != Item->Handle)
+			{
+				AddParentOption(Candidate);
+			}
+		}
+		if (bMore)
+		{
+			Edit_Input_Parent->AddOption(MoreParentsOption);
+		}
+	}
+
+	Edit_Input_Parent->SetSelectedOption(ParentOptions.Contains(Selected) ? Selected : FString(NoParentOption));
+	bParentOptionsLoaded = true;
+}
+
+void UGISWebWidget::OnParentPickerOpening()
+{
+	if (!bParentOptionsLoaded)
+	{
+		PopulateParentPicker(Edit_Parent_Search ? Edit_Parent_Search->GetText().ToString() : FString());
+	}
+}
+
+void UGISWebWidget::OnParentSearchChanged(const FText& Text)
+{
+	PopulateParentPicker(Text.ToString().TrimStartAndEnd());
+}
+
+void UGISWebWidget::CloseEditDialog()
+{
+	if (Edit_Dialog_Overlay)
+	{
+		Edit_Dialog_Overlay->SetVisibility(ESlateVisibility::Collapsed);
+	}
+	CurrentEditingItem = nullptr;
+}
+
+void UGISWebWidget::OnColorSliderChanged(float Value)
+{
+	if (Slider_R && Slider_G && Slider_B)
+	{
+		FLinearColor NewColor(Slider_R->GetValue(), Slider_G->GetValue(), Slider_B->GetValue());
+		if (Color_Preview)
+		{
+			Color_Preview->SetBrushColor(NewColor);
+		}
+		if (Edit_Input_Color)
+		{
+			Edit_Input_Color->SetText(FText::FromString("#" + NewColor.ToFColor(true).ToHex()));
+		}
+	}
+}
+
+void UGISWebWidget::OnTextColorSliderChanged(float Value)
+{
+	if (Slider_Text_R && Slider_Text_G && Slider_Text_B)
+	{
+		FLinearColor NewColor(Slider_Text_R->GetValue(), Slider_Text_G->GetValue(), Slider_Text_B->GetValue());
+		if (TextColor_Preview)
+		{
+			TextColor_Preview->SetBrushColor(NewColor);
+		}
+		if (Edit_Input_TextColor)
+		{
+			Edit_Input_TextColor->SetText(FText::FromString("#" + NewColor.ToFColor(true).ToHex()));
+		}
+	}
+}
+
+void UGISWebWidget::OnPresetColorClicked(FLinearColor NewColor)
+{
+	UpdateColorUI(NewColor);
+}
+
+void UGISWebWidget::UpdateColorUI(FLinearColor Color)
+{
+	if (Slider_R) Slider_R->SetValue(Color.R);
+	if (Slider_G) Slider_G->SetValue(Color.G);
+	if (Slider_B) Slider_B->SetValue(Color.B);
+	if (Color_Preview) Color_Preview->SetBrushColor(Color);
+	if (Edit_Input_Color) Edit_Input_Color->SetText(FText::FromString("#" + Color.ToFColor(true).ToHex()));
+}
+
+void UGISWebWidget::UpdateTextColorUI(FLinearColor Color)
+{
+	if (Slider_Text_R) Slider_Text_R->SetValue(Color.R);
 	if (Slider_Text_G) Slider_Text_G->SetValue(Color.G);
 	if (Slider_Text_B) Slider_Text_B->SetValue(Color.B);
 	if (TextColor_Preview) TextColor_Preview->SetBrushColor(Color);
 	if (Edit_Input_TextColor) Edit_Input_TextColor->SetText(FText::FromString("#" + Color.ToFColor(true).ToHex()));
 }
 
-FString UGISWebWidget::GetDistrictNameByCode(const FString& Code)
+FString UGISWebWidget::GetDistrictNameByCode(const FString& Code)
+{
+	if (DistrictNameMap.Contains(Code))
+	{
+		return DistrictNameMap[Code];
+	}
+	return FString::Printf(TEXT("行政区_%s"), *Code); // 兜底显示
+}
+
+void UGISWebWidget::SetMode(FString ModeName)
+{
+	if (MapBrowser)
+	{
+		MapBrowser->ExecuteJavascript(FString::Printf(TEXT("setMode('%s');"), *ModeName));
+	}
+}
+
+void UGISWebWidget::FocusID(FString ID)
+{
+	if (MapBrowser)
+	{
+		MapBrowser->ExecuteJavascript(MakeScriptCall(TEXT("focusPoly"), { ID }));
+	}
+}
+
+void UGISWebWidget::DeleteID(FString ID)
+{
+	// 要素文本由页面删除时上报，之后才可撤销
+	FGISHistoryChange Change;
+	Change.Op = EGISHistoryOp::Delete;
+	Change.ID = ID;
+	if (RemoveFeature(ID, &Change.Children))
+	{
+		TArray<FGISHistoryChange> Changes;
+		Changes.Add(MoveTemp(Change));
+		History.Record(MoveTemp(Changes));
+	}
+}
+
+bool UGISWebWidget::RemoveFeature(const FString& ID, TArray<FString>* OutOrphanIDs)
+{
+	// 类型要在从存储中移除之前取出
+	const bool bJoinTarget = PointLayer.IsValid() && IsPointJoinTarget(ID);
+	if (MapBrowser)
+	{
+		MapBrowser->ExecuteJavascript(MakeScriptCall(TEXT("deletePoly"), { ID }));
+	}
+	UGISPolyItemData* Item = FindItem(ID);
+	if (Item)
+	{
+		DetachItem(Item);
+
+		// 子节点原父级已不存在，挂回根列表
+		TArray<FGISFeatureHandle> Orphans;
+		const int32 Slot = Item->Handle.Index;
+		FeatureStats.Remove(Item->Handle);
+		FeatureStore.Remove(Item->Handle, &Orphans);
+		ItemsByHandle[Slot] = nullptr;
+		for (const FGISFeatureHandle Orphan : Orphans)
+		{
+			if (UGISPolyItemData* Child = GetItemByHandle(Orphan))
+			{
+				AttachItem(Child, true);
+				if (OutOrphanIDs)
+				{
+					OutOrphanIDs->Add(Child->GetID());
+				}
+			}
+		}
+	}
+	SearchIndex.Remove(ID);
+	FilterEngine.RemoveFeature(ID);
+	if (SpatialIndex.Remove(ID))
+	{
+		bSnapServiceDirty = true;
+		bLodDirty = true;
+		bExtrusionDirty = true;
+		Scoring.MarkFeatureChanged(ID);
+		bPointJoinDirty |= bJoinTarget;
+	}
+	Roads.Remove(ID);
+	return Item != nullptr;
+}
+
+void UGISWebWidget::RestoreFeature(const FGISHistoryChange& Change)
+{
+	if (!MapBrowser || !Change.Feature.IsValid())
+	{
+		return;
+	}
+
+	// 页面按原 id 重建后经正常的上报路径回到列表与索引，届时再挂回子要素
+	if (Change.Children.Num() > 0)
+	{
+		PendingReattach.Add(Change.ID, Change.Children);
+	}
+	// 要素文本本身就是合法的 JS 字面量
+	MapBrowser->ExecuteJavascript(TEXT("restorePoly(") + *Change.Feature + TEXT(");"));
+}
+
+void UGISWebWidget::ApplyHistory(const FGISHistoryCommand& Command, bool bUndo)
+{
+	const int32 Count = Command.Changes.Num();
+	for (int32 Step = 0; Step < Count; ++Step)
+	{
+		// 撤销逆序应用
+		const FGISHistoryChange& Change = Command.Changes[bUndo ? Count - 1 - Step : Step];
+		switch (Change.Op)
+		{
+		case EGISHistoryOp::Attributes:
+			ApplyFeatureEdit(Change.ID, bUndo ? Change.Before : Change.After);
+			break;
+		case EGISHistoryOp::Create:
+			if (bUndo)
+			{
+				RemoveFeature(Change.ID);
+			}
+			else
+			{
+				RestoreFeature(Change);
+			}
+			break;
+		case EGISHistoryOp::Delete:
+			if (bUndo)
+			{
+				RestoreFeature(Change);
+			}
+			else
+			{
+				RemoveFeature(Change.ID);
+			}
+			break;
+		}
+	}
+}
+
+void UGISWebWidget::Undo()
+{
+	if (const FGISHistoryCommand* Command = History.Undo())
+	{
+		ApplyHistory(*Command, true);
+	}
+}
+
+void UGISWebWidget::Redo()
+{
+	if (const FGISHistoryCommand* Command = History.Redo())
+	{
+		ApplyHistory(*Command, false);
+	}
+}
+
+void UGISWebWidget::HandleUndo(const FString& Payload)
+{
+	Undo();
+}
+
+void UGISWebWidget::HandleRedo(const FString& Payload)
+{
+	Redo();
+}
+
+void UGISWebWidget::FilterByType(FString TypeName)
+{
+	const bool bShowAll = TypeName.IsEmpty() || TypeName == TEXT("All");
+	FilterEngine.SetAllKeysActive(bShowAll);
+	if (!bShowAll)
+	{
+		FilterEngine.SetKeyActive(TypeName, true);
+	}
+	PushFilterKeys();
+}
+
+void UGISWebWidget::SetFilterKeyActive(FString Key, bool bActive)
+{
+	FilterEngine.SetKeyActive(Key, bActive);
+	PushFilterKeys();
+}
+
+void UGISWebWidget::HandleFilter(const FString& Payload)
+{
+	// 载荷：{keys:[...], active:bool} 或 {all:bool}；面板自己已更新勾选状态，不回推
+	TSharedPtr<FJsonObject> Json;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload);
+	if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
+	{
+		UE_LOG(LogGISWebWidget, Warning, TEXT("无法解析筛选请求"));
+		return;
+	}
+
+	bool bAll = false;
+	if (Json->TryGetBoolField(TEXT("all"), bAll))
+	{
+		FilterEngine.SetAllKeysActive(bAll);
+		return;
+	}
+
+	TArray<FString> Keys;
+	const bool bActive = Json->GetBoolField(TEXT("active"));
+	if (Json->TryGetStringArrayField(TEXT("keys"), Keys))
+	{
+		for (const FString& Key : Keys)
+		{
+			FilterEngine.SetKeyActive(Key, bActive);
+		}
+	}
+}
+
+void UGISWebWidget::TickFilter()
+{
+	if (!MapBrowser || !FilterEngine.HasChanges())
+	{
+		return;
+	}
+
+	TArray<FString> Shown;
+	TArray<FString> Hidden;
+	FilterEngine.ConsumeChanges(Shown, Hidden);
+	if (Shown.Num() == 0 && Hidden.Num() == 0)
+	{
+		return;
+	}
+
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("show"), Shown);
+	Writer->WriteValue(TEXT("hide"), Hidden);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	MapBrowser->ExecuteJavascript(TEXT("applyFilterDelta(") + Output + TEXT(");"));
+}
+
+void UGISWebWidget::PushFilterKeys()
+{
+	if (!MapBrowser)
+	{
+		return;
+	}
+
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	Writer->WriteArrayStart();
+	for (const FString& Key : FilterEngine.GetActiveKeys())
+	{
+		Writer->WriteValue(Key);
+	}
+	Writer->WriteArrayEnd();
+	Writer->Close();
+
+	MapBrowser->ExecuteJavascript(TEXT("syncFilterUI(") + Output + TEXT(");"));
+}
+
+void UGISWebWidget::LoadMap(FString FileName)
 {
-	if (DistrictNameMap.Contains(Code))
+	/* Legacy */
+}
+
+TArray<FString> UGISWebWidget::GetSaveFiles() { return TArray<FString>(); }
+
+void UGISWebWidget::SaveMapAs(FString FileName)
+{
+	/* Legacy */
+}
+
+bool UGISWebWidget::ImportCSV(FString CsvPath, EGISCoordSystem SourceCoords)
+{
+	if (FPaths::IsRelative(CsvPath))
 	{
-		return DistrictNameMap[Code];
+		CsvPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir() + TEXT("HTML/"), CsvPath);
 	}
-	return FString::Printf(TEXT("行政区_%s"), *Code); // 兜底显示
+	if (!FPaths::FileExists(CsvPath))
+	{
+		UE_LOG(LogGISWebWidget, Warning, TEXT("街道 CSV 不存在: %s"), *CsvPath);
+		return false;
+	}
+
+	const FString SaveDir = FGISSaveIndex::GetSaveFolder();
+	IFileManager::Get().MakeDirectory(*SaveDir, true);
+	const FString OutputPath = SaveDir + FString::Printf(
+		TEXT("Save_%s_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), *FGuid::NewGuid().ToString());
+
+	FGISCsvImportOptions Options;
+	Options.SourceCoords = SourceCoords;
+	Options.SaveName = FPaths::GetBaseFilename(CsvPath);
+
+	// 解析与写出存档都在线程池中进行，完成后在游戏线程载入
+	const int32 Serial = ++CsvImportSerial;
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, CsvPath, OutputPath, Options]()
+	{
+		const FGISCsvImportResult Result = FGISCsvImporter::Import(CsvPath, OutputPath, Options);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, OutputPath, Result]()
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget || Serial != Widget->CsvImportSerial)
+			{
+				return;
+			}
+			if (!Result.bSuccess)
+			{
+				if (Widget->MapBrowser)
+				{
+					Widget->MapBrowser->ExecuteJavascript(FString::Printf(TEXT("alert('%s');"), *Result.Error.ReplaceCharWithEscapedChar()));
+				}
+				return;
+			}
+			Widget->ExecuteLoadFromFile(OutputPath);
+		});
+	});
+	return true;
 }
 
-void UGISWebWidget::SetMode(FString ModeName)
+void UGISWebWidget::RequestSaveDataFromWeb()
 {
 	if (MapBrowser)
 	{
-		MapBrowser->ExecuteJavascript(FString::Printf(TEXT("setMode('%s');"), *ModeName));
+		MapBrowser->ExecuteJavascript(TEXT("requestAllDataForSave();"));
 	}
 }
 
-void UGISWebWidget::FocusID(FString ID)
+void UGISWebWidget::SaveCurrentMap()
 {
-	if (MapBrowser)
+	if (EditJournal.HasDocument())
+	{
+		AutosaveElapsed = 0.0f;
+		FlushEditJournal();
+	}
+	else
 	{
-		MapBrowser->ExecuteJavascript(FString::Printf(TEXT("focusPoly('%s');"), *ID));
+		RequestSaveDataFromWeb();
 	}
 }
 
-void UGISWebWidget::DeleteID(FString ID)
+void UGISWebWidget::HandleEdits(const FString& Payload)
 {
-	if (MapBrowser)
+	// 载荷：[{op:"put"|"del", id, feature:"<Feature JSON 文本>", created}]，要素文本原样入日志，不再解析
+	// 页面新建的要素 (created) 作为一条撤销记录；删除时附带的要素文本交给撤销历史，日志不需要
+	TArray<FGISHistoryChange> Created;
+	TArray<TSharedPtr<FJsonValue>> Edits;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload);
+	if (!FJsonSerializer::Deserialize(Reader, Edits))
 	{
-		MapBrowser->ExecuteJavascript(FString::Printf(TEXT("deletePoly('%s');"), *ID));
+		UE_LOG(LogGISWebWidget, Warning, TEXT("无法解析编辑记录"));
+		return;
 	}
-	if (UGISPolyItem** Item = WidgetMap.Find(ID))
+
+	for (const TSharedPtr<FJsonValue>& Value : Edits)
 	{
-		if (*Item)
+		const TSharedPtr<FJsonObject>* Edit = nullptr;
+		FString Op;
+		FString ID;
+		if (!Value.IsValid() || !Value->TryGetObject(Edit) || !(*Edit)->TryGetStringField(TEXT("op"), Op) || !(*Edit)->TryGetStringField(TEXT("id"), ID))
+		{
+			continue;
+		}
+
+		FString FeatureJson;
+		(*Edit)->TryGetStringField(TEXT("feature"), FeatureJson);
+		if (Op == TEXT("del"))
+		{
+			EditJournal.Delete(ID);
+			History.SetDeletedFeature(ID, MoveTemp(FeatureJson));
+		}
+		else if (!FeatureJson.IsEmpty())
 		{
-			(*Item)->RemoveFromParent();
+			bool bCreated = false;
+			if ((*Edit)->TryGetBoolField(TEXT("created"), bCreated) && bCreated)
+			{
+				FGISHistoryChange& Change = Created.AddDefaulted_GetRef();
+				Change.Op = EGISHistoryOp::Create;
+				Change.ID = ID;
+			}
+			EditJournal.Put(ID, MoveTemp(FeatureJson));
 		}
-		WidgetMap.Remove(ID);
 	}
+	History.Record(MoveTemp(Created));
 }
 
-void UGISWebWidget::FilterByType(FString TypeName)
+void UGISWebWidget::TickAutosave(float DeltaTime)
 {
-	if (MapBrowser)
+	if (AutosaveIntervalSeconds <= 0.0f || !EditJournal.HasPending())
+	{
+		AutosaveElapsed = 0.0f;
+		return;
+	}
+
+	// 从第一条未保存的编辑开始计时
+	AutosaveElapsed += DeltaTime;
+	if (AutosaveElapsed >= AutosaveIntervalSeconds)
 	{
-		MapBrowser->ExecuteJavascript(FString::Printf(TEXT("filterPolys('%s');"), *TypeName));
+		AutosaveElapsed = 0.0f;
+		FlushEditJournal();
 	}
 }
 
-void UGISWebWidget::LoadMap(FString FileName)
+void UGISWebWidget::FlushEditJournal()
 {
-	/* Legacy */
-}
+	// 上一次写盘未完成时只做标记，完成后立即再写一次，保证同一日志不会并发写入
+	if (EditFlushFuture.IsValid())
+	{
+		bEditFlushQueued = true;
+		return;
+	}
 
-TArray<FString> UGISWebWidget::GetSaveFiles() { return TArray<FString>(); }
+	TArray<FGISEditBatch> Batches = EditJournal.TakeBatches(JournalCompactRecords);
+	if (Batches.Num() == 0)
+	{
+		return;
+	}
 
-void UGISWebWidget::SaveMapAs(FString FileName)
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	EditFlushFuture = Async(EAsyncExecution::ThreadPool, [WeakThis, Batches = MoveTemp(Batches), bCompress = bCompressSaves]() mutable
+	{
+		TArray<bool> Results;
+		TArray<FGISSaveMetadata> Compacted;
+		Results.SetNum(Batches.Num());
+		Compacted.SetNum(Batches.Num());
+		for (int32 Index = 0; Index < Batches.Num(); ++Index)
+		{
+			Results[Index] = WriteEditBatch(Batches[Index], bCompress, Compacted[Index]);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Batches = MoveTemp(Batches), Results = MoveTemp(Results), Compacted = MoveTemp(Compacted)]()
+		{
+			UGISWebWidget* Widget = WeakThis.Get();
+			if (!Widget)
+			{
+				return;
+			}
+
+			Widget->EditFlushFuture.Reset();
+			for (int32 Index = 0; Index < Batches.Num(); ++Index)
+			{
+				const FString& NewSnapshotPath = Compacted[Index].FilePath;
+				Widget->EditJournal.OnBatchWritten(Batches[Index], Results[Index], NewSnapshotPath);
+				if (!NewSnapshotPath.IsEmpty())
+				{
+					Widget->SaveIndex.Update(Compacted[Index]);
+				}
+			}
+
+			if (Widget->bEditFlushQueued)
+			{
+				Widget->bEditFlushQueued = false;
+				Widget->FlushEditJournal();
+			}
+		});
+	});
+}
+
+bool UGISWebWidget::WriteEditBatch(const FGISEditBatch& Batch, bool bCompress, FGISSaveMetadata& OutCompacted)
 {
-	/* Legacy */
+	if (Batch.bCompact)
+	{
+		if (CompactSnapshot(Batch.SnapshotPath, Batch.Records, bCompress, OutCompacted))
+		{
+			return true;
+		}
+		// 压实失败时退回追加，保证本次编辑不丢
+		UE_LOG(LogGISWebWidget, Warning, TEXT("压实存档失败，改为追加编辑日志: %s"), *Batch.SnapshotPath);
+		OutCompacted = FGISSaveMetadata();
+	}
+	return FGISEditJournal::Append(FGISEditJournal::GetJournalPath(Batch.SnapshotPath), Batch.Records);
 }
 
-void UGISWebWidget::RequestSaveDataFromWeb()
+bool UGISWebWidget::CompactSnapshot(const FString& SnapshotPath, const TArray<FGISEditRecord>& Records, bool bCompress, FGISSaveMetadata& OutMeta)
 {
-	if (MapBrowser)
+	// 快照 + 已有日志 + 本批记录，合并后整体写成 .gisb
+	FString Features;
+	FString Merged;
+	if (!ReadSaveFeatures(SnapshotPath, OutMeta, Features) || !FGISEditJournal::Apply(Features, Records, Merged))
 	{
-		MapBrowser->ExecuteJavascript(TEXT("requestAllDataForSave();"));
+		return false;
 	}
+
+	FGISSaveHeader Header;
+	Header.ID = OutMeta.ID;
+	Header.Name = OutMeta.Name;
+	Header.Description = OutMeta.Description;
+	Header.Date = OutMeta.Date;
+
+	// 先写临时文件再替换，替换前崩溃不影响旧快照
+	const FString NewPath = FPaths::ChangeExtension(SnapshotPath, FGISBinarySave::Extension);
+	const FString TempPath = NewPath + TEXT(".tmp");
+	if (!FGISBinarySave::Save(TempPath, Merged, Header, bCompress) || !IFileManager::Get().Move(*NewPath, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	// 新快照已包含日志的全部内容；若在删除日志前崩溃，重放旧日志结果不变
+	if (NewPath != SnapshotPath)
+	{
+		IFileManager::Get().Delete(*SnapshotPath, false, false, true);
+	}
+	IFileManager::Get().Delete(*FGISEditJournal::GetJournalPath(SnapshotPath), false, false, true);
+
+	OutMeta.FilePath = NewPath;
+	return true;
 }
 
 void UGISWebWidget::OpenLoadDialog()
@@ -507,16 +2576,116 @@ void UGISWebWidget::OpenLoadDialog()
 	}
 }
 
+TSharedRef<FGISFileTask> UGISWebWidget::BeginFileTask(EGISFileTaskType Type)
+{
+	CancelFileTask();
+
+	TSharedRef<FGISFileTask> Task = MakeShared<FGISFileTask>(Type);
+	CurrentFileTask = Task;
+	LastFileProgress = -1.0f;
+	return Task;
+}
+
+void UGISWebWidget::CancelFileTask()
+{
+	if (!CurrentFileTask.IsValid())
+	{
+		return;
+	}
+
+	// 工作线程在下一个检查点退出，结果回到游戏线程时因任务已不是当前任务而被丢弃
+	TSharedPtr<FGISFileTask> Task = MoveTemp(CurrentFileTask);
+	Task->Cancel();
+	BroadcastFileCompleted(Task->Type, false, CurrentFilePath);
+}
+
+void UGISWebWidget::BroadcastFileCompleted(EGISFileTaskType Type, bool bSuccess, const FString& FilePath)
+{
+	if (Type == EGISFileTaskType::Save)
+	{
+		OnSaveCompleted.Broadcast(bSuccess, FilePath);
+	}
+	else
+	{
+		OnLoadCompleted.Broadcast(bSuccess, FilePath);
+	}
+}
+
+void UGISWebWidget::TickFileTaskProgress()
+{
+	if (!CurrentFileTask.IsValid())
+	{
+		return;
+	}
+
+	const float Progress = CurrentFileTask->GetProgress();
+	if (Progress != LastFileProgress)
+	{
+		LastFileProgress = Progress;
+		OnFileProgress.Broadcast(Progress);
+	}
+}
+
 void UGISWebWidget::ExecuteSaveToFile(FString GeoJsonData, FString SaveName, FString SaveDesc)
 {
-	TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
 	FString NewGuid = FGuid::NewGuid().ToString();
-	FString NowTime = FDateTime::Now().ToString(TEXT("%Y-%m-%d %H:%M:%S"));
+	FString BasePath = FGISSaveIndex::GetSaveFolder() + FString::Printf(
+		TEXT("Save_%s_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), *NewGuid);
+
+	// 扩展名由工作线程按实际写出的格式补全
+	FGISSaveMetadata Meta;
+	Meta.ID = NewGuid;
+	Meta.Name = SaveName;
+	Meta.Description = SaveDesc;
+	Meta.Date = FDateTime::Now().ToString(TEXT("%Y-%m-%d %H:%M:%S"));
+	Meta.FilePath = BasePath;
+
+	TSharedRef<FGISFileTask> Task = BeginFileTask(EGISFileTaskType::Save);
+	CurrentFilePath = BasePath;
+
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Task, Meta, bBinary = bBinarySaves, bCompress = bCompressSaves, GeoJsonData = MoveTemp(GeoJsonData)]() mutable
+	{
+		const bool bSaved = WriteSaveFile(GeoJsonData, Meta, bBinary, bCompress, *Task);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Task, bSaved, Meta = MoveTemp(Meta)]()
+		{
+			if (UGISWebWidget* Widget = WeakThis.Get())
+			{
+				Widget->FinishSave(Task, bSaved, Meta);
+			}
+		});
+	});
+}
+
+bool UGISWebWidget::WriteSaveFile(const FString& GeoJsonData, FGISSaveMetadata& InOutMeta, bool bBinary, bool bCompress, FGISFileTask& Task)
+{
+	const FString BasePath = InOutMeta.FilePath;
 
-	RootObject->SetStringField("id", NewGuid);
-	RootObject->SetStringField("name", SaveName);
-	RootObject->SetStringField("desc", SaveDesc);
-	RootObject->SetStringField("date", NowTime);
+	if (bBinary)
+	{
+		FGISSaveHeader Header;
+		Header.ID = InOutMeta.ID;
+		Header.Name = InOutMeta.Name;
+		Header.Description = InOutMeta.Description;
+		Header.Date = InOutMeta.Date;
+		InOutMeta.FilePath = BasePath + FGISBinarySave::Extension;
+		if (FGISBinarySave::Save(InOutMeta.FilePath, GeoJsonData, Header, bCompress, Task.MakeProgressCallback()))
+		{
+			return true;
+		}
+		if (Task.IsCancelled())
+		{
+			return false;
+		}
+		// 数据无法解析为要素数组时退回 JSON，原文保存在 raw_data 中
+	}
+
+	TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+	RootObject->SetStringField("id", InOutMeta.ID);
+	RootObject->SetStringField("name", InOutMeta.Name);
+	RootObject->SetStringField("desc", InOutMeta.Description);
+	RootObject->SetStringField("date", InOutMeta.Date);
 
 	TSharedPtr<FJsonValue> GeoJsonValue;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(GeoJsonData);
@@ -530,58 +2699,252 @@ void UGISWebWidget::ExecuteSaveToFile(FString GeoJsonData, FString SaveName, FSt
 		RootObject->SetStringField("raw_data", GeoJsonData);
 	}
 
+	if (!Task.ReportProgress(0.5f))
+	{
+		return false;
+	}
+
 	FString OutputString;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
 
-	FString FullPath = FPaths::ProjectSavedDir() + TEXT("GISData/") + FString::Printf(
-		TEXT("Save_%s_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), *NewGuid);
-	FFileHelper::SaveStringToFile(OutputString, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	if (!Task.ReportProgress(0.9f))
+	{
+		return false;
+	}
+
+	InOutMeta.FilePath = BasePath + TEXT(".json");
+	return FFileHelper::SaveStringToFile(OutputString, *InOutMeta.FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
 }
 
-void UGISWebWidget::ExecuteLoadFromFile(FString FilePath)
+void UGISWebWidget::FinishSave(const TSharedRef<FGISFileTask>& Task, bool bSaved, const FGISSaveMetadata& Meta)
+{
+	// 即使任务已被取代，已经落盘的文件也要登记
+	if (bSaved)
+	{
+		SaveIndex.Update(Meta);
+	}
+
+	if (CurrentFileTask.Get() != &Task.Get())
+	{
+		return;
+	}
+	CurrentFileTask.Reset();
+	if (bSaved)
+	{
+		// 之后的编辑追加到新存档的日志
+		EditJournal.Rebase(Meta.FilePath);
+		TileCache->Open(Meta.FilePath);
+		OnFileProgress.Broadcast(1.0f);
+	}
+	BroadcastFileCompleted(EGISFileTaskType::Save, bSaved, Meta.FilePath);
+}
+
+namespace
+{
+	// 把快照之后的编辑日志重放到要素数组文本上
+	bool ApplyJournal(const FString& SnapshotPath, FString& InOutFeaturesJson, FGISJournalState* OutJournal)
+	{
+		TArray<FGISEditRecord> Records;
+		FGISJournalState State;
+		if (!FGISEditJournal::Read(FGISEditJournal::GetJournalPath(SnapshotPath), Records, State))
+		{
+			return false;
+		}
+		if (OutJournal)
+		{
+			*OutJournal = State;
+		}
+		if (Records.Num() == 0)
+		{
+			return true;
+		}
+
+		FString Merged;
+		if (!FGISEditJournal::Apply(InOutFeaturesJson, Records, Merged))
+		{
+			return false;
+		}
+		InOutFeaturesJson = MoveTemp(Merged);
+		return true;
+	}
+}
+
+bool UGISWebWidget::ReadSaveFeatures(const FString& FilePath, FGISSaveMetadata& OutMeta, FString& OutFeaturesJson, const FGISSaveProgress& Progress, FGISJournalState* OutJournal)
 {
+	OutMeta.FilePath = FilePath;
+
+	// 二进制存档：一次读盘，直接解码为要素数组文本
+	if (FGISBinarySave::IsBinarySave(FilePath))
+	{
+		FGISSaveHeader Header;
+		if (!FGISBinarySave::Load(FilePath, Header, OutFeaturesJson, Progress))
+		{
+			return false;
+		}
+		OutMeta.ID = Header.ID;
+		OutMeta.Name = Header.Name;
+		OutMeta.Description = Header.Description;
+		OutMeta.Date = Header.Date;
+		return ApplyJournal(FilePath, OutFeaturesJson, OutJournal);
+	}
+
 	FString FileContent;
-	if (FFileHelper::LoadFileToString(FileContent, *FilePath))
+	if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+	{
+		return false;
+	}
+	if (Progress && !Progress(0.3f))
 	{
-		TSharedPtr<FJsonObject> JsonObj;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContent);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObj;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContent);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObj))
+	{
+		return false;
+	}
+	if (Progress && !Progress(0.7f))
+	{
+		return false;
+	}
 
-		if (FJsonSerializer::Deserialize(Reader, JsonObj))
+	JsonObj->TryGetStringField(TEXT("id"), OutMeta.ID);
+	JsonObj->TryGetStringField(TEXT("name"), OutMeta.Name);
+	JsonObj->TryGetStringField(TEXT("desc"), OutMeta.Description);
+	JsonObj->TryGetStringField(TEXT("date"), OutMeta.Date);
+
+	OutFeaturesJson.Reset();
+	if (JsonObj->HasField("data"))
+	{
+		const TSharedPtr<FJsonValue>& DataVal = JsonObj->GetField<EJson::None>("data");
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutFeaturesJson);
+		FJsonSerializer::Serialize(DataVal, "", Writer);
+	}
+	else if (JsonObj->HasField("raw_data"))
+	{
+		// raw_data 是保存时无法解析的原文，不能直接当作要素数组交给页面或拼进导出的 JSON；
+		// 只有它本身能解析为数组时才按规范 JSON 重新写出，否则拒绝读取
+		TArray<TSharedPtr<FJsonValue>> RawFeatures;
+		TSharedRef<TJsonReader<>> RawReader = TJsonReaderFactory<>::Create(JsonObj->GetStringField("raw_data"));
+		if (!FJsonSerializer::Deserialize(RawReader, RawFeatures))
 		{
-			FString MapDataStr;
-			if (JsonObj->HasField("data"))
-			{
-				const TSharedPtr<FJsonValue>& DataVal = JsonObj->GetField<EJson::None>("data");
-				TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&MapDataStr);
-				FJsonSerializer::Serialize(DataVal, "", Writer);
-			}
-			else if (JsonObj->HasField("raw_data"))
-			{
-				MapDataStr = JsonObj->GetStringField("raw_data");
-			}
+			UE_LOG(LogGISWebWidget, Warning, TEXT("存档 %s 的 raw_data 不是要素数组，无法读取"), *FilePath);
+			return false;
+		}
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutFeaturesJson);
+		FJsonSerializer::Serialize(RawFeatures, Writer);
+	}
+	return ApplyJournal(FilePath, OutFeaturesJson, OutJournal);
+}
 
-			if (List_Admin)
-			{
-				List_Admin->ClearChildren();
-			}
-			if (List_Reconstruct)
+void UGISWebWidget::HandleImportDone(const FString& Payload)
+{
+	// 较早的读档被新的取代时，其回报不解除新读档的等待
+	if (bImportPending && FCString::Atoi(*Payload) == ImportSerial)
+	{
+		bImportPending = false;
+	}
+}
+
+void UGISWebWidget::ExecuteLoadFromFile(FString FilePath)
+{
+	TSharedRef<FGISFileTask> Task = BeginFileTask(EGISFileTaskType::Load);
+	CurrentFilePath = FilePath;
+
+	TWeakObjectPtr<UGISWebWidget> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Task, FilePath]()
+	{
+		FGISSaveMetadata Meta;
+		FString MapDataStr;
+		FGISJournalState Journal;
+		bool bLoaded = ReadSaveFeatures(FilePath, Meta, MapDataStr, Task->MakeProgressCallback(), &Journal);
+
+		// 页面按 UTF-8 字节读取，转码也放在工作线程
+		TArray<uint8> MapData;
+		if (bLoaded)
+		{
+			if (MapDataStr.IsEmpty())
 			{
-				List_Reconstruct->ClearChildren();
+				MapDataStr = TEXT("[]");
 			}
-			if (List_Road)
+			FTCHARToUTF8 Utf8(*MapDataStr, MapDataStr.Len());
+			MapData.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Task, bLoaded, FilePath, MapData = MoveTemp(MapData), Journal]() mutable
+		{
+			if (UGISWebWidget* Widget = WeakThis.Get())
 			{
-				List_Road->ClearChildren();
+				Widget->FinishLoad(Task, bLoaded, FilePath, MoveTemp(MapData), Journal);
 			}
+		});
+	});
+}
+
+void UGISWebWidget::FinishLoad(const TSharedRef<FGISFileTask>& Task, bool bLoaded, const FString& FilePath, TArray<uint8> MapData, const FGISJournalState& Journal)
+{
+	if (CurrentFileTask.Get() != &Task.Get())
+	{
+		return;
+	}
+	CurrentFileTask.Reset();
+
+	if (bLoaded)
+	{
+		ClearAllLists();
+		PendingFeatures.Reset();
+		PendingFeatureHead = 0;
 
-			WidgetMap.Empty();
-			LastProcessedID = "";
+		// 之后的编辑记入该存档的日志；日志尾部损坏时下次保存先压实
+		EditJournal.Open(FilePath, Journal);
+		TileCache->Open(FilePath);
 
-			MapDataStr = MapDataStr.Replace(TEXT("\n"), TEXT("")).Replace(TEXT("\r"), TEXT(""));
-			if (MapBrowser)
+		if (MapBrowser)
+		{
+			// 页面导入完最后一块后带着序号回报 IMPORT_DONE
+			bImportPending = true;
+			const int32 Serial = ++ImportSerial;
+			if (ResourceServer.IsRegistered())
+			{
+				// 页面 fetch 后直接 JSON 解析，数据不进入脚本源码
+				const FString Url = ResourceServer.Publish(TEXT("features"), MoveTemp(MapData));
+				MapBrowser->ExecuteJavascript(FString::Printf(TEXT("importMapFromUrl('%s', %d);"), *Url, Serial));
+			}
+			else
 			{
-				MapBrowser->ExecuteJavascript(TEXT("importMap('") + MapDataStr + TEXT("');"));
+				// 没有 CEF 资源通道时退回脚本字面量 (要素数组本身就是合法的 JS 字面量)
+				FUTF8ToTCHAR MapDataStr(reinterpret_cast<const ANSICHAR*>(MapData.GetData()), MapData.Num());
+				MapBrowser->ExecuteJavascript(TEXT("importMap(") + FString(MapDataStr.Length(), MapDataStr.Get()) + FString::Printf(TEXT(", %d);"), Serial));
 			}
 		}
+		OnFileProgress.Broadcast(1.0f);
+	}
+	BroadcastFileCompleted(EGISFileTaskType::Load, bLoaded, FilePath);
+}
+
+bool UGISWebWidget::ExportSaveAsJson(FString FilePath, FString OutputPath)
+{
+	FGISSaveMetadata Meta;
+	FString MapDataStr;
+	if (!ReadSaveFeatures(FilePath, Meta, MapDataStr))
+	{
+		return false;
 	}
+
+	TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+	RootObject->SetStringField("id", Meta.ID);
+	RootObject->SetStringField("name", Meta.Name);
+	RootObject->SetStringField("desc", Meta.Description);
+	RootObject->SetStringField("date", Meta.Date);
+
+	// 要素数组已是 JSON 文本，直接拼到元数据对象末尾，避免再建一次 DOM
+	FString OutputString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+	OutputString.LeftChopInline(1);
+	OutputString += TEXT(",\"data\":") + (MapDataStr.IsEmpty() ? FString(TEXT("[]")) : MapDataStr) + TEXT("}");
+
+	return FFileHelper::SaveStringToFile(OutputString, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
 }
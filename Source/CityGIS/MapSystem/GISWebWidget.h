@@ -3,26 +3,49 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "WebBrowserWidget/Public/WebBrowser.h"
+#include "Components/TreeView.h"
 #include "Components/ScrollBox.h"
 #include "Components/EditableText.h"
 #include "Components/ComboBoxString.h"
 #include "Components/Slider.h"
 #include "Components/Border.h"
+#include "Async/Future.h"
+#include "GISPolyItemData.h"
 #include "GISPolyItem.h"
 #include "GISLoadDialog.h"
 #include "GISSaveDialog.h"
+#include "GISBridge.h"
+#include "GISSpatialIndex.h"
+#include "GISSnapService.h"
+#include "GISCoordinates.h"
+#include "GISSaveIndex.h"
+#include "GISFileTask.h"
+#include "GISEditJournal.h"
+#include "GISResourceServer.h"
+#include "GISLodPyramid.h"
+#include "GISTileCache.h"
+#include "GISSearchIndex.h"
+#include "GISFilterEngine.h"
+#include "GISEditHistory.h"
+#include "GISFeatureStats.h"
+#include "GISScoring.h"
+#include "GISPointLayer.h"
+#include "GISLineBuffer.h"
 #include "GISWebWidget.generated.h"
 
-USTRUCT(BlueprintType)
-struct FGISSaveMetadata
-{
-    GENERATED_BODY()
-    FString ID;
-    FString Name;
-    FString Description;
-    FString Date;
-    FString FilePath;
-};
+struct FGISOverlayResult;
+class AGISCityMeshActor;
+class UMaterialInterface;
+
+// 【新增】后台存档读写的进度 (0~1) 与完成通知，供存档/读档弹窗绑定
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGISFileProgressSignature, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGISFileCompletedSignature, bool, bSuccess, const FString&, FilePath);
+
+// 【新增】街道打分重算完成，打分表需要刷新
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGISScoresUpdatedSignature);
+
+// 【新增】点资源图层与街道/区镇的空间连接完成
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGISPointsJoinedSignature, int32, NumPoints);
 
 UCLASS()
 class CITYGIS_API UGISWebWidget : public UUserWidget
@@ -31,6 +54,8 @@ class CITYGIS_API UGISWebWidget : public UUserWidget
 
 public:
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
+    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
     UFUNCTION(BlueprintCallable)
     void ActivateReconstructionTool();
@@ -46,15 +71,56 @@ public:
 
     UFUNCTION(BlueprintCallable) 
     TArray<FString> GetSaveFiles();
+
+    // 【新增】街道 CSV 直接导入为存档并载入 (相对路径基于 Content/HTML)；
+    // 解析在线程池中进行，返回是否已开始，较晚开始的导入覆盖较早的
+    UFUNCTION(BlueprintCallable)
+    bool ImportCSV(FString CsvPath, EGISCoordSystem SourceCoords = EGISCoordSystem::BD09);
     
+    // 【新增】空间查询 (经纬度)：包含该点的最内层要素 / 最近的 K 个要素
+    UFUNCTION(BlueprintCallable)
+    FString FindFeatureAt(double Lng, double Lat) const;
+
+    UFUNCTION(BlueprintCallable)
+    TArray<FString> FindNearestFeatures(double Lng, double Lat, int32 Count) const;
+
+    // 【新增】按名称 / ID / 拼音首字母搜索要素，返回按匹配程度排序的 ID；选中结果时定位并高亮列表
+    UFUNCTION(BlueprintCallable)
+    TArray<FString> SearchFeatures(FString Query, int32 MaxResults = 20);
+
+    UFUNCTION(BlueprintCallable)
+    void SelectSearchResult(FString ID);
+
     void FocusID(FString ID);
     void DeleteID(FString ID);
+
+    // 【新增】撤销/重做属性修改、删除与新建的要素；只向页面与列表推送受影响的要素
+    UFUNCTION(BlueprintCallable)
+    void Undo();
+
+    UFUNCTION(BlueprintCallable)
+    void Redo();
+
+    UFUNCTION(BlueprintPure)
+    bool CanUndo() const { return History.CanUndo(); }
+
+    UFUNCTION(BlueprintPure)
+    bool CanRedo() const { return History.CanRedo(); }
+
+    // 【修改】只显示该类型 ("All" 或空为全部显示)；筛选在 C++ 中求值，页面只接收可见性变化的要素
     void FilterByType(FString TypeName);
 
+    // 【新增】启用/停用一个筛选键 (类型名或标签)
+    UFUNCTION(BlueprintCallable)
+    void SetFilterKeyActive(FString Key, bool bActive);
+
+    // 属性谓词等扩展筛选直接操作筛选引擎，变化在下一帧下发
+    FGISFilterEngine& GetFilterEngine() { return FilterEngine; }
+
     // 【新增】高亮列表项
     void HighlightListUI(FString ID);
 
-    void OpenEditDialog(class UGISPolyItem* ItemToEdit);
+    void OpenEditDialog(UGISPolyItemData* ItemToEdit);
     
     UFUNCTION(BlueprintCallable) 
     void SaveEditChanges();
@@ -68,17 +134,126 @@ public:
     UFUNCTION(BlueprintCallable) 
     void RequestSaveDataFromWeb();
 
+    // 【新增】保存当前存档：只把新的编辑记录追加到日志；尚未存过的新地图走另存为流程
+    UFUNCTION(BlueprintCallable)
+    void SaveCurrentMap();
+
+    UFUNCTION(BlueprintPure)
+    bool HasUnsavedEdits() const { return EditJournal.HasPending(); }
+
     UFUNCTION(BlueprintCallable) 
     void OpenLoadDialog();
     
+    // 【修改】存档/读档都在线程池中执行，只有最终的列表与网页更新回到游戏线程
+    // 同一时间只保留一个任务，新任务会取消尚未完成的旧任务
     void ExecuteSaveToFile(FString GeoJsonData, FString SaveName, FString SaveDesc);
     void ExecuteLoadFromFile(FString FilePath);
 
+    UFUNCTION(BlueprintCallable)
+    void CancelFileTask();
+
+    UFUNCTION(BlueprintPure)
+    bool IsFileTaskRunning() const { return CurrentFileTask.IsValid(); }
+
+    UPROPERTY(BlueprintAssignable)
+    FGISFileProgressSignature OnFileProgress;
+
+    UPROPERTY(BlueprintAssignable)
+    FGISFileCompletedSignature OnSaveCompleted;
+
+    UPROPERTY(BlueprintAssignable)
+    FGISFileCompletedSignature OnLoadCompleted;
+
+    // 【新增】把任意存档 (.gisb / .json) 导出为 JSON 存档，用于与外部工具交换
+    UFUNCTION(BlueprintCallable)
+    bool ExportSaveAsJson(FString FilePath, FString OutputPath);
+
+    // 【新增】存档元数据索引，读档列表与删除都经由这里
+    FGISSaveIndex& GetSaveIndex() { return SaveIndex; }
+
+    // 【新增】要素列式存储 (属性与层级)，以及句柄到列表数据节点的映射
+    const FGISFeatureStore& GetFeatureStore() const { return FeatureStore; }
+
+    // 【新增】要素的面积、周长、质心/标注点，以及沿 区镇->街道->小区 汇总的下级统计 (量测在后台完成，尚未量测时几何字段为 0)
+    UFUNCTION(BlueprintCallable)
+    bool GetFeatureSummary(FString ID, FGISFeatureSummary& OutSummary) const;
+
+    const FGISFeatureStats& GetFeatureStats() const { return FeatureStats; }
+
+    // 【新增】街道打分：按打分项加权评分 (面积、地标资源数、重构区域覆盖率)，几何增删后只重算受影响的街道
+    UFUNCTION(BlueprintCallable)
+    void SetScoreTerms(const TArray<FGISScoreTerm>& Terms);
+
+    // 打分表，SortColumn 为 -1 时按总分排序，否则按第 SortColumn 项指标
+    UFUNCTION(BlueprintCallable)
+    TArray<FGISScoreRow> GetScoreTable(int32 SortColumn = -1, bool bDescending = true) const;
+
+    // 在地图上按总分分级设色，关闭后恢复要素自身的颜色
+    UFUNCTION(BlueprintCallable)
+    void SetScoreChoroplethVisible(bool bVisible);
+
+    UPROPERTY(BlueprintAssignable)
+    FGISScoresUpdatedSignature OnScoresUpdated;
+
+    // 【新增】点资源图层 (学校、车站等)：CSV 在线程池中读入 (返回是否已开始)，完成后整体替换当前图层；
+    // 点只存在 C++ 中，页面按视口取聚合后的瓦片，打分项 PointCount 按类别取连接后的计数
+    UFUNCTION(BlueprintCallable)
+    bool ImportPointsCSV(FString CsvPath, EGISCoordSystem SourceCoords = EGISCoordSystem::BD09);
+
+    UFUNCTION(BlueprintCallable)
+    void ClearPoints();
+
+    UFUNCTION(BlueprintPure)
+    int32 GetNumPoints() const;
+
+    // 街道或区镇内的点数 (区镇含其街道内的点)，Category 为空时为全部类别；连接完成前为 0
+    UFUNCTION(BlueprintCallable)
+    int32 GetPointCount(FString FeatureID, FString Category) const;
+
+    UPROPERTY(BlueprintAssignable)
+    FGISPointsJoinedSignature OnPointsJoined;
+
+    // 【新增】道路以中心线与宽度为源数据，面由 C++ 生成 (圆角/斜接/倒角连接，可逐段设宽)；改动只重建该条道路
+    // 宽度均为全宽。旧存档中的道路没有中心线 (properties.road)，只有当时以滑块值为半径缓冲出的面 (实际是标注宽度的两倍)，
+    // 无法还原中心线，因此保持原几何：这些道路不能改宽、改走向或重建，相应调用返回 false 并记录警告
+    UFUNCTION(BlueprintCallable)
+    bool SetRoadWidth(FString ID, float WidthMeters);
+
+    // 逐段全宽 (米)，个数须与线段数相同
+    UFUNCTION(BlueprintCallable)
+    bool SetRoadSegmentWidths(FString ID, const TArray<float>& WidthsMeters);
+
+    // 编辑中心线 (BD09 经纬度)；段数变了且原来是逐段宽度时，统一取原第一段的宽度
+    UFUNCTION(BlueprintCallable)
+    bool SetRoadCenterline(FString ID, const TArray<FVector2D>& Centerline);
+
+    UFUNCTION(BlueprintCallable)
+    bool SetRoadStyle(FString ID, EGISLineJoin Join, EGISLineCap Cap);
+
+    UFUNCTION(BlueprintCallable)
+    bool GetRoadCenterline(FString ID, TArray<FVector2D>& OutCenterline, TArray<float>& OutWidths) const;
+
+    // 整个路网在线程池中并行重建
+    UFUNCTION(BlueprintCallable)
+    void RebuildRoadNetwork();
+
+    // 【新增】按高度拉伸出的城市体块 (首次有可拉伸的要素时生成)
+    UFUNCTION(BlueprintPure)
+    AGISCityMeshActor* GetCityMeshActor() const { return CityMeshActor.Get(); }
+    UGISPolyItemData* GetItemByHandle(FGISFeatureHandle Handle) const;
+    UGISPolyItemData* FindItem(const FString& ID) const;
+
 protected:
     UPROPERTY(meta = (BindWidget)) UWebBrowser* MapBrowser;
-    UPROPERTY(meta = (BindWidget)) UScrollBox* List_Admin;
-    UPROPERTY(meta = (BindWidget)) UScrollBox* List_Reconstruct;
-    UPROPERTY(meta = (BindWidget)) UScrollBox* List_Road; 
+    // 虚拟化树列表：只为可见行生成 UGISPolyItem (在 UMG 中设置 EntryWidgetClass 为行蓝图)
+    UPROPERTY(meta = (BindWidgetOptional)) UTreeView* Tree_Admin;
+    UPROPERTY(meta = (BindWidgetOptional)) UTreeView* Tree_Reconstruct;
+    UPROPERTY(meta = (BindWidgetOptional)) UTreeView* Tree_Road;
+
+    // 旧版蓝图的滚动列表：蓝图中没有 Tree_* 时，按树的顺序把 PolyItemClass 行控件平铺进来 (按层级缩进，不虚拟化)
+    UPROPERTY(meta = (BindWidgetOptional)) UScrollBox* List_Admin;
+    UPROPERTY(meta = (BindWidgetOptional)) UScrollBox* List_Reconstruct;
+    UPROPERTY(meta = (BindWidgetOptional)) UScrollBox* List_Road; 
 
     UPROPERTY(meta = (BindWidget)) UEditableText* Input_SaveName;
     UPROPERTY(meta = (BindWidget)) UComboBoxString* Combo_Files;
@@ -93,6 +268,9 @@ protected:
     
     UPROPERTY(meta = (BindWidget)) UComboBoxString* Edit_Input_Parent;
 
+    // 父级选择器的搜索框 (可选)，输入时按名称或 ID 重新筛选候选
+    UPROPERTY(meta = (BindWidgetOptional)) UEditableText* Edit_Parent_Search;
+
     UPROPERTY(meta = (BindWidget)) UBorder* Color_Preview;
     UPROPERTY(meta = (BindWidget)) UBorder* TextColor_Preview;
     
@@ -103,6 +281,7 @@ protected:
     UPROPERTY(meta = (BindWidget)) USlider* Slider_Text_G;
     UPROPERTY(meta = (BindWidget)) USlider* Slider_Text_B;
 
+    // 旧版滚动列表的行控件 (树列表改用 EntryWidgetClass)
     UPROPERTY(EditAnywhere, Category = "Config")
     TSubclassOf<UGISPolyItem> PolyItemClass;
 
@@ -112,29 +291,306 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Config")
     TSubclassOf<UGISLoadDialog> LoadDialogClass;
 
+    // 每帧处理入队要素的时间预算 (毫秒)，超出则留到下一帧
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "0.5"))
+    float IngestBudgetMs = 4.0f;
+
+    // 自动吸附容差 (米)
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "0.1"))
+    float SnapToleranceMeters = 50.0f;
+
+    // 存档写为二进制 .gisb (关闭则写旧版 JSON)；读取时两种格式都支持
+    UPROPERTY(EditAnywhere, Category = "Config")
+    bool bBinarySaves = true;
+
+    // .gisb 负载使用 Oodle/Zlib 压缩
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (EditCondition = "bBinarySaves"))
+    bool bCompressSaves = true;
+
+    // 自动保存间隔 (秒)，只写出新增的编辑记录；0 为关闭
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "0"))
+    float AutosaveIntervalSeconds = 30.0f;
+
+    // 编辑日志累计达到该条数时压实进快照
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "1"))
+    int32 JournalCompactRecords = 500;
+
+    // 面要素按视口内的矢量瓦片显示 (需要资源通道)；关闭则每个要素常驻一个覆盖物
+    UPROPERTY(EditAnywhere, Category = "Config")
+    bool bTiledOverlays = true;
+
+    // 内存中最多保留的瓦片数 (超出按最久未用淘汰，磁盘缓存不受限)
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "16", EditCondition = "bTiledOverlays"))
+    int32 MaxMemoryTiles = 512;
+
+    // 搜索时匹配中文名称的拼音首字母 (如 "cnq" 匹配 "长宁区")
+    UPROPERTY(EditAnywhere, Category = "Config")
+    bool bSearchPinyin = true;
+
+    // 搜索框每次输入返回的结果数
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "1"))
+    int32 MaxSearchResults = 20;
+
+    // 父级下拉框一次最多列出的候选数，更多的通过搜索框筛选
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "10"))
+    int32 ParentPickerPageSize = 200;
+
+    // 撤销历史占用的内存上限 (MB)，超出时丢弃最旧的记录
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "0"))
+    float UndoMemoryLimitMB = 32.0f;
+
+    // 在场景中把有高度的面要素拉伸为体块，每个区镇一个网格段
+    UPROPERTY(EditAnywhere, Category = "Config")
+    bool bExtrudeFeatures = true;
+
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (EditCondition = "bExtrudeFeatures"))
+    UMaterialInterface* ExtrusionMaterial = nullptr;
+
+    // 为体块生成碰撞 (异步烘焙，大量要素时仍有开销)
+    UPROPERTY(EditAnywhere, Category = "Config", meta = (EditCondition = "bExtrudeFeatures"))
+    bool bExtrusionCollision = false;
+
+    // 街道打分项，为空则不打分
+    UPROPERTY(EditAnywhere, Category = "Config")
+    TArray<FGISScoreTerm> ScoreTerms;
+
+    // 启动时即在地图上显示打分设色
+    UPROPERTY(EditAnywhere, Category = "Config")
+    bool bShowScoreChoropleth = false;
+
 private:
     UFUNCTION() 
     void HandleConsoleMessage(const FString& Message, const FString& Source, int32 Line);
 
+    // 【新增】结构化通道：把 Bridge 绑定到浏览器，并按消息类型注册处理函数
+    void BindBridge();
+    void HandleFeatureBatch(const TArray<FGISFeatureRecord>& Records);
+    void HandleExportData(const FString& Payload);
+    void HandleDoubleClick(const FString& Payload);
+
+    // 【新增】重构分析：在线程池中做多边形叠加，结果回到游戏线程后推给网页
+    void HandleAnalyze(const FString& Payload);
+    void ApplyAnalysisResult(int32 Serial, const FGISOverlayResult& Result);
+    void StoreFeatureGeometry(const FString& ID, const FString& GeometryJson);
+    void AddFeatureGeometry(const FString& ID, TSharedPtr<const FGISMultiPolygon> Geometry);
+
+    // 【新增】道路缓冲：BUFFER 为绘制道路时请求生成面；中心线或宽度改动后替换 C++ 索引与页面中的几何
+    void HandleBuffer(const FString& Payload);
+    bool UpdateRoad(const FString& ID, const FGISRoadLine& Road);
+    // 道路的源数据；旧存档中没有中心线的道路返回空并记录警告
+    const FGISRoadLine* FindRoadLine(const FString& ID) const;
+    void ApplyRoadGeometries(const TArray<FString>& IDs, TArray<FGISMultiPolygon>& Geometries);
+
+    // 【新增】吸附请求：SNAP 为保存前整面吸附，SNAP_POINT 为绘制时单点吸附
+    void HandleSnap(const FString& Payload);
+    void HandleSnapPoint(const FString& Payload);
+    const FGISSnapService& GetSnapService();
+
+    // 读取存档中的要素数组文本 (可直接作为 JS 字面量)，两种格式通用；不访问成员，可在工作线程调用
+    // 存档带有编辑日志时一并重放
+    static bool ReadSaveFeatures(const FString& FilePath, FGISSaveMetadata& OutMeta, FString& OutFeaturesJson, const FGISSaveProgress& Progress = nullptr, FGISJournalState* OutJournal = nullptr);
+    static bool WriteSaveFile(const FString& GeoJsonData, FGISSaveMetadata& InOutMeta, bool bBinary, bool bCompress, FGISFileTask& Task);
+
+    // 【新增】后台存档任务：开始时取消旧任务，完成后在游戏线程收尾
+    TSharedRef<FGISFileTask> BeginFileTask(EGISFileTaskType Type);
+    void FinishSave(const TSharedRef<FGISFileTask>& Task, bool bSaved, const FGISSaveMetadata& Meta);
+    void FinishLoad(const TSharedRef<FGISFileTask>& Task, bool bLoaded, const FString& FilePath, TArray<uint8> MapData, const FGISJournalState& Journal);
+    // 页面分块导入完成 (载荷为读档序号)；此前入队的要素只是存档的一部分
+    void HandleImportDone(const FString& Payload);
+    void BroadcastFileCompleted(EGISFileTaskType Type, bool bSuccess, const FString& FilePath);
+    void TickFileTaskProgress();
+
+    // 【新增】编辑日志：网页上报增/改/删，按间隔或手动保存时在线程池中写盘，同一时间只有一个写盘任务
+    void HandleEdits(const FString& Payload);
+    void TickAutosave(float DeltaTime);
+    void FlushEditJournal();
+    static bool WriteEditBatch(const FGISEditBatch& Batch, bool bCompress, FGISSaveMetadata& OutCompacted);
+    static bool CompactSnapshot(const FString& SnapshotPath, const TArray<FGISEditRecord>& Records, bool bCompress, FGISSaveMetadata& OutMeta);
+
+    // 【新增】按帧预算消化入队的要素，突发批量也不会丢失
+    void ProcessPendingFeatures();
+
+    // 【新增】几何多级简化：要素变动后在线程池中重建，网页缩放跨级时只下发对应级别
+    void HandleView(const FString& Payload);
+    void TickLod();
+    void PushLodLevel(int32 Level);
+
+    // 【新增】矢量瓦片：页面就绪后告知瓦片地址，几何源更新后通知页面重取受影响的瓦片
+    void HandlePageReady(const FString& Payload);
+    void PushTileChanges(const TArray<FGISTileRange>& Changed, bool bAll);
+
+    // 【新增】搜索框：SEARCH 为逐字输入的查询，SEARCH_PICK 为选中的结果
+    void HandleSearch(const FString& Payload);
+    void HandleSearchPick(const FString& Payload);
+
+    // 【新增】筛选面板的开关 (FILTER)，以及每帧把可见性变化合并为一次调用下发
+    void HandleFilter(const FString& Payload);
+    void TickFilter();
+    void PushFilterKeys();
+
+    // 【新增】撤销历史：页面快捷键 (UNDO/REDO)、编辑框属性的读取与应用、要素的移除与恢复
+    void HandleUndo(const FString& Payload);
+    void HandleRedo(const FString& Payload);
+    void ApplyHistory(const FGISHistoryCommand& Command, bool bUndo);
+    FGISFeatureEdit ReadFeatureEdit(FGISFeatureHandle Handle) const;
+    void ApplyFeatureEdit(const FString& ID, const FGISFeatureEdit& Edit);
+    bool RemoveFeature(const FString& ID, TArray<FString>* OutOrphanIDs = nullptr);
+    void RestoreFeature(const FGISHistoryChange& Change);
+
+    // 【新增】体块拉伸：要素或属性变动后在线程池中重建，只向网格提交变化的区镇
+    void TickExtrusion();
+    FString GetExtrusionGroup(FGISFeatureHandle Handle) const;
+
+    // 【新增】要素量测：几何变动后在线程池中并行量测，回到游戏线程后增量更新层级汇总
+    void TickMeasure();
+
+    // 【新增】街道打分：量测完成后在线程池中并行重算受影响的街道，设色变化合并为一次调用下发
+    void TickScoring();
+    void PushScoreStyle();
+
+    // 【新增】点资源图层：街道/区镇几何或图层变动后在线程池中重做空间连接
+    void TickPointJoin();
+    void PushPointLayer();
+    void SetPointLayer(TSharedPtr<const FGISPointLayer> Layer);
+    bool IsPointJoinTarget(const FString& ID) const;
+
     UFUNCTION() 
     void OnColorSliderChanged(float Value);
 
     UFUNCTION() 
     void OnTextColorSliderChanged(float Value);
 
+    // 【新增】父级选择器：打开编辑框时只放入当前父级，展开下拉或输入搜索时才按类型查询候选
+    UFUNCTION()
+    void OnParentPickerOpening();
+
+    UFUNCTION()
+    void OnParentSearchChanged(const FText& Text);
+
+    void PopulateParentPicker(const FString& Filter);
+    void AddParentOption(FGISFeatureHandle Handle);
+
     void ProcessAddPolyItem(FString ID, FString Name, FString Type, FString ParentID, FString Color, float Opacity, FString TextColor, FString Tag, float Height);
+
+    // 【新增】树列表的数据模型操作
+    UGISPolyItemData* RegisterItem(const FString& ID, const FGISFeatureStore::FAttributes& Attributes);
+    void OnGetItemChildren(UObject* Item, TArray<UObject*>& OutChildren);
+    // bKeepRoadsInRoadList: 道路始终挂在道路列表根部，不随父级进入树
+    void AttachItem(UGISPolyItemData* Item, bool bKeepRoadsInRoadList);
+    void DetachItem(UGISPolyItemData* Item);
+    UTreeView* FindOwningTree(UGISPolyItemData* Item) const;
+    void RefreshItemEntry(UGISPolyItemData* Item);
+    void ClearAllLists();
+
+    // 旧版滚动列表：结构变化后标脏，每帧最多重排一次，行控件按数据节点复用
+    bool UsesLegacyLists() const;
+    void TickLegacyLists();
     void UpdateColorUI(FLinearColor Color);
     void UpdateTextColorUI(FLinearColor Color);
 
     // 【新增】根据区代码获取真实中文名 (如 310101 -> 黄浦区)
     FString GetDistrictNameByCode(const FString& Code);
     
-    UPROPERTY() TMap<FString, UGISPolyItem*> WidgetMap = {};
+    // 要素属性与层级只存在 FeatureStore 中；ItemsByHandle 以句柄的槽位下标存放对应的数据节点
+    FGISFeatureStore FeatureStore;
+    UPROPERTY() TArray<UGISPolyItemData*> ItemsByHandle;
+    UPROPERTY() TMap<UGISPolyItemData*, UGISPolyItem*> LegacyRows;
+    bool bLegacyListsDirty = false;
+
+    // 父级下拉框的选项文本 -> 句柄 ("无" 对应空句柄)
+    TMap<FString, FGISFeatureHandle> ParentOptions;
+    bool bParentOptionsLoaded = false;
     
-    UPROPERTY() TWeakObjectPtr<UGISPolyItem> CurrentEditingItem;
+    UPROPERTY() TWeakObjectPtr<UGISPolyItemData> CurrentEditingItem;
+
+    UPROPERTY() UGISBridge* Bridge = nullptr;
     
-    FString LastProcessedID;
-    double LastLogTime = 0.0f;
+    TArray<FGISFeatureRecord> PendingFeatures;
+    int32 PendingFeatureHead = 0;
+
+    // 要素几何的空间索引 (几何只读共享，分析任务直接持有候选快照，不拷贝坐标)
+    FGISSpatialIndex SpatialIndex;
+
+    // 吸附网格只支持追加，删除要素后标脏，下次吸附时从空间索引整体重建
+    FGISSnapService SnapService;
+
+    // 道路的中心线与宽度 (要素上报时随 properties.road 带来；旧存档的道路不在其中)
+    TMap<FString, FGISRoadLine> Roads;
+    int32 RoadBuildSerial = 0;
+    bool bSnapServiceDirty = false;
+
+    FGISSaveIndex SaveIndex;
+
+    // 页面通过 fetch 读取的大块数据 (读档的要素数组)
+    FGISResourceServer ResourceServer;
+
+    // 多级简化几何 (建好后只读，工作线程生成下发数据时直接持有)
+    TSharedPtr<const FGISLodPyramid> LodPyramid;
+    bool bLodDirty = false;
+    bool bLodBuildInFlight = false;
+    int32 LodBuildSerial = 0;
+    // 读档后页面尚未导入完毕时不建 LOD 与瓦片源 (分块之间要素已全部消化，但文档还不完整)
+    bool bImportPending = false;
+    int32 ImportSerial = 0;
+    int32 LodPushSerial = 0;
+    int32 ViewLodLevel = 0;
+
+    // 瓦片缓存由资源通道的工作线程访问，以共享指针持有；地址为空表示未启用瓦片模式
+    TSharedRef<FGISTileCache> TileCache = MakeShared<FGISTileCache>();
+    FString TileBaseUrl;
+
+    // 要素名称的搜索索引，随列表增删改同步更新
+    FGISSearchIndex SearchIndex;
+
+    // 按类型/标签的可见性位集
+    FGISFilterEngine FilterEngine;
+
+    // 撤销/重做历史；恢复的要素入列表后按此把原来的子要素挂回
+    FGISEditHistory History;
+    TMap<FString, TArray<FString>> PendingReattach;
+
+    // 体块网格与局部坐标原点 (首次构建时取数据范围中心，清空列表后重新选取)
+    TWeakObjectPtr<AGISCityMeshActor> CityMeshActor;
+    FGISEnuFrame ExtrusionFrame;
+    bool bExtrusionDirty = false;
+    bool bExtrusionBuildInFlight = false;
+    int32 ExtrusionBuildSerial = 0;
+
+    // 量测缓存与层级汇总；层级变化时在 AttachItem/DetachItem 中同步
+    FGISFeatureStats FeatureStats;
+    bool bMeasureDirty = false;
+    bool bMeasureInFlight = false;
+    int32 MeasureSerial = 0;
+
+    // 街道打分 (面积取自量测缓存，因此等量测完成后再算)
+    FGISScoringEngine Scoring;
+    bool bScoringInFlight = false;
+    int32 ScoringSerial = 0;
+
+    // 点资源图层 (只读，替换时整体换新)；瓦片源由资源通道的工作线程访问
+    TSharedPtr<const FGISPointLayer> PointLayer;
+    TSharedRef<FGISPointTileSource> PointTiles = MakeShared<FGISPointTileSource>();
+    FString PointTileBaseUrl;
+    int32 PointLoadSerial = 0;
+    TSharedPtr<const FGISPointJoin> PointJoin;
+    bool bPointJoinDirty = false;
+    bool bPointJoinInFlight = false;
+    int32 PointJoinSerial = 0;
+
+    // 当前的后台存档任务及上次广播的进度 (只在游戏线程访问)
+    TSharedPtr<FGISFileTask> CurrentFileTask;
+    FString CurrentFilePath;
+    float LastFileProgress = -1.0f;
+    int32 CsvImportSerial = 0;
+
+    // 当前存档的编辑日志与自动保存状态
+    FGISEditJournal EditJournal;
+    float AutosaveElapsed = 0.0f;
+    TFuture<void> EditFlushFuture;
+    bool bEditFlushQueued = false;
+
+    // 每次发起分析自增，过期的异步结果直接丢弃
+    int32 AnalysisSerial = 0;
 
     // 【新增】区划代码映射表
     TMap<FString, FString> DistrictNameMap;